@@ -0,0 +1,342 @@
+#ifndef BDN_Actor_H_
+#define BDN_Actor_H_
+
+#include <bdn/IDispatcher.h>
+#include <bdn/AsyncOpRunnable.h>
+#include <bdn/entry.h>
+
+#if BDN_HAVE_THREADS
+#include <bdn/ThreadPool.h>
+#include <bdn/SerialExecutor.h>
+#endif
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace bdn
+{
+
+    /** An object of type StateType that is owned by a mailbox ("actor").
+
+        The state object can only be accessed by sending messages to the actor.
+       Messages are functions that receive a reference to the state object.
+       They are executed one after the other, in the order in which they were
+       sent, and never concurrently. So the state object does not need any
+       locking, even though messages can be sent from any thread.
+
+        The messages are executed by one of the following:
+
+        - an IDispatcher (for example, the main dispatcher, so that the state is
+          owned by the main thread)
+        - a SerialExecutor
+        - a ThreadPool (the actor then behaves like its own SerialExecutor on
+          that pool).
+
+        An actor does not own a thread. When its mailbox is empty then it does
+       not occupy any resources of the executing dispatcher or pool. When
+       messages arrive then a single drain call is scheduled, which executes
+       all messages that have accumulated so far in one batch.
+
+        tell() sends a message without waiting for a result. It does not
+       allocate memory per message, as long as the message function is small
+       enough to be stored inside std::function without an extra allocation
+       (e.g. a lambda that only captures a pointer or two). The mailbox
+       storage is reused from one batch to the next.
+
+        ask() sends a message that returns a value and returns an IAsyncOp
+       object that provides the result.
+
+        If a message throws an exception then it is handled like an exception
+       in a thread pool job (see bdn::unhandledException()). The remaining
+       messages are executed normally.
+
+        When the actor is deleted then messages that have not been executed yet
+       are discarded. Operations returned by ask() for such messages fail with
+       an AbortedError. Note that the actor is kept alive while a batch of
+       its messages is executed.
+
+        Example:
+
+        \code
+
+        struct Counter
+        {
+            int value = 0;
+        };
+
+        P<Actor<Counter>> counter = newObj<Actor<Counter>>(getMainDispatcher());
+
+        counter->tell([](Counter &state) { state.value++; });
+
+        P<IAsyncOp<int>> op = counter->ask([](Counter &state) { return state.value; });
+
+        \endcode
+    */
+    template <class StateType> class Actor : public Base
+    {
+      public:
+        typedef std::function<void(StateType &)> Message;
+
+        /** Creates an actor whose messages are executed by the specified
+           dispatcher. The remaining arguments are passed to the constructor
+           of the state object.*/
+        template <class... StateArgs>
+        Actor(IDispatcher *dispatcher, StateArgs &&... stateArgs)
+            : _dispatcher(dispatcher), _state(std::forward<StateArgs>(stateArgs)...)
+        {}
+
+#if BDN_HAVE_THREADS
+        /** Creates an actor whose messages are executed by the specified
+           serial executor. The remaining arguments are passed to the
+           constructor of the state object.*/
+        template <class... StateArgs>
+        Actor(SerialExecutor *executor, StateArgs &&... stateArgs)
+            : _executor(executor), _state(std::forward<StateArgs>(stateArgs)...)
+        {}
+
+        /** Creates an actor whose messages are executed by the threads of the
+           specified pool. The remaining arguments are passed to the constructor
+           of the state object.*/
+        template <class... StateArgs>
+        Actor(ThreadPool *pool, StateArgs &&... stateArgs)
+            : _pool(pool), _state(std::forward<StateArgs>(stateArgs)...)
+        {}
+#endif
+
+        ~Actor() { discardMessages(); }
+
+        /** Sends a message to the actor. The message is executed
+           asynchronously, after all previously sent messages.
+
+            tell() can be called from any thread, including from a message of
+           the actor itself.
+
+            If the drain cannot be scheduled (for example, because the pool
+           rejects it with a QueueFullError) then the exception is passed on.
+           The message stays in the mailbox and is executed after the next
+           successful tell() or ask().*/
+        void tell(Message message)
+        {
+            bool scheduleDrain = false;
+
+            {
+                Mutex::Lock lock(_mutex);
+
+                _mailbox.push_back(std::move(message));
+
+                if (!_drainScheduled) {
+                    _drainScheduled = true;
+                    scheduleDrain = true;
+                }
+            }
+
+            if (scheduleDrain)
+                this->scheduleDrain();
+        }
+
+        /** Sends a message that returns a value. Returns an IAsyncOp object that
+           provides the return value of the message function when it has been
+           executed (or the exception that it threw).
+
+            ask() can be called from any thread.*/
+        template <class FuncType>
+        P<IAsyncOp<typename std::result_of<FuncType(StateType &)>::type>> ask(FuncType func)
+        {
+            typedef typename std::result_of<FuncType(StateType &)>::type ResultType;
+
+            P<AskOp_<ResultType>> op = newObj<AskOp_<ResultType>>(std::move(func));
+            P<AskGuard_<ResultType>> guard = newObj<AskGuard_<ResultType>>(op);
+
+            tell([guard](StateType &state) { guard->execute(state); });
+
+            return op;
+        }
+
+        /** Returns the number of messages that are waiting to be executed
+           (not including the batch that is currently being executed).
+
+            Note that this number can change at any time, so it is only fully
+           reliable in rare cases (possibly during testing).*/
+        int getPendingMessageCount() const
+        {
+            Mutex::Lock lock(_mutex);
+
+            return (int)_mailbox.size();
+        }
+
+      private:
+        template <class ResultType> class AskOp_ : public AsyncOpRunnable<ResultType>
+        {
+          public:
+            AskOp_(std::function<ResultType(StateType &)> func) : _func(std::move(func)) {}
+
+            void runOn(StateType &state)
+            {
+                _state = &state;
+                this->run();
+            }
+
+          protected:
+            ResultType doOp() override { return _func(*_state); }
+
+          private:
+            std::function<ResultType(StateType &)> _func;
+            StateType *_state = nullptr;
+        };
+
+        /** Aborts the operation of an ask() message if the message is
+           discarded without being executed. The message function can be copied,
+           so the guard is reference counted and acts when the last copy is
+           gone.*/
+        template <class ResultType> class AskGuard_ : public Base
+        {
+          public:
+            AskGuard_(AskOp_<ResultType> *op) : _op(op) {}
+
+            ~AskGuard_()
+            {
+                // has no effect if the operation was executed.
+                _op->signalStop();
+            }
+
+            void execute(StateType &state) { _op->runOn(state); }
+
+          private:
+            P<AskOp_<ResultType>> _op;
+        };
+
+        /** The job that drains the mailbox on a ThreadPool or SerialExecutor.
+         * Also used for dispatchers.*/
+        class Drainer_ : public Base, BDN_IMPLEMENTS IThreadRunnable
+        {
+          public:
+            Drainer_(Actor *actor) : _actorWeak(actor) {}
+
+            void run() override
+            {
+                // the actor is kept alive while the batch is executed.
+                P<Actor> actor = _actorWeak.toStrong();
+                if (actor != nullptr)
+                    actor->drain();
+            }
+
+            void signalStop() override
+            {
+                // the pool is shutting down and will not execute us. Allow
+                // the next tell() to schedule a new drain.
+                P<Actor> actor = _actorWeak.toStrong();
+                if (actor != nullptr) {
+                    Mutex::Lock lock(actor->_mutex);
+                    actor->_drainScheduled = false;
+                }
+            }
+
+          private:
+            WeakP<Actor> _actorWeak;
+        };
+
+        void scheduleDrain()
+        {
+            if (_drainer == nullptr) {
+                // the drainer is only ever accessed by the thread that has set
+                // _drainScheduled, so there is no race here.
+                _drainer = newObj<Drainer_>(this);
+            }
+
+            try {
+                if (_dispatcher != nullptr) {
+                    P<Drainer_> drainer = _drainer;
+                    _dispatcher->enqueue([drainer]() { drainer->run(); });
+                }
+#if BDN_HAVE_THREADS
+                else if (_executor != nullptr)
+                    _executor->addJob(_drainer);
+                else
+                    _pool->addJob(_drainer);
+#endif
+            }
+            catch (...) {
+                // e.g. QueueFullError. The messages stay in the mailbox and the
+                // next tell() tries to schedule the drain again.
+                Mutex::Lock lock(_mutex);
+                _drainScheduled = false;
+
+                throw;
+            }
+        }
+
+        void drain()
+        {
+            {
+                Mutex::Lock lock(_mutex);
+
+                // we take all messages that have accumulated so far. The
+                // vectors keep their capacity, so in the steady state no memory
+                // is allocated.
+                _batch.swap(_mailbox);
+            }
+
+            for (Message &message : _batch) {
+                try {
+                    message(_state);
+                }
+                catch (...) {
+                    if (!bdn::unhandledException(true))
+                        std::terminate();
+                }
+            }
+
+            _batch.clear();
+
+            bool moreMessages;
+            {
+                Mutex::Lock lock(_mutex);
+
+                moreMessages = !_mailbox.empty();
+                if (!moreMessages)
+                    _drainScheduled = false;
+            }
+
+            // if new messages have arrived in the meantime then we schedule
+            // another drain instead of looping here. That gives other work
+            // on the same dispatcher or pool a chance to run.
+            if (moreMessages)
+                scheduleDrain();
+        }
+
+        void discardMessages()
+        {
+            std::vector<Message> discarded;
+
+            {
+                Mutex::Lock lock(_mutex);
+                discarded.swap(_mailbox);
+            }
+
+            // the messages are destroyed here, without the mutex. That aborts
+            // the pending ask() operations, which may call notification
+            // handlers.
+        }
+
+        P<IDispatcher> _dispatcher;
+#if BDN_HAVE_THREADS
+        P<SerialExecutor> _executor;
+        P<ThreadPool> _pool;
+#endif
+
+        P<Drainer_> _drainer;
+
+        mutable Mutex _mutex;
+        std::vector<Message> _mailbox;
+        bool _drainScheduled = false;
+
+        // only accessed by the drain
+        std::vector<Message> _batch;
+
+        StateType _state;
+    };
+}
+
+#endif
@@ -4,34 +4,58 @@
 #include <bdn/IAsyncOp.h>
 #include <bdn/IThreadRunnable.h>
 #include <bdn/RequireNewAlloc.h>
+#include <bdn/ProgrammingError.h>
+#include <bdn/CancellationToken.h>
+
+#include <atomic>
+#include <type_traits>
 
 namespace bdn
 {
 
-    template <class ResultType> class AsyncOpResultHelper_ : public Base
+    /** Stores the result of an AsyncOpRunnable inline, without a separate
+     * heap allocation.*/
+    template <class ResultType> class AsyncOpResultStorage_
     {
       public:
-        static void doOpAndInitResult(ResultType *&result, std::function<ResultType()> opFunc)
+        AsyncOpResultStorage_() = default;
+        AsyncOpResultStorage_(const AsyncOpResultStorage_ &) = delete;
+
+        ~AsyncOpResultStorage_()
+        {
+            if (_hasValue)
+                getPtr()->~ResultType();
+        }
+
+        template <class FuncType> void initFrom(FuncType &&func)
         {
-            result = new ResultType(opFunc());
+            ::new (&_storage) ResultType(func());
+            _hasValue = true;
         }
 
-        static ResultType getResultValue(ResultType *result) { return *result; }
+        const ResultType &get() const { return *getPtr(); }
+
+        ResultType take() { return std::move(*getPtr()); }
 
-        static void deleteResult(ResultType *result) { delete result; }
+      private:
+        ResultType *getPtr() { return reinterpret_cast<ResultType *>(&_storage); }
+        const ResultType *getPtr() const { return reinterpret_cast<const ResultType *>(&_storage); }
+
+        typename std::aligned_storage<sizeof(ResultType), alignof(ResultType)>::type _storage;
+        bool _hasValue = false;
     };
 
-    template <> class AsyncOpResultHelper_<void> : public Base
+    template <> class AsyncOpResultStorage_<void>
     {
       public:
-        static void doOpAndInitResult(void *&result, std::function<void()> opFunc) { opFunc(); }
+        template <class FuncType> void initFrom(FuncType &&func) { func(); }
 
-        static void getResultValue(void *result)
+        void get() const
         {
             // do nothing.
         }
 
-        static void deleteResult(void *result)
+        void take()
         {
             // do nothing
         }
@@ -62,6 +86,19 @@ namespace bdn
        started. If you want to support stopping during doOp then your doOp
        implementation must call isStopSignalled() regularly and abort with an
        AbortedError exception when it returns true.
+
+        An operation can also be tied to a CancellationToken (see the
+       corresponding constructor). If the token is cancelled before the
+       operation has started then run() does not call doOp() and the operation
+       fails with a CancelledError. While doOp() is running, isStopSignalled()
+       also returns true when the token is cancelled.
+
+        AsyncOpRunnable is designed to be cheap, since many small operations
+       (like reading a single line) are implemented with it. The result is
+       stored inside the object (no separate allocation) and can be moved out
+       with takeResult(). The completion state is tracked without locks and the
+       done notifier is only created when onDone() is called for the first
+       time.
     */
     template <class ResultType>
     class AsyncOpRunnable : public RequireNewAlloc<Base, AsyncOpRunnable<ResultType>>,
@@ -69,12 +106,34 @@ namespace bdn
                             BDN_IMPLEMENTS IThreadRunnable
     {
       public:
-        AsyncOpRunnable() { _doneNotifier = newObj<OneShotStateNotifier<P<IAsyncOp<ResultType>>>>(); }
+        AsyncOpRunnable() {}
+
+        /** Creates an operation that is aborted when the specified token is
+           cancelled. If the operation has not started yet then it is done
+           (with a CancelledError) as soon as the token is cancelled, even if it
+           is still waiting in a queue.*/
+        AsyncOpRunnable(const CancellationToken &cancellationToken) : _cancellationToken(cancellationToken)
+        {
+            if (_cancellationToken.canBeCancelled() && !_cancellationToken.isCancelled()) {
+                // the handler only holds a weak reference, so that the token
+                // does not keep the operation alive.
+                WeakP<AsyncOpRunnable> opWeak(this);
+
+                _cancelSubscription = _cancellationToken.onCancel([opWeak]() {
+                    P<AsyncOpRunnable> op = opWeak.toStrong();
+                    if (op != nullptr)
+                        op->signalStop();
+                });
+            }
+        }
 
         ~AsyncOpRunnable()
         {
-            if (_result != nullptr)
-                AsyncOpResultHelper_<ResultType>::deleteResult(_result);
+            _cancellationToken.removeOnCancel(_cancelSubscription);
+
+            DoneNotifier_ *notifier = _doneNotifier.load();
+            if (notifier != nullptr)
+                notifier->releaseRef();
         }
 
         ResultType getResult() const override
@@ -85,38 +144,45 @@ namespace bdn
             if (_error)
                 std::rethrow_exception(_error);
 
-            return AsyncOpResultHelper_<ResultType>::getResultValue(_result);
+            if (_resultTaken)
+                programmingError("AsyncOpRunnable::getResult called after the result was taken with takeResult().");
+
+            return _result.get();
         }
 
-        void signalStop() override
+        ResultType takeResult() override
         {
-            bool actuallyAborted = false;
+            if (!isDone())
+                throw UnfinishedError();
 
-            {
-                Mutex::Lock lock(_mutex);
+            if (_error)
+                std::rethrow_exception(_error);
 
-                _stopSignalled = true;
+            if (_resultTaken.exchange(true))
+                programmingError("AsyncOpRunnable::takeResult called multiple times.");
 
-                // we cannot abort the operation when it is already in progress
-                if (!_started && !_abortedBeforeStart) {
-                    // not started yet. Mark as aborted and set the result
-                    _abortedBeforeStart = true;
-                    actuallyAborted = true;
+            return _result.take();
+        }
 
+        void signalStop() override
+        {
+            _stopSignalled = true;
+
+            // we cannot abort the operation when it is already in progress
+            int expectedState = statePending;
+            if (_state.compare_exchange_strong(expectedState, stateRunning)) {
+                // not started yet. We have claimed the operation, so run()
+                // will not start it anymore. Set the result.
+                if (_cancellationToken.isCancelled())
+                    _error = std::make_exception_ptr(CancelledError());
+                else
                     _error = std::make_exception_ptr(AbortedError());
-                }
-            }
 
-            if (actuallyAborted)
                 setDone();
+            }
         }
 
-        bool isDone() const override
-        {
-            Mutex::Lock lock(_mutex);
-
-            return _done;
-        }
+        bool isDone() const override { return _state == stateDone; }
 
         /** Performs the actual operation.
 
@@ -125,20 +191,18 @@ namespace bdn
            getResult() is called.*/
         void run() override
         {
-            {
-                Mutex::Lock lock(_mutex);
-                if (_abortedBeforeStart) {
-                    // aborted before we were started => do nothing
-                    return;
-                }
+            if (_cancellationToken.isCancelled())
+                signalStop();
 
-                // mark as started - from this point on aborting is not possible
-                // anymore.
-                _started = true;
-            }
+            // mark as started - from this point on aborting is not possible
+            // anymore. If the operation was aborted before it was started
+            // then we do nothing.
+            int expectedState = statePending;
+            if (!_state.compare_exchange_strong(expectedState, stateRunning))
+                return;
 
             try {
-                AsyncOpResultHelper_<ResultType>::doOpAndInitResult(_result, plainMethod(this, &AsyncOpRunnable::doOp));
+                _result.initFrom([this]() { return doOp(); });
             }
             catch (...) {
                 _error = std::current_exception();
@@ -147,7 +211,32 @@ namespace bdn
             setDone();
         }
 
-        IAsyncNotifier<P<IAsyncOp<ResultType>>> &onDone() const override { return *_doneNotifier; }
+        /** The done notifier is only created when the first handler is
+           registered. Operations that nobody subscribes to (e.g. because the
+           caller polls isDone() or simply runs them synchronously) never
+           allocate one and never post a notification.*/
+        IAsyncNotifier<P<IAsyncOp<ResultType>>> &onDone() const override
+        {
+            DoneNotifier_ *notifier = _doneNotifier.load();
+            if (notifier == nullptr) {
+                P<DoneNotifier_> newNotifier = newObj<DoneNotifier_>();
+
+                if (_doneNotifier.compare_exchange_strong(notifier, newNotifier.getPtr())) {
+                    // we own the reference now.
+                    notifier = newNotifier.detachPtr();
+
+                    // if the operation finished while we were creating the
+                    // notifier then setDone may not have seen it.
+                    if (isDone())
+                        const_cast<AsyncOpRunnable *>(this)->postDoneNotification();
+                }
+
+                // otherwise another thread was faster and notifier now points
+                // to its notifier. Ours is released.
+            }
+
+            return *notifier;
+        }
 
       protected:
         /** Override this in derived classes. This should perform the actual
@@ -155,41 +244,56 @@ namespace bdn
          */
         virtual ResultType doOp() = 0;
 
-        /** Returns true if signalStop() has been called, i.e. if the operation
-           was asked to abort. This can be used by the doActualWork()
-           implementation to detect when it should abort. That would allow the
-           operation to be aborted while it is in progress.*/
-        bool isStopSignalled()
-        {
-            Mutex::Lock lock(_mutex);
-            return _stopSignalled;
-        }
+        /** Returns true if signalStop() has been called or the cancellation
+           token was cancelled, i.e. if the operation was asked to abort. This
+           can be used by the doActualWork() implementation to detect when it
+           should abort. That would allow the operation to be aborted while it
+           is in progress.*/
+        bool isStopSignalled() { return _stopSignalled || _cancellationToken.isCancelled(); }
+
+        /** Returns the cancellation token that was passed to the constructor
+           (or a token that is never cancelled).*/
+        const CancellationToken &getCancellationToken() const { return _cancellationToken; }
 
       private:
+        typedef OneShotStateNotifier<P<IAsyncOp<ResultType>>> DoneNotifier_;
+
+        enum
+        {
+            statePending,
+            /** doOp is executing, or signalStop is setting the abort result.*/
+            stateRunning,
+            stateDone
+        };
+
         void setDone()
         {
-            {
-                Mutex::Lock lock(_mutex);
-                _done = true;
-            }
+            _state = stateDone;
 
-            _doneNotifier->postNotification(this);
+            postDoneNotification();
         }
 
-        class DummySubscription : public Base, BDN_IMPLEMENTS INotifierSubscription
+        /** Posts the done notification if the notifier exists. setDone and
+           onDone can both end up here for the same operation, so only the
+           first call has an effect.*/
+        void postDoneNotification()
         {
-          public:
-        };
+            DoneNotifier_ *notifier = _doneNotifier.load();
+            if (notifier != nullptr && !_notificationPosted.exchange(true))
+                notifier->postNotification(this);
+        }
+
+        std::atomic<int> _state{statePending};
+        std::atomic<bool> _stopSignalled{false};
+        std::atomic<bool> _resultTaken{false};
+        std::atomic<bool> _notificationPosted{false};
+        mutable std::atomic<DoneNotifier_ *> _doneNotifier{nullptr};
 
-        mutable Mutex _mutex;
-        bool _stopSignalled = false;
-        bool _abortedBeforeStart = false;
-        bool _started = false;
-        bool _done = false;
-        P<OneShotStateNotifier<P<IAsyncOp<ResultType>>>> _doneNotifier;
+        CancellationToken _cancellationToken;
+        P<INotifierSubscription> _cancelSubscription;
 
         std::exception_ptr _error;
-        ResultType *_result = nullptr;
+        AsyncOpResultStorage_<ResultType> _result;
     };
 }
 
@@ -8,6 +8,12 @@ namespace bdn
 {
 
     /** Implements asynchronous reading from a std::basic_istream.
+
+        The read operations are executed one by one by a thread of the reader's
+       own. Unlike AsyncStdioWriter it does not use a SerialExecutor on the
+       shared thread pool: a pending read blocks its thread until data becomes
+       available (which may never happen), and that would take a thread away
+       from all other users of the shared pool.
      */
     template <typename CharType> class AsyncStdioReader : public Base
     {
@@ -35,7 +41,9 @@ namespace bdn
 
                 // we need a thread with a queue that we can have execute our
                 // read jobs one by one. We can use a thread pool with a single
-                // thread for that.
+                // thread for that. Note that this must be a thread of our own
+                // (not the shared pool), since a pending read blocks it until
+                // data becomes available.
                 if (_opExecutor == nullptr)
                     _opExecutor = newObj<ThreadPool>(1, 1);
 
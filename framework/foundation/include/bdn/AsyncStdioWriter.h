@@ -2,12 +2,15 @@
 #define BDN_AsyncStdioWriter_H_
 
 #include <bdn/AsyncOpRunnable.h>
-#include <bdn/ThreadPool.h>
+#include <bdn/SerialExecutor.h>
 
 namespace bdn
 {
 
     /** Implements asynchronous writing to a std::basic_ostream.
+
+        The write operations are executed one by one by a SerialExecutor on the
+       shared thread pool (see getSharedThreadPool()).
      */
     template <typename CharType> class AsyncStdioWriter : public Base
     {
@@ -33,11 +36,10 @@ namespace bdn
             {
                 Mutex::Lock lock(_mutex);
 
-                // we need a thread with a queue that we can have execute our
-                // jobs one by one. We can use a thread pool with a single
-                // thread for that.
+                // our jobs must be executed one by one, in order. A serial
+                // executor does that without needing a thread of its own.
                 if (_opExecutor == nullptr)
-                    _opExecutor = newObj<ThreadPool>(1, 1);
+                    _opExecutor = newObj<SerialExecutor>();
 
                 _opExecutor->addJob(op);
             }
@@ -81,11 +83,10 @@ namespace bdn
             {
                 Mutex::Lock lock(_mutex);
 
-                // we need a thread with a queue that we can have execute our
-                // jobs one by one. We can use a thread pool with a single
-                // thread for that.
+                // our jobs must be executed one by one, in order. A serial
+                // executor does that without needing a thread of its own.
                 if (_opExecutor == nullptr)
-                    _opExecutor = newObj<ThreadPool>(1, 1);
+                    _opExecutor = newObj<SerialExecutor>();
 
                 _opExecutor->addJob(op);
             }
@@ -123,7 +124,7 @@ namespace bdn
         std::basic_ostream<CharType> *_stream;
 
 #if BDN_HAVE_THREADS
-        P<ThreadPool> _opExecutor;
+        P<SerialExecutor> _opExecutor;
 #endif
     };
 }
@@ -0,0 +1,75 @@
+#ifndef BDN_CancellationSource_H_
+#define BDN_CancellationSource_H_
+
+#include <bdn/CancellationToken.h>
+
+namespace bdn
+{
+
+    /** Signals cancellation to a group of operations.
+
+        Operations receive a CancellationToken from the source (see getToken())
+       and are cancelled together when cancel() is called. That is useful for
+       work that becomes obsolete, for example a search that was superseded by
+       a new search, or a layout request for a view that changed again.
+
+        Example:
+
+        \code
+
+        P<CancellationSource> searchCancel = newObj<CancellationSource>();
+
+        pool->addJob(newObj<SearchJob>(query), searchCancel->getToken());
+
+        // later, when the user changes the query:
+        searchCancel->cancel();
+
+        \endcode
+
+        Cancelling is thread-safe and can only happen once. A new
+       CancellationSource has to be created for the next group of operations.
+    */
+    class CancellationSource : public Base
+    {
+      public:
+        CancellationSource() : _state(newObj<CancellationToken::State_>()) {}
+
+        /** Returns a token that is cancelled when cancel() is called.*/
+        CancellationToken getToken() const { return CancellationToken(_state); }
+
+        /** Cancels all tokens of the source. The functions registered with
+           CancellationToken::onCancel() are called synchronously, from the
+           calling thread.
+
+            Calling cancel() multiple times has no additional effect.*/
+        void cancel()
+        {
+            P<ThreadSafeNotifier<>> notifier;
+
+            {
+                Mutex::Lock lock(_state->mutex);
+
+                if (_state->cancelled)
+                    return;
+
+                _state->cancelled = true;
+
+                // the registered functions are only called once, so we can
+                // drop the notifier afterwards.
+                notifier = _state->notifier;
+                _state->notifier = nullptr;
+            }
+
+            if (notifier != nullptr)
+                notifier->notify();
+        }
+
+        /** Returns true if cancel() has been called.*/
+        bool isCancelled() const { return _state->cancelled; }
+
+      private:
+        P<CancellationToken::State_> _state;
+    };
+}
+
+#endif
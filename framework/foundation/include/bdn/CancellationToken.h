@@ -0,0 +1,120 @@
+#ifndef BDN_CancellationToken_H_
+#define BDN_CancellationToken_H_
+
+#include <bdn/CancelledError.h>
+#include <bdn/ThreadSafeNotifier.h>
+
+#include <atomic>
+
+namespace bdn
+{
+
+    class CancellationSource;
+
+    /** Lets an operation find out whether it has been cancelled.
+
+        CancellationToken objects are obtained from a CancellationSource (see
+       CancellationSource::getToken()). When the source is cancelled then all
+       its tokens report that.
+
+        Tokens are small value objects that can be copied freely and passed to
+       other threads. A default-constructed token can never be cancelled.
+
+        Code that does work for a token can either check isCancelled() /
+       throwIfCancelled() at convenient points (cooperative cancellation) or
+       register a function with onCancel() that is called when the token is
+       cancelled.
+
+        Tokens are accepted by IDispatcher::enqueueCancellable(),
+       ThreadPool::addJob() and AsyncOpRunnable.
+    */
+    class CancellationToken
+    {
+      public:
+        /** Creates a token that can never be cancelled.*/
+        CancellationToken() {}
+
+        /** Returns true if the token's source has been cancelled.*/
+        bool isCancelled() const { return _state != nullptr && _state->cancelled; }
+
+        /** Returns false if the token can never be cancelled (i.e. if it was
+         * default-constructed).*/
+        bool canBeCancelled() const { return _state != nullptr; }
+
+        /** Throws a CancelledError if the token's source has been
+         * cancelled.*/
+        void throwIfCancelled() const
+        {
+            if (isCancelled())
+                throw CancelledError();
+        }
+
+        /** Registers a function that is called when the token is cancelled.
+
+            The function is called synchronously by the thread that calls
+           CancellationSource::cancel(). If the token is already cancelled then
+           the function is called immediately, before onCancel returns.
+
+            Returns a subscription object that can be passed to
+           removeOnCancel(). Returns null if the token can never be cancelled
+           or if the function was already called.*/
+        P<INotifierSubscription> onCancel(const std::function<void()> &func) const
+        {
+            if (_state == nullptr)
+                return nullptr;
+
+            {
+                Mutex::Lock lock(_state->mutex);
+
+                if (!_state->cancelled) {
+                    if (_state->notifier == nullptr)
+                        _state->notifier = newObj<ThreadSafeNotifier<>>();
+
+                    return _state->notifier->subscribe(func);
+                }
+            }
+
+            func();
+
+            return nullptr;
+        }
+
+        /** Removes a function that was registered with onCancel(). Does
+           nothing if subscription is null.
+
+            Note that the function can still be called after removeOnCancel()
+           has returned, if cancel() is called concurrently from another
+           thread.*/
+        void removeOnCancel(INotifierSubscription *subscription) const
+        {
+            if (_state == nullptr || subscription == nullptr)
+                return;
+
+            P<ThreadSafeNotifier<>> notifier;
+            {
+                Mutex::Lock lock(_state->mutex);
+                notifier = _state->notifier;
+            }
+
+            if (notifier != nullptr)
+                notifier->unsubscribe(subscription);
+        }
+
+      private:
+        friend class CancellationSource;
+
+        struct State_ : public Base
+        {
+            std::atomic<bool> cancelled{false};
+
+            Mutex mutex;
+            P<ThreadSafeNotifier<>> notifier;
+        };
+
+        CancellationToken(State_ *state) : _state(state) {}
+
+        P<State_> _state;
+    };
+}
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef BDN_CancelledError_H_
+#define BDN_CancelledError_H_
+
+#include <bdn/AbortedError.h>
+
+namespace bdn
+{
+
+    /** Thrown when an operation was aborted because its CancellationToken was
+       cancelled (see CancellationSource).
+
+        CancelledError is derived from AbortedError, so code that handles
+       aborted operations also handles cancelled ones.*/
+    class CancelledError : public AbortedError
+    {
+      public:
+        CancelledError(const String &message) : AbortedError(message) {}
+
+        CancelledError() : AbortedError("Operation was cancelled") {}
+    };
+}
+
+#endif
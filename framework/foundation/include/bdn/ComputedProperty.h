@@ -0,0 +1,425 @@
+#ifndef BDN_ComputedProperty_H_
+#define BDN_ComputedProperty_H_
+
+#include <bdn/IPropertyReadAccessor.h>
+#include <bdn/PlainPropertyReadAccessor.h>
+#include <bdn/PropertyNotifier.h>
+#include <bdn/PropertyUpdateBatch.h>
+#include <bdn/IDispatcher.h>
+#include <bdn/DanglingFunctionError.h>
+#include <bdn/ProgrammingError.h>
+#include <bdn/WeakP.h>
+#include <bdn/cast.h>
+
+#include <map>
+#include <vector>
+
+namespace bdn
+{
+
+    /** Internal base class of ComputedProperty. Do not use directly.
+
+        Manages the subscriptions to the "changed" notifiers of the properties
+        that the last evaluation of the computed property has read. Also keeps
+        track of the computed properties that depend on this one, so that they
+        can be marked dirty before anything is recomputed.
+    */
+    class ComputedPropertyBase_ : public Base
+    {
+      private:
+        struct Dependency_
+        {
+            P<IBase> notifier;
+            std::function<void()> unsubscribe;
+        };
+        using DependencyMap_ = std::map<const IBase *, Dependency_>;
+
+        /** Subscribed to the changed notifiers of dependencies. Only holds a
+            weak reference to the computed property, so that dependencies do
+           not keep it alive.*/
+        template <typename VALUE_TYPE> class DependencySubscriber_
+        {
+          public:
+            typedef void WeakCallableTag_;
+
+            DependencySubscriber_(ComputedPropertyBase_ *target) : _targetWeak(target) {}
+
+            void operator()(const VALUE_TYPE &) const
+            {
+                P<ComputedPropertyBase_> target = _targetWeak.toStrong();
+                if (target == nullptr) {
+                    // let the notifier remove us
+                    if (!DanglingCallScope_::markDanglingIfTarget<void(const VALUE_TYPE &)>(this))
+                        throw DanglingFunctionError();
+                } else
+                    target->dependencyChanged();
+            }
+
+          private:
+            WeakP<ComputedPropertyBase_> _targetWeak;
+        };
+
+        static void releaseDependencies(DependencyMap_ &dependencies)
+        {
+            for (auto &entry : dependencies)
+                entry.second.unsubscribe();
+            dependencies.clear();
+        }
+
+      public:
+        /** Records the properties that the compute function of a
+            ComputedProperty reads.
+
+            The compute function gets a DependencyTracker object as its
+           parameter. It must read the properties it depends on through the
+           tracker (see get() and \ref BDN_TRACK_PROPERTY). Dependencies that
+           the function does not read in an evaluation are automatically
+           dropped, so conditional dependencies are handled correctly.
+        */
+        class DependencyTracker
+        {
+          public:
+            DependencyTracker(ComputedPropertyBase_ *owner) : _owner(owner)
+            {
+                _oldDependencies.swap(owner->_dependencies);
+            }
+
+            ~DependencyTracker()
+            {
+                if (!_committed) {
+                    // the evaluation failed. Keep listening to everything we
+                    // know about, so that the next change triggers a new
+                    // attempt.
+                    for (auto &entry : _newDependencies)
+                        _oldDependencies.insert(std::move(entry));
+                    _owner->_dependencies.swap(_oldDependencies);
+                }
+            }
+
+            DependencyTracker(const DependencyTracker &) = delete;
+            DependencyTracker &operator=(const DependencyTracker &) = delete;
+
+            /** Returns the current value of the property that the accessor
+             * refers to and records it as a dependency.*/
+            template <typename VALUE_TYPE> VALUE_TYPE get(const IPropertyReadAccessor<VALUE_TYPE> &accessor)
+            {
+                trackDependency(accessor.changed(), &accessor);
+                return accessor.get();
+            }
+
+            /** Records the specified notifier as a dependency. When it fires,
+             * the computed property is marked dirty.*/
+            template <typename VALUE_TYPE> void track(IPropertyNotifier<VALUE_TYPE> &notifier)
+            {
+                trackDependency(notifier, nullptr);
+            }
+
+            /** Called after a successful evaluation. Unsubscribes from the
+             * properties that were not read anymore.*/
+            void commit()
+            {
+                releaseDependencies(_oldDependencies);
+                _owner->_dependencies.swap(_newDependencies);
+                _committed = true;
+            }
+
+          private:
+            template <typename VALUE_TYPE>
+            void trackDependency(IPropertyNotifier<VALUE_TYPE> &notifier,
+                                 const IPropertyReadAccessor<VALUE_TYPE> *accessor)
+            {
+                const IBase *key = &notifier;
+
+                if (_newDependencies.find(key) != _newDependencies.end())
+                    return;
+
+                auto oldIt = _oldDependencies.find(key);
+                if (oldIt != _oldDependencies.end()) {
+                    // we are already subscribed from a previous evaluation
+                    _newDependencies.insert(std::move(*oldIt));
+                    _oldDependencies.erase(oldIt);
+                    return;
+                }
+
+                // we keep a reference to the notifier. That ensures that we
+                // can always unsubscribe, even if the property owner is gone.
+                P<IPropertyNotifier<VALUE_TYPE>> notifierRef(&notifier);
+                P<INotifierSubscription> sub = notifier.subscribe(DependencySubscriber_<VALUE_TYPE>(_owner));
+
+                // if the dependency is itself a computed property then we
+                // register with it, so that it can mark us dirty as soon as it
+                // becomes dirty.
+                ComputedPropertyBase_ *computed = nullptr;
+                if (accessor != nullptr)
+                    computed = const_cast<ComputedPropertyBase_ *>(tryCast<ComputedPropertyBase_>(accessor));
+                WeakP<ComputedPropertyBase_> computedWeak(computed);
+                ComputedPropertyBase_ *owner = _owner;
+
+                if (computed != nullptr)
+                    computed->_dependents[owner] = WeakP<ComputedPropertyBase_>(owner);
+
+                Dependency_ &dep = _newDependencies[key];
+                dep.notifier = notifierRef;
+                dep.unsubscribe = [notifierRef, sub, computedWeak, owner]() {
+                    notifierRef->unsubscribe(sub);
+
+                    P<ComputedPropertyBase_> computed = computedWeak.toStrong();
+                    if (computed != nullptr)
+                        computed->_dependents.erase(owner);
+                };
+            }
+
+            ComputedPropertyBase_ *_owner;
+            bool _committed = false;
+            DependencyMap_ _oldDependencies;
+            DependencyMap_ _newDependencies;
+        };
+        friend class DependencyTracker;
+
+      protected:
+        ~ComputedPropertyBase_() { releaseDependencies(_dependencies); }
+
+        /** Marks the property as dirty and schedules an update if needed.
+           Implementations must call invalidateDependents() when the property
+           was not dirty before.*/
+        virtual void invalidate() = 0;
+
+        /** Marks all computed properties that depend on this one as dirty.*/
+        void invalidateDependents()
+        {
+            // invalidate() does not change the dependency graph, but the
+            // dependents can be deleted when we release our references. So we
+            // collect them first.
+            std::vector<P<ComputedPropertyBase_>> dependents;
+            for (auto &entry : _dependents) {
+                P<ComputedPropertyBase_> dependent = entry.second.toStrong();
+                if (dependent != nullptr)
+                    dependents.push_back(dependent);
+            }
+
+            for (auto &dependent : dependents)
+                dependent->invalidate();
+        }
+
+      private:
+        /** Called when one of the properties that the last evaluation has read
+         * changes.*/
+        void dependencyChanged()
+        {
+            // if the change comes from a property notifier then we are inside
+            // its batch and the updates run when all of its subscribers have
+            // marked themselves dirty. Otherwise this batch runs them.
+            PropertyUpdateBatch_ batch;
+
+            invalidate();
+
+            batch.end();
+        }
+
+        mutable DependencyMap_ _dependencies;
+        std::map<const ComputedPropertyBase_ *, WeakP<ComputedPropertyBase_>> _dependents;
+    };
+
+    /** A read-only property whose value is computed from other properties.
+
+        The compute function gets a \ref ComputedPropertyBase_::DependencyTracker
+        "DependencyTracker" and reads the properties it depends on through it.
+        ComputedProperty records these reads and subscribes to the "changed"
+        notifiers of the properties. The set of dependencies is recorded anew on
+        each evaluation.
+
+        The value is computed lazily: when a dependency changes, the computed
+       property is only marked dirty. The compute function is called again on
+       the next read. As long as nobody has accessed the changed() notifier,
+       nothing else happens.
+
+        Once changed() has been accessed, the property has to find out whether
+       its value actually changed, so it is recomputed after a dependency
+       change. If an update dispatcher was passed to the constructor, then this
+       happens in a work item on that dispatcher - i.e. at most once per
+       dispatcher turn, no matter how many dependencies change in between. If
+       no dispatcher was passed then it happens synchronously, as soon as the
+       change has been propagated completely. In both cases the changed
+       notifier only fires when the new value differs from the old one.
+
+        Updates happen in two phases. When a property changes, all computed
+       properties that depend on it (directly or through other computed
+       properties) are marked dirty first. Only then are they recomputed. So a
+       computed property never sees a mix of old and new values, and with
+       "diamond" dependencies (B and C depend on A, D depends on B and C) D
+       is only notified once per change of A.
+
+        ComputedProperty implements IPropertyReadAccessor, so it can be used as
+       a dependency of other computed properties and as the source of a
+       property binding.
+
+        Like all properties, ComputedProperty does not support multi-threaded
+       access. ComputedProperty objects must be allocated with newObj.
+
+        Example:
+
+        \code
+
+        P<ComputedProperty<String>> fullName = newObj<ComputedProperty<String>>(
+            [person](ComputedProperty<String>::DependencyTracker &tracker)
+            {
+                return BDN_TRACK_PROPERTY(tracker, *person, firstName) + " "
+                    + BDN_TRACK_PROPERTY(tracker, *person, lastName);
+            },
+            getMainDispatcher() );
+
+        fullName->changed() += [](const String& newName) { ... };
+
+        \endcode
+    */
+    template <typename VALUE_TYPE>
+    class ComputedProperty : public ComputedPropertyBase_, BDN_IMPLEMENTS IPropertyReadAccessor<VALUE_TYPE>
+    {
+      public:
+        using ComputeFunc = std::function<VALUE_TYPE(DependencyTracker &)>;
+
+        /** \param computeFunc the function that computes the property value.
+            \param updateDispatcher optional dispatcher on which change
+           notifications are computed. If this is null then the value is
+           recomputed synchronously whenever a dependency changes (provided
+           that someone has accessed changed()).*/
+        ComputedProperty(const ComputeFunc &computeFunc, IDispatcher *updateDispatcher = nullptr)
+            : _computeFunc(computeFunc), _updateDispatcher(updateDispatcher)
+        {}
+
+        VALUE_TYPE get() const override
+        {
+            if (_dirty)
+                evaluate();
+
+            return _value;
+        }
+
+        IPropertyNotifier<VALUE_TYPE> &changed() const override
+        {
+            if (_changed == nullptr) {
+                _changed = newObj<PropertyNotifier<VALUE_TYPE>>();
+
+                // we need to know the dependencies to be able to detect
+                // changes.
+                if (_dirty)
+                    evaluate();
+            }
+
+            return *_changed;
+        }
+
+        /** Returns true if a dependency has changed and the value has not yet
+         * been recomputed.*/
+        bool isDirty() const { return _dirty; }
+
+        /** Recomputes the value if it is dirty and fires the changed notifier
+           if the value has changed since the last notification.
+
+            This is called automatically. It only needs to be called explicitly
+           to flush a pending update before the dispatcher gets to it.*/
+        void update()
+        {
+            if (_dirty)
+                evaluate();
+
+            if (_changePending) {
+                _changePending = false;
+                _changed->notify(*this);
+            }
+        }
+
+      protected:
+        void invalidate() override
+        {
+            bool wasDirty = _dirty;
+            _dirty = true;
+
+            if (_changed != nullptr) {
+                if (_updateDispatcher == nullptr) {
+                    // runs when the current change has been propagated
+                    // completely (see PropertyUpdateBatch_).
+                    WeakP<ComputedProperty> propertyWeak(this);
+                    PropertyUpdateBatch_::addPendingUpdate([propertyWeak]() {
+                        P<ComputedProperty> property = propertyWeak.toStrong();
+                        if (property != nullptr)
+                            property->update();
+                    });
+                } else if (!_updateScheduled) {
+                    _updateScheduled = true;
+                    _updateDispatcher->enqueue(weakMethod(this, &ComputedProperty::scheduledUpdate));
+                }
+            }
+
+            // if we were dirty already then our dependents have already been
+            // marked as well.
+            if (!wasDirty)
+                invalidateDependents();
+        }
+
+      private:
+        void scheduledUpdate()
+        {
+            _updateScheduled = false;
+            update();
+        }
+
+        void evaluate() const
+        {
+            if (_evaluating)
+                throw ProgrammingError("ComputedProperty depends on itself.");
+
+            _evaluating = true;
+
+            try {
+                DependencyTracker tracker(const_cast<ComputedProperty *>(this));
+
+                VALUE_TYPE newValue = _computeFunc(tracker);
+
+                tracker.commit();
+
+                _dirty = false;
+
+                if (!_hasValue || newValue != _value) {
+                    // the first value is not a change - nobody could have seen
+                    // the value before.
+                    if (_hasValue && _changed != nullptr)
+                        _changePending = true;
+
+                    _value = std::move(newValue);
+                    _hasValue = true;
+                }
+            }
+            catch (...) {
+                _evaluating = false;
+                throw;
+            }
+
+            _evaluating = false;
+        }
+
+        ComputeFunc _computeFunc;
+        P<IDispatcher> _updateDispatcher;
+
+        mutable VALUE_TYPE _value{};
+        mutable bool _hasValue = false;
+        mutable bool _dirty = true;
+        mutable bool _changePending = false;
+        mutable bool _evaluating = false;
+        bool _updateScheduled = false;
+
+        mutable P<PropertyNotifier<VALUE_TYPE>> _changed;
+    };
+
+/** Reads a property inside the compute function of a bdn::ComputedProperty
+   and records it as a dependency.
+
+    \param tracker the DependencyTracker object that was passed to the compute
+   function \param owner the owner of the property (a reference or object, not
+   a pointer) \param propertyName the name of the property
+*/
+#define BDN_TRACK_PROPERTY(tracker, owner, propertyName)                                                               \
+    (tracker).get(BDN_PROPERTY_READ_ACCESSOR(owner, propertyName))
+}
+
+#endif
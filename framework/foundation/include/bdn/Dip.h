@@ -2,6 +2,7 @@
 #define BDN_Dip_H_
 
 #include <map>
+#include <type_traits>
 
 #include <bdn/round.h>
 
@@ -48,13 +49,15 @@ namespace bdn
 
         Also see \ref BDN_AGGRESSIVE_FLOAT_OPTIMIZATIONS
 
+        Dip is a plain value type with the same size as a double. It is
+       trivially copyable, so it can be passed around and stored in arrays
+       without any overhead compared to a plain double.
+
     */
-    class Dip : public Base
+    class Dip
     {
       public:
-        Dip(double val = 0) : _value(val) {}
-
-        Dip(const Dip &d) : _value(d._value) {}
+        constexpr Dip(double val = 0) : _value(val) {}
 
         /** Aligns the aligns of the Dip object to a physical pixel boundary.
             See pixelAlign(double, double, RoundType) for more information.*/
@@ -234,11 +237,15 @@ namespace bdn
             return (equal(a.x, b.x) && equal(a.y, b.y) && equal(a.width, b.width) && equal(a.height, b.height));
         }
 
-        double getValue() const { return _value; }
+        constexpr double getValue() const { return _value; }
 
-        void operator=(double v) { _value = v; }
+        Dip &operator=(double v)
+        {
+            _value = v;
+            return *this;
+        }
 
-        operator double() const { return _value; }
+        constexpr operator double() const { return _value; }
 
         bool operator==(const Dip &o) const { return compare(_value, o._value) == 0; }
 
@@ -318,6 +325,9 @@ namespace bdn
       private:
         double _value;
     };
+
+    static_assert(sizeof(Dip) == sizeof(double), "Dip must have the same size as a double");
+    static_assert(std::is_trivially_copyable<Dip>::value, "Dip must be trivially copyable");
 }
 
 inline bool operator==(double a, const bdn::Dip &b) { return b == a; }
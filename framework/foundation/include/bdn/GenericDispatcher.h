@@ -9,7 +9,9 @@
 #include <bdn/List.h>
 
 #include <chrono>
+#include <deque>
 #include <functional>
+#include <map>
 
 namespace bdn
 {
@@ -20,6 +22,19 @@ namespace bdn
         This can also be used if an independent dispatcher is needed in a
        secondary work thread.
 
+        GenericDispatcher supports all priority levels (see
+       IDispatcher::Priority). By default, items with a lower priority are only
+       executed when no items with a higher priority are ready.
+
+        Items can also be added with a deadline (see enqueueWithDeadline()).
+       Among the items of the same priority, items with a deadline are ordered
+       by their deadline. Items whose deadline has passed are executed before
+       all other items, regardless of their priority.
+
+        Optionally, waiting items can age (see setAgingIntervalSeconds()): for
+       each aging interval that an item waits, its effective priority increases
+       by one level. That ensures that low priority items are eventually
+       executed, even if the dispatcher never runs out of higher priority work.
         */
     class GenericDispatcher : public Base, BDN_IMPLEMENTS IDispatcher
     {
@@ -33,20 +48,30 @@ namespace bdn
             Mutex::Lock lock(_mutex);
 
             for (int priorityQueueIndex = 0; priorityQueueIndex < priorityCount; priorityQueueIndex++) {
-                List<std::function<void()>> &queue = _queues[priorityQueueIndex];
+                PriorityQueue_ &queue = _queues[priorityQueueIndex];
 
                 // remove the objects one by one so that we can ignore
                 // exceptions that happen in the destructor.
-                while (!queue.empty()) {
+                while (!queue.fifoItems.empty()) {
                     BDN_LOG_AND_IGNORE_EXCEPTION(
                         { // make a copy so that pop_front is not aborted if the
                           // destructor fails.
-                            std::function<void()> item = queue.front();
-                            queue.pop_front();
+                            std::function<void()> item = queue.fifoItems.front().func;
+                            queue.fifoItems.pop_front();
                         },
                         "Error clearing GenericDispatcher item during dispose. "
                         "Ignoring.");
                 }
+
+                while (!queue.deadlineItems.empty()) {
+                    BDN_LOG_AND_IGNORE_EXCEPTION(
+                        {
+                            std::function<void()> item = queue.deadlineItems.begin()->second.func;
+                            queue.deadlineItems.erase(queue.deadlineItems.begin());
+                        },
+                        "Error clearing GenericDispatcher deadline item during dispose. "
+                        "Ignoring.");
+                }
             }
 
             // also remove timed items
@@ -67,11 +92,61 @@ namespace bdn
         {
             Mutex::Lock lock(_mutex);
 
-            getQueue(priority).push_back(func);
+            getQueue(priority).fifoItems.push_back(QueuedItem_{std::move(func), Clock::now()});
 
             _somethingChangedSignal.set();
         }
 
+        /** Schedules the specified function to be executed with the
+           specified priority and a deadline.
+
+            The deadline is a hint: among the items with the same priority,
+           items with a deadline are executed in the order of their deadlines.
+           When the deadline has passed and the item has not been executed yet
+           then it is executed before all other items, regardless of their
+           priority.
+
+            Note that unlike enqueueInSeconds, the item can be executed right
+           away - the deadline is the latest time the item should be executed,
+           not the earliest.
+
+            enqueueWithDeadline() can be called from any thread.*/
+        void enqueueWithDeadline(double deadlineSeconds, std::function<void()> func,
+                                 Priority priority = Priority::normal)
+        {
+            Mutex::Lock lock(_mutex);
+
+            TimePoint now = Clock::now();
+
+            getQueue(priority).deadlineItems.emplace(now + secondsToDuration(deadlineSeconds),
+                                                     QueuedItem_{std::move(func), now});
+
+            _somethingChangedSignal.set();
+        }
+
+        /** Sets the aging interval. For each aging interval that an item waits,
+           its effective priority increases by one level (urgent, high, normal,
+           low and idle are consecutive levels). So an idle item that waited
+           for four intervals is treated like a new urgent item.
+
+            If seconds is 0 or negative then aging is disabled. That is the
+           default.*/
+        void setAgingIntervalSeconds(double seconds)
+        {
+            Mutex::Lock lock(_mutex);
+
+            _agingInterval = (seconds > 0) ? secondsToDuration(seconds) : Duration::zero();
+        }
+
+        /** Returns the aging interval, or 0 if aging is disabled (see
+         * setAgingIntervalSeconds()).*/
+        double getAgingIntervalSeconds() const
+        {
+            Mutex::Lock lock(_mutex);
+
+            return durationToSeconds(_agingInterval);
+        }
+
         void enqueueInSeconds(double seconds, std::function<void()> func, Priority priority = Priority::normal) override
         {
             if (seconds <= 0)
@@ -175,19 +250,19 @@ namespace bdn
         typedef Clock::time_point TimePoint;
         typedef Clock::duration Duration;
 
-        Duration secondsToDuration(double seconds)
+        static Duration secondsToDuration(double seconds)
         {
             return Duration((Duration::rep)(seconds * Duration::period::den / Duration::period::num));
         }
 
-        double durationToSeconds(const Duration &dur)
+        static double durationToSeconds(const Duration &dur)
         {
             return ((double)dur.count()) * Duration::period::num / Duration::period::den;
         }
 
         enum
         {
-            priorityCount = 2
+            priorityCount = 5
         };
 
         int priorityToQueueIndex(Priority priority) const
@@ -195,14 +270,36 @@ namespace bdn
             switch (priority) {
             case Priority::idle:
                 return 0;
-            case Priority::normal:
+            case Priority::low:
                 return 1;
+            case Priority::normal:
+                return 2;
+            case Priority::high:
+                return 3;
+            case Priority::urgent:
+                return 4;
             }
 
             throw InvalidArgumentError("Invalid dispatcher item priority: " + std::to_string((int)priority));
         }
 
-        List<std::function<void()>> &getQueue(Priority priority) { return _queues[priorityToQueueIndex(priority)]; }
+        struct QueuedItem_
+        {
+            std::function<void()> func;
+            TimePoint enqueueTime;
+        };
+
+        /** The items of one priority level. Items with a deadline are kept
+         * separately, ordered by their deadline.*/
+        struct PriorityQueue_
+        {
+            std::deque<QueuedItem_> fifoItems;
+            std::multimap<TimePoint, QueuedItem_> deadlineItems;
+
+            bool empty() const { return fifoItems.empty() && deadlineItems.empty(); }
+        };
+
+        PriorityQueue_ &getQueue(Priority priority) { return _queues[priorityToQueueIndex(priority)]; }
 
         void addTimedItem(TimePoint scheduledTime, std::function<void()> func, Priority priority)
         {
@@ -288,7 +385,12 @@ namespace bdn
                 bool continueTimer = true;
                 try {
                     try {
+                        DanglingCallScope_ danglingScope(_func);
+
                         continueTimer = _func();
+
+                        // a dangling weak method returns false, so the timer
+                        // is also stopped in that case.
                     }
                     catch (DanglingFunctionError &) {
                         // DanglingFunctionError exceptions are ignored. They
@@ -354,9 +456,10 @@ namespace bdn
             Priority priority = Priority::normal;
         };
 
-        Mutex _mutex;
+        mutable Mutex _mutex;
 
-        List<std::function<void()>> _queues[priorityCount];
+        PriorityQueue_ _queues[priorityCount];
+        Duration _agingInterval = Duration::zero();
 
         std::map<TimedItemKey, TimedItem> _timedItemMap;
         int64_t _timedItemCounter = 0;
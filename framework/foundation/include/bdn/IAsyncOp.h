@@ -22,6 +22,16 @@ namespace bdn
             */
         virtual ResultType getResult() const = 0;
 
+        /** Like getResult(), except that the result is moved out of the
+           operation object instead of being copied. That avoids a copy for
+           results that are expensive to copy.
+
+            takeResult() can only be called once. getResult() must not be
+           called afterwards.
+
+            */
+        virtual ResultType takeResult() = 0;
+
         /** Signals that the operation should be aborted, if that is possible.6
             signalStop() returns immediately - it does not wait for the
            operation to finish.
@@ -6,6 +6,8 @@
 #pragma warning(disable : 4250)
 #endif
 
+#include <bdn/InterfaceId.h>
+
 namespace bdn
 {
 
@@ -36,6 +38,16 @@ namespace bdn
             releaseRef implementations MUST be thread-safe.
             */
         virtual void releaseRef() const = 0;
+
+        /** Returns a pointer to the interface with the specified ID and fully
+           qualified name, if the object's class lists it in its interface
+           table (see \ref BDN_INTERFACE_TABLE). Otherwise nullptr is returned.
+
+            Note that nullptr does not mean that the object does not implement
+           the interface - the interface table does not have to be complete.
+           Use tryCast() to query interfaces. It uses this as a fast path and
+           falls back to dynamic_cast.*/
+        virtual void *queryInterface(InterfaceId, const char *) { return nullptr; }
     };
 }
 
@@ -6,6 +6,8 @@
 namespace bdn
 {
 
+    class CancellationToken;
+
     /** Interface for dispatchers. Dispatchers handle scheduling of small tasks
         with different priorities.
 
@@ -42,17 +44,30 @@ namespace bdn
     class IDispatcher : BDN_IMPLEMENTS IBase
     {
       public:
+        /** The priority of a dispatcher item.
+
+            urgent is intended for things that the user is waiting for right
+           now (for example, handling input). idle items are only executed when
+           the dispatcher has nothing else to do.
+
+            Dispatchers that do not have separate queues for all levels (for
+           example, some platform main dispatchers) treat low, high and urgent
+           like normal. GenericDispatcher supports all levels.*/
         enum class Priority
         {
             idle = -100,
+            low = -50,
             normal = 0,
+            high = 100,
+            urgent = 200,
         };
 
         /** Schedules the specified function to be executed
             with the specified priority.
 
             Lower priority items are only executed when there are no higher
-           priority items available to be executed.
+           priority items available to be executed (see the
+           GenericDispatcher documentation for exceptions to this rule).
 
             enqueue() can be called from any thread.
 
@@ -110,6 +125,23 @@ namespace bdn
 
             */
         virtual void createTimer(double intervalSeconds, std::function<bool()> func) = 0;
+
+        /** Like enqueue(), except that the function is not executed if the
+           specified token is cancelled before the item is executed.
+
+            If the token is already cancelled then nothing is enqueued.
+           Otherwise func is released as soon as the token is cancelled, so
+           that its captured objects are not kept alive. The (now empty) item
+           stays in the queue until it is reached and then does nothing.*/
+        void enqueueCancellable(const CancellationToken &token, std::function<void()> func,
+                                Priority priority = Priority::normal);
+
+        /** Like enqueueInSeconds(), except that the function is not executed
+           if the specified token is cancelled before the time has elapsed.
+
+            See enqueueCancellable().*/
+        void enqueueInSecondsCancellable(const CancellationToken &token, double seconds, std::function<void()> func,
+                                         Priority priority = Priority::normal);
     };
 
     /** Returns the main dispatcher of the app.
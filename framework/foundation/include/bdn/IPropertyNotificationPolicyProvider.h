@@ -0,0 +1,26 @@
+#ifndef BDN_IPropertyNotificationPolicyProvider_H_
+#define BDN_IPropertyNotificationPolicyProvider_H_
+
+#include <bdn/NotificationPolicy.h>
+
+namespace bdn
+{
+
+    /** Interface that property owners can implement to select the
+        notification policy for all of their properties at once (see
+       NotificationPolicy).
+
+        The default property implementations (see \ref BDN_PROPERTY) query the
+       policy when the "changed" notifier of a property is created, i.e. when it
+       is first accessed. The policy of individual properties can still be
+       changed afterwards with IPropertyNotifier::setNotificationPolicy().
+    */
+    class IPropertyNotificationPolicyProvider : BDN_IMPLEMENTS IBase
+    {
+      public:
+        /** Returns the notification policy for the owner's properties.*/
+        virtual NotificationPolicy getPropertyNotificationPolicy() const = 0;
+    };
+}
+
+#endif
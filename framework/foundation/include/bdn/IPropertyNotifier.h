@@ -8,6 +8,7 @@ namespace bdn
 
 #include <bdn/INotifierBase.h>
 #include <bdn/IPropertyReadAccessor.h>
+#include <bdn/NotificationPolicy.h>
 
 namespace bdn
 {
@@ -37,6 +38,19 @@ namespace bdn
            subscribers will get the new, updated value as their parameter.
         */
         virtual void notify(const IPropertyReadAccessor<PROPERTY_VALUE_TYPE> &accessor) = 0;
+
+        /** Sets the policy that controls when notifications are delivered
+            (see NotificationPolicy). The default is
+           NotificationPolicy::immediate().
+
+            With a deferred policy, notify() only records the current value of
+           the property. The subscribers are called later with the latest
+           recorded value. In that case notify() may also be called from
+           other threads than the one that delivers the notifications.*/
+        virtual void setNotificationPolicy(const NotificationPolicy &policy) = 0;
+
+        /** Returns the notification policy (see setNotificationPolicy()).*/
+        virtual NotificationPolicy getNotificationPolicy() const = 0;
     };
 }
 
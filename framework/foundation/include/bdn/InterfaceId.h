@@ -0,0 +1,156 @@
+#ifndef BDN_InterfaceId_H_
+#define BDN_InterfaceId_H_
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace bdn
+{
+
+    /** Identifies an interface for IBase::queryInterface(). See \ref
+     * BDN_INTERFACE_ID.*/
+    using InterfaceId = uint64_t;
+
+    /** Computes an InterfaceId from the fully qualified interface name (64
+       bit FNV-1a hash). Used by \ref BDN_INTERFACE_ID. The ID only depends on
+       the name, so it is the same in all modules and shared libraries.*/
+    constexpr InterfaceId makeInterfaceId_(const char *name)
+    {
+        uint64_t hash = 14695981039346656037ull;
+
+        for (; *name != 0; name++) {
+            hash ^= (uint8_t)*name;
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    /** Returns true if name is qualified with a namespace or class (i.e. if it
+       contains "::"). Used by \ref BDN_INTERFACE_ID.*/
+    constexpr bool isQualifiedInterfaceName_(const char *name)
+    {
+        for (; *name != 0; name++) {
+            if (name[0] == ':' && name[1] == ':')
+                return true;
+        }
+
+        return false;
+    }
+
+    /** Returns true if the two interface names are the same. The IDs of
+       different interfaces can collide (they are hashes), so a matching ID is
+       confirmed with this.*/
+    inline bool interfaceNamesEqual_(const char *a, const char *b) { return a == b || std::strcmp(a, b) == 0; }
+
+    template <class T> struct InterfaceIdVoid_
+    {
+        using Type = void;
+    };
+
+    /** std::true_type if T declares its own ID with \ref BDN_INTERFACE_ID
+        (as opposed to inheriting the ID of a base interface).*/
+    template <class T, class = void> struct HasOwnInterfaceId_ : public std::false_type
+    {};
+
+    template <class T>
+    struct HasOwnInterfaceId_<T, typename InterfaceIdVoid_<typename T::InterfaceIdOwner_>::Type>
+        : public std::is_same<typename T::InterfaceIdOwner_, typename std::remove_cv<T>::type>
+    {};
+
+    /** Implementation of the interface lookup for \ref BDN_INTERFACE_TABLE.*/
+    template <class... INTERFACES> struct InterfaceTable_;
+
+    template <> struct InterfaceTable_<>
+    {
+        template <class CLASS> static void *query(CLASS *, InterfaceId, const char *) { return nullptr; }
+    };
+
+    template <class FIRST, class... REST> struct InterfaceTable_<FIRST, REST...>
+    {
+        template <class CLASS> static void *query(CLASS *object, InterfaceId id, const char *interfaceName)
+        {
+            static_assert(HasOwnInterfaceId_<FIRST>::value,
+                          "Interfaces listed in BDN_INTERFACE_TABLE must declare an ID with BDN_INTERFACE_ID.");
+
+            if (id == FIRST::getInterfaceId_() && interfaceNamesEqual_(interfaceName, FIRST::getInterfaceName_()))
+                return static_cast<FIRST *>(object);
+
+            return InterfaceTable_<REST...>::query(object, id, interfaceName);
+        }
+    };
+}
+
+/** \def BDN_INTERFACE_ID(qualifiedInterfaceName)
+
+    Declares a static ID for an interface. This enables the fast path of
+   bdn::tryCast and bdn::cast for the interface: objects whose class lists the
+   interface in its \ref BDN_INTERFACE_TABLE are cast without dynamic_cast.
+
+    The parameter must be the fully qualified name of the interface (e.g.
+   bdn::IViewCore, or ::IMyInterface for an interface in the global
+   namespace). The ID is a hash of that name. Since two different names can
+   have the same hash, a matching ID is confirmed by comparing the names. If
+   they differ then bdn::tryCast falls back to dynamic_cast.
+
+    The macro must be placed inside the interface declaration. It ends with
+   the public access specifier active.
+
+    Derived interfaces do not inherit the ID - they need their own
+   BDN_INTERFACE_ID declaration to use the fast path.
+
+    Example:
+
+    \code
+    namespace bdn
+    {
+        class IViewCore : BDN_IMPLEMENTS IBase
+        {
+            BDN_INTERFACE_ID(bdn::IViewCore);
+
+          public:
+            ...
+        };
+    }
+    \endcode
+*/
+#define BDN_INTERFACE_ID(qualifiedInterfaceName)                                                                       \
+  public:                                                                                                              \
+    using InterfaceIdOwner_ = qualifiedInterfaceName;                                                                  \
+    static_assert(bdn::isQualifiedInterfaceName_(#qualifiedInterfaceName),                                             \
+                  "BDN_INTERFACE_ID needs the fully qualified interface name (e.g. bdn::IViewCore).");                 \
+    static constexpr const char *getInterfaceName_() { return #qualifiedInterfaceName; }                               \
+    static constexpr bdn::InterfaceId getInterfaceId_() { return bdn::makeInterfaceId_(#qualifiedInterfaceName); }
+
+/** \def BDN_INTERFACE_TABLE(...)
+
+    Declares the interfaces that IBase::queryInterface() returns for objects of
+   the class (a COM-style interface table). The parameters are the interfaces.
+   Each of them must have an ID (see \ref BDN_INTERFACE_ID).
+
+    The table does not need to be complete: bdn::tryCast falls back to
+   dynamic_cast for interfaces that are not listed. A class that declares its
+   own table replaces the table of its base class, so the base class interfaces
+   that should use the fast path must be listed again.
+
+    The macro ends with the public access specifier active.
+
+    Example:
+
+    \code
+    class ButtonCore : public ViewCore, BDN_IMPLEMENTS IButtonCore
+    {
+        BDN_INTERFACE_TABLE(IButtonCore, IViewCore);
+        ...
+    };
+    \endcode
+*/
+#define BDN_INTERFACE_TABLE(...)                                                                                       \
+  public:                                                                                                              \
+    void *queryInterface(bdn::InterfaceId id, const char *interfaceName) override                                      \
+    {                                                                                                                  \
+        return bdn::InterfaceTable_<__VA_ARGS__>::query(this, id, interfaceName);                                      \
+    }
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef BDN_LoopAllocator_H_
+#define BDN_LoopAllocator_H_
+
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace bdn
+{
+
+    /** A small-object allocator that belongs to a single thread (for example
+       one event loop of a ThreadPerCoreRuntime).
+
+        LoopAllocator is NOT thread-safe and does not use any locking. Memory
+       must be allocated and released by the thread that owns the allocator.
+
+        Blocks of up to maxPooledSize bytes are served from per-size free lists
+       that are refilled from larger chunks. Released blocks go back to their
+       free list and are reused. Bigger blocks are passed through to the
+       global operator new. The chunks are only returned to the system when
+       the allocator is destroyed.
+    */
+    class LoopAllocator
+    {
+      public:
+        /** The biggest block size that is served from the free lists.*/
+        static constexpr size_t maxPooledSize = 256;
+
+        LoopAllocator() {}
+
+        LoopAllocator(const LoopAllocator &) = delete;
+        LoopAllocator &operator=(const LoopAllocator &) = delete;
+
+        ~LoopAllocator()
+        {
+            for (void *chunk : _chunks)
+                ::operator delete(chunk);
+        }
+
+        /** Allocates a block of the specified size. The block is aligned for
+           any fundamental type.*/
+        void *allocate(size_t size)
+        {
+            if (size > maxPooledSize)
+                return ::operator new(size);
+
+            FreeBlock_ *&freeList = _freeLists[sizeClassIndex(size)];
+
+            if (freeList == nullptr)
+                refill(sizeClassIndex(size));
+
+            FreeBlock_ *block = freeList;
+            freeList = block->next;
+
+            return block;
+        }
+
+        /** Releases a block that was allocated with allocate(). The size must
+           be the same size that was passed to allocate().*/
+        void deallocate(void *block, size_t size)
+        {
+            if (block == nullptr)
+                return;
+
+            if (size > maxPooledSize) {
+                ::operator delete(block);
+                return;
+            }
+
+            FreeBlock_ *freeBlock = static_cast<FreeBlock_ *>(block);
+            FreeBlock_ *&freeList = _freeLists[sizeClassIndex(size)];
+
+            freeBlock->next = freeList;
+            freeList = freeBlock;
+        }
+
+        /** Allocates memory for an object of type T and constructs it with the
+         * specified arguments.*/
+        template <typename T, typename... Args> T *create(Args &&... args)
+        {
+            void *mem = allocate(sizeof(T));
+
+            try {
+                return ::new (mem) T(std::forward<Args>(args)...);
+            }
+            catch (...) {
+                deallocate(mem, sizeof(T));
+                throw;
+            }
+        }
+
+        /** Destroys an object that was created with create().*/
+        template <typename T> void destroy(T *object)
+        {
+            if (object != nullptr) {
+                object->~T();
+                deallocate(object, sizeof(T));
+            }
+        }
+
+      private:
+        struct FreeBlock_
+        {
+            FreeBlock_ *next;
+        };
+
+        enum
+        {
+            granularity = 16,
+            sizeClassCount = maxPooledSize / granularity,
+            chunkSize = 64 * 1024
+        };
+
+        static size_t sizeClassIndex(size_t size) { return (size == 0) ? 0 : (size - 1) / granularity; }
+
+        void refill(size_t classIndex)
+        {
+            size_t blockSize = (classIndex + 1) * granularity;
+
+            char *chunk = static_cast<char *>(::operator new(chunkSize));
+            try {
+                _chunks.push_back(chunk);
+            }
+            catch (...) {
+                ::operator delete(chunk);
+                throw;
+            }
+
+            // link all blocks of the new chunk into the free list
+            size_t blockCount = chunkSize / blockSize;
+            FreeBlock_ *&freeList = _freeLists[classIndex];
+
+            for (size_t i = blockCount; i > 0; i--) {
+                FreeBlock_ *block = reinterpret_cast<FreeBlock_ *>(chunk + (i - 1) * blockSize);
+                block->next = freeList;
+                freeList = block;
+            }
+        }
+
+        FreeBlock_ *_freeLists[sizeClassCount] = {};
+        std::vector<void *> _chunks;
+    };
+}
+
+#endif
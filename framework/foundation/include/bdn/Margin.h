@@ -1,6 +1,8 @@
 #ifndef BDN_Margin_H_
 #define BDN_Margin_H_
 
+#include <type_traits>
+
 namespace bdn
 {
 
@@ -24,31 +26,17 @@ namespace bdn
         double bottom = 0;
         double left = 0;
 
-        Margin() : top(0), right(0), bottom(0), left(0) {}
+        constexpr Margin() {}
 
-        explicit Margin(double all)
-        {
-            top = all;
-            right = all;
-            bottom = all;
-            left = all;
-        }
+        constexpr explicit Margin(double all) : top(all), right(all), bottom(all), left(all) {}
 
-        Margin(double topBottom, double leftRight)
-        {
-            top = topBottom;
-            right = leftRight;
-            bottom = topBottom;
-            left = leftRight;
-        }
+        constexpr Margin(double topBottom, double leftRight)
+            : top(topBottom), right(leftRight), bottom(topBottom), left(leftRight)
+        {}
 
-        Margin(double top, double right, double bottom, double left)
-        {
-            this->top = top;
-            this->right = right;
-            this->bottom = bottom;
-            this->left = left;
-        }
+        constexpr Margin(double top, double right, double bottom, double left)
+            : top(top), right(right), bottom(bottom), left(left)
+        {}
 
         Margin operator+(const Margin &o) const { return Margin(*this) += o; }
 
@@ -75,6 +63,9 @@ namespace bdn
         }
     };
 
+    static_assert(sizeof(Margin) == 4 * sizeof(double), "Margin must not contain anything but its components");
+    static_assert(std::is_trivially_copyable<Margin>::value, "Margin must be trivially copyable");
+
     template <typename CHAR_TYPE, class CHAR_TRAITS>
     std::basic_ostream<CHAR_TYPE, CHAR_TRAITS> &operator<<(std::basic_ostream<CHAR_TYPE, CHAR_TRAITS> &stream,
                                                            const Margin &m)
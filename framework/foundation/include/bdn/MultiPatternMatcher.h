@@ -0,0 +1,327 @@
+#ifndef BDN_MultiPatternMatcher_H_
+#define BDN_MultiPatternMatcher_H_
+
+#include <algorithm>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace bdn
+{
+
+    /** Searches a sequence of elements for any one of a set of patterns in a
+       single pass (Aho-Corasick automaton).
+
+        Element is the type of the sequence elements. For strings this is
+       usually the encoded element type (e.g. char for UTF-8 data). Matching on
+       encoded UTF-8, UTF-16 or UTF-32 data is equivalent to matching on the
+       decoded characters, since the encodings never produce a pattern match
+       that begins in the middle of a character.
+
+        findNext() returns the leftmost match. If several patterns match at
+       the same position then the longest one wins. If two identical patterns
+       were specified then the first one is reported.
+
+        If all patterns consist of a single element (as is often the case for
+       escaping functions) then a lookup table is used instead of the
+       automaton. For single-byte elements the automaton is a complete
+       transition table, so that each input element is processed with a single
+       table lookup. For wider elements the trie edges are searched and failure
+       links are followed as needed.
+
+        The matcher cannot be modified after it was constructed. So it can be
+       used by multiple threads at the same time.
+    */
+    template <class Element> class MultiPatternMatcher
+    {
+      public:
+        typedef std::basic_string<Element> Pattern;
+
+        /** Constructs a matcher for the specified patterns. Empty patterns are
+           ignored (they never match), but still count for the pattern
+           indices that findNext() reports.*/
+        MultiPatternMatcher(const std::vector<Pattern> &patterns)
+        {
+            for (const Pattern &pattern : patterns)
+                _patternLengths.push_back(pattern.length());
+
+            std::fill(_startLookup, _startLookup + lookupSize, false);
+
+            if (!initSingleElementLookup(patterns))
+                initAutomaton(patterns);
+        }
+
+        /** Returns the number of patterns (including empty ones).*/
+        int getPatternCount() const { return (int)_patternLengths.size(); }
+
+        /** Returns the length of the pattern with the specified index.*/
+        size_t getPatternLength(int patternIndex) const { return _patternLengths[patternIndex]; }
+
+        /** Searches for the first match in the sequence [begin, end).
+
+            If a match is found then a pointer to its first element is
+           returned, matchEnd is set to the end of the match and patternIndex to
+           the index of the pattern that matched.
+
+            If no match is found then \c end is returned and the output
+           parameters are not modified.*/
+        const Element *findNext(const Element *begin, const Element *end, const Element *&matchEnd,
+                                int &patternIndex) const
+        {
+            if (_singleElementLookup)
+                return findNextSingleElement(begin, end, matchEnd, patternIndex);
+            else
+                return findNextWithAutomaton(begin, end, matchEnd, patternIndex);
+        }
+
+      private:
+        typedef typename std::make_unsigned<Element>::type UnsignedElement;
+
+        enum
+        {
+            lookupSize = 256
+        };
+
+        typedef std::integral_constant<bool, sizeof(Element) == 1> UseTransitionTable;
+
+        bool initSingleElementLookup(const std::vector<Pattern> &patterns)
+        {
+            for (const Pattern &pattern : patterns) {
+                if (pattern.length() > 1 || (pattern.length() == 1 && (UnsignedElement)pattern[0] >= lookupSize))
+                    return false;
+            }
+
+            std::fill(_singleElementPattern, _singleElementPattern + lookupSize, -1);
+
+            for (int i = (int)patterns.size() - 1; i >= 0; i--) {
+                if (!patterns[i].empty())
+                    _singleElementPattern[(UnsignedElement)patterns[i][0]] = i;
+            }
+
+            _singleElementLookup = true;
+
+            return true;
+        }
+
+        void initAutomaton(const std::vector<Pattern> &patterns)
+        {
+            // state 0 is the root of the trie
+            _children.resize(1);
+            _fail.push_back(0);
+            _depth.push_back(0);
+            _output.push_back(-1);
+
+            for (int patternIndex = 0; patternIndex < (int)patterns.size(); patternIndex++) {
+                const Pattern &pattern = patterns[patternIndex];
+                if (pattern.empty())
+                    continue;
+
+                addStartElement(pattern[0]);
+
+                int state = 0;
+                for (Element element : pattern) {
+                    int child = findChild(state, element);
+                    if (child < 0) {
+                        child = (int)_fail.size();
+
+                        _children.emplace_back();
+                        _fail.push_back(0);
+                        _depth.push_back(_depth[state] + 1);
+                        _output.push_back(-1);
+
+                        auto &children = _children[state];
+                        children.insert(std::lower_bound(children.begin(), children.end(),
+                                                         std::make_pair(element, 0), compareEdges),
+                                        std::make_pair(element, child));
+                    }
+                    state = child;
+                }
+
+                if (_output[state] < 0)
+                    _output[state] = patternIndex;
+            }
+
+            // breadth first, so that the failure target of a state (which is
+            // always less deep) is complete when the state is processed.
+            std::vector<int> order;
+            order.push_back(0);
+            for (size_t i = 0; i < order.size(); i++) {
+                int state = order[i];
+
+                for (auto &edge : _children[state]) {
+                    int child = edge.second;
+
+                    if (state != 0)
+                        _fail[child] = followEdges(_fail[state], edge.first);
+
+                    // the longest pattern that ends in this state is either
+                    // the state itself or the longest one that ends in the
+                    // failure target.
+                    if (_output[child] < 0)
+                        _output[child] = _output[_fail[child]];
+
+                    order.push_back(child);
+                }
+            }
+
+            initTransitionTable(order, UseTransitionTable());
+        }
+
+        void initTransitionTable(const std::vector<int> &order, std::true_type)
+        {
+            _transitions.resize(order.size() * lookupSize);
+
+            for (int state : order) {
+                int *row = &_transitions[state * lookupSize];
+
+                for (int element = 0; element < lookupSize; element++) {
+                    int child = findChild(state, (Element)element);
+                    if (child >= 0)
+                        row[element] = child;
+                    else if (state == 0)
+                        row[element] = 0;
+                    else
+                        row[element] = _transitions[_fail[state] * lookupSize + element];
+                }
+            }
+        }
+
+        void initTransitionTable(const std::vector<int> &order, std::false_type) {}
+
+        void addStartElement(Element element)
+        {
+            if ((UnsignedElement)element < lookupSize)
+                _startLookup[(UnsignedElement)element] = true;
+            else
+                _wideStartElements.insert(
+                    std::lower_bound(_wideStartElements.begin(), _wideStartElements.end(), element), element);
+        }
+
+        bool isStartElement(Element element) const
+        {
+            if ((UnsignedElement)element < lookupSize)
+                return _startLookup[(UnsignedElement)element];
+            else
+                return std::binary_search(_wideStartElements.begin(), _wideStartElements.end(), element);
+        }
+
+        static bool compareEdges(const std::pair<Element, int> &a, const std::pair<Element, int> &b)
+        {
+            return a.first < b.first;
+        }
+
+        int findChild(int state, Element element) const
+        {
+            auto &children = _children[state];
+
+            auto it = std::lower_bound(children.begin(), children.end(), std::make_pair(element, 0), compareEdges);
+            if (it != children.end() && it->first == element)
+                return it->second;
+            else
+                return -1;
+        }
+
+        int followEdges(int state, Element element) const
+        {
+            while (true) {
+                int child = findChild(state, element);
+                if (child >= 0)
+                    return child;
+                if (state == 0)
+                    return 0;
+                state = _fail[state];
+            }
+        }
+
+        int transition(int state, Element element, std::true_type) const
+        {
+            return _transitions[state * lookupSize + (UnsignedElement)element];
+        }
+
+        int transition(int state, Element element, std::false_type) const { return followEdges(state, element); }
+
+        const Element *findNextSingleElement(const Element *begin, const Element *end, const Element *&matchEnd,
+                                             int &patternIndex) const
+        {
+            for (const Element *current = begin; current != end; ++current) {
+                if ((UnsignedElement)*current < lookupSize) {
+                    int index = _singleElementPattern[(UnsignedElement)*current];
+                    if (index >= 0) {
+                        matchEnd = current + 1;
+                        patternIndex = index;
+                        return current;
+                    }
+                }
+            }
+
+            return end;
+        }
+
+        const Element *findNextWithAutomaton(const Element *begin, const Element *end, const Element *&matchEnd,
+                                             int &patternIndex) const
+        {
+            const Element *candidateBegin = nullptr;
+            const Element *candidateEnd = nullptr;
+            int candidatePattern = -1;
+
+            int state = 0;
+            for (const Element *current = begin; current != end; ++current) {
+                if (state == 0 && candidatePattern < 0) {
+                    // skip quickly over the parts that cannot begin a match.
+                    while (current != end && !isStartElement(*current))
+                        ++current;
+                    if (current == end)
+                        break;
+                }
+
+                state = transition(state, *current, UseTransitionTable());
+
+                // no match that has not been seen yet can begin before the
+                // start of the current state. So if that is after our
+                // candidate then the candidate is the leftmost-longest match.
+                const Element *stateBegin = current + 1 - _depth[state];
+                if (candidatePattern >= 0 && stateBegin > candidateBegin)
+                    break;
+
+                int output = _output[state];
+                if (output >= 0) {
+                    const Element *outputBegin = current + 1 - _patternLengths[output];
+
+                    if (candidatePattern < 0 || outputBegin < candidateBegin ||
+                        (outputBegin == candidateBegin && current + 1 > candidateEnd)) {
+                        candidateBegin = outputBegin;
+                        candidateEnd = current + 1;
+                        candidatePattern = output;
+                    }
+                }
+            }
+
+            if (candidatePattern < 0)
+                return end;
+
+            matchEnd = candidateEnd;
+            patternIndex = candidatePattern;
+
+            return candidateBegin;
+        }
+
+        std::vector<size_t> _patternLengths;
+
+        bool _singleElementLookup = false;
+        int _singleElementPattern[lookupSize];
+
+        bool _startLookup[lookupSize];
+        std::vector<Element> _wideStartElements;
+
+        std::vector<std::vector<std::pair<Element, int>>> _children;
+        std::vector<int> _fail;
+        std::vector<int> _depth;
+        std::vector<int> _output;
+
+        // complete transition table. Only used for single-byte elements.
+        std::vector<int> _transitions;
+    };
+}
+
+#endif
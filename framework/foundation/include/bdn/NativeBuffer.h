@@ -0,0 +1,69 @@
+#ifndef BDN_NativeBuffer_H_
+#define BDN_NativeBuffer_H_
+
+#include <cstdint>
+
+namespace bdn
+{
+
+    /** A contiguous block of memory that is owned by native code and whose
+        lifetime is controlled by reference counting (see bdn::P).
+
+        NativeBuffer is intended for large binary payloads (image data, file
+        contents, serialized models, etc.) that have to be shared with other
+        components without copying them. For example, on Android the buffer can
+        be exposed to Java as a direct java.nio.ByteBuffer (see
+        bdn::java::JNativeBuffer). The memory stays valid as long as at least
+        one reference to the NativeBuffer object exists.
+
+        Use one of the static creation functions to obtain a buffer:
+
+        - allocate() allocates heap memory.
+        - mapFile() maps the contents of a file into memory (only available on
+          POSIX platforms).
+
+        Platform specific code can also create subclasses that wrap memory that
+        is owned by another component (for example, a Java direct buffer).
+        These hold a reference to the original owner.
+        */
+    class NativeBuffer : public Base
+    {
+      public:
+        /** Allocates a new buffer with the specified size on the heap.
+            The buffer contents are not initialized.
+
+            The memory is suitably aligned for any fundamental type.*/
+        static P<NativeBuffer> allocate(size_t size);
+
+#if BDN_PLATFORM_FAMILY_POSIX
+        /** Maps the file at the specified path read-only into memory.
+
+            The file data is not copied. Pages are loaded lazily by the
+            operating system when they are accessed.
+
+            Throws a SystemError if the file cannot be opened or mapped.
+            */
+        static P<NativeBuffer> mapFile(const String &path);
+#endif
+
+        /** Returns a pointer to the buffer memory.*/
+        uint8_t *getData() const { return _data; }
+
+        /** Returns the size of the buffer in bytes.*/
+        size_t getSize() const { return _size; }
+
+        /** Returns true if the buffer contents may be modified.
+            Buffers created with mapFile() are read-only.*/
+        bool isWritable() const { return _writable; }
+
+      protected:
+        NativeBuffer(uint8_t *data, size_t size, bool writable) : _data(data), _size(size), _writable(writable) {}
+
+      private:
+        uint8_t *_data;
+        size_t _size;
+        bool _writable;
+    };
+}
+
+#endif
@@ -0,0 +1,168 @@
+#ifndef BDN_NotificationPolicy_H_
+#define BDN_NotificationPolicy_H_
+
+#include <bdn/IDispatcher.h>
+#include <bdn/InvalidArgumentError.h>
+#include <bdn/Mutex.h>
+
+#include <chrono>
+
+namespace bdn
+{
+
+    /** Controls when a notifier delivers its notifications to the subscribers.
+
+        - immediate: every notification is delivered synchronously (the
+       default).
+        - coalesced: notifications are delivered in a work item on a dispatcher.
+       All notifications that happen before that work item runs are combined
+       into one. Only the latest value is delivered.
+        - throttled: like coalesced, but deliveries happen at most a certain
+       number of times per second.
+
+        With the deferred modes (coalesced and throttled), the subscribers are
+       called from the dispatcher's thread. If no dispatcher is specified then
+       the main dispatcher is used (see getMainDispatcher()).
+
+        NotificationPolicy is a simple value type.
+
+        Example:
+
+        \code
+
+        // deliver progress updates at most 30 times per second
+        model->progressChanged().setNotificationPolicy(
+       NotificationPolicy::throttled(30) );
+
+        \endcode
+    */
+    class NotificationPolicy
+    {
+      public:
+        enum class Mode
+        {
+            immediate,
+            coalesced,
+            throttled
+        };
+
+        NotificationPolicy() {}
+
+        /** Notifications are delivered synchronously.*/
+        static NotificationPolicy immediate() { return NotificationPolicy(); }
+
+        /** Notifications are combined and delivered on the next turn of the
+         * specified dispatcher (or the main dispatcher, if it is null).*/
+        static NotificationPolicy coalesced(IDispatcher *dispatcher = nullptr)
+        {
+            return NotificationPolicy(Mode::coalesced, 0, dispatcher);
+        }
+
+        /** Notifications are combined and delivered at most maxPerSecond
+           times per second, on the specified dispatcher (or the main
+           dispatcher, if it is null).
+
+            Throws an InvalidArgumentError if maxPerSecond is not positive.*/
+        static NotificationPolicy throttled(double maxPerSecond, IDispatcher *dispatcher = nullptr)
+        {
+            if (!(maxPerSecond > 0))
+                throw InvalidArgumentError("NotificationPolicy::throttled must be called with maxPerSecond > 0");
+
+            return NotificationPolicy(Mode::throttled, maxPerSecond, dispatcher);
+        }
+
+        Mode getMode() const { return _mode; }
+
+        /** Returns true if notifications are not delivered synchronously.*/
+        bool isDeferred() const { return _mode != Mode::immediate; }
+
+        /** Returns the maximum number of deliveries per second of a throttled
+         * policy. Returns 0 for the other modes.*/
+        double getMaxPerSecond() const { return _maxPerSecond; }
+
+        /** Returns the dispatcher that deferred notifications are delivered
+         * on. Can be null (meaning: the main dispatcher).*/
+        P<IDispatcher> getDispatcher() const { return _dispatcher; }
+
+        bool operator==(const NotificationPolicy &o) const
+        {
+            return (_mode == o._mode && _maxPerSecond == o._maxPerSecond && _dispatcher == o._dispatcher);
+        }
+
+        bool operator!=(const NotificationPolicy &o) const { return !operator==(o); }
+
+      private:
+        NotificationPolicy(Mode mode, double maxPerSecond, IDispatcher *dispatcher)
+            : _mode(mode), _maxPerSecond(maxPerSecond), _dispatcher(dispatcher)
+        {}
+
+        Mode _mode = Mode::immediate;
+        double _maxPerSecond = 0;
+        P<IDispatcher> _dispatcher;
+    };
+
+    /** Internal helper for notifiers that support deferred notification
+        policies. Ensures that at most one delivery is scheduled at any given
+       time and enforces the minimum interval of throttled policies.
+
+        All methods are thread safe.*/
+    class NotificationDeferrer_
+    {
+      public:
+        /** Schedules a call to deliverFunc according to the policy. Does
+           nothing if a delivery is already scheduled and has not started yet.*/
+        void schedule(const NotificationPolicy &policy, const std::function<void()> &deliverFunc)
+        {
+            double delaySeconds = 0;
+
+            {
+                Mutex::Lock lock(_mutex);
+
+                if (_deliveryScheduled)
+                    return;
+                _deliveryScheduled = true;
+
+                if (policy.getMode() == NotificationPolicy::Mode::throttled && _hasDelivered) {
+                    std::chrono::duration<double> sinceLast = Clock::now() - _lastDeliveryTime;
+
+                    delaySeconds = 1.0 / policy.getMaxPerSecond() - sinceLast.count();
+                }
+            }
+
+            P<IDispatcher> dispatcher = policy.getDispatcher();
+            if (dispatcher == nullptr)
+                dispatcher = getMainDispatcher();
+
+            if (delaySeconds > 0)
+                dispatcher->enqueueInSeconds(delaySeconds, deliverFunc);
+            else
+                dispatcher->enqueue(deliverFunc);
+        }
+
+        /** Must be called by the delivery function before the subscribers are
+           called. Notifications that happen after this will schedule a new
+           delivery.*/
+        void beginDelivery()
+        {
+            Mutex::Lock lock(_mutex);
+
+            _deliveryScheduled = false;
+            _lastDeliveryTime = Clock::now();
+            _hasDelivered = true;
+        }
+
+        /** Returns the mutex that protects the deferrer. Notifiers can use it
+         * to protect their pending notification data as well.*/
+        Mutex &getMutex() { return _mutex; }
+
+      private:
+        using Clock = std::chrono::steady_clock;
+
+        Mutex _mutex;
+        bool _deliveryScheduled = false;
+        bool _hasDelivered = false;
+        Clock::time_point _lastDeliveryTime;
+    };
+}
+
+#endif
@@ -141,9 +141,15 @@ namespace bdn
                         // with the fact that the function might be called once
                         // more directly after unsubscribe finishes.
 
+                        bool dangling;
+
                         try {
                             typename MUTEX_TYPE::Unlock unlock(_mutex);
 
+                            // weak subscribers whose object is gone report
+                            // that through the scope, without throwing.
+                            DanglingCallScope_ danglingScope(item.second.func);
+
                             // note: we MUST NOT use std::forward here, since we
                             // may have to call multiple subscribers.
                             // std::forward might convert the temporary object
@@ -151,13 +157,18 @@ namespace bdn
                             // additionalCallMakerArgs variable might otherwise
                             // be invalidated by the first subscriber call.
                             callMaker(item.second.func, additionalCallMakerArgs...);
+
+                            dangling = danglingScope.wasDangling();
                         }
                         catch (DanglingFunctionError &) {
                             // this is a perfectly normal case. It means that
                             // the target function was a weak reference and the
-                            // target object has been destroyed. Just remove it
-                            // from our list and ignore the exception.
+                            // target object has been destroyed.
+                            dangling = true;
+                        }
 
+                        if (dangling) {
+                            // Just remove the subscriber from our list.
                             unsubscribeById(item.first);
                         }
                     }
@@ -272,9 +283,26 @@ namespace bdn
         class ParamlessFunctionAdapter
         {
           public:
+            typedef void WeakCallableTag_;
+
             ParamlessFunctionAdapter(std::function<void()> func) { _func = func; }
 
-            void operator()(ARG_TYPES... args) { _func(); }
+            void operator()(ARG_TYPES... args) const
+            {
+                bool dangling;
+
+                {
+                    DanglingCallScope_ danglingScope(_func);
+
+                    _func();
+
+                    dangling = danglingScope.wasDangling();
+                }
+
+                // pass the dangling state on to our own caller
+                if (dangling && !DanglingCallScope_::markDanglingIfTarget<void(ARG_TYPES...)>(this))
+                    throw DanglingFunctionError();
+            }
 
           protected:
             std::function<void()> _func;
@@ -6,6 +6,32 @@
 // needed so that we can provide specializations for std::hash
 #include <functional>
 #include <cmath>
+#include <limits>
+#include <type_traits>
+#include <cstring>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+
+#define BDN_INT_OP_MSC_INTRINSICS 1
+
+// The MSVC intrinsics cannot be evaluated at compile time, unlike the
+// GCC/Clang builtins. So functions that use them cannot be constexpr.
+#define BDN_INT_OP_CONSTEXPR
+
+#else
+#define BDN_INT_OP_CONSTEXPR constexpr
+
+#endif
+
+// __builtin_popcount becomes a library call if the target has no popcount
+// instruction (e.g. baseline x86-64 without -mpopcnt). The inline portable
+// implementation is faster than that.
+#if defined(__GNUC__) && (defined(__POPCNT__) || defined(__aarch64__) || defined(__ARM_NEON))
+#define BDN_INT_OP_POPCOUNT_BUILTIN 1
+#else
+#define BDN_INT_OP_POPCOUNT_BUILTIN 0
+#endif
 
 namespace bdn
 {
@@ -40,11 +66,14 @@ namespace bdn
        standard types listed above. The resulting hash value is identical to the
        value one would get by applying std::hash directly to the wrapped inner
        integer or floating point value.
+
+        Number is a plain value type. It has the same size as the wrapped simple
+       type and is trivially copyable.
     */
-    template <typename BaseType> class Number : public Base
+    template <typename BaseType> class Number
     {
       public:
-        Number(BaseType value = 0) : _value(value) {}
+        constexpr Number(BaseType value = 0) : _value(value) {}
 
         /** The simple integer or floating point type that this Number class
            uses. This is the type that was passed as a template parameter.*/
@@ -129,7 +158,7 @@ namespace bdn
         constexpr static inline bool isInteger() { return std::numeric_limits<BaseType>::is_integer; }
 
         /** Returns the value of the Number object.*/
-        BaseType getValue() const { return _value; }
+        constexpr BaseType getValue() const { return _value; }
 
         /** Sets the value of the integer object.*/
         template <typename ArgType> void setValue(ArgType &&val) { _value = std::forward<ArgType>(val); }
@@ -141,7 +170,7 @@ namespace bdn
         }
 
         /** Returns true if the integer value is not 0.*/
-        operator BaseType() const { return _value; }
+        constexpr operator BaseType() const { return _value; }
 
         template <typename ArgType> bool operator==(ArgType &&otherValue) const
         {
@@ -177,6 +206,11 @@ namespace bdn
         BaseType _value;
     };
 
+    static_assert(sizeof(Number<int>) == sizeof(int), "Number must have the same size as its simple type");
+    static_assert(sizeof(Number<double>) == sizeof(double), "Number must have the same size as its simple type");
+    static_assert(std::is_trivially_copyable<Number<int>>::value, "Number must be trivially copyable");
+    static_assert(std::is_trivially_copyable<Number<double>>::value, "Number must be trivially copyable");
+
     // note that signed char and unsigned char
     // are always different types than just plain char
     using SignedChar = Number<signed char>;
@@ -203,117 +237,214 @@ namespace bdn
     using Double = Number<double>;
     using LongDouble = Number<long double>;
 
-    template <int byteCount> struct _IntOpImpl;
 
-    template <> struct _IntOpImpl<1>
+    /** Portable implementations of the bit counting operations, for compilers
+     * that do not have builtins for them.*/
+    struct _PortableBitCountImpl
     {
-        static inline uint8_t _rotateBitsLeftImpl(uint8_t val, int bits) { return (val << bits) | (val >> (8 - bits)); }
+        static constexpr int _popCount32(uint32_t val)
+        {
+            val = val - ((val >> 1) & 0x55555555);
+            val = (val & 0x33333333) + ((val >> 2) & 0x33333333);
+            return int((((val + (val >> 4)) & 0x0f0f0f0f) * 0x01010101) >> 24);
+        }
+
+        static constexpr int _popCount64(uint64_t val) { return _popCount32(uint32_t(val)) + _popCount32(val >> 32); }
 
-        static inline uint8_t _rotateBitsRightImpl(uint8_t val, int bits)
+        static constexpr int _countLeadingZeros32(uint32_t val)
         {
-            return (val >> bits) | (val << (8 - bits));
+            // after copying the highest set bit to all lower bits, the number
+            // of set bits is the bit width minus the leading zeros.
+            val |= val >> 1;
+            val |= val >> 2;
+            val |= val >> 4;
+            val |= val >> 8;
+            val |= val >> 16;
+            return 32 - _popCount32(val);
         }
 
-        static inline uint8_t _invertByteOrderImpl(uint8_t val)
+        static constexpr int _countLeadingZeros64(uint64_t val)
         {
-            // single byte
-            return val;
+            return ((val >> 32) != 0) ? _countLeadingZeros32(uint32_t(val >> 32))
+                                      : 32 + _countLeadingZeros32(uint32_t(val));
         }
+
+        // val & -val isolates the lowest set bit. Subtracting 1 then sets all
+        // bits below it (or all bits, if val is 0).
+        static constexpr int _countTrailingZeros32(uint32_t val) { return _popCount32((val & (0 - val)) - 1); }
+
+        static constexpr int _countTrailingZeros64(uint64_t val) { return _popCount64((val & (0 - val)) - 1); }
     };
 
-    template <> struct _IntOpImpl<2>
+    template <int byteCount> struct _IntOpImpl;
+
+    template <> struct _IntOpImpl<4>
     {
-        static inline uint16_t _rotateBitsLeftImpl(uint16_t val, int bits)
+        // the masked shift counts make this well defined for bits=0. GCC,
+        // Clang and MSVC all compile this pattern to a single rotate
+        // instruction.
+        static BDN_INT_OP_CONSTEXPR inline uint32_t _rotateBitsLeftImpl(uint32_t val, int bits)
         {
-            return (val << bits) | (val >> (16 - bits));
+#ifdef BDN_INT_OP_MSC_INTRINSICS
+            return _rotl(val, bits);
+
+#else
+            return (val << (bits & 31)) | (val >> ((32 - bits) & 31));
+
+#endif
         }
 
-        static inline uint16_t _rotateBitsRightImpl(uint16_t val, int bits)
+        static BDN_INT_OP_CONSTEXPR inline uint32_t _rotateBitsRightImpl(uint32_t val, int bits)
         {
-            return (val >> bits) | (val << (16 - bits));
+#ifdef BDN_INT_OP_MSC_INTRINSICS
+            return _rotr(val, bits);
+
+#else
+            return (val >> (bits & 31)) | (val << ((32 - bits) & 31));
+
+#endif
         }
 
-        static inline uint16_t _invertByteOrderImpl(uint16_t val)
+        static BDN_INT_OP_CONSTEXPR inline uint32_t _invertByteOrderImpl(uint32_t val)
         {
-#ifdef _MSC_VER
-            return _byteswap_ushort(val);
+#ifdef BDN_INT_OP_MSC_INTRINSICS
+            return _byteswap_ulong(val);
 
 #elif defined(__GNUC__)
-            return __builtin_bswap16(val);
+            return __builtin_bswap32(val);
 
 #else
-            return (val & 0xff) << 8 | (val & 0xff00) >> 8;
+            return (val & 0xff) << 24 | (val & 0xff00) << 8 | (val & 0xff0000) >> 8 | (val & 0xff000000) >> 24;
 
 #endif
         }
-    };
 
-    template <> struct _IntOpImpl<4>
-    {
-        static inline uint32_t _rotateBitsLeftImpl(uint32_t val, int bits)
+        static constexpr int _popCountImpl(uint32_t val)
         {
-#ifdef _MSC_VER
-            return _rotl(val, bits);
+#if BDN_INT_OP_POPCOUNT_BUILTIN
+            return __builtin_popcount(val);
+#else
+            return _PortableBitCountImpl::_popCount32(val);
+#endif
+        }
 
+        static constexpr int _countLeadingZerosImpl(uint32_t val)
+        {
+#if defined(__GNUC__)
+            // __builtin_clz is undefined for 0
+            return (val == 0) ? 32 : __builtin_clz(val);
 #else
-            return (val << bits) | (val >> (32 - bits));
+            return _PortableBitCountImpl::_countLeadingZeros32(val);
+#endif
+        }
 
+        static constexpr int _countTrailingZerosImpl(uint32_t val)
+        {
+#if defined(__GNUC__)
+            return (val == 0) ? 32 : __builtin_ctz(val);
+#else
+            return _PortableBitCountImpl::_countTrailingZeros32(val);
 #endif
         }
+    };
 
-        static inline uint32_t _rotateBitsRightImpl(uint32_t val, int bits)
+    template <> struct _IntOpImpl<1>
+    {
+        static constexpr uint8_t _rotateBitsLeftImpl(uint8_t val, int bits)
         {
-#ifdef _MSC_VER
-            return _rotr(val, bits);
+            return uint8_t((val << (bits & 7)) | (val >> ((8 - bits) & 7)));
+        }
 
-#else
-            return (val >> bits) | (val << (32 - bits));
+        static constexpr uint8_t _rotateBitsRightImpl(uint8_t val, int bits)
+        {
+            return uint8_t((val >> (bits & 7)) | (val << ((8 - bits) & 7)));
+        }
 
-#endif
+        static constexpr uint8_t _invertByteOrderImpl(uint8_t val)
+        {
+            // single byte
+            return val;
         }
 
-        static inline uint32_t _invertByteOrderImpl(uint32_t val)
+        static constexpr int _popCountImpl(uint8_t val) { return _IntOpImpl<4>::_popCountImpl(val); }
+
+        static constexpr int _countLeadingZerosImpl(uint8_t val)
         {
-#ifdef _MSC_VER
-            return _byteswap_ulong(val);
+            return _IntOpImpl<4>::_countLeadingZerosImpl(val) - 24;
+        }
+
+        static constexpr int _countTrailingZerosImpl(uint8_t val)
+        {
+            return (val == 0) ? 8 : _IntOpImpl<4>::_countTrailingZerosImpl(val);
+        }
+    };
+
+    template <> struct _IntOpImpl<2>
+    {
+        static constexpr uint16_t _rotateBitsLeftImpl(uint16_t val, int bits)
+        {
+            return uint16_t((val << (bits & 15)) | (val >> ((16 - bits) & 15)));
+        }
+
+        static constexpr uint16_t _rotateBitsRightImpl(uint16_t val, int bits)
+        {
+            return uint16_t((val >> (bits & 15)) | (val << ((16 - bits) & 15)));
+        }
+
+        static BDN_INT_OP_CONSTEXPR inline uint16_t _invertByteOrderImpl(uint16_t val)
+        {
+#ifdef BDN_INT_OP_MSC_INTRINSICS
+            return _byteswap_ushort(val);
 
 #elif defined(__GNUC__)
-            return __builtin_bswap32(val);
+            return __builtin_bswap16(val);
 
 #else
-            return (val & 0xff) << 24 | (val & 0xff00) << 8 | (val & 0xff0000) >> 8 | (val & 0xff000000) >> 24;
+            return uint16_t((val & 0xff) << 8 | (val & 0xff00) >> 8);
 
 #endif
         }
+
+        static constexpr int _popCountImpl(uint16_t val) { return _IntOpImpl<4>::_popCountImpl(val); }
+
+        static constexpr int _countLeadingZerosImpl(uint16_t val)
+        {
+            return _IntOpImpl<4>::_countLeadingZerosImpl(val) - 16;
+        }
+
+        static constexpr int _countTrailingZerosImpl(uint16_t val)
+        {
+            return (val == 0) ? 16 : _IntOpImpl<4>::_countTrailingZerosImpl(val);
+        }
     };
 
     template <> struct _IntOpImpl<8>
     {
-        static inline uint64_t _rotateBitsLeftImpl(uint64_t val, int bits)
+        static BDN_INT_OP_CONSTEXPR inline uint64_t _rotateBitsLeftImpl(uint64_t val, int bits)
         {
-#ifdef _MSC_VER
+#ifdef BDN_INT_OP_MSC_INTRINSICS
             return _rotl64(val, bits);
 
 #else
-            return (val << bits) | (val >> (64 - bits));
+            return (val << (bits & 63)) | (val >> ((64 - bits) & 63));
 
 #endif
         }
 
-        static inline uint64_t _rotateBitsRightImpl(uint64_t val, int bits)
+        static BDN_INT_OP_CONSTEXPR inline uint64_t _rotateBitsRightImpl(uint64_t val, int bits)
         {
-#ifdef _MSC_VER
+#ifdef BDN_INT_OP_MSC_INTRINSICS
             return _rotr64(val, bits);
 
 #else
-            return (val >> bits) | (val << (64 - bits));
+            return (val >> (bits & 63)) | (val << ((64 - bits) & 63));
 
 #endif
         }
 
-        static inline uint64_t _invertByteOrderImpl(uint64_t val)
+        static BDN_INT_OP_CONSTEXPR inline uint64_t _invertByteOrderImpl(uint64_t val)
         {
-#ifdef _MSC_VER
+#ifdef BDN_INT_OP_MSC_INTRINSICS
             return _byteswap_uint64(val);
 
 #elif defined(__GNUC__)
@@ -324,6 +455,33 @@ namespace bdn
                    (val & 0xff00000000) >> 8 | (val & 0xff0000000000) >> 24 | (val & 0xff000000000000) >> 40 |
                    (val & 0xff00000000000000) >> 56;
 
+#endif
+        }
+
+        static constexpr int _popCountImpl(uint64_t val)
+        {
+#if BDN_INT_OP_POPCOUNT_BUILTIN
+            return __builtin_popcountll(val);
+#else
+            return _PortableBitCountImpl::_popCount64(val);
+#endif
+        }
+
+        static constexpr int _countLeadingZerosImpl(uint64_t val)
+        {
+#if defined(__GNUC__)
+            return (val == 0) ? 64 : __builtin_clzll(val);
+#else
+            return _PortableBitCountImpl::_countLeadingZeros64(val);
+#endif
+        }
+
+        static constexpr int _countTrailingZerosImpl(uint64_t val)
+        {
+#if defined(__GNUC__)
+            return (val == 0) ? 64 : __builtin_ctzll(val);
+#else
+            return _PortableBitCountImpl::_countTrailingZeros64(val);
 #endif
         }
     };
@@ -346,7 +504,7 @@ namespace bdn
         \endcode
 
         */
-    template <typename ArgIntType> static inline ArgIntType invertByteOrder(ArgIntType value)
+    template <typename ArgIntType> static BDN_INT_OP_CONSTEXPR inline ArgIntType invertByteOrder(ArgIntType value)
     {
         return static_cast<ArgIntType>(_IntOpImpl<sizeof(ArgIntType)>::_invertByteOrderImpl(value));
     }
@@ -381,7 +539,8 @@ namespace bdn
 
         \endcode
     */
-    template <typename ArgIntType> static inline ArgIntType rotateBitsLeft(ArgIntType value, int bits)
+    template <typename ArgIntType>
+    static BDN_INT_OP_CONSTEXPR inline ArgIntType rotateBitsLeft(ArgIntType value, int bits)
     {
         return static_cast<ArgIntType>(_IntOpImpl<sizeof(ArgIntType)>::_rotateBitsLeftImpl(value, bits));
     }
@@ -416,11 +575,192 @@ namespace bdn
 
         \endcode
     */
-    template <typename ArgIntType> static inline ArgIntType rotateBitsRight(ArgIntType value, int bits)
+    template <typename ArgIntType>
+    static BDN_INT_OP_CONSTEXPR inline ArgIntType rotateBitsRight(ArgIntType value, int bits)
     {
         return static_cast<ArgIntType>(_IntOpImpl<sizeof(ArgIntType)>::_rotateBitsRightImpl(value, bits));
     }
 
+    /** Inverts the byte order of the specified integer variable in place.
+        This is the same as value = invertByteOrder(value).*/
+    template <typename ArgIntType> static BDN_INT_OP_CONSTEXPR inline void swapByteOrder(ArgIntType &value)
+    {
+        value = invertByteOrder(value);
+    }
+
+    /** Returns the number of bits that are set to 1 in the specified integer
+        value (the "population count"). Negative values are counted in their
+        two's complement representation.
+
+        This is implemented with a single instruction on processors that
+        support it.*/
+    template <typename ArgIntType> static BDN_INT_OP_CONSTEXPR inline int popCount(ArgIntType value)
+    {
+        return _IntOpImpl<sizeof(ArgIntType)>::_popCountImpl(value);
+    }
+
+    /** Returns the number of 0 bits above the highest 1 bit of the specified
+        integer value. Returns the bit width of the type (e.g. 32 for
+        uint32_t) if the value is 0.*/
+    template <typename ArgIntType> static BDN_INT_OP_CONSTEXPR inline int countLeadingZeros(ArgIntType value)
+    {
+        return _IntOpImpl<sizeof(ArgIntType)>::_countLeadingZerosImpl(value);
+    }
+
+    /** Returns the number of 0 bits below the lowest 1 bit of the specified
+        integer value. Returns the bit width of the type (e.g. 32 for
+        uint32_t) if the value is 0.*/
+    template <typename ArgIntType> static BDN_INT_OP_CONSTEXPR inline int countTrailingZeros(ArgIntType value)
+    {
+        return _IntOpImpl<sizeof(ArgIntType)>::_countTrailingZerosImpl(value);
+    }
+
+    /** Returns the smallest power of two that is greater or equal to the
+        specified unsigned integer value. Returns 1 for 0.
+
+        Returns 0 if the result cannot be represented by the integer type
+        (i.e. if the value is bigger than the highest power of two of the
+        type).
+
+        Example:
+
+        \code
+
+        nextPowerOfTwo(5u);     // 8
+        nextPowerOfTwo(8u);     // 8
+        nextPowerOfTwo(uint8_t(200)); // 0
+
+        \endcode
+        */
+    template <typename ArgIntType> static BDN_INT_OP_CONSTEXPR inline ArgIntType nextPowerOfTwo(ArgIntType value)
+    {
+        static_assert(std::is_unsigned<ArgIntType>::value, "nextPowerOfTwo can only be used with unsigned types.");
+
+        return (value <= 1) ? ArgIntType(1)
+                            : (countLeadingZeros(ArgIntType(value - 1)) == 0)
+                                  ? ArgIntType(0)
+                                  : ArgIntType(ArgIntType(1) << (sizeof(ArgIntType) * 8 -
+                                                                 countLeadingZeros(ArgIntType(value - 1))));
+    }
+
+    /** Reads an integer that is stored in little endian byte order at the
+        specified memory location. The memory does not need to be aligned.
+
+        On little endian machines this compiles to a simple (unaligned) load,
+        on big endian machines to a load followed by a byte swap.
+
+        Example:
+
+        \code
+
+        uint32_t value = loadLittleEndian<uint32_t>(pBytes);
+
+        \endcode
+        */
+    template <typename IntType> static inline IntType loadLittleEndian(const void *bytes)
+    {
+        IntType value;
+        std::memcpy(&value, bytes, sizeof(IntType));
+#if BDN_IS_BIG_ENDIAN
+        swapByteOrder(value);
+#endif
+        return value;
+    }
+
+    /** Reads an integer that is stored in big endian byte order (network
+        byte order) at the specified memory location. The memory does not
+        need to be aligned. See loadLittleEndian().*/
+    template <typename IntType> static inline IntType loadBigEndian(const void *bytes)
+    {
+        IntType value;
+        std::memcpy(&value, bytes, sizeof(IntType));
+#if !BDN_IS_BIG_ENDIAN
+        swapByteOrder(value);
+#endif
+        return value;
+    }
+
+    /** Stores an integer in little endian byte order at the specified memory
+        location. The memory does not need to be aligned.*/
+    template <typename IntType> static inline void storeLittleEndian(void *bytes, IntType value)
+    {
+#if BDN_IS_BIG_ENDIAN
+        swapByteOrder(value);
+#endif
+        std::memcpy(bytes, &value, sizeof(IntType));
+    }
+
+    /** Stores an integer in big endian byte order (network byte order) at the
+        specified memory location. The memory does not need to be aligned.*/
+    template <typename IntType> static inline void storeBigEndian(void *bytes, IntType value)
+    {
+#if !BDN_IS_BIG_ENDIAN
+        swapByteOrder(value);
+#endif
+        std::memcpy(bytes, &value, sizeof(IntType));
+    }
+
+    /** Reads \c count integers that are stored in little endian byte order
+        from the specified byte buffer into the \c values array. The byte
+        buffer does not need to be aligned.
+
+        On little endian machines this is a single memcpy.*/
+    template <typename IntType> static inline void loadLittleEndian(const void *bytes, IntType *values, size_t count)
+    {
+        std::memcpy(values, bytes, count * sizeof(IntType));
+#if BDN_IS_BIG_ENDIAN
+        for (size_t i = 0; i < count; i++)
+            swapByteOrder(values[i]);
+#endif
+    }
+
+    /** Reads \c count integers that are stored in big endian byte order
+        from the specified byte buffer into the \c values array. The byte
+        buffer does not need to be aligned.
+
+        On big endian machines this is a single memcpy.*/
+    template <typename IntType> static inline void loadBigEndian(const void *bytes, IntType *values, size_t count)
+    {
+        std::memcpy(values, bytes, count * sizeof(IntType));
+#if !BDN_IS_BIG_ENDIAN
+        for (size_t i = 0; i < count; i++)
+            swapByteOrder(values[i]);
+#endif
+    }
+
+    /** Stores \c count integers from the \c values array in little endian
+        byte order in the specified byte buffer. The byte buffer does not need
+        to be aligned.
+
+        On little endian machines this is a single memcpy.*/
+    template <typename IntType>
+    static inline void storeLittleEndian(void *bytes, const IntType *values, size_t count)
+    {
+#if BDN_IS_BIG_ENDIAN
+        uint8_t *out = static_cast<uint8_t *>(bytes);
+        for (size_t i = 0; i < count; i++)
+            storeLittleEndian(out + i * sizeof(IntType), values[i]);
+#else
+        std::memcpy(bytes, values, count * sizeof(IntType));
+#endif
+    }
+
+    /** Stores \c count integers from the \c values array in big endian byte
+        order (network byte order) in the specified byte buffer. The byte
+        buffer does not need to be aligned.
+
+        On big endian machines this is a single memcpy.*/
+    template <typename IntType> static inline void storeBigEndian(void *bytes, const IntType *values, size_t count)
+    {
+#if !BDN_IS_BIG_ENDIAN
+        uint8_t *out = static_cast<uint8_t *>(bytes);
+        for (size_t i = 0; i < count; i++)
+            storeBigEndian(out + i * sizeof(IntType), values[i]);
+#else
+        std::memcpy(bytes, values, count * sizeof(IntType));
+#endif
+    }
+
 #if BDN_STD_ISNAN_INT_MISSING
 
     template <bool IsFloatingPoint> struct MscNumberUtilHelper_
@@ -257,20 +257,29 @@ namespace bdn
                     // might be called once more directly after unsubscribe
                     // finishes.
 
+                    bool dangling;
+
                     try {
                         Mutex::Unlock unlock(_mutex);
 
+                        DanglingCallScope_ danglingScope(item.second.func);
+
                         // note that _subscribedFuncCaller has the notification
                         // parameters bound to it. So we do not need to pass
                         // them here.
                         _subscribedFuncCaller(item.second.func);
+
+                        dangling = danglingScope.wasDangling();
                     }
                     catch (DanglingFunctionError &) {
                         // this is a perfectly normal case. It means that the
                         // target function was a weak reference and the target
-                        // object has been destroyed. Just remove it from our
-                        // list and ignore the exception.
+                        // object has been destroyed.
+                        dangling = true;
+                    }
 
+                    if (dangling) {
+                        // Just remove it from our list.
                         unsubscribeById(item.first);
                     }
                 }
@@ -1,6 +1,8 @@
 #ifndef BDN_Point_H_
 #define BDN_Point_H_
 
+#include <type_traits>
+
 namespace bdn
 {
 
@@ -16,9 +18,9 @@ namespace bdn
         double x = 0;
         double y = 0;
 
-        Point() {}
+        constexpr Point() {}
 
-        Point(double x, double y) : x(x), y(y) {}
+        constexpr Point(double x, double y) : x(x), y(y) {}
 
         /** Adds the specified point to this point
             (by adding the coordinates of one point to those of the other).*/
@@ -51,6 +53,9 @@ namespace bdn
         }
     };
 
+    static_assert(sizeof(Point) == 2 * sizeof(double), "Point must not contain anything but its coordinates");
+    static_assert(std::is_trivially_copyable<Point>::value, "Point must be trivially copyable");
+
     template <typename CHAR_TYPE, class CHAR_TRAITS>
     std::basic_ostream<CHAR_TYPE, CHAR_TRAITS> &operator<<(std::basic_ostream<CHAR_TYPE, CHAR_TRAITS> &stream,
                                                            const Point &p)
@@ -4,12 +4,20 @@
 #include <bdn/DummyMutex.h>
 #include <bdn/IPropertyNotifier.h>
 #include <bdn/NotifierBase.h>
+#include <bdn/NotificationPolicy.h>
+#include <bdn/PropertyUpdateBatch.h>
+#include <bdn/func.h>
+
+#include <atomic>
+#include <memory>
 
 namespace bdn
 {
 
     /** The default implementation for IPropertyNotifier (see \ref
        IPropertyNotifier decription for more info).
+
+        Supports deferred notification policies (see setNotificationPolicy()).
     */
     template <typename PROPERTY_VALUE_TYPE>
     class PropertyNotifier : public NotifierBase<DummyMutex, const PROPERTY_VALUE_TYPE &>
@@ -28,12 +36,68 @@ namespace bdn
 
         void notify(const IPropertyReadAccessor<PROPERTY_VALUE_TYPE> &propertyAccessor) override
         {
-            BASE::template notifyImpl<decltype(&PropertyNotifier::callPropertySubscriber),
-                                      const IPropertyReadAccessor<PROPERTY_VALUE_TYPE> &>(
-                &PropertyNotifier::callPropertySubscriber, propertyAccessor);
+            if (_deferred) {
+                Mutex::Lock lock(_deferrer.getMutex());
+
+                // only the latest value is delivered
+                if (_pendingValue == nullptr)
+                    _pendingValue.reset(new PROPERTY_VALUE_TYPE(propertyAccessor.get()));
+                else
+                    *_pendingValue = propertyAccessor.get();
+
+                _deferrer.schedule(_policy, strongMethod(this, &PropertyNotifier::deliverPending));
+            } else {
+                // computed properties that depend on us are only updated after
+                // all subscribers have been notified (see
+                // PropertyUpdateBatch_).
+                PropertyUpdateBatch_ batch;
+
+                BASE::template notifyImpl<decltype(&PropertyNotifier::callPropertySubscriber),
+                                          const IPropertyReadAccessor<PROPERTY_VALUE_TYPE> &>(
+                    &PropertyNotifier::callPropertySubscriber, propertyAccessor);
+
+                batch.end();
+            }
+        }
+
+        void setNotificationPolicy(const NotificationPolicy &policy) override
+        {
+            Mutex::Lock lock(_deferrer.getMutex());
+
+            _policy = policy;
+            _deferred = policy.isDeferred();
+        }
+
+        NotificationPolicy getNotificationPolicy() const override
+        {
+            Mutex::Lock lock(_deferrer.getMutex());
+
+            return _policy;
         }
 
       private:
+        /** Delivers the latest value that was recorded by a deferred
+         * notify() call.*/
+        void deliverPending()
+        {
+            std::unique_ptr<PROPERTY_VALUE_TYPE> value;
+
+            {
+                Mutex::Lock lock(_deferrer.getMutex());
+
+                _deferrer.beginDelivery();
+                value = std::move(_pendingValue);
+            }
+
+            if (value != nullptr) {
+                PropertyUpdateBatch_ batch;
+
+                BASE::doNotify(*value);
+
+                batch.end();
+            }
+        }
+
         /** Makes the notification call to a single subscriber.
             Call maker ensures that the current value of a property is provided
            to subscribers even if a property is set recursively from within a
@@ -43,6 +107,11 @@ namespace bdn
         {
             subscribedFunc(propertyAccessor.get());
         }
+
+        std::atomic<bool> _deferred{false};
+        NotificationPolicy _policy;
+        mutable NotificationDeferrer_ _deferrer;
+        std::unique_ptr<PROPERTY_VALUE_TYPE> _pendingValue;
     };
 }
 
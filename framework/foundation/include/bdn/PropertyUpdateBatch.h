@@ -0,0 +1,65 @@
+#ifndef BDN_PropertyUpdateBatch_H_
+#define BDN_PropertyUpdateBatch_H_
+
+#include <deque>
+#include <functional>
+
+namespace bdn
+{
+
+    /** Internal class. Do not use directly.
+
+        Defers the updates of computed properties (see ComputedProperty) until
+       a property change has been propagated completely.
+
+        Property notifiers open a batch while they call their subscribers.
+       Computed properties that depend on the property only mark themselves
+       (and everything that depends on them) as dirty at that point and add
+       their update to the batch. The updates are executed when the outermost
+       batch ends. So when a computed property is recomputed, all other
+       computed properties that are affected by the same change already know
+       that they are dirty, and no stale values are read (e.g. for "diamond"
+       dependencies).
+
+        Batches can be nested. Only the outermost batch executes the updates.
+       Updates that are added while the updates are executed are executed by
+       the same batch.
+
+        Each thread has its own batch state.
+    */
+    class PropertyUpdateBatch_
+    {
+      public:
+        PropertyUpdateBatch_();
+        ~PropertyUpdateBatch_();
+
+        PropertyUpdateBatch_(const PropertyUpdateBatch_ &) = delete;
+        PropertyUpdateBatch_ &operator=(const PropertyUpdateBatch_ &) = delete;
+
+        /** Ends the batch. If this is the outermost batch then the pending
+           updates are executed.
+
+            If the batch object is destroyed without end() having been called
+           (e.g. because an exception was thrown) then the pending updates are
+           discarded when the outermost batch goes away. The affected computed
+           properties stay dirty and are recomputed on the next read.*/
+        void end();
+
+        /** Adds an update that is executed at the end of the outermost batch.
+           Must only be called while a batch is active.*/
+        static void addPendingUpdate(std::function<void()> update);
+
+      private:
+        struct State_
+        {
+            int depth = 0;
+            std::deque<std::function<void()>> pendingUpdates;
+        };
+
+        static State_ &getState_();
+
+        bool _ended = false;
+    };
+}
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef BDN_QueueFullError_H_
+#define BDN_QueueFullError_H_
+
+#include <stdexcept>
+
+namespace bdn
+{
+
+    /** Thrown when an item cannot be added to a queue because the queue has
+     * reached its maximum capacity.*/
+    class QueueFullError : public std::runtime_error
+    {
+      public:
+        QueueFullError(const String &message) : std::runtime_error(message) {}
+
+        QueueFullError() : std::runtime_error("Queue is full") {}
+    };
+}
+
+#endif
@@ -5,6 +5,8 @@
 #include <bdn/Size.h>
 #include <bdn/Point.h>
 
+#include <type_traits>
+
 namespace bdn
 {
 
@@ -24,17 +26,17 @@ namespace bdn
         double width = 0;
         double height = 0;
 
-        Rect() {}
+        constexpr Rect() {}
 
-        Rect(double x, double y, double width, double height) : x(x), y(y), width(width), height(height) {}
+        constexpr Rect(double x, double y, double width, double height) : x(x), y(y), width(width), height(height) {}
 
-        Rect(const Point &pos, const Size &size) : x(pos.x), y(pos.y), width(size.width), height(size.height) {}
+        constexpr Rect(const Point &pos, const Size &size) : x(pos.x), y(pos.y), width(size.width), height(size.height) {}
 
         /** Returns the position of the top left corner of the rect.*/
-        Point getPosition() const { return Point(x, y); }
+        constexpr Point getPosition() const { return Point(x, y); }
 
         /** Returns the size of the rect.*/
-        Size getSize() const { return Size(width, height); }
+        constexpr Size getSize() const { return Size(width, height); }
 
         /** Decrease the rect size by subtracting the specified margin.*/
         Rect operator-(const Margin &margin) const { return Rect(*this) -= margin; }
@@ -65,6 +67,9 @@ namespace bdn
         }
     };
 
+    static_assert(sizeof(Rect) == 4 * sizeof(double), "Rect must not contain anything but its components");
+    static_assert(std::is_trivially_copyable<Rect>::value, "Rect must be trivially copyable");
+
     template <typename CHAR_TYPE, class CHAR_TRAITS>
     std::basic_ostream<CHAR_TYPE, CHAR_TRAITS> &operator<<(std::basic_ostream<CHAR_TYPE, CHAR_TRAITS> &stream,
                                                            const Rect &r)
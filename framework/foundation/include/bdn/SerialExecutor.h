@@ -0,0 +1,110 @@
+#ifndef BDN_SerialExecutor_H_
+#define BDN_SerialExecutor_H_
+
+#if BDN_HAVE_THREADS
+
+#include <bdn/ThreadPool.h>
+
+#include <bdn/List.h>
+
+namespace bdn
+{
+
+    /** Executes jobs one after the other, in the order in which they were
+       added, using the threads of a ThreadPool (this is often called a
+       "strand").
+
+        SerialExecutor guarantees that its jobs never overlap and that they are
+       executed in FIFO order. But unlike a ThreadPool with a single thread, a
+       SerialExecutor does not own any threads. Many SerialExecutor objects can
+       share the same pool, so thousands of independent ordered queues do not
+       cost a single dedicated thread. When a SerialExecutor has nothing to do
+       then it does not occupy a pool thread at all.
+
+        Consecutive jobs are not necessarily executed by the same pool thread.
+
+        A SerialExecutor executes at most a limited number of jobs in a row
+       before it hands its pool thread back to the pool. So a single busy
+       executor cannot monopolize a thread while other executors of the same
+       pool have work waiting.
+
+        When the SerialExecutor object is deleted then all jobs that have not
+       started yet are discarded and signalStop() is called on them. The job
+       that is currently running (if any) is also asked to stop. Note that a
+       job keeps the executor alive while it runs, so the executor will only be
+       deleted after the active job has finished.
+    */
+    class SerialExecutor : public Base
+    {
+      public:
+        /** Constructor.
+
+            \param pool the thread pool that executes the jobs. If this is null
+           then the pool returned by getSharedThreadPool() is used.*/
+        SerialExecutor(ThreadPool *pool = nullptr);
+        ~SerialExecutor();
+
+        /** Adds a job to the end of the queue. The job will be executed after
+           all previously added jobs have finished.
+
+            If the pool rejects the executor's job (see
+           ThreadPool::OverflowPolicy::reject) then the QueueFullError is passed
+           on. The job remains queued and is executed after the next successful
+           addJob call.*/
+        void addJob(IThreadRunnable *runnable);
+
+        /** Returns the number of jobs that have been added and have not yet
+           finished (including the currently running job).
+
+            Note that this number can change at any time when jobs finish, so
+           it is only fully reliable in rare cases (possibly during testing).*/
+        int getPendingJobCount() const;
+
+        /** Returns the thread pool that executes the jobs.*/
+        P<ThreadPool> getThreadPool() const { return _pool; }
+
+      private:
+        /** The maximum number of jobs that are executed in a row before the
+         * pool thread is handed back to the pool.*/
+        static constexpr int maxJobsPerTurn = 16;
+
+        /** The pool job that executes the queued jobs.*/
+        class Drainer : public Base, BDN_IMPLEMENTS IThreadRunnable
+        {
+          public:
+            Drainer(SerialExecutor *executor) : _executorWeak(executor) {}
+
+            void run() override;
+            void signalStop() override;
+
+          private:
+            WeakP<SerialExecutor> _executorWeak;
+        };
+        friend class Drainer;
+
+        /** Runs the next queued job. Returns false if there was none.*/
+        bool runNextJob();
+
+        /** Called when the drainer has used up its turn. Puts the drainer
+           back into the pool if there are more jobs.
+
+            Returns true if the pool's queue is full. The drainer must then
+           continue in the current thread.*/
+        bool endTurn();
+
+        void stopJobs();
+
+        P<ThreadPool> _pool;
+        P<Drainer> _drainer;
+
+        mutable Mutex _mutex;
+
+        List<P<IThreadRunnable>> _queuedJobs;
+        P<IThreadRunnable> _activeJob;
+        bool _drainScheduled = false;
+    };
+}
+
+#endif // BDN_HAVE_THREADS
+
+#endif
@@ -5,6 +5,7 @@
 
 #include <limits>
 #include <cmath>
+#include <type_traits>
 
 namespace bdn
 {
@@ -159,6 +160,9 @@ namespace bdn
         }
     };
 
+    static_assert(sizeof(Size) == 2 * sizeof(double), "Size must not contain anything but its components");
+    static_assert(std::is_trivially_copyable<Size>::value, "Size must be trivially copyable");
+
     template <typename CHAR_TYPE, class CHAR_TRAITS>
     std::basic_ostream<CHAR_TYPE, CHAR_TRAITS> &operator<<(std::basic_ostream<CHAR_TYPE, CHAR_TRAITS> &stream,
                                                            const Size &s)
@@ -0,0 +1,135 @@
+#ifndef BDN_SpscChannel_H_
+#define BDN_SpscChannel_H_
+
+#include <atomic>
+#include <memory>
+
+namespace bdn
+{
+
+    /** A lock-free, bounded queue for passing items from exactly one producer
+       thread to exactly one consumer thread ("single producer, single
+       consumer").
+
+        Only one thread may call tryPush() and only one (possibly different)
+       thread may call tryPop(). Neither of them ever blocks or locks a mutex.
+
+        The capacity is fixed when the channel is created. It is rounded up to
+       the next power of two.
+
+        ItemType must be default-constructible and move-assignable. Popped slots
+       are reset to a default-constructed value, so that resources held by the
+       items (for example the captured state of a std::function) are released
+       right away.
+    */
+    template <typename ItemType> class SpscChannel
+    {
+      public:
+        explicit SpscChannel(size_t capacity)
+        {
+            size_t roundedCapacity = 1;
+            while (roundedCapacity < capacity)
+                roundedCapacity <<= 1;
+
+            _items.reset(new ItemType[roundedCapacity]);
+            _mask = roundedCapacity - 1;
+        }
+
+        SpscChannel(const SpscChannel &) = delete;
+        SpscChannel &operator=(const SpscChannel &) = delete;
+
+        /** Returns the maximum number of items that the channel can hold.*/
+        size_t getCapacity() const { return _mask + 1; }
+
+        /** Adds an item at the end of the channel. Returns false if the channel
+           is full. In that case the item is not modified.
+
+            Must only be called from the producer thread.*/
+        bool tryPush(ItemType &&item)
+        {
+            size_t tail = _tail.load(std::memory_order_relaxed);
+
+            if (tail - _cachedHead > _mask) {
+                // the channel looked full the last time we checked. Refresh our
+                // view of the consumer's position.
+                _cachedHead = _head.load(std::memory_order_acquire);
+
+                if (tail - _cachedHead > _mask)
+                    return false;
+            }
+
+            _items[tail & _mask] = std::move(item);
+
+            _tail.store(tail + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        bool tryPush(const ItemType &item)
+        {
+            ItemType copy(item);
+            return tryPush(std::move(copy));
+        }
+
+        /** Removes the first item from the channel and stores it in the item
+           parameter. Returns false if the channel is empty.
+
+            Must only be called from the consumer thread.*/
+        bool tryPop(ItemType &item)
+        {
+            size_t head = _head.load(std::memory_order_relaxed);
+
+            if (head == _cachedTail) {
+                _cachedTail = _tail.load(std::memory_order_acquire);
+
+                if (head == _cachedTail)
+                    return false;
+            }
+
+            ItemType &slot = _items[head & _mask];
+            item = std::move(slot);
+            slot = ItemType();
+
+            _head.store(head + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        /** Returns true if the channel is currently empty.
+
+            The result is only a snapshot - the producer can add an item at any
+           time. It is reliable for the consumer in the sense that if it
+           returns false then the next tryPop() will succeed.*/
+        bool isEmpty() const
+        {
+            return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+        }
+
+      private:
+        enum
+        {
+            // producer and consumer data are kept on separate cache lines, so
+            // that the two threads do not slow each other down.
+            cacheLineSize = 64
+        };
+
+        std::unique_ptr<ItemType[]> _items;
+        size_t _mask;
+
+        char _padding1[cacheLineSize];
+
+        // written by the consumer
+        std::atomic<size_t> _head{0};
+        size_t _cachedTail = 0;
+
+        char _padding2[cacheLineSize];
+
+        // written by the producer
+        std::atomic<size_t> _tail{0};
+        size_t _cachedHead = 0;
+
+        char _padding3[cacheLineSize];
+    };
+}
+
+#endif
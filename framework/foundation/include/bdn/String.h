@@ -5,6 +5,8 @@
 #include <bdn/NativeStringData.h>
 
 #include <iostream>
+#include <type_traits>
+#include <utility>
 
 namespace bdn
 {
@@ -151,212 +153,213 @@ namespace bdn
     typedef StringImpl<NativeStringData> String;
 }
 
-inline bdn::String operator+(const bdn::String &a, const bdn::String &b)
-{
-    bdn::String result(a);
-    result += b;
-
-    return result;
-}
-
-inline bdn::String operator+(const bdn::String &a, const std::string &b)
-{
-    bdn::String result(a);
-    result += b;
-
-    return result;
-}
-
-inline bdn::String operator+(const bdn::String &a, const std::wstring &b)
-{
-    bdn::String result(a);
-    result += b;
-
-    return result;
-}
-
-inline bdn::String operator+(const bdn::String &a, const std::u16string &b)
-{
-    bdn::String result(a);
-    result += b;
-
-    return result;
-}
-
-inline bdn::String operator+(const bdn::String &a, const std::u32string &b)
-{
-    bdn::String result(a);
-    result += b;
-
-    return result;
-}
-
-inline bdn::String operator+(const bdn::String &a, const char *b)
+namespace bdn
 {
-    bdn::String result(a);
-    result += b;
 
-    return result;
-}
+    /** A term of a string concatenation (see concatStringTerms_) that refers
+     * to a String.*/
+    struct StringConcatStringTerm_
+    {
+        const String *str;
 
-inline bdn::String operator+(const bdn::String &a, const wchar_t *b)
-{
-    bdn::String result(a);
-    result += b;
+        size_t getEncodedSizeHint() const { return str->end().getInner() - str->begin().getInner(); }
 
-    return result;
-}
+        void appendTo(NativeStringData::EncodedString &dest) const
+        {
+            dest.append(str->begin().getInner(), str->end().getInner());
+        }
+    };
 
-inline bdn::String operator+(const bdn::String &a, const char16_t *b)
-{
-    bdn::String result(a);
-    result += b;
+    /** A term of a string concatenation (see concatStringTerms_) that refers
+       to encoded string data (e.g. a string literal or a std::string).
 
-    return result;
-}
+        The data is only re-encoded if Codec is not the native codec.*/
+    template <class Codec> struct StringConcatEncodedTerm_
+    {
+        typedef typename Codec::EncodedElement EncodedElement;
 
-inline bdn::String operator+(const bdn::String &a, const char32_t *b)
-{
-    bdn::String result(a);
-    result += b;
+        const EncodedElement *begin;
+        const EncodedElement *end;
 
-    return result;
-}
+        size_t getEncodedSizeHint() const { return end - begin; }
 
-inline bdn::String operator+(bdn::String &&a, const bdn::String &b)
-{
-    bdn::String result(std::move(a));
-    result += b;
+        void appendTo(NativeStringData::EncodedString &dest) const
+        {
+            appendTo(dest, std::is_same<Codec, NativeStringData::Codec>());
+        }
 
-    return result;
-}
+        void appendTo(NativeStringData::EncodedString &dest, std::true_type sameCodec) const
+        {
+            dest.append(begin, end);
+        }
 
-inline bdn::String operator+(bdn::String &&a, const std::string &b)
-{
-    bdn::String result(std::move(a));
-    result += b;
+        void appendTo(NativeStringData::EncodedString &dest, std::false_type sameCodec) const
+        {
+            typedef typename Codec::template DecodingIterator<const EncodedElement *> DecodingIterator;
+            typedef typename NativeStringData::Codec::template EncodingIterator<DecodingIterator> EncodingIterator;
 
-    return result;
-}
+            dest.append(EncodingIterator(DecodingIterator(begin, begin, end)),
+                        EncodingIterator(DecodingIterator(end, begin, end)));
+        }
+    };
 
-inline bdn::String operator+(bdn::String &&a, const std::wstring &b)
-{
-    bdn::String result(std::move(a));
-    result += b;
+    inline StringConcatStringTerm_ makeStringConcatTerm_(const String &s) { return {&s}; }
 
-    return result;
-}
+    inline StringConcatEncodedTerm_<Utf8Codec> makeStringConcatTerm_(const char *s)
+    {
+        return {s, s + std::char_traits<char>::length(s)};
+    }
 
-inline bdn::String operator+(bdn::String &&a, const std::u16string &b)
-{
-    bdn::String result(std::move(a));
-    result += b;
+    inline StringConcatEncodedTerm_<Utf8Codec> makeStringConcatTerm_(const std::string &s)
+    {
+        return {s.data(), s.data() + s.length()};
+    }
 
-    return result;
-}
+    inline StringConcatEncodedTerm_<WideCodec> makeStringConcatTerm_(const wchar_t *s)
+    {
+        return {s, s + std::char_traits<wchar_t>::length(s)};
+    }
 
-inline bdn::String operator+(bdn::String &&a, const std::u32string &b)
-{
-    bdn::String result(std::move(a));
-    result += b;
+    inline StringConcatEncodedTerm_<WideCodec> makeStringConcatTerm_(const std::wstring &s)
+    {
+        return {s.data(), s.data() + s.length()};
+    }
 
-    return result;
-}
+    inline StringConcatEncodedTerm_<Utf16Codec> makeStringConcatTerm_(const char16_t *s)
+    {
+        return {s, s + std::char_traits<char16_t>::length(s)};
+    }
 
-inline bdn::String operator+(bdn::String &&a, const char *b)
-{
-    bdn::String result(std::move(a));
-    result += b;
+    inline StringConcatEncodedTerm_<Utf16Codec> makeStringConcatTerm_(const std::u16string &s)
+    {
+        return {s.data(), s.data() + s.length()};
+    }
 
-    return result;
-}
+    inline StringConcatEncodedTerm_<Utf32Codec> makeStringConcatTerm_(const char32_t *s)
+    {
+        return {s, s + std::char_traits<char32_t>::length(s)};
+    }
 
-inline bdn::String operator+(bdn::String &&a, const wchar_t *b)
-{
-    bdn::String result(std::move(a));
-    result += b;
+    inline StringConcatEncodedTerm_<Utf32Codec> makeStringConcatTerm_(const std::u32string &s)
+    {
+        return {s.data(), s.data() + s.length()};
+    }
 
-    return result;
-}
+    inline size_t getStringConcatSizeHint_() { return 0; }
 
-inline bdn::String operator+(bdn::String &&a, const char16_t *b)
-{
-    bdn::String result(std::move(a));
-    result += b;
+    template <class Term, class... Terms>
+    inline size_t getStringConcatSizeHint_(const Term &term, const Terms &... terms)
+    {
+        return term.getEncodedSizeHint() + getStringConcatSizeHint_(terms...);
+    }
 
-    return result;
-}
+    inline void appendStringConcatTerms_(NativeStringData::EncodedString &dest) {}
 
-inline bdn::String operator+(bdn::String &&a, const char32_t *b)
-{
-    bdn::String result(std::move(a));
-    result += b;
+    template <class Term, class... Terms>
+    inline void appendStringConcatTerms_(NativeStringData::EncodedString &dest, const Term &term,
+                                         const Terms &... terms)
+    {
+        term.appendTo(dest);
+        appendStringConcatTerms_(dest, terms...);
+    }
 
-    return result;
-}
+    /** Creates a String with the concatenation of the specified terms (see
+       makeStringConcatTerm_). The total encoded size is computed first, so
+       the result is encoded into a single allocation.
 
-inline bdn::String operator+(const std::string &a, const bdn::String &b)
-{
-    bdn::String result(a);
-    result += b;
+        The terms only refer to their operands, so they must not outlive the
+       expression in which they are created.*/
+    template <class... Terms> inline String concatStringTerms_(const Terms &... terms)
+    {
+        P<NativeStringData> data = newObj<NativeStringData>();
 
-    return result;
-}
+        NativeStringData::EncodedString &encoded = data->getEncodedString();
+        encoded.reserve(getStringConcatSizeHint_(terms...));
+        appendStringConcatTerms_(encoded, terms...);
 
-inline bdn::String operator+(const std::wstring &a, const bdn::String &b)
-{
-    bdn::String result(a);
-    result += b;
+        return String(data);
+    }
 
-    return result;
-}
+    /** Concatenates any number of strings. Each argument can be a String or
+       any string type that String can be constructed from (e.g. a string
+       literal or a std::string).
 
-inline bdn::String operator+(const std::u16string &a, const bdn::String &b)
-{
-    bdn::String result(a);
-    result += b;
+        The total encoded size is computed first, so the result is encoded into
+       a single allocation. Prefer this over a chain of + operators (a + b + c)
+       when building a string from more than two parts: the chain appends each
+       part to the temporary result and may reallocate along the way.
 
-    return result;
-}
+        Example:
 
-inline bdn::String operator+(const std::u32string &a, const bdn::String &b)
-{
-    bdn::String result(a);
-    result += b;
+        \code
+        String message = concat("Exception in ", functionName, " during update.");
+        \endcode
+        */
+    template <class... Args> inline String concat(const Args &... args)
+    {
+        return concatStringTerms_(makeStringConcatTerm_(args)...);
+    }
 
-    return result;
-}
+    template <class T> struct IsStringConcatOperand_
+    {
+        typedef typename std::decay<T>::type Decayed;
+        typedef typename std::remove_cv<typename std::remove_pointer<Decayed>::type>::type Pointee;
+
+        enum
+        {
+            value = std::is_same<Decayed, String>::value || std::is_same<Decayed, std::string>::value ||
+                    std::is_same<Decayed, std::wstring>::value || std::is_same<Decayed, std::u16string>::value ||
+                    std::is_same<Decayed, std::u32string>::value ||
+                    (std::is_pointer<Decayed>::value &&
+                     (std::is_same<Pointee, char>::value || std::is_same<Pointee, wchar_t>::value ||
+                      std::is_same<Pointee, char16_t>::value || std::is_same<Pointee, char32_t>::value))
+        };
+    };
 
-inline bdn::String operator+(const char *a, const bdn::String &b)
-{
-    bdn::String result(a);
-    result += b;
+    /** True if A + B is a String concatenation, i.e. if both are string
+       types and at least one of them is a String.*/
+    template <class A, class B> struct IsStringConcat_
+    {
+        typedef typename std::decay<A>::type DecayedA;
+        typedef typename std::decay<B>::type DecayedB;
+
+        enum
+        {
+            value = IsStringConcatOperand_<DecayedA>::value && IsStringConcatOperand_<DecayedB>::value &&
+                    (std::is_same<DecayedA, String>::value || std::is_same<DecayedB, String>::value)
+        };
+    };
 
-    return result;
-}
+    /** Concatenation with a temporary String on the left side (e.g. the
+       result of a previous + in a chain). The right side is appended in place,
+       so the buffer of the temporary is reused and grows geometrically.*/
+    template <class B> inline String concatStrings_(String &&a, const B &b, std::true_type leftIsTemporaryString)
+    {
+        String result(std::move(a));
+        result += b;
 
-inline bdn::String operator+(const wchar_t *a, const bdn::String &b)
-{
-    bdn::String result(a);
-    result += b;
+        return result;
+    }
 
-    return result;
+    /** Concatenation of two operands that we may not modify. The result is
+       encoded into a single pre-sized allocation.*/
+    template <class A, class B> inline String concatStrings_(const A &a, const B &b, std::false_type)
+    {
+        return concatStringTerms_(makeStringConcatTerm_(a), makeStringConcatTerm_(b));
+    }
 }
 
-inline bdn::String operator+(const char16_t *a, const bdn::String &b)
-{
-    bdn::String result(a);
-    result += b;
-
-    return result;
-}
+/** Concatenates two strings. At least one of the operands is a bdn::String,
+   the other can be any string type that String can be constructed from.
 
-inline bdn::String operator+(const char32_t *a, const bdn::String &b)
+    If both operands have to be preserved then the result is encoded into a
+   single allocation of the final size. If the left operand is a temporary
+   String (e.g. in a + b + c) then the right operand is appended to it in
+   place.*/
+template <class A, class B, typename std::enable_if<bdn::IsStringConcat_<A, B>::value, int>::type = 0>
+inline bdn::String operator+(A &&a, B &&b)
 {
-    bdn::String result(a);
-    result += b;
-
-    return result;
+    return bdn::concatStrings_(std::forward<A>(a), b, std::is_same<A, bdn::String>());
 }
 
 inline bool operator==(const bdn::String &a, const bdn::String &b) { return a.operator==(b); }
@@ -712,6 +715,40 @@ namespace bdn
         This function causes swapping of strings in standard algorithms like
        std::sort to be more optimized.*/
     inline void swap(bdn::String &a, bdn::String &b) { return a.swap(b); }
+
+    /** Hash function object that ignores differences in case (see
+       String::calcCaseInsensitiveHash()). Can be used together with
+       CaseInsensitiveStringEqual for HashMaps with case insensitive string
+       keys.
+
+        \code
+
+        HashMap<String, int, CaseInsensitiveStringHash, CaseInsensitiveStringEqual> map;
+
+        map["Hello"] = 17;
+
+        // map["HELLO"] is now also 17
+
+        \endcode
+        */
+    struct CaseInsensitiveStringHash
+    {
+        template <class MainDataType> size_t operator()(const StringImpl<MainDataType> &s) const
+        {
+            return s.calcCaseInsensitiveHash();
+        }
+    };
+
+    /** Equality function object that ignores differences in case (see
+       String::equalsIgnoringCase()). See CaseInsensitiveStringHash.*/
+    struct CaseInsensitiveStringEqual
+    {
+        template <class MainDataType>
+        bool operator()(const StringImpl<MainDataType> &a, const StringImpl<MainDataType> &b) const
+        {
+            return a.equalsIgnoringCase(b);
+        }
+    };
 }
 
 namespace std
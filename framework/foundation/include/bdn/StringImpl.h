@@ -12,7 +12,10 @@
 #include <bdn/XxHash64.h>
 #include <bdn/LocaleEncoder.h>
 #include <bdn/LocaleDecoder.h>
+#include <bdn/unicodeUtil.h>
 
+#include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <list>
 #include <locale>
@@ -95,6 +98,92 @@ namespace bdn
         static const size_t toEnd = npos;
     };
 
+    /** Compares encoded Unicode string data without decoding it. Used by
+       StringImpl if both sides use the same encoding. ElementSize is the size
+       of the encoded elements in bytes.
+
+        For UTF-8 and UTF-32 the order of the encoded elements is the same as
+       the order of the code points, so the data can be compared directly. For
+       UTF-16 only the first difference is examined further: surrogates must
+       sort after all other elements, since they encode characters outside of
+       the basic multilingual plane.*/
+    template <size_t ElementSize> struct EncodedStringComparer_
+    {
+        /** Returns the index of the first element that is different in a and
+           b (or \c length if the two are equal).*/
+        template <class Element> static size_t findFirstDifference(const Element *a, const Element *b, size_t length)
+        {
+            // memcmp is usually implemented with SIMD instructions. So we use
+            // it to skip over the equal blocks and only compare the elements
+            // of the block with the difference individually.
+            const size_t blockLength = 64 / sizeof(Element);
+
+            size_t i = 0;
+            while (length - i >= blockLength && std::memcmp(a + i, b + i, blockLength * sizeof(Element)) == 0)
+                i += blockLength;
+
+            while (i < length && a[i] == b[i])
+                i++;
+
+            return i;
+        }
+
+        template <class Element>
+        static int compare(const Element *a, size_t aLength, const Element *b, size_t bLength)
+        {
+            size_t i = findFirstDifference(a, b, std::min(aLength, bLength));
+
+            if (i == aLength || i == bLength)
+                return (aLength == bLength) ? 0 : ((aLength < bLength) ? -1 : 1);
+
+            uint32_t aOrder = getOrder((typename std::make_unsigned<Element>::type)a[i]);
+            uint32_t bOrder = getOrder((typename std::make_unsigned<Element>::type)b[i]);
+
+            return (aOrder < bOrder) ? -1 : 1;
+        }
+
+        template <class Element>
+        static bool equals(const Element *a, size_t aLength, const Element *b, size_t bLength)
+        {
+            return aLength == bLength && std::memcmp(a, b, aLength * sizeof(Element)) == 0;
+        }
+
+      private:
+        static uint32_t getOrder(uint32_t element)
+        {
+            if (ElementSize == 2 && element >= 0xd800)
+                return (element >= 0xe000) ? (element - 0x800) : (element + 0x2000);
+            else
+                return element;
+        }
+    };
+
+    /** Specialization for single byte elements (UTF-8). Here memcmp returns
+     * the correct order directly.*/
+    template <> struct EncodedStringComparer_<1>
+    {
+        template <class Element>
+        static int compare(const Element *a, size_t aLength, const Element *b, size_t bLength)
+        {
+            int result = std::memcmp(a, b, std::min(aLength, bLength));
+            if (result != 0)
+                return (result < 0) ? -1 : 1;
+
+            return (aLength == bLength) ? 0 : ((aLength < bLength) ? -1 : 1);
+        }
+
+        template <class Element>
+        static bool equals(const Element *a, size_t aLength, const Element *b, size_t bLength)
+        {
+            return aLength == bLength && std::memcmp(a, b, aLength) == 0;
+        }
+    };
+
+    template <class MainDataType> class StringReplacerImpl;
+    template <class MainDataType> class StringSplitterImpl;
+    template <class MainDataType> class StringViewImpl;
+    struct StringSplitOptions;
+
     /** Provides an implementation of a String class with the internal encoding
        being controlled by the template parameter MainDataType. MainDataType
        must be a StringData object (or one that provides the same interface)
@@ -639,19 +728,7 @@ namespace bdn
            length (in characters).
 
             */
-        void prepareForSize(size_t reserveChars)
-        {
-            typename MainDataType::EncodedString::difference_type excessCapacityCharacters = reserveChars - length();
-            if (excessCapacityCharacters < 0)
-                excessCapacityCharacters = 0;
-
-            typename MainDataType::EncodedString::difference_type excessCapacityElements =
-                excessCapacityCharacters * MainDataType::Codec::getMaxEncodedElementsPerCharacter();
-
-            Modify m(this);
-
-            m.std->reserve(m.std->length() + excessCapacityElements);
-        }
+        void prepareForSize(size_t reserveChars);
 
         /** Requests that the string object reduces its capacity (see
            capacity()) to fit its size.
@@ -679,29 +756,7 @@ namespace bdn
            additional space for future modifications, with the aim to avoid
            reallocations.
         */
-        size_t capacity() const noexcept
-        {
-            typename MainDataType::EncodedString::difference_type excessCapacityCharacters;
-
-            if (_data->getRefCount() != 1) {
-                // we are sharing the string with someone else. So every
-                // modification will cause us to copy it.
-                // => no excess capacity.
-                excessCapacityCharacters = 0;
-            } else {
-                typename MainDataType::EncodedString *std = &_data->getEncodedString();
-
-                typename MainDataType::EncodedString::difference_type excessCapacity = std->capacity() - std->length();
-                if (excessCapacity < 0)
-                    excessCapacity = 0;
-
-                excessCapacity += std->cend() - _endIt.getInner();
-
-                excessCapacityCharacters = excessCapacity / MainDataType::Codec::getMaxEncodedElementsPerCharacter();
-            }
-
-            return length() + excessCapacityCharacters;
-        }
+        size_t capacity() const noexcept;
 
         /** Returns the maximum size of a string, given a sufficient amount of
            memory. Note that this is the maximum size that can be guaranteed to
@@ -1068,7 +1123,16 @@ namespace bdn
            two strings is shorter and all characters up to that point are the
            same then the shorter string is smaller.
         */
-        int compare(const StringImpl &o) const { return compare(o.begin(), o.end()); }
+        int compare(const StringImpl &o) const
+        {
+            if (isSameSlice(o))
+                return 0;
+
+            // both strings use the same encoding, so we can compare the
+            // encoded data directly.
+            return EncodedStringComparer_<sizeof(EncodedElement)>::compare(
+                getEncodedDataBegin(), getEncodedDataLength(), o.getEncodedDataBegin(), o.getEncodedDataLength());
+        }
 
         /** Compares this string with a character sequence, specified by two
            iterators.
@@ -1128,70 +1192,55 @@ namespace bdn
          */
         int compare(const std::string &o) const
         {
-            return compare(Utf8Codec::DecodingStringIterator(o.begin(), o.begin(), o.end()),
-                           Utf8Codec::DecodingStringIterator(o.end(), o.begin(), o.end()));
+            return compareWithEncoded(Utf8Codec(), o.data(), o.data() + o.length());
         }
 
         /** See compare()
          */
         int compare(const char *other, size_t otherLength = toEnd) const
         {
-            const char *oEnd = getStringEndPtr(other, otherLength);
-
-            return compare(Utf8Codec::DecodingIterator<const char *>(other, other, oEnd),
-                           Utf8Codec::DecodingIterator<const char *>(oEnd, other, oEnd));
+            return compareWithEncoded(Utf8Codec(), other, getStringEndPtr(other, otherLength));
         }
 
         /** See compare()
          */
         int compare(const std::u16string &other) const
         {
-            return compare(Utf16Codec::DecodingStringIterator(other.begin(), other.begin(), other.end()),
-                           Utf16Codec::DecodingStringIterator(other.end(), other.begin(), other.end()));
+            return compareWithEncoded(Utf16Codec(), other.data(), other.data() + other.length());
         }
 
         /** See compare()
          */
         int compare(const char16_t *other, size_t otherLength = toEnd) const
         {
-            const char16_t *oEnd = getStringEndPtr(other, otherLength);
-
-            return compare(Utf16Codec::DecodingIterator<const char16_t *>(other, other, oEnd),
-                           Utf16Codec::DecodingIterator<const char16_t *>(oEnd, other, oEnd));
+            return compareWithEncoded(Utf16Codec(), other, getStringEndPtr(other, otherLength));
         }
 
         /** See compare()
          */
         int compare(const std::u32string &o) const
         {
-            return compare(Utf32Codec::DecodingStringIterator(o.begin(), o.begin(), o.end()),
-                           Utf32Codec::DecodingStringIterator(o.end(), o.begin(), o.end()));
+            return compareWithEncoded(Utf32Codec(), o.data(), o.data() + o.length());
         }
 
         /** See compare()
          */
         int compare(const char32_t *other, size_t otherLength = toEnd) const
         {
-            const char32_t *oEnd = getStringEndPtr(other, otherLength);
-
-            return compare(other, oEnd);
+            return compareWithEncoded(Utf32Codec(), other, getStringEndPtr(other, otherLength));
         }
 
         /** See compare()
          */
         int compare(const std::wstring &o) const
         {
-            return compare(WideCodec::DecodingStringIterator(o.begin(), o.begin(), o.end()),
-                           WideCodec::DecodingStringIterator(o.end(), o.begin(), o.end()));
+            return compareWithEncoded(WideCodec(), o.data(), o.data() + o.length());
         }
 
         /** See compare() */
         int compare(const wchar_t *other, size_t otherLength = toEnd) const
         {
-            const wchar_t *oEnd = getStringEndPtr(other, otherLength);
-
-            return compare(WideCodec::DecodingIterator<const wchar_t *>(other, other, oEnd),
-                           WideCodec::DecodingIterator<const wchar_t *>(oEnd, other, oEnd));
+            return compareWithEncoded(WideCodec(), other, getStringEndPtr(other, otherLength));
         }
 
         int compare(size_t compareStartIndex, size_t compareLength, const StringImpl &other,
@@ -1268,12 +1317,16 @@ namespace bdn
         }
 
         /** Returns true if this string and the specified other string are
-         * equal.*/
-        template <class OTHER> bool operator==(const OTHER &o) const { return compare(o) == 0; }
+            equal.
+
+            Comparing with another StringImpl of the same type is faster than
+           compare(), since strings whose encoded data has a different size
+           cannot be equal.*/
+        template <class OTHER> bool operator==(const OTHER &o) const { return isEqualTo(o); }
 
         /** Returns true if this string and the specified other string are not
          * equal.*/
-        template <class OTHER> bool operator!=(const OTHER &o) const { return compare(o) != 0; }
+        template <class OTHER> bool operator!=(const OTHER &o) const { return !isEqualTo(o); }
 
         /** Returns true if this string is "smaller" than the specified other
          * string. See compare().*/
@@ -1858,51 +1911,7 @@ namespace bdn
 
             Use findAndReplace() instead, if you want to search for and replace
            a certain substring.*/
-        StringImpl &replace(const Iterator &rangeBegin, const Iterator &rangeEnd, size_t numChars, char32_t chr)
-        {
-            typename MainDataType::Codec::template EncodingIterator<const char32_t *> encodedBegin(&chr);
-            typename MainDataType::Codec::template EncodingIterator<const char32_t *> encodedEnd((&chr) + 1);
-
-            // get the size of the encoded character
-            int encodedCharSize = 0;
-            typename MainDataType::EncodedElement lastEncodedElement = 0;
-            for (auto it = encodedBegin; it != encodedEnd; it++) {
-                lastEncodedElement = *it;
-                encodedCharSize++;
-            }
-
-            // we must convert the range to encoded indices because the
-            // iterators can be invalidated by Modify.
-            size_t encodedRangeBeginIndex = rangeBegin.getInner() - _beginIt.getInner();
-            size_t encodedRangeLength = rangeEnd.getInner() - rangeBegin.getInner();
-
-            {
-                Modify m(this);
-
-                if (encodedCharSize == 0 || numChars == 0) {
-                    // we can use erase
-                    m.std->erase(encodedRangeBeginIndex, encodedRangeLength);
-                } else if (encodedCharSize == 1) {
-                    // we can use the std::string version of replace
-                    m.std->replace(encodedRangeBeginIndex, encodedRangeLength, numChars, lastEncodedElement);
-                } else {
-                    // we must insert in a loop.
-                    // to make room we first fill with zero elements.
-
-                    m.std->replace(encodedRangeBeginIndex, encodedRangeLength, numChars * encodedCharSize, 0);
-
-                    auto destIt = m.std->begin() + encodedRangeBeginIndex;
-                    for (size_t c = 0; c < numChars; c++) {
-                        for (auto it = encodedBegin; it != encodedEnd; it++) {
-                            *destIt = *it;
-                            destIt++;
-                        }
-                    }
-                }
-            }
-
-            return *this;
-        }
+        StringImpl &replace(const Iterator &rangeBegin, const Iterator &rangeEnd, size_t numChars, char32_t chr);
 
         /** Replaces a section of this string (defined by a start index and
            length) with \c numChars occurrences of the character \c chr.
@@ -1915,21 +1924,7 @@ namespace bdn
 
             Use findAndReplace() instead, if you want to search for and replace
            a certain substring.*/
-        StringImpl &replace(size_t rangeStartIndex, size_t rangeLength, size_t numChars, char32_t chr)
-        {
-            size_t myLength = getLength();
-
-            if (rangeStartIndex > myLength)
-                throw OutOfRangeError("Invalid start index passed to String::replace");
-
-            Iterator rangeStart(_beginIt + rangeStartIndex);
-
-            Iterator rangeEnd((rangeLength == toEnd || rangeStartIndex + rangeLength >= myLength)
-                                  ? _endIt
-                                  : (rangeStart + rangeLength));
-
-            return replace(rangeStart, rangeEnd, numChars, chr);
-        }
+        StringImpl &replace(size_t rangeStartIndex, size_t rangeLength, size_t numChars, char32_t chr);
 
         /** Appends the specified string to the end of this string \c other.
 
@@ -2680,23 +2675,7 @@ namespace bdn
             If copyStartIndex is bigger than the length of the string then
            OutOfRangeError is thrown.
             */
-        size_t copy(char32_t *dest, size_t maxCopyLength, size_t copyStartIndex = 0) const
-        {
-            if (copyStartIndex < 0 || copyStartIndex > getLength())
-                throw OutOfRangeError("String::copy called with invalid start index.");
-
-            Iterator it = _beginIt + copyStartIndex;
-            for (size_t i = 0; i < maxCopyLength; i++) {
-                if (it == _endIt)
-                    return i;
-
-                dest[i] = *it;
-
-                ++it;
-            }
-
-            return maxCopyLength;
-        }
+        size_t copy(char32_t *dest, size_t maxCopyLength, size_t copyStartIndex = 0) const;
 
         /** Checks if the string contains the character \c toFind.
 
@@ -3211,22 +3190,7 @@ namespace bdn
 
             If \c toFind is empty then searchStartIndex is returned.
         */
-        size_t find(const StringImpl &toFind, size_t searchStartIndex = 0) const noexcept
-        {
-            if (searchStartIndex > getLength())
-                return noMatch;
-
-            if (toFind.isEmpty())
-                return searchStartIndex;
-
-            IteratorWithIndex foundIt =
-                std::search(IteratorWithIndex(_beginIt + searchStartIndex, searchStartIndex),
-                            IteratorWithIndex(_endIt, getLength()), toFind._beginIt, toFind._endIt);
-            if (foundIt.getInner() == _endIt)
-                return noMatch;
-            else
-                return foundIt.getIndex();
-        }
+        size_t find(const StringImpl &toFind, size_t searchStartIndex = 0) const noexcept;
 
         /** Searches for a sequence of encoded characters in this string.
 
@@ -3959,29 +3923,7 @@ namespace bdn
            charToFind, if it is found. Returns end() if \c charToFind is not
            found.
         */
-        Iterator reverseFind(char32_t charToFind, const Iterator &searchStartPosIt) const noexcept
-        {
-            Iterator myIt(searchStartPosIt);
-
-            if (myIt == _endIt) {
-                if (myIt == _beginIt)
-                    return _endIt;
-
-                --myIt;
-            }
-
-            while (true) {
-                if (*myIt == charToFind)
-                    return myIt;
-
-                if (myIt == _beginIt)
-                    break;
-
-                --myIt;
-            }
-
-            return _endIt;
-        }
+        Iterator reverseFind(char32_t charToFind, const Iterator &searchStartPosIt) const noexcept;
 
         /** Searches for the last occurrence of a character in this string.
 
@@ -3994,31 +3936,7 @@ namespace bdn
            found. Returns String::noMatch (String::npos) if \c charToFind is not
            found.
         */
-        size_t reverseFind(char32_t charToFind, size_t searchStartIndex = npos) const noexcept
-        {
-            if (_beginIt == _endIt)
-                return noMatch;
-
-            size_t myLength = length();
-
-            size_t index =
-                (searchStartIndex == npos || searchStartIndex > myLength - 1) ? (myLength - 1) : searchStartIndex;
-
-            Iterator myIt((index == myLength - 1) ? (_endIt - 1) : (_beginIt + index));
-
-            while (true) {
-                if (*myIt == charToFind)
-                    return index;
-
-                if (myIt == _beginIt)
-                    break;
-
-                --myIt;
-                --index;
-            }
-
-            return noMatch;
-        }
+        size_t reverseFind(char32_t charToFind, size_t searchStartIndex = npos) const noexcept;
 
         /** Same as reverseFind(). Included for compatibility with std::string.
          */
@@ -5765,30 +5683,40 @@ namespace bdn
         int findAndReplace(const ToFindIterator &toFindBegin, const ToFindIterator &toFindEnd,
                            const ReplaceWithIterator &replaceWithBegin, const ReplaceWithIterator &replaceWithEnd)
         {
-            int matchCount = 0;
+            if (toFindBegin == toFindEnd)
+                return 0;
 
-            if (toFindBegin != toFindEnd) {
-                Iterator pos = _beginIt;
-                while (pos != _endIt) {
-                    Iterator matchEnd;
-                    Iterator matchBegin = find(toFindBegin, toFindEnd, pos, &matchEnd);
-                    if (matchBegin == _endIt) {
-                        // no more matches.
-                        break;
-                    }
+            Iterator matchEnd;
+            Iterator matchBegin = find(toFindBegin, toFindEnd, _beginIt, &matchEnd);
+            if (matchBegin == _endIt)
+                return 0;
+
+            // the result is built in a new buffer. Replacing the matches in
+            // place would move the remaining data for every match.
+            typedef
+                typename MainDataType::Codec::template EncodingIterator<ReplaceWithIterator> ReplaceEncodingIterator;
 
-                    matchCount++;
+            P<MainDataType> newData = newObj<MainDataType>();
+            typename MainDataType::EncodedString &result = newData->getEncodedString();
+            result.reserve(_endIt.getInner() - _beginIt.getInner());
 
-                    size_t encodedLengthAfterMatch =
-                        _data->getEncodedString().length() - (matchEnd.getInner() - _beginIt.getInner());
+            int matchCount = 0;
+            Iterator pos = _beginIt;
+            while (matchBegin != _endIt) {
+                matchCount++;
 
-                    replace(matchBegin, matchEnd, replaceWithBegin, replaceWithEnd);
+                result.append(pos.getInner(), matchBegin.getInner());
+                result.append(ReplaceEncodingIterator(replaceWithBegin), ReplaceEncodingIterator(replaceWithEnd));
 
-                    size_t replacedEndOffset = _data->getEncodedString().length() - encodedLengthAfterMatch;
+                pos = matchEnd;
+                if (pos == _endIt)
+                    break;
 
-                    pos = Iterator(_beginIt.getInner() + replacedEndOffset, _beginIt.getInner(), _endIt.getInner());
-                }
+                matchBegin = find(toFindBegin, toFindEnd, pos, &matchEnd);
             }
+            result.append(pos.getInner(), _endIt.getInner());
+
+            assign(StringImpl(newData));
 
             return matchCount;
         }
@@ -5824,6 +5752,71 @@ namespace bdn
                                       replaceWithEncodedEnd, replaceWithEncodedBegin, replaceWithEncodedEnd));
         }
 
+        /** Replaces several different strings in a single pass. Each pair
+           contains the string to search for and the string to replace it with.
+
+            Returns the number of occurrences that were replaced.
+
+            This is much faster than calling findAndReplace() for each pair.
+           Replaced parts are not searched again. If strings to find overlap in
+           the data then the one that begins first wins (and if they begin at
+           the same position then the longer one). See StringReplacerImpl for
+           more information.
+
+            If the same replacements are performed often then it is more
+           efficient to create a StringReplacer object once and reuse it.
+
+            Example:
+
+            \code
+            s.findAndReplace({{"%", "%25"}, {"]]", "%5d%5d"}, {":", "%3a"}});
+            \endcode
+            */
+        int findAndReplace(std::initializer_list<std::pair<StringImpl, StringImpl>> replacements)
+        {
+            return StringReplacerImpl<MainDataType>(replacements).findAndReplace(*this);
+        }
+
+        /** Splits the string into fields that are separated by any of the
+           characters in \c delimiters.
+
+            Returns a lazy range of StringViews (see StringSplitterImpl). The
+           fields are only searched for while the range is iterated and they
+           are not copied. Empty fields are included. Use toArray() on the
+           result to get the fields as an array of strings.
+
+            Example:
+
+            \code
+            for (const StringView &field : path.split("/"))
+                ...
+            \endcode
+        */
+        StringSplitterImpl<MainDataType> split(const StringImpl &delimiters) const
+        {
+            return StringSplitterImpl<MainDataType>(*this, delimiters);
+        }
+
+        /** Like split(const StringImpl&), but with additional options for
+           quoted fields, the maximum number of fields and skipping empty
+           fields. See StringSplitOptions.*/
+        StringSplitterImpl<MainDataType> split(const StringImpl &delimiters, const StringSplitOptions &options) const
+        {
+            return StringSplitterImpl<MainDataType>(*this, delimiters, options);
+        }
+
+        /** Splits the string into tokens that are separated by whitespace.
+           Empty tokens are skipped. This is the same as calling split() with
+           getWhitespaceChars() and StringSplitOptions::skipEmptyFields.*/
+        StringSplitterImpl<MainDataType> tokenize() const { return tokenize(getWhitespaceChars()); }
+
+        /** Splits the string into tokens that are separated by any of the
+           characters in \c delimiters. Empty tokens are skipped.*/
+        StringSplitterImpl<MainDataType> tokenize(const StringImpl &delimiters) const
+        {
+            return StringSplitterImpl<MainDataType>::createTokenizer(*this, delimiters);
+        }
+
         /* operator% has been removed for the time being, while it is being
         evaluated whether other alternatives are better (like << plus a string
         buffer replace function).
@@ -6091,7 +6084,22 @@ namespace bdn
 
             \endcode
             */
-        StringImpl splitOffWord() { return splitOffToken(getWhitespaceChars(), false); }
+        StringImpl splitOffWord()
+        {
+            _beginIt = findCustom([](const Iterator &it) { return !isWhitespaceChar(*it); }, _beginIt);
+
+            Iterator wordEndIt = findCustom([](const Iterator &it) { return isWhitespaceChar(*it); }, _beginIt);
+            StringImpl word = subString(_beginIt, wordEndIt);
+
+            _beginIt = wordEndIt;
+            if (_beginIt != _endIt)
+                ++_beginIt;
+
+            _lengthIfKnown = npos;
+            _dataInDifferentEncoding = nullptr;
+
+            return word;
+        }
 
         /** A special iterator for keeping track of the character index
            associated with its current position.
@@ -6378,49 +6386,592 @@ namespace bdn
             Use calcPortableHash() instead if you need a hash that is the same
            everywhere, on all platforms and on all versions of the framework.
             */
-        size_t calcHash() const
-        {
-            // we want this hash calculation to be as fast as possible. So
-            // instead of hashing the decoded characters (like we do in
-            // calcPortableHash) we simply hash the encoded string data as a
-            // binary blob.
-            auto encodedBegin = _beginIt.getInner();
-            auto encodedEnd = _endIt.getInner();
-
-            const typename MainDataType::EncodedElement *encodedData = &*encodedBegin;
-            size_t encodedDataLengthBytes =
-                std::distance(encodedBegin, encodedEnd) * sizeof(typename MainDataType::EncodedElement);
-
-            if (sizeof(size_t) > 4)
-                return (size_t)XxHash64::calcHash(encodedData, encodedDataLengthBytes);
-            else
-                return (size_t)XxHash32::calcHash(encodedData, encodedDataLengthBytes);
-        }
+        size_t calcHash() const;
 
         /** Calculates a hash value from this string. The way this is calculated
             is standardized so that you will always get the same hash for the
            same string, no matter which encoding it uses internally or which
            platform or CPU architecture the program runs on.
             */
-        uint32_t calcPortableHash() const
+        uint32_t calcPortableHash() const;
+
+        /** Returns a copy of the string in which all characters are converted
+           to lower case.
+
+            The full unicode case mappings are used (see mapCharCase()), so the
+           result can have a different length than this string.
+
+            If no character changes then the returned string shares the data
+           with this string. Otherwise the result is built in a single pass.
+           The memory for it is reserved in advance, assuming that the size of
+           the encoded data does not change (which is true for most strings).
+           Runs of ASCII characters are converted in blocks of 8 characters.*/
+        StringImpl toLower() const { return toCaseMapped(CaseMapping::toLower); }
+
+        /** Returns a copy of the string in which all characters are converted
+           to upper case. See toLower() for more information.
+
+            Note that some characters are converted to multiple upper case
+           characters (for example, the German "sharp s" is converted to
+           "SS").*/
+        StringImpl toUpper() const { return toCaseMapped(CaseMapping::toUpper); }
+
+        /** Returns the case folded form of the string (see
+           CaseMapping::fold). Strings that only differ in case have the same
+           case folded form. See toLower() for more information.*/
+        StringImpl toCaseFolded() const { return toCaseMapped(CaseMapping::fold); }
+
+        /** Compares this string with the specified other string, ignoring
+           differences in case. The result has the same meaning as that of
+           compare(). The order is that of the case folded characters (see
+           toCaseFolded()).
+
+            No temporary strings are created. For UTF-8 strings, ASCII parts that
+           are equal are skipped in blocks of 8 characters.*/
+        int compareIgnoringCase(const StringImpl &o) const
+        {
+            if (isSameSlice(o))
+                return 0;
+
+            const EncodedElement *myBegin = getEncodedDataBegin();
+            const EncodedElement *myEnd = myBegin + getEncodedDataLength();
+            const EncodedElement *otherBegin = o.getEncodedDataBegin();
+            const EncodedElement *otherEnd = otherBegin + o.getEncodedDataLength();
+
+            // compare character by character (with ASCII blocks in between),
+            // until the first difference is found. From there on the folded
+            // characters are compared as streams, since characters can be
+            // folded to different numbers of characters (e.g. "ß" and "ss").
+            while (true) {
+                skipEqualAsciiBlocksIgnoringCase(myBegin, myEnd, otherBegin, otherEnd, HasByteElements());
+                if (myBegin == myEnd || otherBegin == otherEnd)
+                    break;
+
+                EncodedDataDecodingIterator myIt(myBegin, myBegin, myEnd);
+                EncodedDataDecodingIterator otherIt(otherBegin, otherBegin, otherEnd);
+
+                char32_t myFolded[maxCharCaseMappingLength];
+                char32_t otherFolded[maxCharCaseMappingLength];
+                int myFoldedLength = mapCharCase(*myIt, CaseMapping::fold, myFolded);
+                int otherFoldedLength = mapCharCase(*otherIt, CaseMapping::fold, otherFolded);
+                if (myFoldedLength != otherFoldedLength ||
+                    !std::equal(myFolded, myFolded + myFoldedLength, otherFolded))
+                    break;
+
+                ++myIt;
+                ++otherIt;
+                myBegin = myIt.getInner();
+                otherBegin = otherIt.getInner();
+            }
+
+            CaseFoldingReader_<EncodedDataDecodingIterator> myReader(
+                EncodedDataDecodingIterator(myBegin, myBegin, myEnd),
+                EncodedDataDecodingIterator(myEnd, myBegin, myEnd));
+            CaseFoldingReader_<EncodedDataDecodingIterator> otherReader(
+                EncodedDataDecodingIterator(otherBegin, otherBegin, otherEnd),
+                EncodedDataDecodingIterator(otherEnd, otherBegin, otherEnd));
+
+            while (true) {
+                char32_t myChr;
+                char32_t otherChr;
+                bool haveMyChr = myReader.next(myChr);
+                bool haveOtherChr = otherReader.next(otherChr);
+
+                if (!haveMyChr)
+                    return haveOtherChr ? -1 : 0;
+                else if (!haveOtherChr)
+                    return 1;
+                else if (myChr != otherChr)
+                    return (myChr < otherChr) ? -1 : 1;
+            }
+        }
+
+        /** Returns true if this string equals the specified other string,
+         * ignoring differences in case. See compareIgnoringCase().*/
+        bool equalsIgnoringCase(const StringImpl &o) const { return compareIgnoringCase(o) == 0; }
+
+        /** Calculates a hash value that is the same for strings that only
+           differ in case (see equalsIgnoringCase()).
+
+            The result is the same as toCaseFolded().calcHash(), but the case
+           folded string is not created. The folded data is generated in small
+           chunks that are fed directly into the hash function.
+
+            Like calcHash(), the hash may depend on the platform and the
+           internally used encoding.*/
+        size_t calcCaseInsensitiveHash() const
+        {
+            const EncodedElement *begin = getEncodedDataBegin();
+            const EncodedElement *end = begin + getEncodedDataLength();
+
+            if (sizeof(size_t) > 4) {
+                CaseFoldedXxHash64DataProvider_ dataProvider(begin, end);
+                return (size_t)XxHash64::calcHashWithDataProvider(dataProvider);
+            } else {
+                CaseFoldedXxHash32DataProvider_ dataProvider(begin, end);
+                return (size_t)XxHash32::calcHashWithDataProvider(dataProvider);
+            }
+        }
+
+        /** Removes whitespace (see getWhitespaceChars()) from the start and
+           the end of the string.
+
+            The string data is not copied. Like subString(), the string simply
+           refers to a smaller part of the same data afterwards.
+
+            Returns a reference to this string.*/
+        StringImpl &trim()
         {
-            // we cannot hash the encoded data here, since the used encoding may
-            // differ on some platforms. We also have to make sure that
-            // endianness is not an issue. And last but not least we have to
-            // ensure that the hash can be represented as a size_t on all
-            // platforms - meaning that the hash should be 32 bit.
+            trimStart();
+            return trimEnd();
+        }
 
-            // We use xxHash32 to calculate the hash. It has the advantage that
-            // it internally treats the data as a stream of 32 bit values - so
-            // we can simply feed it decoded unicode characters. That takes care
-            // of encoding differences and of endianness at the same time.
+        /** Removes whitespace from the start of the string. See trim().*/
+        StringImpl &trimStart()
+        {
+            size_t removedCount = 0;
+            Iterator it = _beginIt;
+            while (it != _endIt && isWhitespaceChar(*it)) {
+                ++it;
+                removedCount++;
+            }
 
-            XxHash32DataProvider_ dataProvider(_beginIt, length());
+            if (removedCount > 0) {
+                _beginIt = it;
+                onTrimmed(removedCount);
+            }
 
-            return XxHash32::calcHashWithDataProvider(dataProvider);
+            return *this;
+        }
+
+        /** Removes whitespace from the end of the string. See trim().*/
+        StringImpl &trimEnd()
+        {
+            size_t removedCount = 0;
+            Iterator it = _endIt;
+            while (it != _beginIt) {
+                Iterator prevIt = it;
+                --prevIt;
+                if (!isWhitespaceChar(*prevIt))
+                    break;
+
+                it = prevIt;
+                removedCount++;
+            }
+
+            if (removedCount > 0) {
+                _endIt = it;
+                onTrimmed(removedCount);
+            }
+
+            return *this;
         }
 
       private:
+        typedef typename MainDataType::EncodedElement EncodedElement;
+        typedef typename MainDataType::EncodedString EncodedString;
+        typedef typename MainDataType::Codec::template DecodingIterator<const EncodedElement *>
+            EncodedDataDecodingIterator;
+
+        // UTF-8 data can be processed in blocks of ASCII characters
+        typedef std::integral_constant<bool, sizeof(EncodedElement) == 1> HasByteElements;
+
+        void onTrimmed(size_t removedCount)
+        {
+            if (_lengthIfKnown != npos)
+                _lengthIfKnown -= removedCount;
+
+            _dataInDifferentEncoding = nullptr;
+        }
+
+        StringImpl toCaseMapped(CaseMapping mapping) const
+        {
+            const EncodedElement *begin = getEncodedDataBegin();
+            const EncodedElement *end = begin + getEncodedDataLength();
+
+            const EncodedElement *changeBegin = findFirstCaseChange(begin, end, mapping, HasByteElements());
+            if (changeBegin == end)
+                return *this;
+
+            P<MainDataType> data = newObj<MainDataType>();
+            EncodedString &result = data->getEncodedString();
+            result.reserve(end - begin);
+
+            result.append(begin, changeBegin);
+            appendCaseMapped(changeBegin, end, mapping, result, HasByteElements());
+
+            return StringImpl(data);
+        }
+
+        static const EncodedElement *findFirstCaseChange(const EncodedElement *begin, const EncodedElement *end,
+                                                         CaseMapping mapping, std::true_type hasByteElements)
+        {
+            const EncodedElement *current = begin;
+            while (current != end) {
+                if (end - current >= AsciiBlock_::size) {
+                    uint64_t block = AsciiBlock_::load(current);
+                    if (AsciiBlock_::isAscii(block) && AsciiBlock_::getCaseMappingMask(block, mapping) == 0) {
+                        current += AsciiBlock_::size;
+                        continue;
+                    }
+                }
+
+                EncodedDataDecodingIterator it(current, current, end);
+                char32_t chr = *it;
+
+                char32_t mapped[maxCharCaseMappingLength];
+                if (mapCharCase(chr, mapping, mapped) != 1 || mapped[0] != chr)
+                    return current;
+
+                ++it;
+                current = it.getInner();
+            }
+
+            return end;
+        }
+
+        static const EncodedElement *findFirstCaseChange(const EncodedElement *begin, const EncodedElement *end,
+                                                         CaseMapping mapping, std::false_type hasByteElements)
+        {
+            EncodedDataDecodingIterator it(begin, begin, end);
+            EncodedDataDecodingIterator endIt(end, begin, end);
+
+            while (it != endIt) {
+                char32_t chr = *it;
+
+                char32_t mapped[maxCharCaseMappingLength];
+                if (mapCharCase(chr, mapping, mapped) != 1 || mapped[0] != chr)
+                    return it.getInner();
+
+                ++it;
+            }
+
+            return end;
+        }
+
+        static void appendCaseMapped(const EncodedElement *begin, const EncodedElement *end, CaseMapping mapping,
+                                     EncodedString &result, std::true_type hasByteElements)
+        {
+            const EncodedElement *current = begin;
+            while (current != end) {
+                if (end - current >= AsciiBlock_::size) {
+                    uint64_t block = AsciiBlock_::load(current);
+                    if (AsciiBlock_::isAscii(block)) {
+                        EncodedElement mappedBlock[AsciiBlock_::size];
+                        AsciiBlock_::store(block ^ AsciiBlock_::getCaseMappingMask(block, mapping), mappedBlock);
+
+                        result.append(mappedBlock, AsciiBlock_::size);
+                        current += AsciiBlock_::size;
+                        continue;
+                    }
+                }
+
+                current = appendCaseMappedChar(current, end, mapping, result);
+            }
+        }
+
+        static void appendCaseMapped(const EncodedElement *begin, const EncodedElement *end, CaseMapping mapping,
+                                     EncodedString &result, std::false_type hasByteElements)
+        {
+            const EncodedElement *current = begin;
+            while (current != end)
+                current = appendCaseMappedChar(current, end, mapping, result);
+        }
+
+        /** Appends the case mapped version of the character at \c current and
+         * returns a pointer to the next character.*/
+        static const EncodedElement *appendCaseMappedChar(const EncodedElement *current, const EncodedElement *end,
+                                                          CaseMapping mapping, EncodedString &result)
+        {
+            char32_t mapped[maxCharCaseMappingLength];
+
+            if (static_cast<uint32_t>(*current) < 0x80) {
+                mapCharCase(static_cast<char32_t>(*current), mapping, mapped);
+                result.push_back(static_cast<EncodedElement>(mapped[0]));
+
+                return current + 1;
+            }
+
+            EncodedDataDecodingIterator it(current, current, end);
+            int mappedLength = mapCharCase(*it, mapping, mapped);
+
+            typedef typename MainDataType::Codec::template EncodingIterator<const char32_t *> MappedEncodingIterator;
+            result.append(MappedEncodingIterator(mapped), MappedEncodingIterator(mapped + mappedLength));
+
+            ++it;
+            return it.getInner();
+        }
+
+        /** Produces the encoded data of the case folded form of a string in
+           chunks, in a fixed size buffer. Used to calculate the case
+           insensitive hash without creating the case folded string.*/
+        class CaseFoldedDataReader_
+        {
+          public:
+            CaseFoldedDataReader_(const EncodedElement *begin, const EncodedElement *end) : _current(begin), _end(end)
+            {}
+
+          protected:
+            /** Copies the next \c blockSize bytes of case folded data to \c
+               block. Returns false if less data than that is left.*/
+            bool readBlock(void *block, size_t blockSize)
+            {
+                if (getBufferedBytes() < blockSize) {
+                    fill();
+                    if (getBufferedBytes() < blockSize)
+                        return false;
+                }
+
+                std::memcpy(block, _buffer + _bufferBegin, blockSize);
+                _bufferBegin += blockSize / sizeof(EncodedElement);
+                return true;
+            }
+
+            /** Copies all remaining data to \c block and returns its size in
+               bytes. Must only be called after readBlock() has returned false
+               (i.e. when less than one block is left).*/
+            size_t readRest(void *block)
+            {
+                size_t bytes = getBufferedBytes();
+                std::memcpy(block, _buffer + _bufferBegin, bytes);
+                _bufferBegin = _bufferEnd;
+                return bytes;
+            }
+
+          private:
+            size_t getBufferedBytes() const { return (_bufferEnd - _bufferBegin) * sizeof(EncodedElement); }
+
+            void fill()
+            {
+                std::memmove(_buffer, _buffer + _bufferBegin, (_bufferEnd - _bufferBegin) * sizeof(EncodedElement));
+                _bufferEnd -= _bufferBegin;
+                _bufferBegin = 0;
+
+                // the case folded form of one character (or of one ASCII
+                // block) always fits into the space that is kept free here.
+                EncodedElement *out = _buffer + _bufferEnd;
+                EncodedElement *outLimit = _buffer + bufferSize - maxChunkSize;
+                while (_current != _end && out <= outLimit)
+                    _current = foldChunk(_current, _end, out, HasByteElements());
+
+                _bufferEnd = out - _buffer;
+            }
+
+            static const EncodedElement *foldChunk(const EncodedElement *current, const EncodedElement *end,
+                                                   EncodedElement *&out, std::true_type hasByteElements)
+            {
+                if (end - current >= AsciiBlock_::size) {
+                    uint64_t block = AsciiBlock_::load(current);
+                    if (AsciiBlock_::isAscii(block)) {
+                        AsciiBlock_::store(block ^ AsciiBlock_::getCaseMappingMask(block, CaseMapping::fold), out);
+                        out += AsciiBlock_::size;
+                        return current + AsciiBlock_::size;
+                    }
+                }
+
+                return foldChunk(current, end, out, std::false_type());
+            }
+
+            static const EncodedElement *foldChunk(const EncodedElement *current, const EncodedElement *end,
+                                                   EncodedElement *&out, std::false_type hasByteElements)
+            {
+                if (static_cast<uint32_t>(*current) < 0x80) {
+                    uint32_t chr = static_cast<uint32_t>(*current);
+                    if (chr >= 'A' && chr <= 'Z')
+                        chr += 0x20;
+                    *out++ = static_cast<EncodedElement>(chr);
+
+                    return current + 1;
+                }
+
+                EncodedDataDecodingIterator it(current, current, end);
+
+                char32_t folded[maxCharCaseMappingLength];
+                int foldedLength = mapCharCase(*it, CaseMapping::fold, folded);
+
+                typedef typename MainDataType::Codec::template EncodingIterator<const char32_t *>
+                    FoldedEncodingIterator;
+                out = std::copy(FoldedEncodingIterator(folded), FoldedEncodingIterator(folded + foldedLength), out);
+
+                ++it;
+                return it.getInner();
+            }
+
+            enum
+            {
+                bufferSize = 512 / sizeof(EncodedElement),
+
+                // each character is encoded with at most 4 elements
+                maxChunkSize = (maxCharCaseMappingLength * 4 > AsciiBlock_::size) ? maxCharCaseMappingLength * 4
+                                                                                   : AsciiBlock_::size
+            };
+
+            const EncodedElement *_current;
+            const EncodedElement *_end;
+
+            EncodedElement _buffer[bufferSize];
+            size_t _bufferBegin = 0;
+            size_t _bufferEnd = 0;
+        };
+
+        /** Data provider for XxHash64 that hashes the case folded form of a
+         * string. See CaseFoldedDataReader_.*/
+        class CaseFoldedXxHash64DataProvider_ : public CaseFoldedDataReader_
+        {
+          public:
+            using CaseFoldedDataReader_::CaseFoldedDataReader_;
+
+            const uint64_t *next4x8ByteBlock()
+            {
+                if (!this->readBlock(_8ByteValues, 32))
+                    return nullptr;
+
+#if BDN_IS_BIG_ENDIAN
+                for (uint64_t &value : _8ByteValues)
+                    swapByteOrder(value);
+#endif
+                return _8ByteValues;
+            }
+
+            XxHash64::TailData getTailData()
+            {
+                size_t bytes = this->readRest(_8ByteValues);
+
+                // see XxHash64::SimpleDataProvider::getTailData
+                uint32_t *p4ByteValue = (uint32_t *)&_8ByteValues[bytes / 8];
+
+#if BDN_IS_BIG_ENDIAN
+                for (size_t i = 0; i < bytes / 8; i++)
+                    swapByteOrder(_8ByteValues[i]);
+                if ((bytes & 7) >= 4)
+                    swapByteOrder(*p4ByteValue);
+#endif
+
+                return XxHash64::TailData{bytes, _8ByteValues, p4ByteValue,
+                                          (const uint8_t *)_8ByteValues + bytes - (bytes & 3)};
+            }
+
+          private:
+            uint64_t _8ByteValues[4];
+        };
+
+        /** Data provider for XxHash32 that hashes the case folded form of a
+         * string. See CaseFoldedDataReader_.*/
+        class CaseFoldedXxHash32DataProvider_ : public CaseFoldedDataReader_
+        {
+          public:
+            using CaseFoldedDataReader_::CaseFoldedDataReader_;
+
+            const uint32_t *next4x4ByteBlock()
+            {
+                if (!this->readBlock(_4ByteValues, 16))
+                    return nullptr;
+
+#if BDN_IS_BIG_ENDIAN
+                for (uint32_t &value : _4ByteValues)
+                    swapByteOrder(value);
+#endif
+                return _4ByteValues;
+            }
+
+            XxHash32::TailData getTailData()
+            {
+                size_t bytes = this->readRest(_4ByteValues);
+
+#if BDN_IS_BIG_ENDIAN
+                for (size_t i = 0; i < bytes / 4; i++)
+                    swapByteOrder(_4ByteValues[i]);
+#endif
+
+                return XxHash32::TailData{bytes, _4ByteValues, (const uint8_t *)_4ByteValues + bytes - (bytes & 3)};
+            }
+
+          private:
+            uint32_t _4ByteValues[4];
+        };
+
+        static void skipEqualAsciiBlocksIgnoringCase(const EncodedElement *&myBegin, const EncodedElement *myEnd,
+                                                     const EncodedElement *&otherBegin, const EncodedElement *otherEnd,
+                                                     std::true_type hasByteElements)
+        {
+            while (myEnd - myBegin >= AsciiBlock_::size && otherEnd - otherBegin >= AsciiBlock_::size) {
+                uint64_t myBlock = AsciiBlock_::load(myBegin);
+                uint64_t otherBlock = AsciiBlock_::load(otherBegin);
+                if (!AsciiBlock_::isAscii(myBlock | otherBlock))
+                    break;
+
+                myBlock ^= AsciiBlock_::getCaseMappingMask(myBlock, CaseMapping::fold);
+                otherBlock ^= AsciiBlock_::getCaseMappingMask(otherBlock, CaseMapping::fold);
+                if (myBlock != otherBlock)
+                    break;
+
+                myBegin += AsciiBlock_::size;
+                otherBegin += AsciiBlock_::size;
+            }
+        }
+
+        static void skipEqualAsciiBlocksIgnoringCase(const EncodedElement *&myBegin, const EncodedElement *myEnd,
+                                                     const EncodedElement *&otherBegin, const EncodedElement *otherEnd,
+                                                     std::false_type hasByteElements)
+        {}
+
+        bool isEqualTo(const StringImpl &o) const
+        {
+            return isSameSlice(o) ||
+                   EncodedStringComparer_<sizeof(EncodedElement)>::equals(getEncodedDataBegin(), getEncodedDataLength(),
+                                                                          o.getEncodedDataBegin(),
+                                                                          o.getEncodedDataLength());
+        }
+
+        template <class OTHER> bool isEqualTo(const OTHER &o) const { return compare(o) == 0; }
+
+        /** Returns true if this string and \c o refer to the same part of the
+         * same string data object.*/
+        bool isSameSlice(const StringImpl &o) const
+        {
+            return _data == o._data && _beginIt == o._beginIt && _endIt == o._endIt;
+        }
+
+        /** Returns a pointer to the first encoded element of this string.
+            The pointer is derived from data() instead of dereferencing the
+            begin iterator, since that iterator is the end iterator of the
+            encoded string if this string is empty.*/
+        const EncodedElement *getEncodedDataBegin() const
+        {
+            const typename MainDataType::EncodedString &encodedString = _data->getEncodedString();
+
+            return encodedString.data() + (_beginIt.getInner() - encodedString.cbegin());
+        }
+
+        size_t getEncodedDataLength() const { return _endIt.getInner() - _beginIt.getInner(); }
+
+        template <class OtherCodec>
+        int compareWithEncoded(const OtherCodec &otherCodec, const typename OtherCodec::EncodedElement *otherBegin,
+                               const typename OtherCodec::EncodedElement *otherEnd) const
+        {
+            return compareWithEncoded(otherCodec, otherBegin, otherEnd,
+                                      std::is_same<OtherCodec, typename MainDataType::Codec>());
+        }
+
+        template <class OtherCodec>
+        int compareWithEncoded(const OtherCodec &otherCodec, const typename OtherCodec::EncodedElement *otherBegin,
+                               const typename OtherCodec::EncodedElement *otherEnd, std::true_type sameCodec) const
+        {
+            return EncodedStringComparer_<sizeof(EncodedElement)>::compare(
+                getEncodedDataBegin(), getEncodedDataLength(), otherBegin, otherEnd - otherBegin);
+        }
+
+        template <class OtherCodec>
+        int compareWithEncoded(const OtherCodec &otherCodec, const typename OtherCodec::EncodedElement *otherBegin,
+                               const typename OtherCodec::EncodedElement *otherEnd, std::false_type sameCodec) const
+        {
+            typedef typename OtherCodec::template DecodingIterator<const typename OtherCodec::EncodedElement *>
+                OtherDecodingIterator;
+
+            return compare(OtherDecodingIterator(otherBegin, otherBegin, otherEnd),
+                           OtherDecodingIterator(otherEnd, otherBegin, otherEnd));
+        }
+
         class XxHash32DataProvider_
         {
           public:
@@ -6464,6 +7015,8 @@ namespace bdn
             uint32_t _4CharBlock[4];
         };
         friend class XxHash32;
+        friend class StringSplitterImpl<MainDataType>;
+        friend class StringViewImpl<MainDataType>;
 
         template <class T> const typename T::EncodedString &getEncoded(T *dummy) const
         {
@@ -6625,6 +7178,245 @@ namespace bdn
         mutable size_t _lengthIfKnown;
     };
 
+    // Members that are defined outside the class, so that they are only compiled once for the
+    // explicitly instantiated string types (see the extern template declarations below).
+
+    template <class MainDataType>
+    size_t StringImpl<MainDataType>::capacity() const noexcept
+    {
+        typename MainDataType::EncodedString::difference_type excessCapacityCharacters;
+
+        if (_data->getRefCount() != 1) {
+            // we are sharing the string with someone else. So every
+            // modification will cause us to copy it.
+            // => no excess capacity.
+            excessCapacityCharacters = 0;
+        } else {
+            typename MainDataType::EncodedString *std = &_data->getEncodedString();
+
+            typename MainDataType::EncodedString::difference_type excessCapacity = std->capacity() - std->length();
+            if (excessCapacity < 0)
+                excessCapacity = 0;
+
+            excessCapacity += std->cend() - _endIt.getInner();
+
+            excessCapacityCharacters = excessCapacity / MainDataType::Codec::getMaxEncodedElementsPerCharacter();
+        }
+
+        return length() + excessCapacityCharacters;
+    }
+
+    template <class MainDataType>
+    void StringImpl<MainDataType>::prepareForSize(size_t reserveChars)
+    {
+        typename MainDataType::EncodedString::difference_type excessCapacityCharacters = reserveChars - length();
+        if (excessCapacityCharacters < 0)
+            excessCapacityCharacters = 0;
+
+        typename MainDataType::EncodedString::difference_type excessCapacityElements =
+            excessCapacityCharacters * MainDataType::Codec::getMaxEncodedElementsPerCharacter();
+
+        Modify m(this);
+
+        m.std->reserve(m.std->length() + excessCapacityElements);
+    }
+
+    template <class MainDataType>
+    StringImpl<MainDataType> &StringImpl<MainDataType>::replace(const Iterator &rangeBegin, const Iterator &rangeEnd,
+                                                                size_t numChars, char32_t chr)
+    {
+        typename MainDataType::Codec::template EncodingIterator<const char32_t *> encodedBegin(&chr);
+        typename MainDataType::Codec::template EncodingIterator<const char32_t *> encodedEnd((&chr) + 1);
+
+        // get the size of the encoded character
+        int encodedCharSize = 0;
+        typename MainDataType::EncodedElement lastEncodedElement = 0;
+        for (auto it = encodedBegin; it != encodedEnd; it++) {
+            lastEncodedElement = *it;
+            encodedCharSize++;
+        }
+
+        // we must convert the range to encoded indices because the
+        // iterators can be invalidated by Modify.
+        size_t encodedRangeBeginIndex = rangeBegin.getInner() - _beginIt.getInner();
+        size_t encodedRangeLength = rangeEnd.getInner() - rangeBegin.getInner();
+
+        {
+            Modify m(this);
+
+            if (encodedCharSize == 0 || numChars == 0) {
+                // we can use erase
+                m.std->erase(encodedRangeBeginIndex, encodedRangeLength);
+            } else if (encodedCharSize == 1) {
+                // we can use the std::string version of replace
+                m.std->replace(encodedRangeBeginIndex, encodedRangeLength, numChars, lastEncodedElement);
+            } else {
+                // we must insert in a loop.
+                // to make room we first fill with zero elements.
+
+                m.std->replace(encodedRangeBeginIndex, encodedRangeLength, numChars * encodedCharSize, 0);
+
+                auto destIt = m.std->begin() + encodedRangeBeginIndex;
+                for (size_t c = 0; c < numChars; c++) {
+                    for (auto it = encodedBegin; it != encodedEnd; it++) {
+                        *destIt = *it;
+                        destIt++;
+                    }
+                }
+            }
+        }
+
+        return *this;
+    }
+
+    template <class MainDataType>
+    StringImpl<MainDataType> &StringImpl<MainDataType>::replace(size_t rangeStartIndex, size_t rangeLength,
+                                                                size_t numChars, char32_t chr)
+    {
+        size_t myLength = getLength();
+
+        if (rangeStartIndex > myLength)
+            throw OutOfRangeError("Invalid start index passed to String::replace");
+
+        Iterator rangeStart(_beginIt + rangeStartIndex);
+
+        Iterator rangeEnd((rangeLength == toEnd || rangeStartIndex + rangeLength >= myLength)
+                              ? _endIt
+                              : (rangeStart + rangeLength));
+
+        return replace(rangeStart, rangeEnd, numChars, chr);
+    }
+
+    template <class MainDataType>
+    size_t StringImpl<MainDataType>::copy(char32_t *dest, size_t maxCopyLength, size_t copyStartIndex) const
+    {
+        if (copyStartIndex < 0 || copyStartIndex > getLength())
+            throw OutOfRangeError("String::copy called with invalid start index.");
+
+        Iterator it = _beginIt + copyStartIndex;
+        for (size_t i = 0; i < maxCopyLength; i++) {
+            if (it == _endIt)
+                return i;
+
+            dest[i] = *it;
+
+            ++it;
+        }
+
+        return maxCopyLength;
+    }
+
+    template <class MainDataType>
+    size_t StringImpl<MainDataType>::find(const StringImpl &toFind, size_t searchStartIndex) const noexcept
+    {
+        if (searchStartIndex > getLength())
+            return noMatch;
+
+        if (toFind.isEmpty())
+            return searchStartIndex;
+
+        IteratorWithIndex foundIt =
+            std::search(IteratorWithIndex(_beginIt + searchStartIndex, searchStartIndex),
+                        IteratorWithIndex(_endIt, getLength()), toFind._beginIt, toFind._endIt);
+        if (foundIt.getInner() == _endIt)
+            return noMatch;
+        else
+            return foundIt.getIndex();
+    }
+
+    template <class MainDataType>
+    typename StringImpl<MainDataType>::Iterator
+    StringImpl<MainDataType>::reverseFind(char32_t charToFind, const Iterator &searchStartPosIt) const noexcept
+    {
+        Iterator myIt(searchStartPosIt);
+
+        if (myIt == _endIt) {
+            if (myIt == _beginIt)
+                return _endIt;
+
+            --myIt;
+        }
+
+        while (true) {
+            if (*myIt == charToFind)
+                return myIt;
+
+            if (myIt == _beginIt)
+                break;
+
+            --myIt;
+        }
+
+        return _endIt;
+    }
+
+    template <class MainDataType>
+    size_t StringImpl<MainDataType>::reverseFind(char32_t charToFind, size_t searchStartIndex) const noexcept
+    {
+        if (_beginIt == _endIt)
+            return noMatch;
+
+        size_t myLength = length();
+
+        size_t index =
+            (searchStartIndex == npos || searchStartIndex > myLength - 1) ? (myLength - 1) : searchStartIndex;
+
+        Iterator myIt((index == myLength - 1) ? (_endIt - 1) : (_beginIt + index));
+
+        while (true) {
+            if (*myIt == charToFind)
+                return index;
+
+            if (myIt == _beginIt)
+                break;
+
+            --myIt;
+            --index;
+        }
+
+        return noMatch;
+    }
+
+    template <class MainDataType>
+    size_t StringImpl<MainDataType>::calcHash() const
+    {
+        // we want this hash calculation to be as fast as possible. So
+        // instead of hashing the decoded characters (like we do in
+        // calcPortableHash) we simply hash the encoded string data as a
+        // binary blob.
+        const typename MainDataType::EncodedElement *encodedData = getEncodedDataBegin();
+        size_t encodedDataLengthBytes = getEncodedDataLength() * sizeof(typename MainDataType::EncodedElement);
+
+        if (sizeof(size_t) > 4)
+            return (size_t)XxHash64::calcHash(encodedData, encodedDataLengthBytes);
+        else
+            return (size_t)XxHash32::calcHash(encodedData, encodedDataLengthBytes);
+    }
+
+    template <class MainDataType>
+    uint32_t StringImpl<MainDataType>::calcPortableHash() const
+    {
+        // we cannot hash the encoded data here, since the used encoding may
+        // differ on some platforms. We also have to make sure that
+        // endianness is not an issue. And last but not least we have to
+        // ensure that the hash can be represented as a size_t on all
+        // platforms - meaning that the hash should be 32 bit.
+
+        // We use xxHash32 to calculate the hash. It has the advantage that
+        // it internally treats the data as a stream of 32 bit values - so
+        // we can simply feed it decoded unicode characters. That takes care
+        // of encoding differences and of endianness at the same time.
+
+        XxHash32DataProvider_ dataProvider(_beginIt, length());
+
+        return XxHash32::calcHashWithDataProvider(dataProvider);
+    }
+
+    extern template class StringImpl<Utf8StringData>;
+    extern template class StringImpl<Utf16StringData>;
+    extern template class StringImpl<Utf32StringData>;
+    extern template class StringImpl<WideStringData>;
+
     template <typename CHAR_TYPE> struct StringImplStreamWriterImpl_;
 
     template <> struct StringImplStreamWriterImpl_<char32_t>
@@ -6695,4 +7487,8 @@ namespace bdn
     }
 }
 
+// the replacer and the splitter need the complete StringImpl class
+#include <bdn/StringReplacer.h>
+#include <bdn/StringSplitter.h>
+
 #endif
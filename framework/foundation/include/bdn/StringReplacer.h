@@ -0,0 +1,153 @@
+#ifndef BDN_StringReplacer_H_
+#define BDN_StringReplacer_H_
+
+#include <bdn/StringImpl.h>
+#include <bdn/NativeStringData.h>
+#include <bdn/MultiPatternMatcher.h>
+
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace bdn
+{
+
+    /** Replaces occurrences of several different strings in a single pass.
+
+        StringReplacerImpl is usually not used directly. Use the typedef
+       StringReplacer instead.
+
+        The replacer is constructed with a list of pairs. The first value of
+       each pair is the string to search for, the second the string to replace
+       it with. findAndReplace() then scans the string once and builds the
+       result once. That is much faster than calling String::findAndReplace()
+       once for each pair, especially when several replacements are needed
+       (e.g. for escaping special characters).
+
+        Note that replaced parts are not searched again. And if two strings to
+       search for overlap in the input data then the one that begins first
+       wins. If they begin at the same position then the longer one wins. For
+       example, the replacer {{"%", "%25"}, {":", "%3a"}} turns "a:%" into
+       "a%3a%25". Calling findAndReplace on the string for each pair separately
+       would only have the same result if the pairs were processed in the
+       correct order.
+
+        Creating a replacer involves some preparation work. So if the same
+       replacements are used many times then the replacer object should be
+       kept and reused. A replacer object cannot be modified after it was
+       constructed, so it can be used by multiple threads at the same time.
+
+        Example:
+
+        \code
+
+        static const StringReplacer escaper{{"&", "&amp;"}, {"<", "&lt;"}, {">", "&gt;"}};
+
+        String s = "a < b & c";
+        escaper.findAndReplace(s);
+
+        // s now equals "a &lt; b &amp; c"
+
+        \endcode
+    */
+    template <class MainDataType> class StringReplacerImpl
+    {
+      public:
+        typedef StringImpl<MainDataType> StringType;
+        typedef std::pair<StringType, StringType> Replacement;
+        typedef std::vector<Replacement> Replacements;
+
+        StringReplacerImpl(std::initializer_list<Replacement> replacements)
+            : StringReplacerImpl(replacements.begin(), replacements.end())
+        {}
+
+        StringReplacerImpl(const Replacements &replacements)
+            : StringReplacerImpl(replacements.begin(), replacements.end())
+        {}
+
+        /** Searches for all occurrences of the strings to find and replaces
+           them with the corresponding replacement.
+
+            Returns the number of occurrences that were replaced. If nothing was
+           found then the string is not modified at all.*/
+        int findAndReplace(StringType &s) const
+        {
+            typename EncodedString::const_iterator innerBegin = s.begin().getInner();
+            typename EncodedString::const_iterator innerEnd = s.end().getInner();
+            if (innerBegin == innerEnd)
+                return 0;
+
+            const EncodedElement *begin = &*innerBegin;
+            const EncodedElement *end = begin + (innerEnd - innerBegin);
+
+            const EncodedElement *matchEnd;
+            int patternIndex;
+            const EncodedElement *matchBegin = _matcher.findNext(begin, end, matchEnd, patternIndex);
+            if (matchBegin == end)
+                return 0;
+
+            P<MainDataType> data = newObj<MainDataType>();
+            EncodedString &result = data->getEncodedString();
+            result.reserve(end - begin);
+
+            int matchCount = 0;
+            const EncodedElement *current = begin;
+            while (matchBegin != end) {
+                matchCount++;
+
+                result.append(current, matchBegin);
+                result.append(_replaceWith[patternIndex]);
+
+                current = matchEnd;
+                matchBegin = _matcher.findNext(current, end, matchEnd, patternIndex);
+            }
+            result.append(current, end);
+
+            s = StringType(data);
+
+            return matchCount;
+        }
+
+        /** Returns a copy of \c s in which all occurrences of the strings to
+         * find are replaced. See findAndReplace().*/
+        StringType getReplaced(const StringType &s) const
+        {
+            StringType result(s);
+            findAndReplace(result);
+
+            return result;
+        }
+
+      private:
+        typedef typename MainDataType::EncodedString EncodedString;
+        typedef typename MainDataType::EncodedElement EncodedElement;
+
+        template <class Iterator>
+        StringReplacerImpl(Iterator begin, Iterator end)
+            : _matcher(getEncodedStrings(begin, end, &Replacement::first)),
+              _replaceWith(getEncodedStrings(begin, end, &Replacement::second))
+        {}
+
+        template <class Iterator>
+        static std::vector<EncodedString> getEncodedStrings(Iterator begin, Iterator end,
+                                                            StringType Replacement::*member)
+        {
+            std::vector<EncodedString> result;
+            for (Iterator it = begin; it != end; ++it) {
+                const StringType &s = (*it).*member;
+                result.emplace_back(s.begin().getInner(), s.end().getInner());
+            }
+
+            return result;
+        }
+
+        MultiPatternMatcher<EncodedElement> _matcher;
+        std::vector<EncodedString> _replaceWith;
+    };
+
+    /** Replaces occurrences of several different strings in a single pass.
+     * See StringReplacerImpl.*/
+    typedef StringReplacerImpl<NativeStringData> StringReplacer;
+}
+
+#endif
@@ -0,0 +1,354 @@
+#ifndef BDN_StringSplitter_H_
+#define BDN_StringSplitter_H_
+
+#include <bdn/StringImpl.h>
+#include <bdn/StringView.h>
+#include <bdn/NativeStringData.h>
+#include <bdn/Array.h>
+
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace bdn
+{
+
+    /** Options for StringImpl::split() and StringSplitterImpl.*/
+    struct StringSplitOptions
+    {
+        /** If this is not 0 then fields can be enclosed in this quote
+           character. Delimiters inside quotes do not end the field. If a field
+           begins and ends with the quote character then the quotes are removed
+           from the returned field.
+
+            Note that the fields are views of the original data, so quote
+           characters inside the field are NOT unescaped. A field "a""b" is
+           returned as a""b.*/
+        char32_t quoteChar = 0;
+
+        /** If this is not 0 then at most this number of fields is returned. The
+           last field contains the rest of the string (including any
+           delimiters).*/
+        size_t maxFieldCount = 0;
+
+        /** If true then empty fields are skipped. That means that multiple
+           consecutive delimiters are treated like a single one, and that
+           delimiters at the beginning and the end of the string are
+           ignored.*/
+        bool skipEmptyFields = false;
+    };
+
+    /** Splits a string into fields that are separated by delimiter characters.
+
+        StringSplitterImpl is usually not used directly. Use the typedef
+       StringSplitter, or the StringImpl::split() and StringImpl::tokenize()
+       functions instead.
+
+        The splitter is a lazy range: the fields are only searched for while
+       the splitter is iterated. Each field is returned as a StringView of the
+       original string data, so no data is copied and no memory is allocated.
+       The views remain valid as long as the splitter object exists (the
+       splitter keeps the string data alive).
+
+        If the fields need to be stored then toArray() can be used. It returns
+       String objects that share the data of the original string.
+
+        Example:
+
+        \code
+
+        String line = "name,\"Doe, John\",42";
+
+        StringSplitOptions options;
+        options.quoteChar = '"';
+
+        for (const StringView &field : line.split(",", options)) {
+            // the fields are: name, Doe, John and 42
+        }
+
+        \endcode
+    */
+    template <class MainDataType> class StringSplitterImpl
+    {
+      public:
+        typedef StringImpl<MainDataType> StringType;
+        typedef StringViewImpl<MainDataType> ViewType;
+        typedef typename MainDataType::EncodedElement EncodedElement;
+
+        /** Forward iterator that returns the fields of the string as
+         * StringViews.*/
+        class Iterator
+        {
+          public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = ViewType;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const ViewType *;
+            using reference = const ViewType &;
+
+            /** Constructs an end iterator.*/
+            Iterator() : _splitter(nullptr), _next(nullptr), _fieldIndex(0) {}
+
+            Iterator(const StringSplitterImpl *splitter) : _splitter(splitter), _next(splitter->_begin), _fieldIndex(0)
+            {
+                findField();
+            }
+
+            const ViewType &operator*() const { return _field; }
+
+            const ViewType *operator->() const { return &_field; }
+
+            Iterator &operator++()
+            {
+                _fieldIndex++;
+                findField();
+
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator oldVal = *this;
+                operator++();
+
+                return oldVal;
+            }
+
+            bool operator==(const Iterator &o) const
+            {
+                return _splitter == o._splitter && (_splitter == nullptr || _fieldIndex == o._fieldIndex);
+            }
+
+            bool operator!=(const Iterator &o) const { return !operator==(o); }
+
+          private:
+            void findField()
+            {
+                // _next is null if the last field was already returned
+                if (_next == nullptr) {
+                    _splitter = nullptr;
+                    return;
+                }
+
+                const EncodedElement *fieldBegin = _next;
+                if (_splitter->_options.skipEmptyFields) {
+                    fieldBegin = _splitter->skipDelimiters(fieldBegin);
+                    if (fieldBegin == _splitter->_end) {
+                        _splitter = nullptr;
+                        return;
+                    }
+                }
+
+                size_t maxFieldCount = _splitter->_options.maxFieldCount;
+                if (maxFieldCount != 0 && _fieldIndex + 1 >= maxFieldCount) {
+                    _field = _splitter->makeField(fieldBegin, _splitter->_end, StringType::npos);
+                    _next = nullptr;
+                } else {
+                    const EncodedElement *delimiterEnd;
+                    size_t charCount;
+                    const EncodedElement *fieldEnd = _splitter->findDelimiter(fieldBegin, delimiterEnd, charCount);
+
+                    _field = _splitter->makeField(fieldBegin, fieldEnd, charCount);
+                    _next = (fieldEnd == _splitter->_end) ? nullptr : delimiterEnd;
+                }
+            }
+
+            const StringSplitterImpl *_splitter;
+            const EncodedElement *_next;
+            size_t _fieldIndex;
+            ViewType _field;
+        };
+
+        /** Prepares splitting \c source at all characters that are contained
+         * in \c delimiters.*/
+        StringSplitterImpl(const StringType &source, const StringType &delimiters,
+                           const StringSplitOptions &options = StringSplitOptions())
+            : _source(source), _options(options),
+              _quoteChar((options.quoteChar != 0) ? options.quoteChar : noQuoteChar)
+        {
+            ViewType sourceView(_source);
+            _begin = sourceView.getEncodedBegin();
+            _end = sourceView.getEncodedEnd();
+
+            _asciiDelimiterBits[0] = 0;
+            _asciiDelimiterBits[1] = 0;
+            for (char32_t chr : delimiters) {
+                if (chr < 0x80)
+                    _asciiDelimiterBits[chr >> 6] |= uint64_t(1) << (chr & 63);
+                else
+                    _nonAsciiDelimiters.push_back(chr);
+            }
+            std::sort(_nonAsciiDelimiters.begin(), _nonAsciiDelimiters.end());
+        }
+
+        /** Creates a splitter that splits \c source into tokens that are
+           separated by any of the characters in \c delimiters. Empty tokens
+           are skipped.*/
+        static StringSplitterImpl createTokenizer(const StringType &source, const StringType &delimiters)
+        {
+            StringSplitOptions options;
+            options.skipEmptyFields = true;
+
+            return StringSplitterImpl(source, delimiters, options);
+        }
+
+        /** Returns an iterator to the first field.*/
+        Iterator begin() const { return Iterator(this); }
+
+        /** Returns the end iterator.*/
+        Iterator end() const { return Iterator(); }
+
+        /** Returns the number of fields. Note that this iterates over all
+         * fields.*/
+        size_t getFieldCount() const
+        {
+            size_t count = 0;
+            for (Iterator it = begin(); it != end(); ++it)
+                count++;
+
+            return count;
+        }
+
+        /** Returns an array with all fields. The array is allocated with the
+           final size in advance. The returned strings share the data of the
+           source string.*/
+        Array<StringType> toArray() const
+        {
+            Array<StringType> result;
+            result.prepareForSize(getFieldCount());
+
+            auto sourceInnerBegin = _source.begin().getInner();
+            auto sourceInnerEnd = _source.end().getInner();
+
+            for (const ViewType &field : *this) {
+                typename StringType::Iterator beginIt(sourceInnerBegin + (field.getEncodedBegin() - _begin),
+                                                      sourceInnerBegin, sourceInnerEnd);
+                typename StringType::Iterator endIt(sourceInnerBegin + (field.getEncodedEnd() - _begin),
+                                                    sourceInnerBegin, sourceInnerEnd);
+
+                StringType fieldString(_source, beginIt, endIt);
+                fieldString._lengthIfKnown = field._lengthIfKnown;
+
+                result.add(std::move(fieldString));
+            }
+
+            return result;
+        }
+
+        /** Returns the string that is split.*/
+        const StringType &getSource() const { return _source; }
+
+      private:
+        typedef typename MainDataType::Codec::template DecodingIterator<const EncodedElement *> DecodingIterator;
+        typedef typename std::make_unsigned<EncodedElement>::type UnsignedElement;
+
+        // a value that no decoded character can have
+        static const char32_t noQuoteChar = 0xffffffff;
+
+        /** Reads the character at \c p and returns the position after it.*/
+        const EncodedElement *readChar(const EncodedElement *p, char32_t &chr) const
+        {
+            UnsignedElement element = static_cast<UnsignedElement>(*p);
+            if (element < 0x80) {
+                chr = element;
+                return p + 1;
+            }
+
+            DecodingIterator it(p, p, _end);
+            chr = *it;
+            ++it;
+
+            return it.getInner();
+        }
+
+        bool isDelimiter(char32_t chr) const
+        {
+            if (chr < 0x80)
+                return ((_asciiDelimiterBits[chr >> 6] >> (chr & 63)) & 1) != 0;
+            else
+                return std::binary_search(_nonAsciiDelimiters.begin(), _nonAsciiDelimiters.end(), chr);
+        }
+
+        /** Returns the position of the next delimiter that is not inside
+           quotes (or _end if there is none). The position after the delimiter
+           is stored in \c delimiterEnd and the number of characters before it
+           in \c charCount.*/
+        const EncodedElement *findDelimiter(const EncodedElement *p, const EncodedElement *&delimiterEnd,
+                                            size_t &charCount) const
+        {
+            bool inQuotes = false;
+            size_t count = 0;
+            while (p != _end) {
+                char32_t chr;
+                const EncodedElement *next = readChar(p, chr);
+
+                if (chr == _quoteChar)
+                    inQuotes = !inQuotes;
+                else if (!inQuotes && isDelimiter(chr)) {
+                    delimiterEnd = next;
+                    charCount = count;
+                    return p;
+                }
+
+                count++;
+                p = next;
+            }
+
+            delimiterEnd = _end;
+            charCount = count;
+            return _end;
+        }
+
+        const EncodedElement *skipDelimiters(const EncodedElement *p) const
+        {
+            while (p != _end) {
+                char32_t chr;
+                const EncodedElement *next = readChar(p, chr);
+                if (!isDelimiter(chr) || chr == _quoteChar)
+                    break;
+
+                p = next;
+            }
+
+            return p;
+        }
+
+        ViewType makeField(const EncodedElement *begin, const EncodedElement *end, size_t charCount) const
+        {
+            if (_quoteChar != noQuoteChar && begin != end) {
+                char32_t firstChr;
+                const EncodedElement *afterFirst = readChar(begin, firstChr);
+
+                DecodingIterator lastIt(end, begin, end);
+                --lastIt;
+
+                if (firstChr == _quoteChar && *lastIt == _quoteChar && lastIt.getInner() != begin) {
+                    if (charCount != StringType::npos)
+                        charCount -= 2;
+
+                    return ViewType(afterFirst, lastIt.getInner(), charCount);
+                }
+            }
+
+            return ViewType(begin, end, charCount);
+        }
+
+        StringType _source;
+        StringSplitOptions _options;
+        char32_t _quoteChar;
+
+        const EncodedElement *_begin;
+        const EncodedElement *_end;
+
+        uint64_t _asciiDelimiterBits[2];
+        std::vector<char32_t> _nonAsciiDelimiters;
+    };
+
+    template <class MainDataType> const char32_t StringSplitterImpl<MainDataType>::noQuoteChar;
+
+    /** Splits a String into fields. See StringSplitterImpl.*/
+    typedef StringSplitterImpl<NativeStringData> StringSplitter;
+}
+
+#endif
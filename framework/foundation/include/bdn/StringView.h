@@ -0,0 +1,128 @@
+#ifndef BDN_StringView_H_
+#define BDN_StringView_H_
+
+#include <bdn/StringImpl.h>
+#include <bdn/NativeStringData.h>
+
+namespace bdn
+{
+
+    template <class MainDataType> class StringSplitterImpl;
+
+    /** A read-only view of a part of the encoded data of a string.
+
+        StringViewImpl is usually not used directly. Use the typedef StringView
+       instead.
+
+        A view only consists of two pointers into the encoded data of a string
+       (plus the character count, if it is known). Creating and copying it is
+       very cheap: there is no memory allocation and no reference counting.
+
+        The view does NOT keep the data alive. The string that the view refers
+       to must continue to exist (and must not be modified) while the view is
+       used. Use toString() to get an independent String object with the same
+       contents.
+
+        Views are returned by StringImpl::split() and StringImpl::tokenize().
+    */
+    template <class MainDataType> class StringViewImpl
+    {
+      public:
+        typedef StringImpl<MainDataType> StringType;
+        typedef typename MainDataType::EncodedElement EncodedElement;
+
+        /** Type of the character iterators of the view. The iterators return
+         * the decoded unicode characters (char32_t).*/
+        typedef typename MainDataType::Codec::template DecodingIterator<const EncodedElement *> Iterator;
+
+        /** Constructs an empty view.*/
+        StringViewImpl() : _begin(nullptr), _end(nullptr), _lengthIfKnown(0) {}
+
+        /** Constructs a view of the encoded data between \c begin and \c end.
+           \c lengthIfKnown is the number of characters in the data, or
+           StringType::npos if that is not known.*/
+        StringViewImpl(const EncodedElement *begin, const EncodedElement *end,
+                       size_t lengthIfKnown = StringType::npos)
+            : _begin(begin), _end(end), _lengthIfKnown(lengthIfKnown)
+        {}
+
+        /** Constructs a view of the whole string \c s.*/
+        StringViewImpl(const StringType &s)
+            : _begin(s.getEncodedDataBegin()), _end(_begin + s.getEncodedDataLength()), _lengthIfKnown(s._lengthIfKnown)
+        {}
+
+        /** Returns an iterator to the first character of the view.*/
+        Iterator begin() const { return Iterator(_begin, _begin, _end); }
+
+        /** Returns an iterator to the position after the last character of
+         * the view.*/
+        Iterator end() const { return Iterator(_end, _begin, _end); }
+
+        /** Returns true if the view is empty.*/
+        bool isEmpty() const { return _begin == _end; }
+
+        /** Returns the number of characters in the view. If the number is not
+           known yet then the characters are counted (and the result is
+           remembered).*/
+        size_t getLength() const
+        {
+            if (_lengthIfKnown == StringType::npos) {
+                size_t length = 0;
+                for (Iterator it = begin(); it != end(); ++it)
+                    length++;
+
+                _lengthIfKnown = length;
+            }
+
+            return _lengthIfKnown;
+        }
+
+        /** Returns a pointer to the first encoded element of the view.*/
+        const EncodedElement *getEncodedBegin() const { return _begin; }
+
+        /** Returns a pointer to the position after the last encoded element of
+         * the view.*/
+        const EncodedElement *getEncodedEnd() const { return _end; }
+
+        /** Returns the number of encoded elements in the view.*/
+        size_t getEncodedLength() const { return _end - _begin; }
+
+        /** Returns a String object with a copy of the viewed data.*/
+        StringType toString() const
+        {
+            P<MainDataType> data = newObj<MainDataType>();
+            data->getEncodedString().assign(_begin, _end);
+
+            StringType result(data);
+            result._lengthIfKnown = _lengthIfKnown;
+
+            return result;
+        }
+
+        /** Returns true if the view has the same contents as \c o.*/
+        bool operator==(const StringViewImpl &o) const
+        {
+            return EncodedStringComparer_<sizeof(EncodedElement)>::equals(_begin, getEncodedLength(), o._begin,
+                                                                          o.getEncodedLength());
+        }
+
+        /** Returns true if the view has the same contents as the string \c s.*/
+        bool operator==(const StringType &s) const { return operator==(StringViewImpl(s)); }
+
+        bool operator!=(const StringViewImpl &o) const { return !operator==(o); }
+
+        bool operator!=(const StringType &s) const { return !operator==(s); }
+
+      private:
+        const EncodedElement *_begin;
+        const EncodedElement *_end;
+        mutable size_t _lengthIfKnown;
+
+        friend class StringSplitterImpl<MainDataType>;
+    };
+
+    /** A read-only view of a part of a String's data. See StringViewImpl.*/
+    typedef StringViewImpl<NativeStringData> StringView;
+}
+
+#endif
@@ -0,0 +1,166 @@
+#ifndef BDN_TextRope_H_
+#define BDN_TextRope_H_
+
+#include <string>
+#include <utility>
+
+namespace bdn
+{
+
+    /** Stores a large text in a form that can be edited efficiently.
+
+        A String stores its data in a single contiguous buffer. Inserting or
+       erasing text in the middle of a String copies the whole buffer (and if
+       the data is shared with another String object then it is copied once
+       more). For texts with millions of characters that are edited
+       continuously (for example, in a text editor) that is too slow.
+
+        TextRope stores the text in small chunks that are the leaves of a
+       balanced binary tree. Each tree node knows the number of characters and
+       line breaks below it. So the following operations take O(log n) time,
+       independent of where in the text they happen:
+
+        - insert(), erase() and replace()
+        - accessing a character by its index (operator[])
+        - finding the start of a line (getLineStartIndex()) and the line that
+          contains a character (getLineIndex())
+
+        The tree nodes are never modified after they were created. Edits create
+       new nodes only for the path from the root to the changed chunks and
+       share everything else with the previous version. So copying a TextRope
+       is very cheap (O(1)) and can be used to take a snapshot of the text (for
+       example, for an undo history or for passing it to a background thread).
+       Different TextRope objects can be used by different threads at the same
+       time, even if they share data. A single TextRope object must not be
+       modified by one thread while another thread accesses it.
+
+        Like String, TextRope counts characters as unicode code points. Lines
+       are separated by line feed characters ('\\n'). The line feed belongs to
+       the line that it ends.
+
+        Use TextRope(const String&) and toString() to convert from and to
+       String. toString() copies the whole text, so it should not be called
+       after every small edit.
+    */
+    class TextRope
+    {
+      public:
+        /** Used as a character count to indicate "until the end of the
+         * text".*/
+        static const size_t toEnd = std::string::npos;
+
+        /** Constructs an empty text.*/
+        TextRope();
+
+        /** Constructs a rope that contains the specified text.*/
+        TextRope(const String &text);
+
+        TextRope(const TextRope &o);
+        TextRope(TextRope &&o);
+
+        ~TextRope();
+
+        TextRope &operator=(const TextRope &o);
+        TextRope &operator=(TextRope &&o);
+
+        /** Returns the number of characters (unicode code points) in the
+         * text.*/
+        size_t getLength() const;
+
+        /** Returns true if the text is empty.*/
+        bool isEmpty() const { return getLength() == 0; }
+
+        /** Returns the number of lines in the text. This is the number of line
+           feed characters plus 1, so an empty text has one (empty) line.*/
+        size_t getLineCount() const;
+
+        /** Returns the character at the specified index.
+
+            If the index is invalid (>= getLength()) then an OutOfRangeError
+           is thrown.*/
+        char32_t operator[](size_t index) const;
+
+        /** Returns the whole text as a String.*/
+        String toString() const;
+
+        /** Returns a section of the text as a String.
+
+            If startIndex is bigger than getLength() then an OutOfRangeError is
+           thrown. If charCount is toEnd or the section would extend beyond the
+           end of the text then the section ends at the end of the text.*/
+        String subString(size_t startIndex, size_t charCount = toEnd) const;
+
+        /** Returns the index of the first character of the line with the
+           specified index.
+
+            If lineIndex is invalid (>= getLineCount()) then an OutOfRangeError
+           is thrown.*/
+        size_t getLineStartIndex(size_t lineIndex) const;
+
+        /** Returns the index of the line that contains the character with the
+           specified index. charIndex can also be getLength(), which
+           corresponds to the end of the last line.
+
+            If charIndex is bigger than getLength() then an OutOfRangeError is
+           thrown.*/
+        size_t getLineIndex(size_t charIndex) const;
+
+        /** Returns the text of the line with the specified index, without the
+           line feed at the end.
+
+            If lineIndex is invalid (>= getLineCount()) then an OutOfRangeError
+           is thrown.*/
+        String getLine(size_t lineIndex) const;
+
+        /** Inserts the specified text before the character at the specified
+           index. If index equals getLength() then the text is appended.
+
+            If index is bigger than getLength() then an OutOfRangeError is
+           thrown.
+
+            Returns a reference to this object.*/
+        TextRope &insert(size_t index, const String &text);
+
+        /** Inserts the contents of another rope. The data of \c text is shared
+           and not copied, so this is fast even for big texts.
+
+            See insert(size_t, const String&).*/
+        TextRope &insert(size_t index, const TextRope &text);
+
+        /** Appends the specified text at the end. Returns a reference to this
+         * object.*/
+        TextRope &append(const String &text) { return insert(getLength(), text); }
+
+        /** Appends the contents of another rope at the end. Returns a
+         * reference to this object.*/
+        TextRope &append(const TextRope &text) { return insert(getLength(), text); }
+
+        /** Removes a section of the text.
+
+            If startIndex is bigger than getLength() then an OutOfRangeError is
+           thrown. If charCount is toEnd or the section would extend beyond the
+           end of the text then everything from startIndex to the end is
+           removed.
+
+            Returns a reference to this object.*/
+        TextRope &erase(size_t startIndex, size_t charCount = toEnd);
+
+        /** Replaces a section of the text with the specified replacement.
+           startIndex and charCount are interpreted in the same way as in
+           erase().
+
+            Returns a reference to this object.*/
+        TextRope &replace(size_t startIndex, size_t charCount, const String &replaceWith);
+
+      private:
+        class Node;
+
+        TextRope(const P<Node> &root);
+
+        size_t clampCharCount(size_t startIndex, size_t charCount, const char *functionName) const;
+
+        P<Node> _root;
+    };
+}
+
+#endif
@@ -9,6 +9,10 @@
 
 #include <utility>
 
+#if BDN_HAVE_THREADS && BDN_PLATFORM_FAMILY_POSIX
+#include <pthread.h>
+#endif
+
 #include <bdn/IThreadRunnable.h>
 #include <bdn/ThreadRunnableBase.h>
 #include <bdn/ThreadDetachedError.h>
@@ -108,6 +112,61 @@ namespace bdn
         typedef void *Handle;
 #endif
 
+        /** Scheduling priority of a thread, relative to the other threads of
+         * the process.*/
+        enum class Priority
+        {
+            low,
+            normal,
+            high
+        };
+
+        /** Optional settings for a new thread (see Thread(IThreadRunnable*,
+           const Options&)).
+
+            The settings are applied on a best-effort basis. Settings that the
+           platform does not support (or that the process is not allowed to
+           use) are silently ignored.*/
+        struct Options
+        {
+            /** The name of the thread, as shown in debuggers and in tools like
+               top or perf. Linux limits thread names to 15 bytes - longer names
+               are truncated. If this is empty then the thread is not named.*/
+            String name;
+
+            /** The cores that the thread may run on. Bit i corresponds to the
+               core with index i. If this is 0 then the thread can run on any
+               core.*/
+            uint64_t affinityMask = 0;
+
+            /** The scheduling priority of the thread. Note that on Linux a
+               process usually needs special privileges to raise the priority
+               above normal.*/
+            Priority priority = Priority::normal;
+
+            /** The size of the thread's stack in bytes. If this is 0 then the
+             * platform's default size is used.*/
+            size_t stackSize = 0;
+        };
+
+        /** Resource usage statistics of a thread (see
+           getCurrentResourceUsage()). Values that the platform does not
+           provide are 0.*/
+        struct ResourceUsage
+        {
+            /** The CPU time (user and system) that the thread has used so
+             * far.*/
+            double cpuTimeSeconds = 0;
+
+            /** The number of times the thread gave up the CPU voluntarily
+             * (for example, because it waited for a mutex or for I/O).*/
+            int64_t voluntaryContextSwitches = 0;
+
+            /** The number of times the thread was preempted by the
+             * scheduler.*/
+            int64_t involuntaryContextSwitches = 0;
+        };
+
         /** Constructs a dummy Thread object that is not actually connected to a
            real thread. It behaves like an object of a thread that has already
            finished.*/
@@ -133,6 +192,10 @@ namespace bdn
          */
         Thread(IThreadRunnable *runnable);
 
+        /** Like Thread(IThreadRunnable*), but the thread is created with the
+           specified options (name, affinity, priority and stack size).*/
+        Thread(IThreadRunnable *runnable, const Options &options);
+
 #else
 
       private:
@@ -166,7 +229,11 @@ namespace bdn
          * implementation specific.*/
         Handle getHandle()
         {
-#if BDN_HAVE_THREADS
+#if BDN_HAVE_THREADS && BDN_PLATFORM_FAMILY_POSIX
+            if (_isPosixThread)
+                return _posixThread;
+            return _thread.native_handle();
+#elif BDN_HAVE_THREADS
             return _thread.native_handle();
 #else
             return nullptr;
@@ -308,6 +375,50 @@ namespace bdn
          */
         static bool isCurrentMain();
 
+        /** Static function that pins the current thread to the CPU core with
+           the specified index, so that the operating system only schedules it
+           on that core.
+
+            This is the same as calling setCurrentAffinity() with only the bit
+           for cpuIndex set, so only the first 64 cores are supported.
+
+            Returns true if successful. Returns false if the platform does not
+           support thread affinity or if cpuIndex is not a valid core index.*/
+        static bool pinCurrentToCpu(int cpuIndex);
+
+        /** Static function that restricts the current thread to the cores
+           whose bits are set in affinityMask (bit i corresponds to the core
+           with index i).
+
+            Returns true if successful. Returns false if the platform does not
+           support thread affinity or if the mask does not contain any valid
+           core.*/
+        static bool setCurrentAffinity(uint64_t affinityMask);
+
+        /** Static function that sets the name of the current thread, as shown
+           in debuggers and tools like top or perf.
+
+            Returns false if the platform does not support thread names.*/
+        static bool setCurrentName(const String &name);
+
+        /** Static function that sets the scheduling priority of the current
+           thread.
+
+            Returns false if the platform does not support it or if the process
+           does not have the necessary privileges.*/
+        static bool setCurrentPriority(Priority priority);
+
+        /** Static function that returns the CPU time (user and system) that
+           the current thread has used so far, in seconds.
+
+            Returns 0 if the platform does not support per-thread CPU times.*/
+        static double getCurrentCpuTimeSeconds();
+
+        /** Static function that returns resource usage statistics of the
+           current thread (CPU time and context switch counts). This is
+           intended for benchmarks and diagnostics.*/
+        static ResourceUsage getCurrentResourceUsage();
+
         /** Static function that verifies that the current thread is the main
            thread if the code is built in debug mode. If the function is called
            from another thread then a debug assertion is fired.
@@ -440,9 +551,18 @@ namespace bdn
             Mutex runnableMutex;
             P<IThreadRunnable> runnable;
             std::exception_ptr threadException;
+
+            Options options;
+
+#if BDN_PLATFORM_FAMILY_POSIX
+            std::promise<Id> idPromise;
+#endif
         };
 
+        void start(IThreadRunnable *runnable, const Options &options);
+
         static void run(P<ThreadData> threadData);
+        static void applyOptionsToCurrent(const Options &options);
 
         static Id &getMainIdRef()
         {
@@ -457,6 +577,16 @@ namespace bdn
         std::thread _thread;
         Id _threadId;
 
+#if BDN_PLATFORM_FAMILY_POSIX
+        // std::thread cannot set the stack size. Threads with a custom stack
+        // size are created with pthreads directly.
+        static void *runPosixThread(void *param);
+
+        pthread_t _posixThread;
+        bool _isPosixThread = false;
+        bool _posixThreadJoinable = false;
+#endif
+
         bool _detached = false;
 
 #endif
@@ -0,0 +1,170 @@
+#ifndef BDN_ThreadPerCoreRuntime_H_
+#define BDN_ThreadPerCoreRuntime_H_
+
+#if BDN_HAVE_THREADS
+
+#include <bdn/GenericDispatcher.h>
+#include <bdn/Thread.h>
+#include <bdn/SpscChannel.h>
+#include <bdn/LoopAllocator.h>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace bdn
+{
+
+    /** Runs one event loop per CPU core, for CPU-bound background services
+       that want to partition their data by core and avoid cross-core locking.
+
+        Each loop is a GenericDispatcher that runs in its own thread. By
+       default each loop thread is pinned to the core with the same index (if
+       the platform supports it, see Thread::pinCurrentToCpu()). Since the
+       loops are normal dispatchers, existing code that works with an
+       IDispatcher can run on any loop (see getDispatcher()).
+
+        Tasks can be sent to a loop with submitTo() and to all loops with
+       broadcast(). When these are called from a loop thread then the task is
+       passed through a lock-free single-producer/single-consumer channel
+       (see SpscChannel) that exists for each pair of loops, so no mutex is
+       locked in the common case. Tasks sent from one loop to another are
+       executed in the order in which they were sent. If a channel is full then
+       the tasks wait in a local overflow queue of the sending loop, so tasks
+       are never dropped and never reordered.
+
+        When submitTo is called from a thread that does not belong to the
+       runtime then the task is enqueued in the target loop's dispatcher
+       directly.
+
+        Each loop also has its own LoopAllocator (see
+       getCurrentLoopAllocator()), which can be used for loop-local data
+       without any synchronization.
+
+        The runtime must not be deleted or stopped from one of its own loop
+       threads.
+    */
+    class ThreadPerCoreRuntime : public Base
+    {
+      public:
+        /** Constructor. Starts the loop threads.
+
+            \param loopCount the number of loops. If this is 0 then one loop
+           per CPU core is started.
+            \param pinThreads if true then each loop thread is pinned to the
+           core with the same index (modulo the number of cores).
+            \param channelCapacity the capacity of the channels between the
+           loops (per pair of loops).*/
+        ThreadPerCoreRuntime(int loopCount = 0, bool pinThreads = true, size_t channelCapacity = 1024);
+        ~ThreadPerCoreRuntime();
+
+        /** Returns the number of loops.*/
+        int getLoopCount() const { return (int)_loops.size(); }
+
+        /** Returns the dispatcher of the loop with the specified index.*/
+        P<IDispatcher> getDispatcher(int loopIndex) const;
+
+        /** Returns true if the thread of the specified loop was successfully
+           pinned to a CPU core. Can only be false if pinning is not supported
+           or if pinning was disabled in the constructor.
+
+            Note that the loop thread pins itself when it starts. So this might
+           return false for a very short time right after construction.*/
+        bool isLoopPinned(int loopIndex) const;
+
+        /** Schedules the task to be executed by the loop with the specified
+         * index. This can be called from any thread.*/
+        void submitTo(int loopIndex, std::function<void()> task);
+
+        /** Schedules the task to be executed once by each loop. This can be
+         * called from any thread.*/
+        void broadcast(const std::function<void()> &task);
+
+        /** Returns the index of the loop that the calling thread belongs to,
+         * or -1 if the calling thread is not one of the runtime's loops.*/
+        int getCurrentLoopIndex() const;
+
+        /** Returns the allocator of the loop that the calling thread belongs
+           to. The allocator must only be used from that loop.
+
+            Throws a ProgrammingError if the calling thread is not one of the
+           runtime's loops.*/
+        LoopAllocator &getCurrentLoopAllocator();
+
+        /** Stops all loops and waits for their threads to end. Pending tasks
+           are discarded. It is ok to call stop multiple times.
+
+            Throws a ProgrammingError if it is called from one of the loop
+           threads.*/
+        void stop();
+
+      private:
+        using Task_ = std::function<void()>;
+        using Channel_ = SpscChannel<Task_>;
+
+        class Loop_ : public Base
+        {
+          public:
+            int index = 0;
+
+            P<GenericDispatcher> dispatcher;
+            P<Thread> thread;
+
+            LoopAllocator allocator;
+
+            /** incomingChannels[i] carries tasks from loop i to this loop.*/
+            std::vector<std::unique_ptr<Channel_>> incomingChannels;
+
+            /** outgoingOverflow[i] holds tasks for loop i that did not fit
+               into the channel. Only accessed by this loop's thread.*/
+            std::vector<std::deque<Task_>> outgoingOverflow;
+            bool hasOverflow = false;
+
+            std::atomic<bool> sleeping{false};
+            std::atomic<bool> pinned{false};
+        };
+
+        class LoopRunnable_ : public ThreadRunnableBase
+        {
+          public:
+            LoopRunnable_(ThreadPerCoreRuntime *runtime, Loop_ *loop, int cpuIndex)
+                : _runtime(runtime), _loop(loop), _cpuIndex(cpuIndex)
+            {}
+
+            void signalStop() override;
+            void run() override;
+
+          private:
+            ThreadPerCoreRuntime *_runtime;
+            Loop_ *_loop;
+            int _cpuIndex;
+        };
+        friend class LoopRunnable_;
+
+        /** Identifies the loop that the current thread belongs to.*/
+        struct CurrentLoop_
+        {
+            ThreadPerCoreRuntime *runtime = nullptr;
+            Loop_ *loop = nullptr;
+        };
+
+        static CurrentLoop_ &getCurrentLoopInfo();
+
+        void sendFromLoop(Loop_ &source, Loop_ &target, Task_ &&task);
+        void wakeUp(Loop_ &loop);
+
+        bool flushOverflow(Loop_ &loop);
+        bool executeIncoming(Loop_ &loop);
+        bool incomingEmpty(Loop_ &loop) const;
+
+        Loop_ &getLoop(int loopIndex) const;
+
+        std::vector<P<Loop_>> _loops;
+        bool _stopped = false;
+    };
+}
+
+#endif // BDN_HAVE_THREADS
+
+#endif
@@ -6,10 +6,18 @@
 #include <bdn/Thread.h>
 #include <bdn/ThreadRunnableBase.h>
 #include <bdn/Signal.h>
+#include <bdn/CancellationToken.h>
+
+#include <bdn/QueueFullError.h>
 
 #include <bdn/List.h>
 #include <bdn/Set.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+
 namespace bdn
 {
 
@@ -18,6 +26,24 @@ namespace bdn
         A thread pool is often used to minimize the amount of threads that are
        created and destroyed for small tasks (since creating a new thread for
        each short job can be quite expensive).
+
+        Jobs that cannot be started right away are added to a waiting queue.
+        By default the queue is unbounded. setQueueLimit() can be used to limit
+       the number of waiting jobs and to select what happens when a job is
+       added to a full queue (see OverflowPolicy).
+
+        Each job has a priority. Waiting jobs with a higher priority are
+       started first. To prevent starvation, waiting jobs age: for each aging
+       interval (see setAgingIntervalSeconds()) that a job waits, its effective
+       priority increases by one level.
+
+        Jobs can also be added with a deadline hint (see addJobWithDeadline()).
+       Among the waiting jobs of the same priority, jobs with a deadline are
+       ordered by their deadline. Jobs whose deadline has passed are started
+       before all other waiting jobs.
+
+        getMetrics() provides statistics about the queue length and the time
+       jobs spend waiting, which can be used to size a pool.
     */
     class ThreadPool : public Base
     {
@@ -35,12 +61,151 @@ namespace bdn
                 destroyed again.
         */
         ThreadPool(int minThreadCount, int maxThreadCount);
+
+        /** Like ThreadPool(int, int), but the worker threads are created with
+           the specified options. This can be used to name the workers, to
+           restrict them to certain cores, to change their priority or their
+           stack size (see Thread::Options).*/
+        ThreadPool(int minThreadCount, int maxThreadCount, const Thread::Options &threadOptions);
+
         ~ThreadPool();
 
+        /** Returns the options that the pool uses for its worker threads.*/
+        const Thread::Options &getThreadOptions() const { return _threadOptions; }
+
+        /** The priority of a job. Waiting jobs with higher priority are
+         * started first.*/
+        enum class Priority
+        {
+            low,
+            normal,
+            high
+        };
+
+        /** Controls what happens when a job is added while the waiting queue
+         * is full (see setQueueLimit()).*/
+        enum class OverflowPolicy
+        {
+            /** addJob blocks until there is space in the queue.
+
+                Note that this can deadlock if the job is added from a job that
+               runs in the same pool. */
+            block,
+
+            /** addJob throws a QueueFullError.*/
+            reject,
+
+            /** The job is executed synchronously in the thread that calls
+               addJob. Exceptions thrown by the job are passed through to the
+               caller. This naturally slows down producers that are faster than
+               the pool.*/
+            callerRuns
+        };
+
+        /** Statistics about the work of the pool. See getMetrics().*/
+        struct Metrics
+        {
+            /** The number of jobs that are currently waiting in the queue.*/
+            int queuedJobCount = 0;
+
+            /** The highest number of waiting jobs so far.*/
+            int peakQueuedJobCount = 0;
+
+            /** The number of jobs that were started by the pool threads.*/
+            uint64_t startedJobCount = 0;
+
+            /** The number of jobs that were rejected because the queue was
+             * full (see OverflowPolicy::reject).*/
+            uint64_t rejectedJobCount = 0;
+
+            /** The number of jobs that were executed by the thread that added
+             * them because the queue was full (see OverflowPolicy::callerRuns).*/
+            uint64_t callerRunJobCount = 0;
+
+            /** The number of addJob calls that had to wait for space in the
+             * queue (see OverflowPolicy::block).*/
+            uint64_t blockedAddCount = 0;
+
+            /** The average time that started jobs spent waiting in the queue,
+             * in seconds.*/
+            double averageWaitSeconds = 0;
+
+            /** The longest time that a started job has spent waiting in the
+             * queue, in seconds.*/
+            double maxWaitSeconds = 0;
+        };
+
         /** Adds a job for the thread pool to execute. Note that if the pool
            currently has no free capacity then the job will not start right
-           away. Instead it will be added to a waiting queue and start later.*/
-        void addJob(IThreadRunnable *runnable);
+           away. Instead it will be added to a waiting queue and start later.
+
+            If the queue is full then the configured OverflowPolicy is applied
+           (see setQueueLimit()).*/
+        void addJob(IThreadRunnable *runnable, Priority priority = Priority::normal);
+
+        /** Like addJob(), but also specifies a deadline hint: the job should
+           start within deadlineSeconds seconds.
+
+            The pool does not guarantee that the deadline is met. It only uses
+           it to decide which waiting job to start next: among jobs of the same
+           priority, jobs with a deadline are ordered by their deadline, and
+           jobs whose deadline has passed are started before all other waiting
+           jobs.*/
+        void addJobWithDeadline(IThreadRunnable *runnable, double deadlineSeconds,
+                                Priority priority = Priority::normal);
+
+        /** Like addJob(), but the job is tied to a cancellation token.
+
+            When the token is cancelled then signalStop() is called on the job.
+           A job that has not started yet is then not executed at all: it is
+           dropped when it reaches the front of the queue. A running job can
+           check the token (see CancellationToken::isCancelled()) to abort
+           early.
+
+            If the token is already cancelled then the job is not added.
+           signalStop() is called on it immediately instead.*/
+        void addJob(IThreadRunnable *runnable, const CancellationToken &token, Priority priority = Priority::normal);
+
+        /** Limits the number of jobs that can wait in the queue and sets what
+           happens when a job is added to a full queue.
+
+            If maxQueuedJobs is negative then the queue is unbounded (this is
+           the default). A value of 0 means that jobs are never queued: they
+           are either started right away or the overflow policy is applied.
+
+            Changing the limit does not affect jobs that are already queued.*/
+        void setQueueLimit(int maxQueuedJobs, OverflowPolicy overflowPolicy = OverflowPolicy::block);
+
+        /** Returns the maximum number of queued jobs. Negative if the queue is
+         * unbounded. See setQueueLimit().*/
+        int getMaxQueuedJobs() const;
+
+        /** Returns the policy that is applied when a job is added to a full
+         * queue. See setQueueLimit().*/
+        OverflowPolicy getOverflowPolicy() const;
+
+        /** Sets the aging interval. For each interval that a job waits in the
+           queue its effective priority increases by one level. So even
+           low-priority jobs eventually start when there is a constant stream
+           of higher-priority jobs.
+
+            The default is 1 second. Throws an InvalidArgumentError if the
+           interval is not positive.*/
+        void setAgingIntervalSeconds(double seconds);
+
+        /** Returns the aging interval. See setAgingIntervalSeconds().*/
+        double getAgingIntervalSeconds() const;
+
+        /** Returns the number of jobs that are currently waiting in the queue.
+           Note that this number can change at any time.*/
+        int getQueuedJobCount() const;
+
+        /** Returns a snapshot of the pool statistics.*/
+        Metrics getMetrics() const;
+
+        /** Resets the statistics returned by getMetrics() (except for the
+         * current queue length).*/
+        void resetMetrics();
 
         /** Returns the number of threads that are currently busy. Note that
            this is number can change at any time when jobs finish or get
@@ -76,18 +241,62 @@ namespace bdn
         };
         friend class PoolRunner;
 
+        using Clock = std::chrono::steady_clock;
+
+        struct QueuedJob_
+        {
+            P<IThreadRunnable> job;
+            Clock::time_point enqueueTime;
+        };
+
+        /** The waiting jobs of one priority level. Jobs with a deadline are
+         * kept separately, ordered by deadline.*/
+        struct PriorityQueue_
+        {
+            std::deque<QueuedJob_> fifoJobs;
+            std::multimap<Clock::time_point, QueuedJob_> deadlineJobs;
+        };
+
+        static constexpr int priorityCount = 3;
+
+        void addJobImpl(IThreadRunnable *runnable, Priority priority, bool hasDeadline, Clock::time_point deadline);
+
+        P<IThreadRunnable> takeNextJob();
+        void recordJobStart(Clock::duration waitTime);
+
         bool runnerFinishedJob(PoolRunner *runner);
 
         mutable Mutex _mutex;
+        std::condition_variable_any _queueSpaceAvailable;
 
         List<P<PoolRunner>> _idleRunners;
         Set<P<PoolRunner>> _busyRunners;
 
-        List<P<IThreadRunnable>> _queuedJobs;
+        PriorityQueue_ _queues[priorityCount];
+        int _queuedJobCount = 0;
 
         int _minThreadCount;
         int _maxThreadCount;
+        Thread::Options _threadOptions;
+
+        int _maxQueuedJobs = -1;
+        OverflowPolicy _overflowPolicy = OverflowPolicy::block;
+        Clock::duration _agingInterval = std::chrono::seconds(1);
+
+        Metrics _metrics;
+        Clock::duration _totalWaitTime = Clock::duration::zero();
     };
+
+    /** Returns a global thread pool that is shared by all components that need
+       to execute small background jobs (see for example SerialExecutor).
+
+        The pool has one thread per CPU core (but at least two). The threads
+       are started on demand and are kept alive after that.
+
+        Jobs executed by the shared pool should not block for a long time,
+       since that would take capacity away from all other users of the pool.
+       Use a dedicated Thread or ThreadPool for those.*/
+    P<ThreadPool> getSharedThreadPool();
 }
 
 #endif // BDN_HAVE_THREADS
@@ -6,9 +6,15 @@
 #include <bdn/NotifierBase.h>
 #include <bdn/mainThread.h>
 #include <bdn/RequireNewAlloc.h>
+#include <bdn/NotificationPolicy.h>
 
 #include <bdn/Map.h>
 
+#include <atomic>
+#include <memory>
+#include <tuple>
+#include <utility>
+
 namespace bdn
 {
 
@@ -35,6 +41,19 @@ namespace bdn
 
         void postNotification(ARG_TYPES... args) override
         {
+            if (_deferred) {
+                Mutex::Lock lock(_deferrer.getMutex());
+
+                // only the arguments of the latest notification are delivered
+                if (_pendingArgs == nullptr)
+                    _pendingArgs.reset(new ArgsTuple_(args...));
+                else
+                    *_pendingArgs = ArgsTuple_(args...);
+
+                _deferrer.schedule(_policy, strongMethod(this, &ThreadSafeNotifier::deliverPending));
+                return;
+            }
+
             // see doc_input/notifier_internal.md for more information about why
             // this has to redirect to the main thread.
 
@@ -42,7 +61,58 @@ namespace bdn
                 strongMethod(this, &ThreadSafeNotifier::notify), std::forward<ARG_TYPES>(args)...));
         }
 
+        /** Sets the policy for notifications that are posted with
+            postNotification() (see NotificationPolicy). notify() is not
+           affected.
+
+            With the default policy (NotificationPolicy::immediate()) each
+           posted notification is delivered separately on the main thread. With
+           a coalesced or throttled policy, notifications that are posted before
+           the delivery takes place are combined and only the arguments of the
+           latest one are delivered.*/
+        void setNotificationPolicy(const NotificationPolicy &policy)
+        {
+            Mutex::Lock lock(_deferrer.getMutex());
+
+            _policy = policy;
+            _deferred = policy.isDeferred();
+        }
+
+        /** Returns the notification policy (see setNotificationPolicy()).*/
+        NotificationPolicy getNotificationPolicy() const
+        {
+            Mutex::Lock lock(_deferrer.getMutex());
+
+            return _policy;
+        }
+
       private:
+        using ArgsTuple_ = std::tuple<typename std::decay<ARG_TYPES>::type...>;
+
+        void deliverPending()
+        {
+            std::unique_ptr<ArgsTuple_> args;
+
+            {
+                Mutex::Lock lock(_deferrer.getMutex());
+
+                _deferrer.beginDelivery();
+                args = std::move(_pendingArgs);
+            }
+
+            if (args != nullptr)
+                notifyWithTuple(*args, std::index_sequence_for<ARG_TYPES...>());
+        }
+
+        template <std::size_t... INDICES> void notifyWithTuple(ArgsTuple_ &args, std::index_sequence<INDICES...>)
+        {
+            notify(std::get<INDICES>(args)...);
+        }
+
+        std::atomic<bool> _deferred{false};
+        NotificationPolicy _policy;
+        mutable NotificationDeferrer_ _deferrer;
+        std::unique_ptr<ArgsTuple_> _pendingArgs;
     };
 }
 
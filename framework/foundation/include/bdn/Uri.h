@@ -7,6 +7,15 @@ namespace bdn
     class Uri : public Base
     {
       public:
+        /** Escapes all characters of the specified string, except the
+           "unreserved" characters of RFC 3986 (A-Z, a-z, 0-9, '-', '.', '_'
+           and '~'). The UTF-8 bytes of each escaped character are encoded as
+           %XY sequences, with upper case hex digits.
+
+            The result can be used in any part of a URI and can be converted
+           back with unescape().*/
+        static String escape(const String &s);
+
         /** Unescapes all URI escape sequences (%XY sequences) in the specified
            string and returns the result.
 
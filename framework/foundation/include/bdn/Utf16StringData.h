@@ -23,6 +23,10 @@ namespace bdn
 
     typedef StringData<Utf16Codec> Utf16StringData;
 
+    template <> Utf16StringData &Utf16StringData::getEmptyData();
+
+    extern template class StringData<Utf16Codec>;
+
 #endif
 }
 
@@ -23,6 +23,10 @@ namespace bdn
 
     typedef StringData<Utf32Codec> Utf32StringData;
 
+    template <> Utf32StringData &Utf32StringData::getEmptyData();
+
+    extern template class StringData<Utf32Codec>;
+
 #endif
 }
 
@@ -14,6 +14,10 @@ namespace bdn
         See StringData for information about constructors and methods.
     */
     typedef StringData<Utf8Codec> Utf8StringData;
+
+    template <> Utf8StringData &Utf8StringData::getEmptyData();
+
+    extern template class StringData<Utf8Codec>;
 }
 
 #endif
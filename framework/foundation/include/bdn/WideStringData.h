@@ -25,6 +25,10 @@ namespace bdn
 
     typedef StringData<WideCodec> WideStringData;
 
+    template <> WideStringData &WideStringData::getEmptyData();
+
+    extern template class StringData<WideCodec>;
+
 #endif
 }
 
@@ -199,21 +199,10 @@ namespace bdn
                 if (_bytesLeft < 16)
                     return nullptr;
 
-                std::memcpy(_4ByteValues, _nextData, 16);
-
-#if BDN_IS_BIG_ENDIAN
-                // in order for the hash to be the same on every system
-                // we need to swap the byte order if we are on a big endian
-                // machine.
-                // This might not be necessary if a portable hash is not
-                // required. But it is a very quick operation and this should be
-                // negligible compared to the other operations we do. So we
-                // simply do this always on big endian systems.
-                swapByteOrder(_4ByteValues[0]);
-                swapByteOrder(_4ByteValues[1]);
-                swapByteOrder(_4ByteValues[2]);
-                swapByteOrder(_4ByteValues[3]);
-#endif
+                // the hash is defined on little endian values. So that it is the
+                // same on every system, the byte order is swapped on big
+                // endian machines (loadLittleEndian does that).
+                loadLittleEndian(_nextData, _4ByteValues, 4);
 
                 _nextData += 16;
                 _bytesLeft -= 16;
@@ -229,21 +229,10 @@ namespace bdn
                 if (_bytesLeft < 32)
                     return nullptr;
 
-                memcpy(_8ByteValues, _nextData, 32);
-
-#if BDN_IS_BIG_ENDIAN
-                // in order for the hash to be the same on every system
-                // we need to swap the byte order if we are on a big endian
-                // machine.
-                // This might not be necessary if a portable hash is not
-                // required. But it is a very quick operation and this should be
-                // negligible compared to the other operations we do. So we
-                // simply do this always on big endian systems.
-                swapByteOrder(_8ByteValues[0]);
-                swapByteOrder(_8ByteValues[1]);
-                swapByteOrder(_8ByteValues[2]);
-                swapByteOrder(_8ByteValues[3]);
-#endif
+                // the hash is defined on little endian values. So that it is the
+                // same on every system, the byte order is swapped on big
+                // endian machines (loadLittleEndian does that).
+                loadLittleEndian(_nextData, _8ByteValues, 4);
 
                 _nextData += 32;
                 _bytesLeft -= 32;
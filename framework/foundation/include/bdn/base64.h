@@ -0,0 +1,41 @@
+#ifndef BDN_base64_H_
+#define BDN_base64_H_
+
+#include <bdn/String.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace bdn
+{
+
+    /** Returns the number of characters that base64Encode() produces for the
+     * specified number of bytes (including padding).*/
+    inline size_t getBase64EncodedLength(size_t bytes) { return (bytes + 2) / 3 * 4; }
+
+    /** Encodes binary data with the standard Base64 alphabet of RFC 4648
+       (with = padding). getBase64EncodedLength(bytes) characters are written
+       to \c out.*/
+    void base64Encode(const void *data, size_t bytes, char *out);
+
+    /** Decodes Base64 encoded text (standard alphabet of RFC 4648, with =
+       padding). \c out must have room for textLength/4*3 bytes. The number of
+       decoded bytes is stored in \c outBytes.
+
+        Returns false if the text is not valid Base64 (for example, if it
+       contains whitespace or if the padding is missing). In that case the
+       contents of \c out are undefined.*/
+    bool base64Decode(const char *text, size_t textLength, void *out, size_t &outBytes);
+
+    /** Decodes the Base64 encoded string \c s and stores the bytes in \c
+       result. Returns false if \c s is not valid Base64 (\c result is empty in
+       that case). See base64Decode(const char*, size_t, void*, size_t&).*/
+    bool base64Decode(const String &s, std::vector<uint8_t> &result);
+
+    /** Returns a string with the Base64 encoding of the specified data (see
+       base64Encode()). The string data is allocated only once, with the final
+       size.*/
+    String toBase64String(const void *data, size_t bytes);
+}
+
+#endif
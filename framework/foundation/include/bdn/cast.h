@@ -2,18 +2,50 @@
 #define BDN_cast_H_
 
 #include <bdn/CastError.h>
+#include <bdn/IBase.h>
+
+#include <type_traits>
 
 namespace bdn
 {
 
+    template <class DestType> DestType *tryCastImpl_(IBase *object, std::false_type)
+    {
+        return dynamic_cast<DestType *>(object);
+    }
+
+    template <class DestType> DestType *tryCastImpl_(IBase *object, std::true_type)
+    {
+        if (object == nullptr)
+            return nullptr;
+
+        typedef typename std::remove_cv<DestType>::type Interface;
+        constexpr InterfaceId id = Interface::getInterfaceId_();
+
+        void *result = object->queryInterface(id, Interface::getInterfaceName_());
+        if (result != nullptr)
+            return static_cast<DestType *>(result);
+
+        // the interface table of the object is either missing or incomplete
+        // (or the ID collided with that of another interface).
+        return dynamic_cast<DestType *>(object);
+    }
+
     /** Tries to cast the specified object pointer to a DestType pointer
        (DestType is the template parameter). Returns nullptr if the object does
        not have a compatible type.
 
         If object is nullptr then tryCast also returns nullptr.
 
+        If DestType is an interface with an ID (see \ref BDN_INTERFACE_ID) then
+       the object's interface table is consulted first (see \ref
+       BDN_INTERFACE_TABLE). Otherwise dynamic_cast is used.
+
         */
-    template <class DestType> DestType *tryCast(IBase *object) { return dynamic_cast<DestType *>(object); }
+    template <class DestType> DestType *tryCast(IBase *object)
+    {
+        return tryCastImpl_<DestType>(object, HasOwnInterfaceId_<DestType>());
+    }
 
     /** Tries to cast the specified object pointer to a DestType pointer
        (DestType is the template parameter). Returns nullptr if the object does
@@ -21,10 +53,12 @@ namespace bdn
 
         If object is nullptr then tryCast also returns nullptr.
 
+        See the non-const version for more information.
+
         */
     template <class DestType> const DestType *tryCast(const IBase *object)
     {
-        return dynamic_cast<const DestType *>(object);
+        return tryCastImpl_<const DestType>(const_cast<IBase *>(object), HasOwnInterfaceId_<DestType>());
     }
 
     /** Casts specified object pointer to a DestType pointer (DestType is the
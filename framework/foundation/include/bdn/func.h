@@ -3,12 +3,148 @@
 
 #include <utility>
 #include <functional>
+#include <typeinfo>
+#include <type_traits>
 
 #include <bdn/DanglingFunctionError.h>
 
 namespace bdn
 {
 
+    /** Internal helper. Do not use directly.*/
+    template <class... Types> struct MakeVoid_
+    {
+        typedef void Type;
+    };
+
+    /** Internal helper. Do not use directly.
+
+        True if CallableType is a weak callable that can report its dangling
+       state to a DanglingCallScope_. Such callables declare a nested type
+       WeakCallableTag_.*/
+    template <class CallableType, class = void> struct IsWeakCallable_ : std::false_type
+    {
+    };
+
+    template <class CallableType>
+    struct IsWeakCallable_<CallableType, typename MakeVoid_<typename CallableType::WeakCallableTag_>::Type>
+        : std::true_type
+    {
+    };
+
+    /** Internal class. Do not use directly.
+
+        Enables weak callables (see weakMethod()) to report that their target
+       object is gone without throwing a DanglingFunctionError.
+
+        Dispatchers and notifiers create a DanglingCallScope_ object for the
+       std::function they are about to call. If that function's target is a
+       weak callable and its object has already been destroyed, then the weak
+       callable detects the active scope, marks it as dangling and returns a
+       default-constructed value instead of throwing. The caller then checks
+       wasDangling() and removes or skips the function. That avoids the cost of
+       throwing and unwinding an exception for every dead subscriber.
+
+        The non-throwing path is only taken when the weak callable is the
+       direct target of the std::function object that the innermost scope was
+       created for. Weak callables that are called in any other way (for
+       example, from inside a lambda) still throw DanglingFunctionError, so
+       callers must continue to handle that exception as well.
+
+        Which callables take part is decided at compile time: a callable opts
+       in by declaring the nested type WeakCallableTag_ (see IsWeakCallable_),
+       and markDanglingIfTarget() does not compile for other types. Whether a
+       given call is the direct call by the dispatcher can only be checked at
+       run time, because dispatchers and notifiers only see a type-erased
+       std::function. That check is one type comparison and one
+       std::function::target() call, and it is only made after the object was
+       found to be gone.
+    */
+    class DanglingCallScope_
+    {
+      public:
+        template <class FuncType>
+        explicit DanglingCallScope_(const std::function<FuncType> &func)
+            : _func(&func), _funcType(&typeid(std::function<FuncType>)), _outer(getInnermost_())
+        {
+            getInnermost_() = this;
+        }
+
+        ~DanglingCallScope_() { getInnermost_() = _outer; }
+
+        DanglingCallScope_(const DanglingCallScope_ &) = delete;
+        DanglingCallScope_ &operator=(const DanglingCallScope_ &) = delete;
+
+        /** Returns true if the function's target reported that it is
+         * dangling.*/
+        bool wasDangling() const { return _dangling; }
+
+        /** Called by weak callables when their object is gone. \c callable
+           must be a pointer to the callable object itself, as stored in the
+           std::function<FuncType>.
+
+            Returns true if the innermost scope was created for a std::function
+           whose target is \c callable. In that case the scope is marked as
+           dangling and the callable must return without throwing. Returns
+           false otherwise - then the callable must throw
+           DanglingFunctionError.*/
+        template <class FuncType, class CallableType> static bool markDanglingIfTarget(const CallableType *callable)
+        {
+            static_assert(IsWeakCallable_<CallableType>::value,
+                          "Only weak callables (with a nested WeakCallableTag_ type) can report a dangling state.");
+
+            DanglingCallScope_ *scope = getInnermost_();
+
+            if (scope == nullptr || *scope->_funcType != typeid(std::function<FuncType>))
+                return false;
+
+            const std::function<FuncType> *func = static_cast<const std::function<FuncType> *>(scope->_func);
+            if (func->template target<CallableType>() != callable)
+                return false;
+
+            scope->_dangling = true;
+            return true;
+        }
+
+      private:
+        static DanglingCallScope_ *&getInnermost_();
+
+        const void *_func;
+        const std::type_info *_funcType;
+        DanglingCallScope_ *_outer;
+        bool _dangling = false;
+    };
+
+    /** Internal helper. Do not use directly.
+
+        Provides the value that a weak callable returns when it is called in a
+       DanglingCallScope_ after its object was destroyed. Result types that
+       cannot be default-constructed do not support the non-throwing path.*/
+    template <class ResultType,
+              bool SUPPORTED = std::is_void<ResultType>::value || std::is_default_constructible<ResultType>::value>
+    struct DanglingResult_
+    {
+        static constexpr bool supported = true;
+
+        static ResultType make() { return ResultType(); }
+    };
+
+    template <class ResultType> struct DanglingResult_<ResultType, false>
+    {
+        static constexpr bool supported = false;
+
+        static ResultType make() { throw DanglingFunctionError(); }
+    };
+
+    /** Internal helper. Do not use directly.
+        Extracts the plain function type from a method pointer type.*/
+    template <class MethodType> struct MethodFunctionType_;
+
+    template <class ObjectType, class FuncType> struct MethodFunctionType_<FuncType(ObjectType::*)>
+    {
+        typedef FuncType Type;
+    };
+
     /** Internal class. Do not use directly.
      */
     template <class ObjectType, class MethodType> class StrongMethod_
@@ -50,6 +186,8 @@ namespace bdn
     template <class ObjectType, class MethodType> class WeakMethod_
     {
       public:
+        typedef void WeakCallableTag_;
+
         WeakMethod_() : _method(nullptr), _valid(false) {}
 
         WeakMethod_(ObjectType *object, MethodType method)
@@ -62,14 +200,46 @@ namespace bdn
             if (!isValid())
                 throw std::bad_function_call();
 
+            typedef typename std::result_of<MethodType(ObjectType *, ArgTypes...)>::type ResultType;
+
             P<ObjectType> object = _objectWeak.toStrong();
 
-            if (object == nullptr)
+            if (object == nullptr) {
+                // if we are called by a dispatcher or notifier that supports
+                // it then we report the dangling state without an exception.
+                if (DanglingResult_<ResultType>::supported &&
+                    DanglingCallScope_::markDanglingIfTarget<typename MethodFunctionType_<MethodType>::Type>(this))
+                    return DanglingResult_<ResultType>::make();
+
                 throw DanglingFunctionError();
+            }
 
             return ((*object).*_method)(std::forward<ArgTypes>(args)...);
         }
 
+        /** Calls the method if its object still exists. Returns false without
+           calling anything if the object has been destroyed.
+
+            Unlike operator() this never throws DanglingFunctionError. The
+           method's return value (if any) is discarded.*/
+        template <class... ArgTypes> bool tryCall(ArgTypes &&... args) const
+        {
+            if (!isValid())
+                throw std::bad_function_call();
+
+            P<ObjectType> object = _objectWeak.toStrong();
+
+            if (object == nullptr)
+                return false;
+
+            ((*object).*_method)(std::forward<ArgTypes>(args)...);
+
+            return true;
+        }
+
+        /** Returns true if the method's object has been destroyed.*/
+        bool isDangling() const { return _objectWeak.toStrong() == nullptr; }
+
         /** Returns true if the method pointer is valid.
          Invalid methods will throw an exception when they are called.*/
         bool isValid() const { return _valid; }
@@ -199,6 +369,10 @@ namespace bdn
        the exception. So it is perfectly safe to use weak methods with
        Notifiers.
 
+        Notifiers and dispatchers also detect dead weak methods without
+       the exception being thrown in the first place (see DanglingCallScope_),
+       so dead subscribers are cheap to skip and remove.
+
         */
     template <class ObjectType, typename FuncType>
     std::function<FuncType> weakMethod(ObjectType *object, FuncType ObjectType::*method)
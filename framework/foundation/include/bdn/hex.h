@@ -1,6 +1,12 @@
 #ifndef BDN_hex_H_
 #define BDN_hex_H_
 
+#include <bdn/String.h>
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
 namespace bdn
 {
 
@@ -42,6 +48,96 @@ namespace bdn
         else
             return 0;
     }
+
+    /** Encodes binary data as hexadecimal digits. Each byte is encoded as two
+       digits, with the high nibble first. 2*bytes elements are written to
+       \c out.
+
+        If \c upperCase is true then the upper case digits A-F are used
+       instead of a-f.
+
+        There is an optimized overload for char output (see
+       hexEncode(const void*, size_t, char*, bool)).*/
+    template <class Element> inline void hexEncode(const void *data, size_t bytes, Element *out, bool upperCase = false)
+    {
+        const char *digits = upperCase ? "0123456789ABCDEF" : "0123456789abcdef";
+
+        const uint8_t *p = static_cast<const uint8_t *>(data);
+        for (size_t i = 0; i < bytes; i++) {
+            *out++ = Element(digits[p[i] >> 4]);
+            *out++ = Element(digits[p[i] & 0xf]);
+        }
+    }
+
+    /** Encodes binary data as hexadecimal digits. Same as the template version
+       of hexEncode(), but processes 16 bytes at once with SIMD instructions on
+       processors that support them.*/
+    void hexEncode(const void *data, size_t bytes, char *out, bool upperCase = false);
+
+    /** Decodes a sequence of hexadecimal digits (upper or lower case) to
+       binary data. Two digits are decoded to one byte, with the high nibble
+       first. textLength/2 bytes are written to \c out.
+
+        Returns false if the text contains anything other than hex digits, or
+       if textLength is odd. In that case the contents of \c out are
+       undefined.
+
+        There is an optimized overload for char input (see
+       hexDecode(const char*, size_t, void*)).*/
+    template <class Element> inline bool hexDecode(const Element *text, size_t textLength, void *out)
+    {
+        if (textLength % 2 != 0)
+            return false;
+
+        uint8_t *outBytes = static_cast<uint8_t *>(out);
+        for (size_t i = 0; i < textLength; i += 2) {
+            int high = decodeHexDigit(text[i]);
+            int low = decodeHexDigit(text[i + 1]);
+            if (high < 0 || low < 0)
+                return false;
+
+            *outBytes++ = uint8_t((high << 4) | low);
+        }
+
+        return true;
+    }
+
+    /** Decodes a sequence of hexadecimal digits. Same as the template version
+       of hexDecode(), but processes 16 digits at once with SIMD instructions
+       on processors that support them.*/
+    bool hexDecode(const char *text, size_t textLength, void *out);
+
+    /** Decodes the hexadecimal digits in \c s and stores the bytes in \c
+       result. Returns false if the string contains anything other than hex
+       digits or has an odd length (\c result is empty in that case).*/
+    bool hexDecode(const String &s, std::vector<uint8_t> &result);
+
+    /** Returns a string with the hexadecimal representation of the specified
+       data (see hexEncode()). The string data is allocated only once, with the
+       final size.*/
+    String toHexString(const void *data, size_t bytes, bool upperCase = false);
+
+    /** Returns the hexadecimal representation of an integer value, with the
+       most significant digit first and always with 2*sizeof(T) digits (i.e.
+       with leading zeros). This is the usual way to print hash values (e.g. of
+       XxHash32 and XxHash64) and other digests.
+
+        Negative values are printed in two's complement representation.*/
+    template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+    inline String toHexString(T value, bool upperCase = false)
+    {
+        const char *digits = upperCase ? "0123456789ABCDEF" : "0123456789abcdef";
+
+        typename std::make_unsigned<T>::type remaining = value;
+
+        char text[sizeof(T) * 2];
+        for (size_t i = sizeof(T) * 2; i > 0; i--) {
+            text[i - 1] = digits[remaining & 0xf];
+            remaining >>= 4;
+        }
+
+        return String(text, sizeof(text));
+    }
 }
 
 #endif
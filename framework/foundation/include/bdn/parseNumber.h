@@ -0,0 +1,358 @@
+#ifndef BDN_parseNumber_H_
+#define BDN_parseNumber_H_
+
+#include <bdn/config.h>
+#include <bdn/StringImpl.h>
+#include <bdn/StringView.h>
+#include <bdn/Nullable.h>
+#include <bdn/unicodeUtil.h>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+namespace bdn
+{
+
+    /** A decimal floating point number with up to 19 significant digits (the
+       number of digits that always fit into a uint64_t). Used internally by
+       parseDouble().*/
+    struct DecimalNumber_
+    {
+        uint64_t mantissa;
+        int64_t exponent;
+        bool negative;
+
+        /** True if the number had more than 19 significant digits. In that
+         * case mantissa only contains the first 19.*/
+        bool truncated;
+    };
+
+    /** Converts the decimal number to the closest double value. Returns false
+       if the result cannot be determined from the first 19 significant digits
+       alone (this is only possible if number.truncated is true).*/
+    bool decimalToDouble_(const DecimalNumber_ &number, double &result);
+
+    /** Slow, but exact conversion of the text of a number to a double. The
+       text must have already been validated. Only used for rare cases in which
+       decimalToDouble_ fails.*/
+    double asciiToDouble_(const std::string &text);
+
+    /** Helper functions for parseInt() and parseDouble() that work on encoded
+     * string data.*/
+    template <class Element> struct NumberParser_
+    {
+        typedef typename std::make_unsigned<Element>::type UnsignedElement;
+
+        static uint32_t at(const Element *p) { return static_cast<UnsignedElement>(*p); }
+
+        static bool isDigit(const Element *p) { return at(p) - '0' < 10; }
+
+        /** Adds the decimal digits at p to value (without checking for
+           overflow). Returns the position after the last digit.*/
+        static const Element *parseDigits(const Element *p, const Element *end, uint64_t &value)
+        {
+            typedef std::integral_constant<bool, sizeof(Element) == 1 && !BDN_IS_BIG_ENDIAN> EightDigitBlocks;
+
+            return parseDigits(p, end, value, EightDigitBlocks());
+        }
+
+        static const Element *parseDigits(const Element *p, const Element *end, uint64_t &value,
+                                          std::false_type eightDigitBlocks)
+        {
+            while (p != end && isDigit(p)) {
+                value = value * 10 + (at(p) - '0');
+                ++p;
+            }
+
+            return p;
+        }
+
+        static const Element *parseDigits(const Element *p, const Element *end, uint64_t &value,
+                                          std::true_type eightDigitBlocks)
+        {
+            while (end - p >= 8) {
+                uint64_t block = AsciiBlock_::load(p);
+
+                // the high nibble of each byte must be 3 and the low nibble
+                // must be <= 9 (i.e. adding 6 must not overflow into the high
+                // nibble).
+                if (((block + 0x4646464646464646) | (block - 0x3030303030303030)) & 0x8080808080808080)
+                    break;
+
+                // combine pairs of digits, then pairs of 2-digit numbers, then
+                // pairs of 4-digit numbers. The first digit is in the lowest
+                // byte.
+                block -= 0x3030303030303030;
+                block = (block * 10) + (block >> 8);
+                block = (((block & 0x000000FF000000FF) * 0x000F424000000064) +
+                         (((block >> 16) & 0x000000FF000000FF) * 0x0000271000000001)) >>
+                        32;
+
+                value = value * 100000000 + uint32_t(block);
+                p += 8;
+            }
+
+            return parseDigits(p, end, value, std::false_type());
+        }
+
+        /** Returns true if the text at p (up to end) equals the lower case
+         * ASCII text \c lowerCaseText, ignoring case.*/
+        static bool equalsIgnoringAsciiCase(const Element *p, const Element *end, const char *lowerCaseText)
+        {
+            for (; p != end; ++p, ++lowerCaseText) {
+                uint32_t chr = at(p);
+                if (chr >= 'A' && chr <= 'Z')
+                    chr += 0x20;
+
+                if (*lowerCaseText == 0 || chr != uint32_t(*lowerCaseText))
+                    return false;
+            }
+
+            return *lowerCaseText == 0;
+        }
+
+        template <typename T> static Nullable<T> magnitudeToInt(uint64_t magnitude, bool negative)
+        {
+            typedef typename std::make_unsigned<T>::type UnsignedT;
+
+            if (negative) {
+                if (!std::is_signed<T>::value)
+                    return (magnitude == 0) ? Nullable<T>(T(0)) : Nullable<T>();
+
+                if (magnitude > uint64_t(std::numeric_limits<T>::max()) + 1)
+                    return nullptr;
+
+                return T(UnsignedT(0) - UnsignedT(magnitude));
+            }
+
+            if (magnitude > uint64_t(std::numeric_limits<T>::max()))
+                return nullptr;
+
+            return T(magnitude);
+        }
+
+        template <typename T> static Nullable<T> parseInt(const Element *begin, const Element *end)
+        {
+            const Element *p = begin;
+
+            bool negative = false;
+            if (p != end && (at(p) == '-' || at(p) == '+')) {
+                negative = (at(p) == '-');
+                ++p;
+            }
+
+            const Element *digitsBegin = p;
+
+            // leading zeros do not count towards the 19 digits that always fit
+            // into a uint64_t
+            while (p != end && at(p) == '0')
+                ++p;
+
+            uint64_t magnitude = 0;
+            p = parseDigits(p, (end - p > 19) ? (p + 19) : end, magnitude);
+
+            if (p != end && isDigit(p)) {
+                // 20 digits can still fit into uint64_t
+                uint64_t digit = at(p) - '0';
+                if (magnitude > (std::numeric_limits<uint64_t>::max() - digit) / 10)
+                    return nullptr;
+
+                magnitude = magnitude * 10 + digit;
+                ++p;
+            }
+
+            if (p != end || p == digitsBegin)
+                return nullptr;
+
+            return magnitudeToInt<T>(magnitude, negative);
+        }
+
+        static Nullable<double> parseDouble(const Element *begin, const Element *end)
+        {
+            const Element *p = begin;
+
+            DecimalNumber_ number{0, 0, false, false};
+            if (p != end && (at(p) == '-' || at(p) == '+')) {
+                number.negative = (at(p) == '-');
+                ++p;
+            }
+
+            const Element *integerBegin = p;
+            p = parseDigits(p, end, number.mantissa);
+            const Element *integerEnd = p;
+
+            const Element *fractionBegin = p;
+            if (p != end && at(p) == '.') {
+                ++p;
+                fractionBegin = p;
+                p = parseDigits(p, end, number.mantissa);
+            }
+            const Element *fractionEnd = p;
+
+            int64_t digitCount = (integerEnd - integerBegin) + (fractionEnd - fractionBegin);
+            if (digitCount == 0) {
+                if (equalsIgnoringAsciiCase(integerBegin, end, "inf") ||
+                    equalsIgnoringAsciiCase(integerBegin, end, "infinity"))
+                    return number.negative ? -std::numeric_limits<double>::infinity()
+                                           : std::numeric_limits<double>::infinity();
+
+                if (equalsIgnoringAsciiCase(integerBegin, end, "nan"))
+                    return std::numeric_limits<double>::quiet_NaN();
+
+                return nullptr;
+            }
+
+            int64_t explicitExponent = 0;
+            if (p != end && (at(p) == 'e' || at(p) == 'E')) {
+                ++p;
+
+                bool negativeExponent = false;
+                if (p != end && (at(p) == '-' || at(p) == '+')) {
+                    negativeExponent = (at(p) == '-');
+                    ++p;
+                }
+
+                if (p == end || !isDigit(p))
+                    return nullptr;
+
+                for (; p != end && isDigit(p); ++p) {
+                    // bigger exponents make no difference
+                    if (explicitExponent < 0x10000000)
+                        explicitExponent = explicitExponent * 10 + (at(p) - '0');
+                }
+
+                if (negativeExponent)
+                    explicitExponent = -explicitExponent;
+            }
+
+            if (p != end)
+                return nullptr;
+
+            number.exponent = explicitExponent - (fractionEnd - fractionBegin);
+
+            if (digitCount > 19) {
+                // leading zeros are not significant
+                for (const Element *zeroIt = integerBegin; zeroIt != fractionEnd; ++zeroIt) {
+                    if (at(zeroIt) == '0')
+                        digitCount--;
+                    else if (at(zeroIt) != '.')
+                        break;
+                }
+            }
+
+            if (digitCount > 19) {
+                // only use the first 19 significant digits
+                const uint64_t minNineteenDigitValue = 1000000000000000000;
+
+                number.truncated = true;
+                number.mantissa = 0;
+
+                const Element *digitIt = integerBegin;
+                while (number.mantissa < minNineteenDigitValue && digitIt != integerEnd) {
+                    number.mantissa = number.mantissa * 10 + (at(digitIt) - '0');
+                    ++digitIt;
+                }
+
+                if (number.mantissa >= minNineteenDigitValue)
+                    number.exponent = explicitExponent + (integerEnd - digitIt);
+                else {
+                    digitIt = fractionBegin;
+                    while (number.mantissa < minNineteenDigitValue && digitIt != fractionEnd) {
+                        number.mantissa = number.mantissa * 10 + (at(digitIt) - '0');
+                        ++digitIt;
+                    }
+
+                    number.exponent = explicitExponent - (digitIt - fractionBegin);
+                }
+            }
+
+            double result;
+            if (!decimalToDouble_(number, result))
+                result = asciiToDouble_(std::string(begin, end));
+
+            return result;
+        }
+    };
+
+    /** Parses a decimal integer from encoded string data. See
+     * parseInt(const StringImpl<MainDataType>&).*/
+    template <typename T, class Element> inline Nullable<T> parseInt(const Element *begin, const Element *end)
+    {
+        static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value,
+                      "parseInt can only be used with integer types.");
+
+        return NumberParser_<Element>::template parseInt<T>(begin, end);
+    }
+
+    /** Parses the string as a decimal integer of type T.
+
+        The string must consist of an optional sign (+ or -), followed by one
+       or more decimal digits. Whitespace and other characters are not
+       allowed. The format is independent of the current locale.
+
+        Returns null if the string does not have the correct format or if the
+       value does not fit into T.
+
+        The digits are parsed directly from the encoded string data, without
+       any conversion or memory allocation.
+
+        Example:
+
+        \code
+        Nullable<int> value = parseInt<int>(text);
+        if (value.isNull())
+            ... invalid input
+        \endcode
+    */
+    template <typename T, class MainDataType> inline Nullable<T> parseInt(const StringImpl<MainDataType> &s)
+    {
+        StringViewImpl<MainDataType> view(s);
+        return parseInt<T>(view.getEncodedBegin(), view.getEncodedEnd());
+    }
+
+    /** Parses the viewed string as a decimal integer of type T. See
+     * parseInt(const StringImpl<MainDataType>&).*/
+    template <typename T, class MainDataType> inline Nullable<T> parseInt(const StringViewImpl<MainDataType> &view)
+    {
+        return parseInt<T>(view.getEncodedBegin(), view.getEncodedEnd());
+    }
+
+    /** Parses a floating point number from encoded string data. See
+     * parseDouble(const StringImpl<MainDataType>&).*/
+    template <class Element> inline Nullable<double> parseDouble(const Element *begin, const Element *end)
+    {
+        return NumberParser_<Element>::parseDouble(begin, end);
+    }
+
+    /** Parses the string as a floating point number.
+
+        The string must have the format [sign] digits [. digits] [e [sign]
+       digits], with at least one digit before or after the decimal point. The
+       decimal point is always a dot and the format is independent of the
+       current locale. "inf", "infinity" and "nan" (ignoring case, with an
+       optional sign) are also accepted. Whitespace is not allowed.
+
+        The result is the double value that is closest to the decimal number
+       (with ties rounded to even), like the result of std::strtod.
+
+        Returns null if the string does not have the correct format. Values
+       that are too big for a double are returned as infinity and values that
+       are too small are returned as 0.
+    */
+    template <class MainDataType> inline Nullable<double> parseDouble(const StringImpl<MainDataType> &s)
+    {
+        StringViewImpl<MainDataType> view(s);
+        return parseDouble(view.getEncodedBegin(), view.getEncodedEnd());
+    }
+
+    /** Parses the viewed string as a floating point number. See
+     * parseDouble(const StringImpl<MainDataType>&).*/
+    template <class MainDataType> inline Nullable<double> parseDouble(const StringViewImpl<MainDataType> &view)
+    {
+        return parseDouble(view.getEncodedBegin(), view.getEncodedEnd());
+    }
+}
+
+#endif
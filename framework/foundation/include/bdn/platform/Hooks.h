@@ -5,6 +5,8 @@
 
 #include <bdn/log.h>
 
+#include <memory>
+
 namespace bdn
 {
     namespace platform
@@ -3,10 +3,38 @@
 
 #include <bdn/PlainPropertyReadAccessor.h>
 #include <bdn/PropertyNotifier.h>
+#include <bdn/IPropertyNotificationPolicyProvider.h>
+
+#include <type_traits>
 
 namespace bdn
 {
 
+    template <typename VALUE_TYPE, class OWNER_TYPE>
+    void applyOwnerNotificationPolicy_(PropertyNotifier<VALUE_TYPE> *, const OWNER_TYPE *, std::false_type)
+    {}
+
+    template <typename VALUE_TYPE, class OWNER_TYPE>
+    void applyOwnerNotificationPolicy_(PropertyNotifier<VALUE_TYPE> *notifier, const OWNER_TYPE *owner, std::true_type)
+    {
+        notifier->setNotificationPolicy(owner->getPropertyNotificationPolicy());
+    }
+
+    /** Creates the "changed" notifier for a property of the specified owner.
+        If the owner implements IPropertyNotificationPolicyProvider then its
+       policy is applied to the notifier. Used by \ref
+       BDN_PROPERTY_CHANGED_DEFAULT_IMPLEMENTATION.*/
+    template <typename VALUE_TYPE, class OWNER_TYPE>
+    P<PropertyNotifier<VALUE_TYPE>> newPropertyNotifier_(const OWNER_TYPE *owner)
+    {
+        P<PropertyNotifier<VALUE_TYPE>> notifier = newObj<PropertyNotifier<VALUE_TYPE>>();
+
+        applyOwnerNotificationPolicy_(notifier.getPtr(), owner,
+                                      std::is_base_of<IPropertyNotificationPolicyProvider, OWNER_TYPE>());
+
+        return notifier;
+    }
+
 /** \def BDN_FINALIZE_CUSTOM_PROPERTY_WITH_CUSTOM_ACCESS( valueType, readAccess,
    name, writeAccess, setterName, ...)
 
@@ -174,6 +202,9 @@ namespace bdn
    notifier. In the current implementation, the notifier object is allocated
     dynamically on first use - so it adds only minimal overhead when not used.
 
+    If the owner implements IPropertyNotificationPolicyProvider then the
+   owner's notification policy is applied to the notifier when it is created.
+
     \param valueType the type of the internal property value. This must be a
    valid C++ type or class name. \param propertyName the name of the property
     \param ... The last parameter is optional. It can either be omitted or it
@@ -188,7 +219,7 @@ namespace bdn
     virtual bdn::IPropertyNotifier<valueType> &propertyName##Changed() const __VA_ARGS__                               \
     {                                                                                                                  \
         if (_propertyChanged_##propertyName == nullptr)                                                                \
-            _propertyChanged_##propertyName = bdn::newObj<bdn::PropertyNotifier<valueType>>();                         \
+            _propertyChanged_##propertyName = bdn::newPropertyNotifier_<valueType>(this);                              \
         return *_propertyChanged_##propertyName;                                                                       \
     }                                                                                                                  \
                                                                                                                        \
@@ -386,19 +417,53 @@ namespace bdn
     }                                                                                                                  \
     using PropertyValueType_##name = valueType;
 
-    template <typename VALUE_TYPE, typename OWNER_TYPE, typename SETTER_METHOD_TYPE>
-    std::function<void(const VALUE_TYPE &)> _makePropertySubscriber(OWNER_TYPE *owner,
-                                                                    SETTER_METHOD_TYPE &&setterMethod)
+    /** Internal class. Do not use directly.
+        Subscriber function object that is created by _makePropertySubscriber
+       and _makePropertySubscriberWithFilter.*/
+    template <typename VALUE_TYPE, typename OWNER_TYPE, typename SETTER_METHOD_TYPE, typename FILTER_FUNC_TYPE>
+    class PropertySubscriber_
     {
-        WeakP<OWNER_TYPE> weakOwner(owner);
+      public:
+        typedef void WeakCallableTag_;
+
+        PropertySubscriber_(OWNER_TYPE *owner, SETTER_METHOD_TYPE setterMethod, FILTER_FUNC_TYPE filterFunc)
+            : _weakOwner(owner), _setterMethod(setterMethod), _filterFunc(filterFunc)
+        {}
+
+        void operator()(const VALUE_TYPE &value) const
+        {
+            P<OWNER_TYPE> strongOwner = _weakOwner.toStrong();
+            if (strongOwner == nullptr) {
+                // the notifier can detect this without an exception
+                if (DanglingCallScope_::markDanglingIfTarget<void(const VALUE_TYPE &)>(this))
+                    return;
 
-        return [weakOwner, setterMethod](const VALUE_TYPE &value) {
-            P<OWNER_TYPE> strongOwner = weakOwner.toStrong();
-            if (strongOwner == nullptr)
                 throw DanglingFunctionError();
+            }
+
+            ((*strongOwner).*_setterMethod)(_filterFunc(value));
+        }
+
+      private:
+        WeakP<OWNER_TYPE> _weakOwner;
+        SETTER_METHOD_TYPE _setterMethod;
+        FILTER_FUNC_TYPE _filterFunc;
+    };
+
+    /** Internal helper. Do not use directly.
+        Filter that passes the value through unchanged.*/
+    template <typename VALUE_TYPE> struct PropertySubscriberIdentityFilter_
+    {
+        const VALUE_TYPE &operator()(const VALUE_TYPE &value) const { return value; }
+    };
 
-            ((*strongOwner).*setterMethod)(value);
-        };
+    template <typename VALUE_TYPE, typename OWNER_TYPE, typename SETTER_METHOD_TYPE>
+    std::function<void(const VALUE_TYPE &)> _makePropertySubscriber(OWNER_TYPE *owner,
+                                                                    SETTER_METHOD_TYPE &&setterMethod)
+    {
+        return PropertySubscriber_<VALUE_TYPE, OWNER_TYPE, typename std::decay<SETTER_METHOD_TYPE>::type,
+                                   PropertySubscriberIdentityFilter_<VALUE_TYPE>>(
+            owner, setterMethod, PropertySubscriberIdentityFilter_<VALUE_TYPE>());
     }
 
     template <typename VALUE_TYPE, typename OWNER_TYPE, typename SETTER_METHOD_TYPE, typename FILTER_FUNC_TYPE>
@@ -406,15 +471,8 @@ namespace bdn
                                                                               SETTER_METHOD_TYPE &&setterMethod,
                                                                               FILTER_FUNC_TYPE &&filterFunc)
     {
-        WeakP<OWNER_TYPE> weakOwner(owner);
-
-        return [weakOwner, setterMethod, filterFunc](const VALUE_TYPE &value) {
-            P<OWNER_TYPE> strongOwner = weakOwner.toStrong();
-            if (strongOwner == nullptr)
-                throw DanglingFunctionError();
-
-            ((*strongOwner).*setterMethod)(filterFunc(value));
-        };
+        return PropertySubscriber_<VALUE_TYPE, OWNER_TYPE, typename std::decay<SETTER_METHOD_TYPE>::type,
+                                   typename std::decay<FILTER_FUNC_TYPE>::type>(owner, setterMethod, filterFunc);
     }
 
 /** \def BDN_BIND_TO_PROPERTY( receiverOwner, receiverSetterName, senderOwner,
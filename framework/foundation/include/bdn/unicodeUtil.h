@@ -0,0 +1,173 @@
+#ifndef BDN_unicodeUtil_H_
+#define BDN_unicodeUtil_H_
+
+#include <cstdint>
+#include <cstring>
+
+namespace bdn
+{
+
+    /** The kinds of case conversion that mapCharCase() can perform.*/
+    enum class CaseMapping
+    {
+        /** Conversion to lower case.*/
+        toLower,
+
+        /** Conversion to upper case.*/
+        toUpper,
+
+        /** Unicode case folding. Case folding removes the differences between
+           upper and lower case, so that two strings that only differ in case
+           have the same case folded form. It is used for case insensitive
+           comparisons. For most characters the case folded form is the lower
+           case form.*/
+        fold
+    };
+
+    /** The maximum number of characters that mapCharCase() produces for a
+     * single character.*/
+    constexpr int maxCharCaseMappingLength = 3;
+
+    int mapCharCaseWithTables_(char32_t chr, CaseMapping mapping, char32_t *result);
+
+    /** Converts the case of a single unicode character.
+
+        The result is written to \c result, which must have room for
+       maxCharCaseMappingLength characters. The number of characters that were
+       written is returned. Most characters map to a single character, but
+       some map to multiple ones (for example, the upper case form of the
+       German "sharp s" is "SS").
+
+        The full case mappings of the Unicode Character Database are used (from
+       UnicodeData.txt, SpecialCasing.txt and CaseFolding.txt). Rules that
+       depend on the locale (e.g. the Turkish dotless i) or on the surrounding
+       characters (e.g. the Greek final sigma) are not applied.
+
+        Characters that do not have a case mapping are returned unchanged.
+    */
+    inline int mapCharCase(char32_t chr, CaseMapping mapping, char32_t *result)
+    {
+        if (chr < 0x80) {
+            if (mapping == CaseMapping::toUpper)
+                result[0] = (chr >= 'a' && chr <= 'z') ? (chr - 0x20) : chr;
+            else
+                result[0] = (chr >= 'A' && chr <= 'Z') ? (chr + 0x20) : chr;
+
+            return 1;
+        }
+
+        return mapCharCaseWithTables_(chr, mapping, result);
+    }
+
+    /** Returns true if the specified character is a whitespace character
+       (including the unicode whitespace characters). These are the characters
+       returned by String::getWhitespaceChars().*/
+    inline bool isWhitespaceChar(char32_t chr)
+    {
+        if (chr < 0x80) {
+            // bitmap of the ASCII whitespace characters 0x09-0x0d and 0x20
+            const uint64_t asciiWhitespaceBits = 0x100003e00;
+
+            return chr < 64 && ((asciiWhitespaceBits >> chr) & 1) != 0;
+        }
+
+        return (chr == 0x85 || chr == 0xa0 || chr == 0x1680 || (chr >= 0x2000 && chr <= 0x200a) || chr == 0x2028 ||
+                chr == 0x2029 || chr == 0x202f || chr == 0x205f || chr == 0x3000);
+    }
+
+    /** Reads the case folded characters of a character sequence one by one.
+       Used for case insensitive comparisons.
+
+        CharIterator must be an iterator that returns unicode characters.*/
+    template <class CharIterator> class CaseFoldingReader_
+    {
+      public:
+        CaseFoldingReader_(const CharIterator &beginIt, const CharIterator &endIt) : _it(beginIt), _endIt(endIt) {}
+
+        /** Stores the next case folded character in \c chr. Returns false if
+         * the end of the sequence was reached.*/
+        bool next(char32_t &chr)
+        {
+            if (_foldedIndex < _foldedLength) {
+                chr = _folded[_foldedIndex++];
+                return true;
+            }
+
+            if (_it == _endIt)
+                return false;
+
+            chr = *_it;
+            ++_it;
+
+            if (chr < 0x80) {
+                if (chr >= 'A' && chr <= 'Z')
+                    chr += 0x20;
+            } else {
+                _foldedLength = mapCharCaseWithTables_(chr, CaseMapping::fold, _folded);
+                _foldedIndex = 1;
+                chr = _folded[0];
+            }
+
+            return true;
+        }
+
+      private:
+        CharIterator _it;
+        CharIterator _endIt;
+
+        char32_t _folded[maxCharCaseMappingLength];
+        int _foldedLength = 0;
+        int _foldedIndex = 0;
+    };
+
+    /** Helper functions that process 8 ASCII characters at once. The
+       characters are stored as bytes in a uint64_t (in memory order).*/
+    struct AsciiBlock_
+    {
+        enum
+        {
+            size = 8
+        };
+
+        static uint64_t load(const void *p)
+        {
+            uint64_t block;
+            std::memcpy(&block, p, size);
+            return block;
+        }
+
+        static void store(uint64_t block, void *p) { std::memcpy(p, &block, size); }
+
+        /** Returns true if all bytes in the block are ASCII characters.*/
+        static bool isAscii(uint64_t block) { return (block & 0x8080808080808080) == 0; }
+
+        /** Returns a block that has the value 0x20 in all bytes whose
+           character changes with the specified case mapping, and 0 in all
+           other bytes. XOR-ing this with the block performs the case mapping.
+
+            The block must only contain ASCII characters.*/
+        static uint64_t getCaseMappingMask(uint64_t block, CaseMapping mapping)
+        {
+            if (mapping == CaseMapping::toUpper)
+                return getRangeMask(block, 'a', 'z');
+            else
+                return getRangeMask(block, 'A', 'Z');
+        }
+
+      private:
+        static uint64_t getRangeMask(uint64_t block, uint8_t first, uint8_t last)
+        {
+            const uint64_t ones = 0x0101010101010101;
+
+            // the highest bit of each byte is set if the character is >=
+            // first (or > last, respectively). Since the characters are < 0x80
+            // there is no carry into the next byte.
+            uint64_t atLeastFirst = block + ones * (0x80 - first);
+            uint64_t aboveLast = block + ones * (0x7f - last);
+
+            return ((atLeastFirst ^ aboveLast) & (ones * 0x80)) >> 2;
+        }
+    };
+}
+
+#endif
@@ -37,6 +37,8 @@ namespace bdn
             {
                 bdn::java::JNativeOnceRunnable runnable([func]() {
                     try {
+                        DanglingCallScope_ danglingScope(func);
+
                         func();
                     }
                     catch (DanglingFunctionError &) {
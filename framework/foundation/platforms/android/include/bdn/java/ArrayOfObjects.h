@@ -3,6 +3,11 @@
 
 #include <bdn/java/JObject.h>
 #include <bdn/java/Env.h>
+#include <bdn/java/LocalFrame.h>
+
+#include <bdn/Array.h>
+
+#include <algorithm>
 
 namespace bdn
 {
@@ -77,6 +82,72 @@ namespace bdn
                 env.throwAndClearExceptionFromLastJavaCall();
             }
 
+            /** Calls \c visitor for each element of the array, in order. The
+             * visitor receives the element as a JNI local reference (jobject).
+             *
+             *  This is the bulk path for reading arrays. Unlike getElement() it
+             * does not create a global reference for each element. The local
+             * references are released in blocks by LocalFrame objects, so the
+             * number of live local references stays bounded, no matter how big
+             * the array is.
+             *
+             *  The local reference passed to the visitor is only valid during
+             * the call. The visitor must not delete it and must not store it.
+             * If it needs to keep the element then it can convert it with
+             * Reference::convertExternalLocal().*/
+            template <class VISITOR> void visitElements_(VISITOR visitor)
+            {
+                bdn::java::Env &env = bdn::java::Env::get();
+                JNIEnv *jniEnv = env.getJniEnv();
+
+                jobjectArray javaRef = (jobjectArray)getJObject_();
+
+                jsize length = jniEnv->GetArrayLength(javaRef);
+                env.throwAndClearExceptionFromLastJavaCall();
+
+                const jsize blockSize = 64;
+
+                for (jsize blockStart = 0; blockStart < length; blockStart += blockSize) {
+                    jsize blockEnd = std::min(blockStart + blockSize, length);
+
+                    LocalFrame frame(blockSize);
+
+                    for (jsize i = blockStart; i < blockEnd; i++) {
+                        jobject element = jniEnv->GetObjectArrayElement(javaRef, i);
+
+                        env.throwAndClearExceptionFromLastJavaCall();
+
+                        visitor(element);
+                    }
+                }
+            }
+
+            /** Sets the elements of the array, starting at index \c start, to
+             * the specified elements.
+             *
+             *  This is more efficient than calling setElement() in a loop,
+             * since the array reference and the JNI environment are only
+             * retrieved once.*/
+            void setElements_(size_t start, const Array<ELEMENT_TYPE> &elements)
+            {
+                bdn::java::Env &env = bdn::java::Env::get();
+                JNIEnv *jniEnv = env.getJniEnv();
+
+                jobjectArray javaRef = (jobjectArray)getJObject_();
+
+                size_t index = start;
+                for (const ELEMENT_TYPE &element : elements) {
+                    jniEnv->SetObjectArrayElement(javaRef, index, const_cast<ELEMENT_TYPE &>(element).getJObject_());
+
+                    // ArrayIndexOutOfBoundsException or ArrayStoreException
+                    // leave the JNI environment in an exception state. So we
+                    // must check after every call.
+                    env.throwAndClearExceptionFromLastJavaCall();
+
+                    index++;
+                }
+            }
+
             /** Returns the JClass object for this class.
              *
              *  Note that the returned class object is not necessarily unique
@@ -0,0 +1,138 @@
+#ifndef BDN_JAVA_ArrayOfPrimitives_H_
+#define BDN_JAVA_ArrayOfPrimitives_H_
+
+#include <bdn/java/JObject.h>
+#include <bdn/java/Env.h>
+
+namespace bdn
+{
+    namespace java
+    {
+
+        /** Maps a JNI primitive type to the JNI functions that operate on
+         * arrays of that type. Used internally by ArrayOfPrimitives.*/
+        template <typename JAVA_TYPE> struct PrimitiveArrayTraits_;
+
+        template <> struct PrimitiveArrayTraits_<jint>
+        {
+            static const char *getElementTypeName() { return "int"; }
+
+            static jarray newArray(JNIEnv *env, jsize length) { return env->NewIntArray(length); }
+
+            static void getRegion(JNIEnv *env, jarray array, jsize start, jsize count, jint *dest)
+            {
+                env->GetIntArrayRegion((jintArray)array, start, count, dest);
+            }
+
+            static void setRegion(JNIEnv *env, jarray array, jsize start, jsize count, const jint *source)
+            {
+                env->SetIntArrayRegion((jintArray)array, start, count, source);
+            }
+        };
+
+        /** Helper to handle Java arrays of primitive types (e.g. int[]).
+         *
+         *  Unlike ArrayOfObjects the elements are not accessed one by one.
+         * Instead, whole regions of the array are copied in a single JNI call
+         * (see getRegion_() and setRegion_()). That makes it well suited for
+         * passing bulk data between the native and the Java side with a
+         * single transition.
+         *
+         *  Use the ArrayOfInts typedef instead of instantiating the template
+         * directly. Other element types can be supported by adding a
+         * PrimitiveArrayTraits_ specialization.
+         * */
+        template <typename JAVA_TYPE> class ArrayOfPrimitives : public JObject
+        {
+          private:
+            typedef PrimitiveArrayTraits_<JAVA_TYPE> Traits;
+
+            static Reference _makeArray(size_t length)
+            {
+                Env &env = Env::get();
+
+                jarray result = Traits::newArray(env.getJniEnv(), (jsize)length);
+
+                env.throwAndClearExceptionFromLastJavaCall();
+
+                return Reference::convertAndDestroyOwnedLocal(result);
+            }
+
+          public:
+            /** @param objectRef the reference to the Java object.
+             *      The JObject instance will copy this reference and keep its
+             * type. So if you want the JObject instance to hold a strong
+             * reference then you need to call toStrong() on the reference first
+             * and pass the result.
+             *      */
+            explicit ArrayOfPrimitives(const Reference &objectRef) : JObject(objectRef) {}
+
+            /** Creates a new Java array with the specified number of elements.
+             * All elements are initialized to zero.*/
+            explicit ArrayOfPrimitives(size_t length) : JObject(_makeArray(length)) {}
+
+            /** Creates a new Java array and initializes it with a copy of the
+             * specified elements.*/
+            ArrayOfPrimitives(const JAVA_TYPE *elements, size_t count) : JObject(_makeArray(count))
+            {
+                if (count > 0)
+                    setRegion_(0, count, elements);
+            }
+
+            size_t getLength()
+            {
+                Env &env = Env::get();
+
+                jsize result = env.getJniEnv()->GetArrayLength((jarray)getJObject_());
+
+                env.throwAndClearExceptionFromLastJavaCall();
+
+                return (size_t)result;
+            }
+
+            /** Copies \c count elements, starting at index \c start, into the
+             * specified native buffer.*/
+            void getRegion_(size_t start, size_t count, JAVA_TYPE *dest)
+            {
+                Env &env = Env::get();
+
+                Traits::getRegion(env.getJniEnv(), (jarray)getJObject_(), (jsize)start, (jsize)count, dest);
+
+                env.throwAndClearExceptionFromLastJavaCall();
+            }
+
+            /** Copies \c count elements from the specified native buffer into
+             * the array, starting at index \c start.*/
+            void setRegion_(size_t start, size_t count, const JAVA_TYPE *source)
+            {
+                Env &env = Env::get();
+
+                Traits::setRegion(env.getJniEnv(), (jarray)getJObject_(), (jsize)start, (jsize)count, source);
+
+                env.throwAndClearExceptionFromLastJavaCall();
+            }
+
+            /** Returns the JClass object for this class.
+             *
+             *  Note that the returned class object is not necessarily unique
+             * for the whole process. You might get different objects if this
+             * function is called from different shared libraries.
+             *
+             *  If you want to check for type equality then you should compare
+             * the type name (see getTypeName() )
+             *  */
+            static JClass &getStaticClass_()
+            {
+                static JClass cls(String(Traits::getElementTypeName()) + "[]");
+
+                return cls;
+            }
+
+            JClass &getClass_() override { return getStaticClass_(); }
+        };
+
+        typedef ArrayOfPrimitives<jint> ArrayOfInts;
+    }
+}
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef BDN_JAVA_DirectByteBufferView_H_
+#define BDN_JAVA_DirectByteBufferView_H_
+
+#include <bdn/java/JByteBuffer.h>
+
+#include <bdn/NativeBuffer.h>
+
+namespace bdn
+{
+    namespace java
+    {
+
+        /** A NativeBuffer that provides native access to the memory of a Java
+         * direct java.nio.ByteBuffer, without copying it.
+         *
+         *  The object holds a strong reference to the Java buffer, so the
+         * memory stays valid as long as the DirectByteBufferView exists.
+         *
+         *  Throws an InvalidArgumentError if the Java buffer is not a direct
+         * buffer.
+         *
+         *  \code
+         *
+         *  P<NativeBuffer> data = newObj<DirectByteBufferView>(javaBuffer);
+         *
+         *  \endcode
+         * */
+        class DirectByteBufferView : public NativeBuffer
+        {
+          public:
+            explicit DirectByteBufferView(JByteBuffer javaBuffer)
+                : NativeBuffer(getBufferData_(javaBuffer), (size_t)javaBuffer.getCapacityBytes_(), true),
+                  _javaBuffer(javaBuffer)
+            {}
+
+            /** Returns the Java buffer whose memory is accessed.*/
+            JByteBuffer getJavaBuffer() const { return _javaBuffer; }
+
+          private:
+            static uint8_t *getBufferData_(JByteBuffer &javaBuffer)
+            {
+                void *data = javaBuffer.getBuffer_();
+
+                // GetDirectBufferAddress returns null for non-direct buffers.
+                if (data == nullptr)
+                    throw InvalidArgumentError("DirectByteBufferView can only be used with direct Java ByteBuffers.");
+
+                return static_cast<uint8_t *>(data);
+            }
+
+            JByteBuffer _javaBuffer;
+        };
+    }
+}
+
+#endif
@@ -3,6 +3,9 @@
 
 #include <bdn/java/JObject.h>
 #include <bdn/java/Env.h>
+#include <bdn/OutOfRangeError.h>
+
+#include <cstring>
 
 namespace bdn
 {
@@ -26,7 +29,7 @@ namespace bdn
         class JByteBuffer : public JObject
         {
           private:
-            Reference newInstance_(void *buffer, int capacityBytes)
+            Reference newInstance_(void *buffer, int64_t capacityBytes)
             {
                 Env &env = Env::get();
 
@@ -79,6 +82,31 @@ namespace bdn
                 return bytes;
             }
 
+            /** Copies \c bytes bytes, starting at \c offset in the buffer, into
+             * the specified native memory.
+             *
+             *  The data is copied directly from the buffer memory with a single
+             * memcpy. No per-element JNI calls are made.
+             *
+             *  Throws an OutOfRangeError if the specified range is not inside
+             * the buffer.*/
+            void copyTo_(int64_t offset, void *dest, int64_t bytes)
+            {
+                if (bytes > 0)
+                    std::memcpy(dest, getRangePointer_(offset, bytes), (size_t)bytes);
+            }
+
+            /** Copies \c bytes bytes from the specified native memory into the
+             * buffer, starting at \c offset.
+             *
+             *  Throws an OutOfRangeError if the specified range is not inside
+             * the buffer.*/
+            void copyFrom_(int64_t offset, const void *source, int64_t bytes)
+            {
+                if (bytes > 0)
+                    std::memcpy(getRangePointer_(offset, bytes), source, (size_t)bytes);
+            }
+
             /** Returns the java class object for the Java object's class.
              *
              *  Note that the returned class object is not necessarily unique
@@ -96,6 +124,24 @@ namespace bdn
             }
 
             JClass &getClass_() override { return getStaticClass_(); }
+
+          private:
+            uint8_t *getRangePointer_(int64_t offset, int64_t bytes)
+            {
+                Env &env = Env::get();
+                JNIEnv *jniEnv = env.getJniEnv();
+
+                jobject obj = getJObject_();
+
+                void *buffer = jniEnv->GetDirectBufferAddress(obj);
+                int64_t capacity = jniEnv->GetDirectBufferCapacity(obj);
+                env.throwAndClearExceptionFromLastJavaCall();
+
+                if (offset < 0 || bytes < 0 || offset + bytes > capacity)
+                    throw OutOfRangeError("JByteBuffer: the specified byte range is outside the buffer.");
+
+                return static_cast<uint8_t *>(buffer) + offset;
+            }
         };
     }
 }
@@ -44,6 +44,8 @@ namespace bdn
              * name with slashes instead of dots. E.g. java/lang/Object instead
              * of java.lang.Object. For Java arrays (e.g. MyClass[]) pass the
              * name of the element type (in slash notation) with [] appended.
+             * Arrays of primitive types use the Java type name of the element
+             * (e.g. int[]).
              *      */
             explicit JClass(const String &classNameInSlashNotation) : JObject(findClass_(classNameInSlashNotation))
             {
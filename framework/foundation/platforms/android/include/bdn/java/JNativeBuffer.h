@@ -0,0 +1,91 @@
+#ifndef BDN_JAVA_JNativeBuffer_H_
+#define BDN_JAVA_JNativeBuffer_H_
+
+#include <bdn/java/JObject.h>
+#include <bdn/java/JByteBuffer.h>
+#include <bdn/java/JNativeStrongPointer.h>
+
+#include <bdn/NativeBuffer.h>
+
+namespace bdn
+{
+    namespace java
+    {
+
+        /** Accessor for Java-side io.boden.java.NativeBuffer objects.
+         *
+         *  These objects expose the memory of a bdn::NativeBuffer to Java as a
+         * direct java.nio.ByteBuffer. The data is not copied.
+         *
+         *  The Java object holds a strong reference to the NativeBuffer, so
+         * the memory stays valid until the Java object is garbage collected or
+         * dispose() is called on it.
+         *
+         *  For the reverse direction (accessing the memory of a Java direct
+         * ByteBuffer from native code) see DirectByteBufferView.
+         * */
+        class JNativeBuffer : public JObject
+        {
+          private:
+            static Reference newInstance_(NativeBuffer *buffer)
+            {
+                JByteBuffer byteBuffer(buffer->getData(), (int64_t)buffer->getSize());
+                JNativeStrongPointer owner(buffer);
+
+                static MethodId constructorId;
+
+                return getStaticClass_().newInstance_(constructorId, byteBuffer, owner);
+            }
+
+          public:
+            /** Creates a new Java-side NativeBuffer object that exposes the
+             * memory of the specified native buffer.*/
+            explicit JNativeBuffer(NativeBuffer *buffer) : JObject(newInstance_(buffer)) {}
+
+            /** @param objectRef the reference to the Java object.
+             *      The JObject instance will copy this reference and keep its
+             * type. So if you want the JObject instance to hold a strong
+             * reference then you need to call toStrong() on the reference first
+             * and pass the result.
+             *      */
+            explicit JNativeBuffer(const Reference &objectRef) : JObject(objectRef) {}
+
+            /** Returns the direct byte buffer that references the native
+             * memory.*/
+            JByteBuffer getByteBuffer()
+            {
+                static MethodId methodId;
+
+                return invoke_<JByteBuffer>(getStaticClass_(), methodId, "getByteBuffer");
+            }
+
+            /** Releases the Java-side reference to the native buffer.*/
+            void dispose()
+            {
+                static MethodId methodId;
+
+                invoke_<void>(getStaticClass_(), methodId, "dispose");
+            }
+
+            /** Returns the JClass object for this class.
+             *
+             *  Note that the returned class object is not necessarily unique
+             * for the whole process. You might get different objects if this
+             * function is called from different shared libraries.
+             *
+             *  If you want to check for type equality then you should compare
+             * the type name (see getTypeName() )
+             *  */
+            static JClass &getStaticClass_()
+            {
+                static JClass cls("io/boden/java/NativeBuffer");
+
+                return cls;
+            }
+
+            JClass &getClass_() override { return getStaticClass_(); }
+        };
+    }
+}
+
+#endif
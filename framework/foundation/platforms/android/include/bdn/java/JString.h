@@ -34,10 +34,16 @@ namespace bdn
 
             JString(const String &inString) : JString(newInstance_(inString)) {}
 
-            String getValue_()
+            String getValue_() { return getValue_((jstring)getJObject_()); }
+
+            /** Returns the value of the specified Java string. \c javaRef can
+             * be a local or a global reference. It must not be null.
+             *
+             *  This can be used to read strings without wrapping each of them
+             * in a JString object (see ArrayOfObjects::visitElements_()).*/
+            static String getValue_(jstring javaRef)
             {
                 JNIEnv *env = Env::get().getJniEnv();
-                jstring javaRef = (jstring)getJObject_();
 
                 const char *data = env->GetStringUTFChars(javaRef, nullptr);
 
@@ -0,0 +1,90 @@
+#ifndef BDN_JAVA_LocalFrame_H_
+#define BDN_JAVA_LocalFrame_H_
+
+#include <bdn/java/Env.h>
+
+namespace bdn
+{
+    namespace java
+    {
+
+        /** Scopes the JNI local references that are created during the
+         * lifetime of the LocalFrame object.
+         *
+         *  The constructor pushes a new JNI local reference frame
+         * (PushLocalFrame) and the destructor pops it again (PopLocalFrame).
+         * All local references that were created in between are freed at that
+         * point, no matter how many there were.
+         *
+         *  This should be used for loops that create many local references
+         * (for example when iterating over child views or over the elements of
+         * a Java array). Without a local frame these loops can overflow the
+         * JNI local reference table.
+         *
+         *  If one local reference must survive the frame then pass it to
+         * popWithResult(). It returns a new local reference to the same object
+         * that is valid in the enclosing frame.
+         *
+         *  \code
+         *
+         *  for (int i = 0; i < childCount; i++) {
+         *      bdn::java::LocalFrame frame(4);
+         *
+         *      ...
+         *  }
+         *
+         *  \endcode
+         *
+         *  LocalFrame objects must be used from the thread that created them
+         * and frames must be popped in the reverse order in which they were
+         * pushed. Simply using them as stack variables takes care of both.
+         * */
+        class LocalFrame
+        {
+          public:
+            /** @param capacity the minimum number of local references that can
+             * be created in the new frame.*/
+            explicit LocalFrame(int capacity = 16)
+            {
+                Env &env = Env::get();
+
+                _jniEnv = env.getJniEnv();
+
+                jint result = _jniEnv->PushLocalFrame(capacity);
+                if (result != 0)
+                    env.throwAndClearExceptionFromLastJavaCall();
+
+                _active = true;
+            }
+
+            ~LocalFrame()
+            {
+                if (_active)
+                    _jniEnv->PopLocalFrame(NULL);
+            }
+
+            LocalFrame(const LocalFrame &) = delete;
+            LocalFrame &operator=(const LocalFrame &) = delete;
+
+            /** Pops the frame early and returns a local reference to the
+             * specified object that is valid in the enclosing frame.
+             *
+             *  After this has been called the destructor does nothing.*/
+            jobject popWithResult(jobject result)
+            {
+                if (!_active)
+                    return NULL;
+
+                _active = false;
+
+                return _jniEnv->PopLocalFrame(result);
+            }
+
+          private:
+            JNIEnv *_jniEnv;
+            bool _active = false;
+        };
+    }
+}
+
+#endif
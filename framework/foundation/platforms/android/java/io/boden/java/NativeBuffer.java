@@ -0,0 +1,41 @@
+package io.boden.java;
+
+import java.nio.ByteBuffer;
+
+/** Provides Java access to a memory block that is owned by native code (a bdn::NativeBuffer object).
+ *
+ *  The memory is exposed as a direct ByteBuffer, so no data is copied between the
+ *  native and the Java side. The NativeBuffer object keeps the native memory alive.
+ *  So Java code must keep a reference to the NativeBuffer object (not only to the ByteBuffer)
+ *  for as long as it accesses the data.
+ *
+ *  dispose() can be called to release the native memory before the object is garbage collected.
+ *  The ByteBuffer must not be used anymore after that.
+ *  */
+public class NativeBuffer extends Object
+{
+    public NativeBuffer(ByteBuffer byteBuffer, NativeStrongPointer owner)
+    {
+        mByteBuffer = byteBuffer;
+        mOwner = owner;
+    }
+
+    public ByteBuffer getByteBuffer()
+    {
+        return mByteBuffer;
+    }
+
+    public void dispose()
+    {
+        mByteBuffer = null;
+
+        if(mOwner!=null)
+        {
+            mOwner.dispose();
+            mOwner = null;
+        }
+    }
+
+    private ByteBuffer mByteBuffer;
+    private NativeStrongPointer mOwner;
+}
@@ -23,13 +23,10 @@ namespace bdn
                     bdn::java::ArrayOfObjects<bdn::java::JString> argArray = extras.getStringArray("commandline-args");
 
                     if (!argArray.isNull_()) {
-                        size_t len = argArray.getLength();
-
-                        for (size_t i = 0; i < len; i++) {
-                            String arg = argArray.getElement(i).getValue_();
-
-                            args.push_back(arg);
-                        }
+                        argArray.visitElements_([&args](jobject element) {
+                            args.push_back(element != NULL ? bdn::java::JString::getValue_((jstring)element)
+                                                           : String());
+                        });
                     }
                 }
             }
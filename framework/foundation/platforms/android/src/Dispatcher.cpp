@@ -39,7 +39,9 @@ namespace bdn
         {
             bool idlePriority = false;
 
-            if (priority == Priority::normal)
+            // the looper only distinguishes between idle and non-idle items.
+            if (priority == Priority::normal || priority == Priority::low || priority == Priority::high ||
+                priority == Priority::urgent)
                 idlePriority = false;
             else if (priority == Priority::idle)
                 idlePriority = true;
@@ -62,6 +64,9 @@ namespace bdn
         {
             bool result;
             try {
+                // a dangling weak method returns false inside this scope
+                DanglingCallScope_ danglingScope(_func);
+
                 result = _func();
             }
             catch (DanglingFunctionError &) {
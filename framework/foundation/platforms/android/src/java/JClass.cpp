@@ -13,6 +13,25 @@ namespace bdn
             if (nameInSlashNotation.endsWith("[]"))
                 return "[" + nameInSlashNotationToSignature_(
                                  nameInSlashNotation.subString(0, nameInSlashNotation.length() - 2));
+
+            // primitive types (these only occur as array element types)
+            else if (nameInSlashNotation == "int")
+                return "I";
+            else if (nameInSlashNotation == "byte")
+                return "B";
+            else if (nameInSlashNotation == "float")
+                return "F";
+            else if (nameInSlashNotation == "double")
+                return "D";
+            else if (nameInSlashNotation == "boolean")
+                return "Z";
+            else if (nameInSlashNotation == "char")
+                return "C";
+            else if (nameInSlashNotation == "short")
+                return "S";
+            else if (nameInSlashNotation == "long")
+                return "J";
+
             else
                 return "L" + nameInSlashNotation + ";";
         }
@@ -30,6 +30,8 @@
         [=]() {
             if (delaySeconds <= 0) {
                 try {
+                    bdn::DanglingCallScope_ danglingScope(func);
+
                     func();
                 }
                 catch (bdn::DanglingFunctionError &) {
@@ -75,6 +77,9 @@
 
                 bool result;
                 try {
+                    // a dangling weak method returns false inside this scope
+                    bdn::DanglingCallScope_ danglingScope(timerFunc);
+
                     result = timerFunc();
                 }
                 catch (bdn::DanglingFunctionError &) {
@@ -198,7 +203,9 @@ namespace bdn
 
         void MainDispatcher::enqueueInSeconds(double seconds, std::function<void()> func, Priority priority)
         {
-            if (priority == Priority::normal) {
+            // we only have separate queues for normal and idle items.
+            if (priority == Priority::normal || priority == Priority::low || priority == Priority::high ||
+                priority == Priority::urgent) {
                 P<MainDispatcher> self = this;
 
                 // we do not schedule the func call directly. Instead we add
@@ -267,6 +274,8 @@ namespace bdn
             }
 
             try {
+                DanglingCallScope_ danglingScope(func);
+
                 func();
             }
             catch (DanglingFunctionError &) {
@@ -286,6 +295,8 @@ namespace bdn
             }
 
             try {
+                DanglingCallScope_ danglingScope(func);
+
                 func();
             }
             catch (DanglingFunctionError &) {
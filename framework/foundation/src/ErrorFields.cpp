@@ -61,7 +61,7 @@ namespace bdn
                 if (!first)
                     result += ", ";
 
-                result += escapeName(item.first) + ": \"" + escapeValue(item.second) + "\"";
+                result += concat(escapeName(item.first), ": \"", escapeValue(item.second), "\"");
 
                 first = false;
             }
@@ -72,27 +72,25 @@ namespace bdn
         }
     }
 
-    String ErrorFields::escapeName(const String &name)
-    {
-        String result = name;
-
-        result.findAndReplace("%", "%25");
-        result.findAndReplace("]]", "%5d%5d");
-        result.findAndReplace(":", "%3a");
+    // the escapers are created once and then shared by all threads.
 
-        return result;
-    }
+    class ErrorFieldsNameEscaper_ : public StringReplacer
+    {
+      public:
+        ErrorFieldsNameEscaper_() : StringReplacer({{"%", "%25"}, {"]]", "%5d%5d"}, {":", "%3a"}}) {}
+    };
+    BDN_SAFE_STATIC_IMPL(ErrorFieldsNameEscaper_, _getErrorFieldsNameEscaper);
 
-    String ErrorFields::escapeValue(const String &value)
+    class ErrorFieldsValueEscaper_ : public StringReplacer
     {
-        String result = value;
+      public:
+        ErrorFieldsValueEscaper_() : StringReplacer({{"%", "%25"}, {"]]", "%5d%5d"}, {"\"", "%22"}}) {}
+    };
+    BDN_SAFE_STATIC_IMPL(ErrorFieldsValueEscaper_, _getErrorFieldsValueEscaper);
 
-        result.findAndReplace("%", "%25");
-        result.findAndReplace("]]", "%5d%5d");
-        result.findAndReplace("\"", "%22");
+    String ErrorFields::escapeName(const String &name) { return _getErrorFieldsNameEscaper().getReplaced(name); }
 
-        return result;
-    }
+    String ErrorFields::escapeValue(const String &value) { return _getErrorFieldsValueEscaper().getReplaced(value); }
 
     String ErrorFields::unescape(const String &value) { return Uri::unescape(value); }
 }
@@ -12,6 +12,10 @@ namespace bdn
         std::function<void()> func;
         if (getNextReady(func, true)) {
             try {
+                // weak methods whose object is gone do not throw inside this
+                // scope. They simply do nothing.
+                DanglingCallScope_ danglingScope(func);
+
                 func();
             }
             catch (DanglingFunctionError &) {
@@ -108,18 +112,93 @@ namespace bdn
 
         enqueueTimedItemsIfTimeReached();
 
-        // go through the queues in priority order and handle one item
-        for (int priorityIndex = priorityCount - 1; priorityIndex >= 0; priorityIndex--) {
-            List<std::function<void()>> &queue = _queues[priorityIndex];
-
-            if (!queue.empty()) {
-                func = queue.front();
-                if (remove)
-                    queue.pop_front();
-                return true;
+        if (!remove) {
+            for (PriorityQueue_ &queue : _queues) {
+                if (!queue.empty())
+                    return true;
             }
+
+            return false;
         }
 
-        return false;
+        TimePoint now = Clock::now();
+
+        PriorityQueue_ *selectedQueue = nullptr;
+        bool selectedDeadlineItem = false;
+
+        // items whose deadline has passed come first, the most overdue one
+        // first.
+        for (PriorityQueue_ &queue : _queues) {
+            if (!queue.deadlineItems.empty()) {
+                TimePoint deadline = queue.deadlineItems.begin()->first;
+
+                if (deadline <= now &&
+                    (selectedQueue == nullptr || deadline < selectedQueue->deadlineItems.begin()->first)) {
+                    selectedQueue = &queue;
+                    selectedDeadlineItem = true;
+                }
+            }
+        }
+
+        if (selectedQueue == nullptr) {
+            // select the item with the highest effective priority. Since the
+            // items of each queue are ordered, only the first items of each
+            // queue need to be considered. If aging is enabled then the
+            // effective priority is the base priority plus one level for each
+            // aging interval that the item has waited. If two items have the
+            // same effective priority then the older one wins.
+            bool aging = (_agingInterval > Duration::zero());
+
+            double bestPriority = 0;
+            TimePoint bestEnqueueTime;
+
+            for (int level = priorityCount - 1; level >= 0; level--) {
+                PriorityQueue_ &queue = _queues[level];
+
+                for (int deadlineItem = 0; deadlineItem < 2; deadlineItem++) {
+                    const QueuedItem_ *candidate = nullptr;
+                    if (deadlineItem) {
+                        if (!queue.deadlineItems.empty())
+                            candidate = &queue.deadlineItems.begin()->second;
+                    } else if (!queue.fifoItems.empty())
+                        candidate = &queue.fifoItems.front();
+
+                    if (candidate == nullptr)
+                        continue;
+
+                    double effectivePriority = level;
+                    if (aging)
+                        effectivePriority += durationToSeconds(now - candidate->enqueueTime) /
+                                             durationToSeconds(_agingInterval);
+
+                    if (selectedQueue == nullptr || effectivePriority > bestPriority ||
+                        (effectivePriority == bestPriority && candidate->enqueueTime < bestEnqueueTime)) {
+                        selectedQueue = &queue;
+                        selectedDeadlineItem = (deadlineItem != 0);
+                        bestPriority = effectivePriority;
+                        bestEnqueueTime = candidate->enqueueTime;
+                    }
+                }
+
+                // without aging a lower level can never win against an item
+                // that we already found.
+                if (!aging && selectedQueue != nullptr)
+                    break;
+            }
+
+            if (selectedQueue == nullptr)
+                return false;
+        }
+
+        if (selectedDeadlineItem) {
+            auto it = selectedQueue->deadlineItems.begin();
+            func = std::move(it->second.func);
+            selectedQueue->deadlineItems.erase(it);
+        } else {
+            func = std::move(selectedQueue->fifoItems.front().func);
+            selectedQueue->fifoItems.pop_front();
+        }
+
+        return true;
     }
 }
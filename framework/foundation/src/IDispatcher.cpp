@@ -1,9 +1,101 @@
 #include <bdn/init.h>
 #include <bdn/IDispatcher.h>
 #include <bdn/IAppRunner.h>
+#include <bdn/CancellationToken.h>
+#include <bdn/func.h>
 
 namespace bdn
 {
 
     P<IDispatcher> getMainDispatcher() { return getAppRunner()->getMainDispatcher(); }
+
+    /** Holds a function that was enqueued with a cancellation token. The
+       function is released as soon as the token is cancelled, so that its
+       captures are not kept alive until the dispatcher reaches the item.*/
+    class CancellableCall_ : public Base
+    {
+      public:
+        CancellableCall_(std::function<void()> func, const CancellationToken &token)
+            : _func(std::move(func)), _token(token)
+        {}
+
+        ~CancellableCall_() { _token.removeOnCancel(_subscription); }
+
+        /** Registers the cancellation handler. This is separate from the
+           constructor because the handler may be called right away.
+
+            Must be called before the call is enqueued.*/
+        void subscribe()
+        {
+            WeakP<CancellableCall_> callWeak(this);
+
+            // the handler must not keep the call alive, or the token would
+            // keep the function alive.
+            _subscription = _token.onCancel([callWeak]() {
+                P<CancellableCall_> call = callWeak.toStrong();
+                if (call != nullptr)
+                    call->release();
+            });
+        }
+
+        void call()
+        {
+            std::function<void()> func;
+            {
+                Mutex::Lock lock(_mutex);
+                func.swap(_func);
+            }
+
+            if (func && !_token.isCancelled()) {
+                // the dispatcher only sees our wrapper. So we provide the scope
+                // in which weak methods can report a dangling object without
+                // throwing.
+                DanglingCallScope_ danglingScope(func);
+
+                func();
+            }
+        }
+
+        void release()
+        {
+            std::function<void()> func;
+            {
+                Mutex::Lock lock(_mutex);
+                func.swap(_func);
+            }
+
+            // the function (and its captures) is destroyed here, without the
+            // mutex.
+        }
+
+      private:
+        Mutex _mutex;
+        std::function<void()> _func;
+
+        CancellationToken _token;
+        P<INotifierSubscription> _subscription;
+    };
+
+    void IDispatcher::enqueueCancellable(const CancellationToken &token, std::function<void()> func, Priority priority)
+    {
+        if (token.isCancelled())
+            return;
+
+        P<CancellableCall_> call = newObj<CancellableCall_>(std::move(func), token);
+        call->subscribe();
+
+        enqueue([call]() { call->call(); }, priority);
+    }
+
+    void IDispatcher::enqueueInSecondsCancellable(const CancellationToken &token, double seconds,
+                                                  std::function<void()> func, Priority priority)
+    {
+        if (token.isCancelled())
+            return;
+
+        P<CancellableCall_> call = newObj<CancellableCall_>(std::move(func), token);
+        call->subscribe();
+
+        enqueueInSeconds(seconds, [call]() { call->call(); }, priority);
+    }
 }
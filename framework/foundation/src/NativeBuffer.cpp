@@ -0,0 +1,90 @@
+#include <bdn/init.h>
+#include <bdn/NativeBuffer.h>
+
+#if BDN_PLATFORM_FAMILY_POSIX
+#include <bdn/errno.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <new>
+
+namespace bdn
+{
+
+    namespace
+    {
+        class HeapNativeBuffer_ : public NativeBuffer
+        {
+          public:
+            HeapNativeBuffer_(size_t size) : NativeBuffer(allocateMemory(size), size, true) {}
+
+            ~HeapNativeBuffer_() { ::operator delete(getData()); }
+
+          private:
+            static uint8_t *allocateMemory(size_t size)
+            {
+                // operator new returns memory that is suitably aligned for any
+                // fundamental type. We never pass 0, so that we always get a
+                // valid pointer.
+                return static_cast<uint8_t *>(::operator new(size == 0 ? 1 : size));
+            }
+        };
+
+#if BDN_PLATFORM_FAMILY_POSIX
+        class MappedFileNativeBuffer_ : public NativeBuffer
+        {
+          public:
+            MappedFileNativeBuffer_(void *mappedData, size_t size)
+                : NativeBuffer(static_cast<uint8_t *>(mappedData), size, false)
+            {}
+
+            ~MappedFileNativeBuffer_()
+            {
+                if (getSize() > 0)
+                    ::munmap(getData(), getSize());
+            }
+        };
+#endif
+    }
+
+    P<NativeBuffer> NativeBuffer::allocate(size_t size) { return newObj<HeapNativeBuffer_>(size); }
+
+#if BDN_PLATFORM_FAMILY_POSIX
+    P<NativeBuffer> NativeBuffer::mapFile(const String &path)
+    {
+        int fd = ::open(path.asUtf8Ptr(), O_RDONLY);
+        if (fd == -1)
+            throw errnoCodeToSystemError(errno, ErrorFields().add("path", path));
+
+        struct stat fileInfo;
+        if (::fstat(fd, &fileInfo) != 0) {
+            int errorCode = errno;
+            ::close(fd);
+            throw errnoCodeToSystemError(errorCode, ErrorFields().add("path", path));
+        }
+
+        size_t size = (size_t)fileInfo.st_size;
+        void *mappedData = nullptr;
+
+        // mmap does not support empty mappings. Empty files simply get an
+        // empty buffer.
+        if (size > 0) {
+            mappedData = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mappedData == MAP_FAILED) {
+                int errorCode = errno;
+                ::close(fd);
+                throw errnoCodeToSystemError(errorCode, ErrorFields().add("path", path));
+            }
+        }
+
+        // the mapping stays valid after the file descriptor is closed.
+        ::close(fd);
+
+        return newObj<MappedFileNativeBuffer_>(mappedData, size);
+    }
+#endif
+}
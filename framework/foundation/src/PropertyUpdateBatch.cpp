@@ -0,0 +1,55 @@
+#include <bdn/init.h>
+#include <bdn/PropertyUpdateBatch.h>
+
+namespace bdn
+{
+
+    PropertyUpdateBatch_::State_ &PropertyUpdateBatch_::getState_()
+    {
+#if BDN_HAVE_THREADS
+        static thread_local State_ state;
+#else
+        static State_ state;
+#endif
+
+        return state;
+    }
+
+    PropertyUpdateBatch_::PropertyUpdateBatch_() { getState_().depth++; }
+
+    PropertyUpdateBatch_::~PropertyUpdateBatch_()
+    {
+        if (!_ended) {
+            State_ &state = getState_();
+
+            state.depth--;
+            if (state.depth == 0)
+                state.pendingUpdates.clear();
+        }
+    }
+
+    void PropertyUpdateBatch_::end()
+    {
+        State_ &state = getState_();
+
+        if (state.depth == 1) {
+            // we stay active while the updates are executed. The updates
+            // notify other properties, and the resulting updates must only be
+            // added to our queue.
+            while (!state.pendingUpdates.empty()) {
+                std::function<void()> update = std::move(state.pendingUpdates.front());
+                state.pendingUpdates.pop_front();
+
+                update();
+            }
+        }
+
+        state.depth--;
+        _ended = true;
+    }
+
+    void PropertyUpdateBatch_::addPendingUpdate(std::function<void()> update)
+    {
+        getState_().pendingUpdates.push_back(std::move(update));
+    }
+}
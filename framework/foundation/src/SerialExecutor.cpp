@@ -0,0 +1,189 @@
+#include <bdn/init.h>
+#include <bdn/SerialExecutor.h>
+
+#include <bdn/entry.h>
+
+#if BDN_HAVE_THREADS
+
+namespace bdn
+{
+
+    SerialExecutor::SerialExecutor(ThreadPool *pool) : _pool(pool)
+    {
+        if (_pool == nullptr)
+            _pool = getSharedThreadPool();
+    }
+
+    SerialExecutor::~SerialExecutor() { stopJobs(); }
+
+    void SerialExecutor::addJob(IThreadRunnable *runnable)
+    {
+        P<Drainer> drainerToSchedule;
+
+        {
+            Mutex::Lock lock(_mutex);
+
+            _queuedJobs.push_back(runnable);
+
+            if (!_drainScheduled) {
+                // we only ever have one drainer in the pool. That is what
+                // ensures that our jobs do not overlap.
+                if (_drainer == nullptr)
+                    _drainer = newObj<Drainer>(this);
+
+                _drainScheduled = true;
+                drainerToSchedule = _drainer;
+            }
+        }
+
+        // the drainer is added to the pool without holding our mutex. Depending
+        // on the pool's overflow policy, the pool's addJob can block until
+        // there is room in its queue, or run the drainer right here. Both would
+        // deadlock with a drainer that needs our mutex in another thread.
+        if (drainerToSchedule != nullptr) {
+            try {
+                _pool->addJob(drainerToSchedule);
+            }
+            catch (...) {
+                // e.g. QueueFullError. The job stays queued and the next
+                // addJob call tries to schedule the drainer again.
+                Mutex::Lock lock(_mutex);
+                _drainScheduled = false;
+
+                throw;
+            }
+        }
+    }
+
+    int SerialExecutor::getPendingJobCount() const
+    {
+        Mutex::Lock lock(_mutex);
+
+        return (int)_queuedJobs.size() + (_activeJob != nullptr ? 1 : 0);
+    }
+
+    void SerialExecutor::stopJobs()
+    {
+        List<P<IThreadRunnable>> discardedJobs;
+        P<IThreadRunnable> activeJob;
+
+        {
+            Mutex::Lock lock(_mutex);
+
+            discardedJobs.swap(_queuedJobs);
+            activeJob = _activeJob;
+        }
+
+        // we call signalStop without holding the mutex, since the jobs might
+        // call back into our object from their notification handlers.
+        for (auto &job : discardedJobs)
+            job->signalStop();
+
+        if (activeJob != nullptr)
+            activeJob->signalStop();
+    }
+
+    bool SerialExecutor::runNextJob()
+    {
+        P<IThreadRunnable> job;
+
+        {
+            Mutex::Lock lock(_mutex);
+
+            if (_queuedJobs.empty()) {
+                // nothing more to do. The next addJob call will schedule a new
+                // drain.
+                _drainScheduled = false;
+                return false;
+            }
+
+            job = _queuedJobs.front();
+            _queuedJobs.pop_front();
+
+            _activeJob = job;
+        }
+
+        try {
+            job->run();
+        }
+        catch (...) {
+            // same handling as for jobs that run directly in the thread pool.
+            if (!bdn::unhandledException(true))
+                std::terminate();
+
+            // ignore exception and continue with the next job.
+        }
+
+        Mutex::Lock lock(_mutex);
+        _activeJob = nullptr;
+
+        return true;
+    }
+
+    bool SerialExecutor::endTurn()
+    {
+        P<Drainer> drainer;
+
+        {
+            Mutex::Lock lock(_mutex);
+
+            if (_queuedJobs.empty()) {
+                _drainScheduled = false;
+                return false;
+            }
+
+            drainer = _drainer;
+        }
+
+        // if the pool's queue is full then we keep the thread we have. Adding
+        // the drainer would block (we occupy one of the threads that could
+        // make room), run it nested in this call or be rejected.
+        int maxQueuedJobs = _pool->getMaxQueuedJobs();
+        if (maxQueuedJobs >= 0 && _pool->getQueuedJobCount() >= maxQueuedJobs)
+            return true;
+
+        // otherwise we go to the back of the pool's queue, so that other jobs
+        // get a chance to run. As in addJob, we must not hold our mutex while
+        // doing that.
+        try {
+            _pool->addJob(drainer);
+        }
+        catch (QueueFullError &) {
+            // the queue has filled up in the meantime.
+            return true;
+        }
+
+        return false;
+    }
+
+    void SerialExecutor::Drainer::run()
+    {
+        while (true) {
+            for (int i = 0; i < maxJobsPerTurn; i++) {
+                // the executor is only kept alive while one of its jobs runs.
+                // If it is released in the meantime then it is deleted after
+                // the job and the remaining jobs are stopped.
+                P<SerialExecutor> executor = _executorWeak.toStrong();
+
+                if (executor == nullptr || !executor->runNextJob())
+                    return;
+            }
+
+            P<SerialExecutor> executor = _executorWeak.toStrong();
+            if (executor == nullptr || !executor->endTurn())
+                return;
+        }
+    }
+
+    void SerialExecutor::Drainer::signalStop()
+    {
+        // this is called when the thread pool shuts down. Our jobs will not be
+        // executed anymore.
+        P<SerialExecutor> executor = _executorWeak.toStrong();
+
+        if (executor != nullptr)
+            executor->stopJobs();
+    }
+}
+
+#endif
@@ -138,7 +138,7 @@ namespace bdn
                         // iterations. If the system clock has been adjusted
                         // forwards then the timeout will expire "early", but
                         // that is acceptable.
-                        waitResult = _condition.wait_until<std::chrono::steady_clock>(lock, absoluteTimeoutTime);
+                        waitResult = _condition.wait_until(lock, absoluteTimeoutTime);
                     }
 
                     if (waitResult == std::cv_status::timeout) {
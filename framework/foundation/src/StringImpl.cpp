@@ -15,6 +15,19 @@ namespace bdn
 
     template <> BDN_SAFE_STATIC_IMPL(WideStringData, WideStringData::getEmptyData);
 
+    // The common string types are compiled once here. The headers declare
+    // them as extern templates, so that other translation units do not have
+    // to instantiate them again.
+    template class StringData<Utf8Codec>;
+    template class StringData<Utf16Codec>;
+    template class StringData<Utf32Codec>;
+    template class StringData<WideCodec>;
+
+    template class StringImpl<Utf8StringData>;
+    template class StringImpl<Utf16StringData>;
+    template class StringImpl<Utf32StringData>;
+    template class StringImpl<WideStringData>;
+
     std::string wideToUtf8(const std::wstring &wideString)
     {
         WideCodec::DecodingIterator<std::wstring::const_iterator> beginCharIt(wideString.begin(), wideString.begin(),
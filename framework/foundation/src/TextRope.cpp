@@ -0,0 +1,511 @@
+#include <bdn/init.h>
+#include <bdn/TextRope.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace bdn
+{
+
+    namespace
+    {
+        // Edits that keep a leaf below this size only copy the leaf.
+        // Bigger leaves are split.
+        const size_t maxLeafBytes = 1024;
+
+        // Leaves created from a String get this size, so that there is room
+        // for later insertions.
+        const size_t initialLeafBytes = 512;
+
+        inline bool isUtf8ContinuationByte(char c) { return (((uint8_t)c) & 0xc0) == 0x80; }
+
+        /** Returns the offset of the byte that begins the character with the
+           specified index (or the size of the text if charIndex is the number
+           of characters in the text).*/
+        size_t getUtf8ByteOffset(const std::string &text, size_t charIndex)
+        {
+            size_t charCount = 0;
+            for (size_t byteOffset = 0; byteOffset < text.size(); byteOffset++) {
+                if (!isUtf8ContinuationByte(text[byteOffset])) {
+                    if (charCount == charIndex)
+                        return byteOffset;
+                    charCount++;
+                }
+            }
+
+            return text.size();
+        }
+    }
+
+    /** A node of the rope's tree. Leaf nodes store a chunk of the text (UTF-8
+       encoded), inner nodes always have two children. Nodes are never
+       modified after they were constructed.
+
+        The tree is kept balanced like an AVL tree: the heights of the two
+       children of a node differ by at most 1.*/
+    class TextRope::Node : public Base
+    {
+      public:
+        Node(std::string text) : _text(std::move(text))
+        {
+            for (char c : _text) {
+                if (!isUtf8ContinuationByte(c))
+                    _charCount++;
+                if (c == '\n')
+                    _lineBreakCount++;
+            }
+        }
+
+        Node(const P<Node> &left, const P<Node> &right)
+            : _left(left), _right(right), _charCount(left->_charCount + right->_charCount),
+              _lineBreakCount(left->_lineBreakCount + right->_lineBreakCount),
+              _height(std::max(left->_height, right->_height) + 1)
+        {}
+
+        bool isLeaf() const { return _left.getPtr() == nullptr; }
+
+        size_t getCharCount() const { return _charCount; }
+        size_t getLineBreakCount() const { return _lineBreakCount; }
+
+        static P<Node> createTree(const std::string &text)
+        {
+            std::vector<P<Node>> leaves;
+
+            size_t begin = 0;
+            while (begin < text.size()) {
+                size_t end = std::min(begin + initialLeafBytes, text.size());
+                while (end < text.size() && isUtf8ContinuationByte(text[end]))
+                    end++;
+
+                leaves.push_back(newObj<Node>(text.substr(begin, end - begin)));
+                begin = end;
+            }
+
+            return createBalancedTree(leaves, 0, leaves.size());
+        }
+
+        /** Returns a tree that contains the text of \c left, followed by the
+           text of \c right. Either of them can be null (empty).*/
+        static P<Node> join(const P<Node> &left, const P<Node> &right)
+        {
+            if (left == nullptr)
+                return right;
+            if (right == nullptr)
+                return left;
+
+            if (left->_height > right->_height + 1)
+                return joinRight(left, right);
+            else if (right->_height > left->_height + 1)
+                return joinLeft(left, right);
+            else
+                return joinSimilarHeight(left, right);
+        }
+
+        /** Splits the tree before the character with the specified index.*/
+        static std::pair<P<Node>, P<Node>> split(const P<Node> &node, size_t charIndex)
+        {
+            if (node == nullptr || charIndex == 0)
+                return std::make_pair(nullptr, node);
+            if (charIndex >= node->_charCount)
+                return std::make_pair(node, nullptr);
+
+            if (node->isLeaf()) {
+                size_t byteOffset = getUtf8ByteOffset(node->_text, charIndex);
+
+                return std::make_pair(newObj<Node>(node->_text.substr(0, byteOffset)),
+                                      newObj<Node>(node->_text.substr(byteOffset)));
+            }
+
+            size_t leftCharCount = node->_left->_charCount;
+            if (charIndex <= leftCharCount) {
+                std::pair<P<Node>, P<Node>> parts = split(node->_left, charIndex);
+                return std::make_pair(parts.first, join(parts.second, node->_right));
+            } else {
+                std::pair<P<Node>, P<Node>> parts = split(node->_right, charIndex - leftCharCount);
+                return std::make_pair(join(node->_left, parts.first), parts.second);
+            }
+        }
+
+        /** Inserts the text into the leaf that contains the specified
+           position, if the leaf does not become too big. Only the nodes on the
+           path to the leaf are replaced, the structure of the tree does not
+           change.
+
+            Returns null if the text does not fit into the leaf.*/
+        static P<Node> insertIntoLeaf(const P<Node> &node, size_t charIndex, const std::string &text)
+        {
+            if (node->isLeaf()) {
+                if (node->_text.size() + text.size() > maxLeafBytes)
+                    return nullptr;
+
+                std::string newText(node->_text);
+                newText.insert(getUtf8ByteOffset(newText, charIndex), text);
+
+                return newObj<Node>(std::move(newText));
+            }
+
+            size_t leftCharCount = node->_left->_charCount;
+            if (charIndex <= leftCharCount) {
+                P<Node> newLeft = insertIntoLeaf(node->_left, charIndex, text);
+                return (newLeft == nullptr) ? nullptr : newObj<Node>(newLeft, node->_right);
+            } else {
+                P<Node> newRight = insertIntoLeaf(node->_right, charIndex - leftCharCount, text);
+                return (newRight == nullptr) ? nullptr : newObj<Node>(node->_left, newRight);
+            }
+        }
+
+        /** Erases the specified section, if it is completely inside a single
+           leaf and the leaf does not become empty. Only the nodes on the path
+           to the leaf are replaced, the structure of the tree does not change.
+
+            Returns null if that is not possible.*/
+        static P<Node> eraseFromLeaf(const P<Node> &node, size_t startIndex, size_t charCount)
+        {
+            if (node->isLeaf()) {
+                if (charCount >= node->_charCount)
+                    return nullptr;
+
+                size_t beginByteOffset = getUtf8ByteOffset(node->_text, startIndex);
+                size_t endByteOffset = getUtf8ByteOffset(node->_text, startIndex + charCount);
+
+                std::string newText(node->_text);
+                newText.erase(beginByteOffset, endByteOffset - beginByteOffset);
+
+                return newObj<Node>(std::move(newText));
+            }
+
+            size_t leftCharCount = node->_left->_charCount;
+            if (startIndex + charCount <= leftCharCount) {
+                P<Node> newLeft = eraseFromLeaf(node->_left, startIndex, charCount);
+                return (newLeft == nullptr) ? nullptr : newObj<Node>(newLeft, node->_right);
+            } else if (startIndex >= leftCharCount) {
+                P<Node> newRight = eraseFromLeaf(node->_right, startIndex - leftCharCount, charCount);
+                return (newRight == nullptr) ? nullptr : newObj<Node>(node->_left, newRight);
+            } else
+                return nullptr;
+        }
+
+        char32_t getChar(size_t charIndex) const
+        {
+            const Node *node = this;
+            while (!node->isLeaf()) {
+                size_t leftCharCount = node->_left->_charCount;
+                if (charIndex < leftCharCount)
+                    node = node->_left;
+                else {
+                    charIndex -= leftCharCount;
+                    node = node->_right;
+                }
+            }
+
+            const std::string &text = node->_text;
+            Utf8Codec::DecodingIterator<std::string::const_iterator> it(
+                text.begin() + getUtf8ByteOffset(text, charIndex), text.begin(), text.end());
+
+            return *it;
+        }
+
+        /** Appends the UTF-8 data of the characters [beginIndex, endIndex) to
+         * \c result.*/
+        void appendUtf8(size_t beginIndex, size_t endIndex, std::string &result) const
+        {
+            if (beginIndex >= endIndex)
+                return;
+
+            if (isLeaf()) {
+                if (beginIndex == 0 && endIndex >= _charCount)
+                    result += _text;
+                else {
+                    size_t beginByteOffset = getUtf8ByteOffset(_text, beginIndex);
+                    size_t endByteOffset = getUtf8ByteOffset(_text, endIndex);
+                    result.append(_text, beginByteOffset, endByteOffset - beginByteOffset);
+                }
+            } else {
+                size_t leftCharCount = _left->_charCount;
+                if (beginIndex < leftCharCount)
+                    _left->appendUtf8(beginIndex, std::min(endIndex, leftCharCount), result);
+                if (endIndex > leftCharCount)
+                    _right->appendUtf8(std::max(beginIndex, leftCharCount) - leftCharCount,
+                                       endIndex - leftCharCount, result);
+            }
+        }
+
+        /** Returns the index of the character that follows the line break with
+           the specified number (1 is the first line break).*/
+        size_t getIndexAfterLineBreak(size_t lineBreakNumber) const
+        {
+            size_t charIndex = 0;
+
+            const Node *node = this;
+            while (!node->isLeaf()) {
+                const Node *left = node->_left;
+                if (lineBreakNumber <= left->_lineBreakCount)
+                    node = left;
+                else {
+                    lineBreakNumber -= left->_lineBreakCount;
+                    charIndex += left->_charCount;
+                    node = node->_right;
+                }
+            }
+
+            for (char c : node->_text) {
+                if (!isUtf8ContinuationByte(c))
+                    charIndex++;
+                if (c == '\n') {
+                    lineBreakNumber--;
+                    if (lineBreakNumber == 0)
+                        break;
+                }
+            }
+
+            return charIndex;
+        }
+
+        /** Returns the number of line breaks before the character with the
+         * specified index.*/
+        size_t getLineBreakCountBefore(size_t charIndex) const
+        {
+            size_t lineBreakCount = 0;
+
+            const Node *node = this;
+            while (!node->isLeaf()) {
+                const Node *left = node->_left;
+                if (charIndex <= left->_charCount)
+                    node = left;
+                else {
+                    charIndex -= left->_charCount;
+                    lineBreakCount += left->_lineBreakCount;
+                    node = node->_right;
+                }
+            }
+
+            const std::string &text = node->_text;
+            size_t endByteOffset = getUtf8ByteOffset(text, charIndex);
+
+            return lineBreakCount + std::count(text.begin(), text.begin() + endByteOffset, '\n');
+        }
+
+      private:
+        static P<Node> createBalancedTree(const std::vector<P<Node>> &leaves, size_t begin, size_t end)
+        {
+            if (begin == end)
+                return nullptr;
+            if (end - begin == 1)
+                return leaves[begin];
+
+            size_t middle = begin + (end - begin) / 2;
+
+            return newObj<Node>(createBalancedTree(leaves, begin, middle), createBalancedTree(leaves, middle, end));
+        }
+
+        static P<Node> joinSimilarHeight(const P<Node> &left, const P<Node> &right)
+        {
+            // many small edits would otherwise produce lots of tiny leaves
+            if (left->isLeaf() && right->isLeaf() && left->_text.size() + right->_text.size() <= maxLeafBytes)
+                return newObj<Node>(left->_text + right->_text);
+
+            return newObj<Node>(left, right);
+        }
+
+        static P<Node> rotateLeft(const P<Node> &node)
+        {
+            const P<Node> &right = node->_right;
+            return newObj<Node>(newObj<Node>(node->_left, right->_left), right->_right);
+        }
+
+        static P<Node> rotateRight(const P<Node> &node)
+        {
+            const P<Node> &left = node->_left;
+            return newObj<Node>(left->_left, newObj<Node>(left->_right, node->_right));
+        }
+
+        /** Joins two trees, where \c left is higher than \c right by more than
+           1. \c right is joined with the right edge of \c left.*/
+        static P<Node> joinRight(const P<Node> &left, const P<Node> &right)
+        {
+            const P<Node> &leftLeft = left->_left;
+            const P<Node> &leftRight = left->_right;
+
+            if (leftRight->_height <= right->_height + 1) {
+                P<Node> joined = joinSimilarHeight(leftRight, right);
+                if (joined->_height <= leftLeft->_height + 1)
+                    return newObj<Node>(leftLeft, joined);
+                else
+                    return rotateLeft(newObj<Node>(leftLeft, rotateRight(joined)));
+            } else {
+                P<Node> joined = joinRight(leftRight, right);
+                P<Node> result = newObj<Node>(leftLeft, joined);
+                if (joined->_height <= leftLeft->_height + 1)
+                    return result;
+                else
+                    return rotateLeft(result);
+            }
+        }
+
+        /** Joins two trees, where \c right is higher than \c left by more than
+           1. \c left is joined with the left edge of \c right.*/
+        static P<Node> joinLeft(const P<Node> &left, const P<Node> &right)
+        {
+            const P<Node> &rightLeft = right->_left;
+            const P<Node> &rightRight = right->_right;
+
+            if (rightLeft->_height <= left->_height + 1) {
+                P<Node> joined = joinSimilarHeight(left, rightLeft);
+                if (joined->_height <= rightRight->_height + 1)
+                    return newObj<Node>(joined, rightRight);
+                else
+                    return rotateRight(newObj<Node>(rotateLeft(joined), rightRight));
+            } else {
+                P<Node> joined = joinLeft(left, rightLeft);
+                P<Node> result = newObj<Node>(joined, rightRight);
+                if (joined->_height <= rightRight->_height + 1)
+                    return result;
+                else
+                    return rotateRight(result);
+            }
+        }
+
+        P<Node> _left;
+        P<Node> _right;
+        std::string _text;
+
+        size_t _charCount = 0;
+        size_t _lineBreakCount = 0;
+        int _height = 0;
+    };
+
+    TextRope::TextRope() {}
+
+    TextRope::TextRope(const String &text) : _root(Node::createTree(text.asUtf8())) {}
+
+    TextRope::TextRope(const P<Node> &root) : _root(root) {}
+
+    TextRope::TextRope(const TextRope &o) = default;
+
+    TextRope::TextRope(TextRope &&o) = default;
+
+    TextRope::~TextRope() {}
+
+    TextRope &TextRope::operator=(const TextRope &o) = default;
+
+    TextRope &TextRope::operator=(TextRope &&o) = default;
+
+    size_t TextRope::getLength() const { return (_root == nullptr) ? 0 : _root->getCharCount(); }
+
+    size_t TextRope::getLineCount() const { return ((_root == nullptr) ? 0 : _root->getLineBreakCount()) + 1; }
+
+    char32_t TextRope::operator[](size_t index) const
+    {
+        if (index >= getLength())
+            throw OutOfRangeError("TextRope::operator[]: Invalid index " + std::to_string(index));
+
+        return _root->getChar(index);
+    }
+
+    String TextRope::toString() const { return subString(0); }
+
+    String TextRope::subString(size_t startIndex, size_t charCount) const
+    {
+        charCount = clampCharCount(startIndex, charCount, "TextRope::subString");
+        if (charCount == 0)
+            return String();
+
+        std::string utf8;
+        utf8.reserve(charCount);
+        _root->appendUtf8(startIndex, startIndex + charCount, utf8);
+
+        return String(utf8);
+    }
+
+    size_t TextRope::getLineStartIndex(size_t lineIndex) const
+    {
+        if (lineIndex >= getLineCount())
+            throw OutOfRangeError("TextRope::getLineStartIndex: Invalid line index " + std::to_string(lineIndex));
+
+        return (lineIndex == 0) ? 0 : _root->getIndexAfterLineBreak(lineIndex);
+    }
+
+    size_t TextRope::getLineIndex(size_t charIndex) const
+    {
+        if (charIndex > getLength())
+            throw OutOfRangeError("TextRope::getLineIndex: Invalid index " + std::to_string(charIndex));
+
+        return (_root == nullptr) ? 0 : _root->getLineBreakCountBefore(charIndex);
+    }
+
+    String TextRope::getLine(size_t lineIndex) const
+    {
+        size_t startIndex = getLineStartIndex(lineIndex);
+
+        size_t endIndex;
+        if (lineIndex + 1 < getLineCount())
+            endIndex = getLineStartIndex(lineIndex + 1) - 1;
+        else
+            endIndex = getLength();
+
+        return subString(startIndex, endIndex - startIndex);
+    }
+
+    TextRope &TextRope::insert(size_t index, const String &text)
+    {
+        clampCharCount(index, 0, "TextRope::insert");
+
+        const std::string &utf8 = text.asUtf8();
+        if (utf8.empty())
+            return *this;
+
+        if (_root != nullptr && utf8.size() < maxLeafBytes) {
+            P<Node> newRoot = Node::insertIntoLeaf(_root, index, utf8);
+            if (newRoot != nullptr) {
+                _root = newRoot;
+                return *this;
+            }
+        }
+
+        return insert(index, TextRope(Node::createTree(utf8)));
+    }
+
+    TextRope &TextRope::insert(size_t index, const TextRope &text)
+    {
+        clampCharCount(index, 0, "TextRope::insert");
+
+        std::pair<P<Node>, P<Node>> parts = Node::split(_root, index);
+        _root = Node::join(Node::join(parts.first, text._root), parts.second);
+
+        return *this;
+    }
+
+    TextRope &TextRope::erase(size_t startIndex, size_t charCount)
+    {
+        charCount = clampCharCount(startIndex, charCount, "TextRope::erase");
+        if (charCount == 0)
+            return *this;
+
+        P<Node> newRoot = Node::eraseFromLeaf(_root, startIndex, charCount);
+        if (newRoot != nullptr)
+            _root = newRoot;
+        else {
+            std::pair<P<Node>, P<Node>> beforeAndRest = Node::split(_root, startIndex);
+            std::pair<P<Node>, P<Node>> erasedAndAfter = Node::split(beforeAndRest.second, charCount);
+
+            _root = Node::join(beforeAndRest.first, erasedAndAfter.second);
+        }
+
+        return *this;
+    }
+
+    TextRope &TextRope::replace(size_t startIndex, size_t charCount, const String &replaceWith)
+    {
+        erase(startIndex, charCount);
+        return insert(startIndex, replaceWith);
+    }
+
+    size_t TextRope::clampCharCount(size_t startIndex, size_t charCount, const char *functionName) const
+    {
+        size_t length = getLength();
+        if (startIndex > length)
+            throw OutOfRangeError(std::string(functionName) + ": Invalid start index " + std::to_string(startIndex));
+
+        return std::min(charCount, length - startIndex);
+    }
+}
@@ -2,8 +2,26 @@
 #include <bdn/Thread.h>
 #include <bdn/platform/Hooks.h>
 
+#include <algorithm>
 #include <cassert>
 
+#if BDN_HAVE_THREADS && BDN_PLATFORM_FAMILY_POSIX
+#include <bdn/errno.h>
+
+#include <limits.h>
+#endif
+
+#if BDN_PLATFORM_FAMILY_POSIX
+#include <time.h>
+#endif
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 namespace bdn
 {
 
@@ -11,7 +29,11 @@ namespace bdn
 
 #if BDN_HAVE_THREADS
 
-    Thread::Thread(IThreadRunnable *runnable)
+    Thread::Thread(IThreadRunnable *runnable) { start(runnable, Options()); }
+
+    Thread::Thread(IThreadRunnable *runnable, const Options &options) { start(runnable, options); }
+
+    void Thread::start(IThreadRunnable *runnable, const Options &options)
     {
         // ensure that our SafeInit global mutex stuff is initialized
         SafeInitBase::_ensureReady();
@@ -19,6 +41,37 @@ namespace bdn
         _threadData = newObj<ThreadData>();
 
         _threadData->runnable = runnable;
+        _threadData->options = options;
+
+#if BDN_PLATFORM_FAMILY_POSIX
+        if (options.stackSize > 0) {
+            pthread_attr_t attr;
+            pthread_attr_init(&attr);
+
+            // if the size is not accepted (e.g. because it is not a multiple
+            // of the page size on some systems) then we stay with the default.
+            pthread_attr_setstacksize(&attr, std::max(options.stackSize, (size_t)PTHREAD_STACK_MIN));
+
+            std::future<Id> idFuture = _threadData->idPromise.get_future();
+
+            // the new thread takes ownership of the parameter
+            P<ThreadData> *param = new P<ThreadData>(_threadData);
+
+            int result = pthread_create(&_posixThread, &attr, &Thread::runPosixThread, param);
+            pthread_attr_destroy(&attr);
+
+            if (result != 0) {
+                delete param;
+                throw errnoCodeToSystemError(result, ErrorFields().add("func", "pthread_create"));
+            }
+
+            _isPosixThread = true;
+            _posixThreadJoinable = true;
+
+            _threadId = idFuture.get();
+            return;
+        }
+#endif
 
         _thread = std::thread(&Thread::run, _threadData);
 
@@ -35,10 +88,26 @@ namespace bdn
     // that the thread function will get a copy of the pointer and thus keep the
     // thread data object alive as long as the thread is alive
 
+#if BDN_PLATFORM_FAMILY_POSIX
+    void *Thread::runPosixThread(void *param)
+    {
+        P<ThreadData> threadData = *static_cast<P<ThreadData> *>(param);
+        delete static_cast<P<ThreadData> *>(param);
+
+        threadData->idPromise.set_value(std::this_thread::get_id());
+
+        run(threadData);
+
+        return nullptr;
+    }
+#endif
+
     void Thread::run(P<ThreadData> threadData)
     {
         platform::Hooks::get()->initializeThread();
 
+        applyOptionsToCurrent(threadData->options);
+
         try {
             threadData->runnable->run();
         }
@@ -67,8 +136,33 @@ namespace bdn
         }
     }
 
+    void Thread::applyOptionsToCurrent(const Options &options)
+    {
+        // all settings are best effort. If one of them fails then the thread
+        // simply runs without it.
+        if (!options.name.isEmpty())
+            setCurrentName(options.name);
+
+        if (options.affinityMask != 0)
+            setCurrentAffinity(options.affinityMask);
+
+        if (options.priority != Priority::normal)
+            setCurrentPriority(options.priority);
+    }
+
     void Thread::detach() noexcept
     {
+#if BDN_PLATFORM_FAMILY_POSIX
+        if (_posixThreadJoinable) {
+            pthread_detach(_posixThread);
+
+            _posixThreadJoinable = false;
+            _threadData = nullptr;
+
+            _detached = true;
+        }
+#endif
+
         if (_thread.joinable()) {
             _thread.detach();
 
@@ -87,6 +181,13 @@ namespace bdn
         if (_thread.joinable())
             _thread.join();
 
+#if BDN_PLATFORM_FAMILY_POSIX
+        if (_posixThreadJoinable) {
+            pthread_join(_posixThread, nullptr);
+            _posixThreadJoinable = false;
+        }
+#endif
+
         if (exceptionForwarding == ExceptionThrow && _threadData != nullptr && _threadData->threadException)
             std::rethrow_exception(_threadData->threadException);
     }
@@ -176,4 +277,109 @@ namespace bdn
         return true;
 #endif
     }
+
+    bool Thread::pinCurrentToCpu(int cpuIndex)
+    {
+        // setCurrentAffinity only supports the first 64 cores.
+        if (cpuIndex < 0 || cpuIndex >= 64)
+            return false;
+
+        return setCurrentAffinity(uint64_t(1) << cpuIndex);
+    }
+
+    bool Thread::setCurrentAffinity(uint64_t affinityMask)
+    {
+#if defined(__linux__) && BDN_HAVE_THREADS
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+
+        for (int cpuIndex = 0; cpuIndex < 64 && cpuIndex < CPU_SETSIZE; cpuIndex++) {
+            if ((affinityMask & ((uint64_t)1 << cpuIndex)) != 0)
+                CPU_SET(cpuIndex, &cpuSet);
+        }
+
+        if (CPU_COUNT(&cpuSet) == 0)
+            return false;
+
+        // on Linux (and Android) pid 0 refers to the calling thread.
+        return (sched_setaffinity(0, sizeof(cpuSet), &cpuSet) == 0);
+
+#else
+        return false;
+#endif
+    }
+
+    bool Thread::setCurrentName(const String &name)
+    {
+#if (defined(__linux__) || defined(__APPLE__)) && BDN_HAVE_THREADS
+        std::string nameUtf8 = name.asUtf8();
+
+#if defined(__linux__)
+        // Linux only allows 15 bytes (plus the terminating zero). We make sure
+        // that we do not cut a multi-byte character in half.
+        const size_t maxLength = 15;
+        if (nameUtf8.length() > maxLength) {
+            size_t length = maxLength;
+            while (length > 0 && (((unsigned char)nameUtf8[length]) & 0xc0) == 0x80)
+                length--;
+            nameUtf8.resize(length);
+        }
+
+        return (pthread_setname_np(pthread_self(), nameUtf8.c_str()) == 0);
+#else
+        return (pthread_setname_np(nameUtf8.c_str()) == 0);
+#endif
+
+#else
+        return false;
+#endif
+    }
+
+    bool Thread::setCurrentPriority(Priority priority)
+    {
+#if defined(__linux__) && BDN_HAVE_THREADS
+        // on Linux the "nice" value can be set per thread. Lower values mean
+        // higher priority.
+        int niceValue = 0;
+        if (priority == Priority::low)
+            niceValue = 10;
+        else if (priority == Priority::high)
+            niceValue = -10;
+
+        pid_t threadId = (pid_t)syscall(SYS_gettid);
+
+        return (setpriority(PRIO_PROCESS, (id_t)threadId, niceValue) == 0);
+
+#else
+        return false;
+#endif
+    }
+
+    double Thread::getCurrentCpuTimeSeconds()
+    {
+#if BDN_PLATFORM_FAMILY_POSIX && defined(CLOCK_THREAD_CPUTIME_ID)
+        struct timespec time;
+        if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) == 0)
+            return (double)time.tv_sec + ((double)time.tv_nsec) / 1000000000.0;
+#endif
+
+        return 0;
+    }
+
+    Thread::ResourceUsage Thread::getCurrentResourceUsage()
+    {
+        ResourceUsage usage;
+
+        usage.cpuTimeSeconds = getCurrentCpuTimeSeconds();
+
+#if defined(__linux__)
+        struct rusage threadUsage;
+        if (getrusage(RUSAGE_THREAD, &threadUsage) == 0) {
+            usage.voluntaryContextSwitches = threadUsage.ru_nvcsw;
+            usage.involuntaryContextSwitches = threadUsage.ru_nivcsw;
+        }
+#endif
+
+        return usage;
+    }
 }
@@ -0,0 +1,282 @@
+#include <bdn/init.h>
+#include <bdn/ThreadPerCoreRuntime.h>
+
+#include <bdn/entry.h>
+#include <bdn/InvalidArgumentError.h>
+#include <bdn/ProgrammingError.h>
+
+#if BDN_HAVE_THREADS
+
+#include <thread>
+
+namespace bdn
+{
+
+    namespace
+    {
+        /** How many tasks are taken from one incoming channel before the loop
+         * moves on to the next channel.*/
+        const int maxTasksPerChannelTurn = 64;
+
+        /** How long an idle loop waits when it still has overflow tasks that
+         * could not be sent yet.*/
+        const double overflowRetrySeconds = 0.001;
+    }
+
+    BDN_SAFE_STATIC_THREAD_LOCAL_IMPL(ThreadPerCoreRuntime::CurrentLoop_, ThreadPerCoreRuntime::getCurrentLoopInfo);
+
+    ThreadPerCoreRuntime::ThreadPerCoreRuntime(int loopCount, bool pinThreads, size_t channelCapacity)
+    {
+        int cpuCount = (int)std::thread::hardware_concurrency();
+        if (cpuCount < 1)
+            cpuCount = 1;
+
+        if (loopCount <= 0)
+            loopCount = cpuCount;
+
+        for (int i = 0; i < loopCount; i++) {
+            P<Loop_> loop = newObj<Loop_>();
+
+            loop->index = i;
+            loop->dispatcher = newObj<GenericDispatcher>();
+            loop->outgoingOverflow.resize(loopCount);
+
+            for (int source = 0; source < loopCount; source++)
+                loop->incomingChannels.emplace_back(new Channel_(channelCapacity));
+
+            _loops.push_back(loop);
+        }
+
+        // the threads are only started when all loops are fully set up, since
+        // they access each other's channels.
+        for (auto &loop : _loops)
+            loop->thread = newObj<Thread>(newObj<LoopRunnable_>(this, loop, pinThreads ? loop->index % cpuCount : -1));
+    }
+
+    ThreadPerCoreRuntime::~ThreadPerCoreRuntime() { stop(); }
+
+    ThreadPerCoreRuntime::Loop_ &ThreadPerCoreRuntime::getLoop(int loopIndex) const
+    {
+        if (loopIndex < 0 || loopIndex >= (int)_loops.size())
+            throw InvalidArgumentError("ThreadPerCoreRuntime: invalid loop index " + std::to_string(loopIndex));
+
+        return *_loops[loopIndex];
+    }
+
+    P<IDispatcher> ThreadPerCoreRuntime::getDispatcher(int loopIndex) const { return getLoop(loopIndex).dispatcher; }
+
+    bool ThreadPerCoreRuntime::isLoopPinned(int loopIndex) const { return getLoop(loopIndex).pinned; }
+
+    int ThreadPerCoreRuntime::getCurrentLoopIndex() const
+    {
+        CurrentLoop_ &current = getCurrentLoopInfo();
+
+        if (current.runtime != this)
+            return -1;
+
+        return current.loop->index;
+    }
+
+    LoopAllocator &ThreadPerCoreRuntime::getCurrentLoopAllocator()
+    {
+        CurrentLoop_ &current = getCurrentLoopInfo();
+
+        if (current.runtime != this)
+            programmingError("ThreadPerCoreRuntime::getCurrentLoopAllocator called from a thread that does not belong "
+                             "to the runtime.");
+
+        return current.loop->allocator;
+    }
+
+    void ThreadPerCoreRuntime::submitTo(int loopIndex, std::function<void()> task)
+    {
+        Loop_ &target = getLoop(loopIndex);
+
+        CurrentLoop_ &current = getCurrentLoopInfo();
+        if (current.runtime == this)
+            sendFromLoop(*current.loop, target, std::move(task));
+        else {
+            // we are not on one of our loops, so we cannot use the channels
+            // (they only allow a single producer).
+            target.dispatcher->enqueue(std::move(task));
+        }
+    }
+
+    void ThreadPerCoreRuntime::broadcast(const std::function<void()> &task)
+    {
+        for (int i = 0; i < (int)_loops.size(); i++)
+            submitTo(i, task);
+    }
+
+    void ThreadPerCoreRuntime::stop()
+    {
+        if (_stopped)
+            return;
+
+        if (getCurrentLoopInfo().runtime == this)
+            programmingError("ThreadPerCoreRuntime::stop must not be called from one of the runtime's loops.");
+
+        _stopped = true;
+
+        for (auto &loop : _loops) {
+            if (loop->thread != nullptr)
+                loop->thread->stop(Thread::ExceptionIgnore);
+        }
+
+        for (auto &loop : _loops) {
+            loop->dispatcher->dispose();
+
+            for (auto &overflow : loop->outgoingOverflow)
+                overflow.clear();
+
+            Task_ task;
+            for (auto &channel : loop->incomingChannels) {
+                while (channel->tryPop(task))
+                    ;
+            }
+        }
+    }
+
+    void ThreadPerCoreRuntime::sendFromLoop(Loop_ &source, Loop_ &target, Task_ &&task)
+    {
+        std::deque<Task_> &overflow = source.outgoingOverflow[target.index];
+
+        // if there are already tasks waiting then the new task has to wait as
+        // well. Otherwise it would overtake them.
+        if (!overflow.empty() || !target.incomingChannels[source.index]->tryPush(std::move(task))) {
+            overflow.push_back(std::move(task));
+            source.hasOverflow = true;
+            return;
+        }
+
+        wakeUp(target);
+    }
+
+    void ThreadPerCoreRuntime::wakeUp(Loop_ &loop)
+    {
+        // pairs with the fence in the loop's idle handling: either the loop
+        // sees our item before it goes to sleep, or we see that it sleeps.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (loop.sleeping.exchange(false))
+            loop.dispatcher->enqueue([]() {});
+    }
+
+    bool ThreadPerCoreRuntime::flushOverflow(Loop_ &loop)
+    {
+        bool stillPending = false;
+
+        for (int targetIndex = 0; targetIndex < (int)_loops.size(); targetIndex++) {
+            std::deque<Task_> &overflow = loop.outgoingOverflow[targetIndex];
+            if (overflow.empty())
+                continue;
+
+            Loop_ &target = *_loops[targetIndex];
+            Channel_ &channel = *target.incomingChannels[loop.index];
+
+            bool pushedAny = false;
+            while (!overflow.empty() && channel.tryPush(std::move(overflow.front()))) {
+                overflow.pop_front();
+                pushedAny = true;
+            }
+
+            if (pushedAny)
+                wakeUp(target);
+
+            if (!overflow.empty())
+                stillPending = true;
+        }
+
+        loop.hasOverflow = stillPending;
+
+        return stillPending;
+    }
+
+    bool ThreadPerCoreRuntime::executeIncoming(Loop_ &loop)
+    {
+        bool executedAny = false;
+        Task_ task;
+
+        for (auto &channel : loop.incomingChannels) {
+            for (int i = 0; i < maxTasksPerChannelTurn && channel->tryPop(task); i++) {
+                executedAny = true;
+
+                // move the task out of our variable, so that its captured state
+                // is released when it is done (even if it throws).
+                Task_ toRun(std::move(task));
+                task = nullptr;
+
+                toRun();
+            }
+        }
+
+        return executedAny;
+    }
+
+    bool ThreadPerCoreRuntime::incomingEmpty(Loop_ &loop) const
+    {
+        for (auto &channel : loop.incomingChannels) {
+            if (!channel->isEmpty())
+                return false;
+        }
+
+        return true;
+    }
+
+    void ThreadPerCoreRuntime::LoopRunnable_::signalStop()
+    {
+        ThreadRunnableBase::signalStop();
+
+        // wake the loop up if it is currently waiting.
+        _loop->dispatcher->enqueue([]() {});
+    }
+
+    void ThreadPerCoreRuntime::LoopRunnable_::run()
+    {
+        if (_cpuIndex >= 0)
+            _loop->pinned = Thread::pinCurrentToCpu(_cpuIndex);
+
+        CurrentLoop_ &current = getCurrentLoopInfo();
+        current.runtime = _runtime;
+        current.loop = _loop;
+
+        while (!shouldStop()) {
+            try {
+                bool didWork = _runtime->executeIncoming(*_loop);
+
+                if (_loop->hasOverflow)
+                    _runtime->flushOverflow(*_loop);
+
+                if (_loop->dispatcher->executeNext())
+                    didWork = true;
+
+                if (!didWork) {
+                    _loop->sleeping = true;
+
+                    // pairs with the fence in wakeUp.
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                    if (_runtime->incomingEmpty(*_loop)) {
+                        // when we still have overflow tasks then we have to
+                        // retry soon, since nobody will wake us when the
+                        // target channel gets free space.
+                        _loop->dispatcher->waitForNext(_loop->hasOverflow ? overflowRetrySeconds : 10);
+                    }
+
+                    _loop->sleeping = false;
+                }
+            }
+            catch (...) {
+                if (!bdn::getAppRunner()->unhandledException(true)) {
+                    // abort the app (= let exception through).
+                    throw;
+                }
+            }
+        }
+
+        current.runtime = nullptr;
+        current.loop = nullptr;
+    }
+}
+
+#endif
@@ -3,13 +3,98 @@
 
 #include <bdn/entry.h>
 
+#include <algorithm>
+#include <thread>
+
 #if BDN_HAVE_THREADS
 
 namespace bdn
 {
 
+    /** Wraps a job that was added with a cancellation token.*/
+    class CancellableJob_ : public Base, BDN_IMPLEMENTS IThreadRunnable
+    {
+      public:
+        CancellableJob_(IThreadRunnable *job, const CancellationToken &token) : _job(job), _token(token) {}
+
+        /** Registers the cancellation handler. This is separate from the
+           constructor because the handler may be called right away.*/
+        void subscribe()
+        {
+            P<IThreadRunnable> job = _job;
+            P<INotifierSubscription> subscription = _token.onCancel([job]() { job->signalStop(); });
+
+            Mutex::Lock lock(_mutex);
+            _subscription = subscription;
+        }
+
+        void run() override
+        {
+            // jobs that were cancelled while they were queued are dropped.
+            // The cancel handler has already called signalStop on them.
+            if (!_token.isCancelled())
+                _job->run();
+
+            unsubscribe();
+        }
+
+        void signalStop() override
+        {
+            _job->signalStop();
+
+            unsubscribe();
+        }
+
+        void unsubscribe()
+        {
+            P<INotifierSubscription> subscription;
+            {
+                Mutex::Lock lock(_mutex);
+                subscription = _subscription;
+                _subscription = nullptr;
+            }
+
+            // the handler holds a reference to the job, so we must remove it
+            // to release the job.
+            _token.removeOnCancel(subscription);
+        }
+
+      private:
+        P<IThreadRunnable> _job;
+        CancellationToken _token;
+
+        Mutex _mutex;
+        P<INotifierSubscription> _subscription;
+    };
+
+    static int getSharedThreadPoolSize() { return std::max(2, (int)std::thread::hardware_concurrency()); }
+
+    class SharedThreadPool_ : public ThreadPool
+    {
+      public:
+        SharedThreadPool_() : ThreadPool(getSharedThreadPoolSize(), getSharedThreadPoolSize(), makeThreadOptions()) {}
+
+      private:
+        static Thread::Options makeThreadOptions()
+        {
+            Thread::Options options;
+            options.name = "bdn shared pool";
+            return options;
+        }
+    };
+
+    BDN_SAFE_STATIC(SharedThreadPool_, _getSharedThreadPool);
+
+    BDN_SAFE_STATIC_IMPL(SharedThreadPool_, _getSharedThreadPool);
+
+    P<ThreadPool> getSharedThreadPool() { return &_getSharedThreadPool(); }
+
     ThreadPool::ThreadPool(int minThreadCount, int maxThreadCount)
-        : _minThreadCount(minThreadCount), _maxThreadCount(maxThreadCount)
+        : ThreadPool(minThreadCount, maxThreadCount, Thread::Options())
+    {}
+
+    ThreadPool::ThreadPool(int minThreadCount, int maxThreadCount, const Thread::Options &threadOptions)
+        : _minThreadCount(minThreadCount), _maxThreadCount(maxThreadCount), _threadOptions(threadOptions)
     {
         if (_minThreadCount < 0)
             throw InvalidArgumentError("ThreadPool constructor parameter minThreadCount must be >=0");
@@ -62,9 +147,8 @@ namespace bdn
     {
         Mutex::Lock lock(_mutex);
 
-        if (!_queuedJobs.empty()) {
-            P<IThreadRunnable> job = _queuedJobs.front();
-            _queuedJobs.pop_front();
+        if (_queuedJobCount > 0) {
+            P<IThreadRunnable> job = takeNextJob();
 
             // give the runner a new job right away
             runner->startJob(job);
@@ -85,51 +169,292 @@ namespace bdn
                 // add the runner to the idle list and let it go to sleep
                 _idleRunners.push_back(runner);
 
+                // a producer that waits for queue space can now hand its job
+                // to the idle runner.
+                _queueSpaceAvailable.notify_one();
+
                 // runner should not end, but wait for the next job
                 return true;
             }
         }
     }
 
+    P<IThreadRunnable> ThreadPool::takeNextJob()
+    {
+        // the mutex must be locked when this is called and there must be at
+        // least one queued job.
+
+        Clock::time_point now = Clock::now();
+
+        PriorityQueue_ *selectedQueue = nullptr;
+        bool selectedDeadlineJob = false;
+
+        // jobs whose deadline has passed come first, the most overdue one
+        // first.
+        for (PriorityQueue_ &queue : _queues) {
+            if (!queue.deadlineJobs.empty()) {
+                Clock::time_point deadline = queue.deadlineJobs.begin()->first;
+
+                if (deadline <= now &&
+                    (selectedQueue == nullptr || deadline < selectedQueue->deadlineJobs.begin()->first)) {
+                    selectedQueue = &queue;
+                    selectedDeadlineJob = true;
+                }
+            }
+        }
+
+        if (selectedQueue == nullptr) {
+            // select the job with the highest effective priority. Since the
+            // jobs of each queue are ordered, only the first jobs of each queue
+            // need to be considered. The effective priority is the base
+            // priority plus one level for each aging interval that the job has
+            // waited.
+            double bestPriority = 0;
+            Clock::time_point bestEnqueueTime;
+
+            for (int level = priorityCount - 1; level >= 0; level--) {
+                PriorityQueue_ &queue = _queues[level];
+
+                for (int deadlineJob = 0; deadlineJob < 2; deadlineJob++) {
+                    const QueuedJob_ *candidate = nullptr;
+                    if (deadlineJob) {
+                        if (!queue.deadlineJobs.empty())
+                            candidate = &queue.deadlineJobs.begin()->second;
+                    } else if (!queue.fifoJobs.empty())
+                        candidate = &queue.fifoJobs.front();
+
+                    if (candidate == nullptr)
+                        continue;
+
+                    double effectivePriority =
+                        level + std::chrono::duration<double>(now - candidate->enqueueTime).count() /
+                                    std::chrono::duration<double>(_agingInterval).count();
+
+                    if (selectedQueue == nullptr || effectivePriority > bestPriority ||
+                        (effectivePriority == bestPriority && candidate->enqueueTime < bestEnqueueTime)) {
+                        selectedQueue = &queue;
+                        selectedDeadlineJob = (deadlineJob != 0);
+                        bestPriority = effectivePriority;
+                        bestEnqueueTime = candidate->enqueueTime;
+                    }
+                }
+            }
+        }
+
+        QueuedJob_ queuedJob;
+        if (selectedDeadlineJob) {
+            auto it = selectedQueue->deadlineJobs.begin();
+            queuedJob = std::move(it->second);
+            selectedQueue->deadlineJobs.erase(it);
+        } else {
+            queuedJob = std::move(selectedQueue->fifoJobs.front());
+            selectedQueue->fifoJobs.pop_front();
+        }
+
+        _queuedJobCount--;
+        _queueSpaceAvailable.notify_one();
+
+        recordJobStart(now - queuedJob.enqueueTime);
+
+        return queuedJob.job;
+    }
+
+    void ThreadPool::recordJobStart(Clock::duration waitTime)
+    {
+        _metrics.startedJobCount++;
+        _totalWaitTime += waitTime;
+
+        double waitSeconds = std::chrono::duration<double>(waitTime).count();
+        if (waitSeconds > _metrics.maxWaitSeconds)
+            _metrics.maxWaitSeconds = waitSeconds;
+    }
+
     // PoolRunner
 
-    void ThreadPool::addJob(IThreadRunnable *runnable)
+    void ThreadPool::addJob(IThreadRunnable *runnable, Priority priority)
+    {
+        addJobImpl(runnable, priority, false, Clock::time_point());
+    }
+
+    void ThreadPool::addJob(IThreadRunnable *runnable, const CancellationToken &token, Priority priority)
+    {
+        if (token.isCancelled()) {
+            runnable->signalStop();
+            return;
+        }
+
+        P<CancellableJob_> job = newObj<CancellableJob_>(runnable, token);
+        job->subscribe();
+
+        try {
+            addJobImpl(job, priority, false, Clock::time_point());
+        }
+        catch (...) {
+            // e.g. QueueFullError
+            job->unsubscribe();
+            throw;
+        }
+    }
+
+    void ThreadPool::addJobWithDeadline(IThreadRunnable *runnable, double deadlineSeconds, Priority priority)
     {
+        Clock::time_point deadline =
+            Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(deadlineSeconds));
+
+        addJobImpl(runnable, priority, true, deadline);
+    }
+
+    void ThreadPool::addJobImpl(IThreadRunnable *runnable, Priority priority, bool hasDeadline,
+                                Clock::time_point deadline)
+    {
+        P<IThreadRunnable> job = runnable;
+
         Mutex::Lock lock(_mutex);
 
-        if (_idleRunners.empty()) {
-            // we have no idle runner waiting.
+        bool blocked = false;
 
-            if (_busyRunners.size() >= (size_t)_maxThreadCount) {
-                // we cannot start a new thread. Add the job to the queue
-                _queuedJobs.push_back(runnable);
-            } else {
+        while (true) {
+            if (!_idleRunners.empty()) {
+                // we have an idle runner waiting. Give it a new job
+                P<PoolRunner> runner = _idleRunners.front();
+                _idleRunners.pop_front();
+
+                _busyRunners.insert(runner);
+
+                recordJobStart(Clock::duration::zero());
+                runner->startJob(job);
+                return;
+            }
+
+            if (_busyRunners.size() < (size_t)_maxThreadCount) {
                 // start another thread.
                 P<PoolRunner> runner = newObj<PoolRunner>(this);
 
-                runner->startJob(runnable);
+                runner->startJob(job);
 
                 _busyRunners.insert(runner);
 
                 try {
-                    P<Thread> thread = newObj<Thread>(runner);
+                    P<Thread> thread = newObj<Thread>(runner, _threadOptions);
                     thread->detach();
+
+                    recordJobStart(Clock::duration::zero());
                 }
                 catch (...) {
                     // if there is an error starting the thread then we remove
                     // the runner again.
                     _busyRunners.erase(runner);
                 }
+                return;
             }
-        } else {
-            // we have an idle runner waiting. Give it a new job
-            P<PoolRunner> runner = _idleRunners.front();
-            _idleRunners.pop_front();
 
-            _busyRunners.insert(runner);
+            // we cannot start a new thread. The job has to wait in the queue.
+            if (_maxQueuedJobs < 0 || _queuedJobCount < _maxQueuedJobs)
+                break;
 
-            runner->startJob(runnable);
+            if (_overflowPolicy == OverflowPolicy::reject) {
+                _metrics.rejectedJobCount++;
+                throw QueueFullError("ThreadPool job queue is full.");
+            } else if (_overflowPolicy == OverflowPolicy::callerRuns) {
+                _metrics.callerRunJobCount++;
+
+                Mutex::Unlock unlock(_mutex);
+                job->run();
+                return;
+            } else {
+                if (!blocked) {
+                    _metrics.blockedAddCount++;
+                    blocked = true;
+                }
+
+                // the mutex is recursive, but we only have it locked once
+                // here. So waiting releases it completely.
+                _queueSpaceAvailable.wait(_mutex);
+            }
         }
+
+        QueuedJob_ queuedJob{job, Clock::now()};
+
+        PriorityQueue_ &queue = _queues[(int)priority];
+        if (hasDeadline)
+            queue.deadlineJobs.emplace(deadline, std::move(queuedJob));
+        else
+            queue.fifoJobs.push_back(std::move(queuedJob));
+
+        _queuedJobCount++;
+        if (_queuedJobCount > _metrics.peakQueuedJobCount)
+            _metrics.peakQueuedJobCount = _queuedJobCount;
+    }
+
+    void ThreadPool::setQueueLimit(int maxQueuedJobs, OverflowPolicy overflowPolicy)
+    {
+        Mutex::Lock lock(_mutex);
+
+        _maxQueuedJobs = maxQueuedJobs;
+        _overflowPolicy = overflowPolicy;
+
+        // blocked producers must re-check the new limit
+        _queueSpaceAvailable.notify_all();
+    }
+
+    int ThreadPool::getMaxQueuedJobs() const
+    {
+        Mutex::Lock lock(_mutex);
+
+        return _maxQueuedJobs;
+    }
+
+    ThreadPool::OverflowPolicy ThreadPool::getOverflowPolicy() const
+    {
+        Mutex::Lock lock(_mutex);
+
+        return _overflowPolicy;
+    }
+
+    void ThreadPool::setAgingIntervalSeconds(double seconds)
+    {
+        if (!(seconds > 0))
+            throw InvalidArgumentError("ThreadPool::setAgingIntervalSeconds must be called with a value >0");
+
+        Mutex::Lock lock(_mutex);
+
+        _agingInterval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+    }
+
+    double ThreadPool::getAgingIntervalSeconds() const
+    {
+        Mutex::Lock lock(_mutex);
+
+        return std::chrono::duration<double>(_agingInterval).count();
+    }
+
+    int ThreadPool::getQueuedJobCount() const
+    {
+        Mutex::Lock lock(_mutex);
+
+        return _queuedJobCount;
+    }
+
+    ThreadPool::Metrics ThreadPool::getMetrics() const
+    {
+        Mutex::Lock lock(_mutex);
+
+        Metrics metrics = _metrics;
+        metrics.queuedJobCount = _queuedJobCount;
+        if (metrics.startedJobCount > 0)
+            metrics.averageWaitSeconds =
+                std::chrono::duration<double>(_totalWaitTime).count() / (double)metrics.startedJobCount;
+
+        return metrics;
+    }
+
+    void ThreadPool::resetMetrics()
+    {
+        Mutex::Lock lock(_mutex);
+
+        _metrics = Metrics();
+        _metrics.peakQueuedJobCount = _queuedJobCount;
+        _totalWaitTime = Clock::duration::zero();
     }
 
     int ThreadPool::getBusyThreadCount() const
@@ -6,49 +6,77 @@
 namespace bdn
 {
 
-    String Uri::unescape(const String &s)
+    namespace
     {
-        String result;
+        /** Returns true for the "unreserved" characters of RFC 3986, which do
+         * not need to be escaped in any part of a URI.*/
+        inline bool isUnreservedUriChar(uint8_t chr)
+        {
+            return ((chr >= 'a' && chr <= 'z') || (chr >= 'A' && chr <= 'Z') || (chr >= '0' && chr <= '9') ||
+                    chr == '-' || chr == '.' || chr == '_' || chr == '~');
+        }
+    }
+
+    String Uri::escape(const String &s)
+    {
+        const std::string &utf8 = s.asUtf8();
+
+        size_t escapeCount = 0;
+        for (char chr : utf8) {
+            if (!isUnreservedUriChar(uint8_t(chr)))
+                escapeCount++;
+        }
 
-        std::string unescapedUtf8;
+        if (escapeCount == 0)
+            return s;
 
-        auto pos = s.begin();
-        auto lastEscapeEnd = s.begin();
-        while (true) {
-            pos = s.find('%', pos);
-            if (pos == s.end() || pos != lastEscapeEnd) {
-                if (!unescapedUtf8.empty()) {
-                    result += unescapedUtf8;
-                    unescapedUtf8.clear();
-                }
+        P<NativeStringData> resultData = newObj<NativeStringData>();
 
-                result += s.subString(lastEscapeEnd, pos);
-                lastEscapeEnd = pos;
+        NativeStringData::EncodedString &result = resultData->getEncodedString();
+        result.resize(utf8.length() + escapeCount * 2);
 
-                if (pos == s.end())
-                    break;
+        auto out = result.begin();
+        for (char chr : utf8) {
+            if (isUnreservedUriChar(uint8_t(chr)))
+                *out++ = chr;
+            else {
+                *out++ = '%';
+                hexEncode(&chr, 1, &*out, true);
+                out += 2;
             }
+        }
 
-            ++pos;
-            if (pos != s.end()) {
-                char32_t chr1 = *pos;
+        return String(resultData);
+    }
 
-                if (isHexDigit(chr1)) {
-                    ++pos;
+    String Uri::unescape(const String &s)
+    {
+        const std::string &utf8 = s.asUtf8();
 
-                    if (pos != s.end()) {
-                        char32_t chr2 = *pos;
-                        if (isHexDigit(chr2)) {
-                            ++pos;
+        size_t pos = utf8.find('%');
+        if (pos == std::string::npos)
+            return s;
 
-                            unescapedUtf8 += (char)((decodeHexDigit(chr1) << 4) | decodeHexDigit(chr2));
-                            lastEscapeEnd = pos;
-                        }
-                    }
-                }
+        std::string result;
+        result.reserve(utf8.length());
+
+        size_t lastEscapeEnd = 0;
+        while (pos != std::string::npos) {
+            uint8_t byte;
+            if (pos + 2 < utf8.length() && hexDecode(&utf8[pos + 1], 2, &byte)) {
+                result.append(utf8, lastEscapeEnd, pos - lastEscapeEnd);
+                result += char(byte);
+
+                lastEscapeEnd = pos + 3;
+                pos = utf8.find('%', lastEscapeEnd);
+            } else {
+                // not a valid escape sequence. The percent sign is kept.
+                pos = utf8.find('%', pos + 1);
             }
         }
 
-        return result;
+        result.append(utf8, lastEscapeEnd, std::string::npos);
+
+        return String(result);
     }
 }
@@ -0,0 +1,140 @@
+#include <bdn/init.h>
+#include <bdn/base64.h>
+
+namespace bdn
+{
+
+    namespace
+    {
+        const char base64Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        /** Maps each byte value to its 6 bit value in the Base64 alphabet, or
+         * to -1 if the byte is not part of the alphabet.*/
+        struct Base64DecodingTable
+        {
+            Base64DecodingTable()
+            {
+                for (int &value : values)
+                    value = -1;
+
+                for (int i = 0; i < 64; i++)
+                    values[uint8_t(base64Alphabet[i])] = i;
+            }
+
+            int values[256];
+        };
+
+        const Base64DecodingTable &getBase64DecodingTable()
+        {
+            static Base64DecodingTable table;
+            return table;
+        }
+
+        template <class Element> void encodeBase64(const void *data, size_t bytes, Element *out)
+        {
+            const uint8_t *p = static_cast<const uint8_t *>(data);
+
+            for (; bytes >= 3; bytes -= 3) {
+                uint32_t group = (uint32_t(p[0]) << 16) | (uint32_t(p[1]) << 8) | p[2];
+
+                out[0] = Element(base64Alphabet[group >> 18]);
+                out[1] = Element(base64Alphabet[(group >> 12) & 0x3f]);
+                out[2] = Element(base64Alphabet[(group >> 6) & 0x3f]);
+                out[3] = Element(base64Alphabet[group & 0x3f]);
+
+                p += 3;
+                out += 4;
+            }
+
+            if (bytes != 0) {
+                uint32_t group = uint32_t(p[0]) << 16;
+                if (bytes == 2)
+                    group |= uint32_t(p[1]) << 8;
+
+                out[0] = Element(base64Alphabet[group >> 18]);
+                out[1] = Element(base64Alphabet[(group >> 12) & 0x3f]);
+                out[2] = Element((bytes == 2) ? base64Alphabet[(group >> 6) & 0x3f] : '=');
+                out[3] = Element('=');
+            }
+        }
+    }
+
+    void base64Encode(const void *data, size_t bytes, char *out) { encodeBase64(data, bytes, out); }
+
+    bool base64Decode(const char *text, size_t textLength, void *out, size_t &outBytes)
+    {
+        outBytes = 0;
+
+        if (textLength % 4 != 0)
+            return false;
+        if (textLength == 0)
+            return true;
+
+        size_t paddingLength = 0;
+        if (text[textLength - 1] == '=')
+            paddingLength = (text[textLength - 2] == '=') ? 2 : 1;
+
+        const int *values = getBase64DecodingTable().values;
+        const uint8_t *in = reinterpret_cast<const uint8_t *>(text);
+        uint8_t *outBytesBegin = static_cast<uint8_t *>(out);
+        uint8_t *outPos = outBytesBegin;
+
+        // all groups of 4 characters, except the last one
+        const uint8_t *lastGroup = in + textLength - 4;
+        for (; in != lastGroup; in += 4) {
+            // invalid characters have the value -1
+            if ((values[in[0]] | values[in[1]] | values[in[2]] | values[in[3]]) < 0)
+                return false;
+
+            uint32_t group = (values[in[0]] << 18) | (values[in[1]] << 12) | (values[in[2]] << 6) | values[in[3]];
+
+            outPos[0] = uint8_t(group >> 16);
+            outPos[1] = uint8_t(group >> 8);
+            outPos[2] = uint8_t(group);
+            outPos += 3;
+        }
+
+        int lastValues[4] = {values[in[0]], values[in[1]], (paddingLength < 2) ? values[in[2]] : 0,
+                             (paddingLength < 1) ? values[in[3]] : 0};
+        if ((lastValues[0] | lastValues[1] | lastValues[2] | lastValues[3]) < 0)
+            return false;
+
+        uint32_t group = (lastValues[0] << 18) | (lastValues[1] << 12) | (lastValues[2] << 6) | lastValues[3];
+
+        outPos[0] = uint8_t(group >> 16);
+        if (paddingLength < 2)
+            outPos[1] = uint8_t(group >> 8);
+        if (paddingLength < 1)
+            outPos[2] = uint8_t(group);
+
+        outBytes = (outPos - outBytesBegin) + 3 - paddingLength;
+        return true;
+    }
+
+    bool base64Decode(const String &s, std::vector<uint8_t> &result)
+    {
+        const std::string &text = s.asUtf8();
+
+        size_t decodedBytes;
+        result.resize(text.length() / 4 * 3);
+        if (!base64Decode(text.c_str(), text.length(), result.data(), decodedBytes)) {
+            result.clear();
+            return false;
+        }
+
+        result.resize(decodedBytes);
+        return true;
+    }
+
+    String toBase64String(const void *data, size_t bytes)
+    {
+        P<NativeStringData> stringData = newObj<NativeStringData>();
+
+        NativeStringData::EncodedString &encoded = stringData->getEncodedString();
+        encoded.resize(getBase64EncodedLength(bytes));
+        if (bytes != 0)
+            encodeBase64(data, bytes, &encoded[0]);
+
+        return String(stringData);
+    }
+}
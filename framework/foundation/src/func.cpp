@@ -0,0 +1,17 @@
+#include <bdn/init.h>
+#include <bdn/func.h>
+
+namespace bdn
+{
+
+    DanglingCallScope_ *&DanglingCallScope_::getInnermost_()
+    {
+#if BDN_HAVE_THREADS
+        static thread_local DanglingCallScope_ *innermost = nullptr;
+#else
+        static DanglingCallScope_ *innermost = nullptr;
+#endif
+
+        return innermost;
+    }
+}
@@ -0,0 +1,136 @@
+#include <bdn/init.h>
+#include <bdn/hex.h>
+
+// SSE2 is available on all x86-64 processors, so it does not need a runtime
+// check.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BDN_HEX_SSE2 1
+#include <emmintrin.h>
+#else
+#define BDN_HEX_SSE2 0
+#endif
+
+namespace bdn
+{
+
+#if BDN_HEX_SSE2
+
+    namespace
+    {
+        /** Converts 16 nibble values (0-15) to hex digits. letterOffset is
+         * the value that has to be added to '0'+nibble for the digits a-f.*/
+        inline __m128i nibblesToHexDigits(__m128i nibbles, __m128i letterOffset)
+        {
+            __m128i isLetter = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+
+            return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), _mm_and_si128(isLetter, letterOffset));
+        }
+
+        /** Converts 16 hex digits to their nibble values. Returns false if
+         * one of the characters is not a hex digit.*/
+        inline bool hexDigitsToNibbles(__m128i chars, __m128i &nibbles)
+        {
+            // SSE2 only has signed comparisons. Flipping the highest bit turns
+            // an unsigned comparison into a signed one.
+            const __m128i signBit = _mm_set1_epi8(char(0x80));
+
+            __m128i digitValues = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+            __m128i isDigit = _mm_cmplt_epi8(_mm_xor_si128(digitValues, signBit), _mm_set1_epi8(char(0x80 + 10)));
+
+            // setting bit 5 converts upper case letters to lower case
+            __m128i letterValues = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+            __m128i isLetter = _mm_cmplt_epi8(_mm_xor_si128(letterValues, signBit), _mm_set1_epi8(char(0x80 + 6)));
+
+            if (_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != 0xffff)
+                return false;
+
+            nibbles = _mm_or_si128(_mm_and_si128(isDigit, digitValues),
+                                   _mm_and_si128(isLetter, _mm_add_epi8(letterValues, _mm_set1_epi8(10))));
+            return true;
+        }
+    }
+
+#endif
+
+    void hexEncode(const void *data, size_t bytes, char *out, bool upperCase)
+    {
+        const uint8_t *p = static_cast<const uint8_t *>(data);
+
+#if BDN_HEX_SSE2
+        const __m128i lowNibbleMask = _mm_set1_epi8(0x0f);
+        const __m128i letterOffset = _mm_set1_epi8(upperCase ? ('A' - '0' - 10) : ('a' - '0' - 10));
+
+        for (; bytes >= 16; bytes -= 16) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+
+            __m128i highNibbles = _mm_and_si128(_mm_srli_epi16(block, 4), lowNibbleMask);
+            __m128i lowNibbles = _mm_and_si128(block, lowNibbleMask);
+
+            // interleave, so that the high nibble of each byte comes first
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out),
+                             nibblesToHexDigits(_mm_unpacklo_epi8(highNibbles, lowNibbles), letterOffset));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 16),
+                             nibblesToHexDigits(_mm_unpackhi_epi8(highNibbles, lowNibbles), letterOffset));
+
+            p += 16;
+            out += 32;
+        }
+#endif
+
+        hexEncode<char>(p, bytes, out, upperCase);
+    }
+
+    bool hexDecode(const char *text, size_t textLength, void *out)
+    {
+        if (textLength % 2 != 0)
+            return false;
+
+        uint8_t *outBytes = static_cast<uint8_t *>(out);
+
+#if BDN_HEX_SSE2
+        for (; textLength >= 16; textLength -= 16) {
+            __m128i nibbles;
+            if (!hexDigitsToNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i *>(text)), nibbles))
+                return false;
+
+            // the high nibbles are in the even bytes, which are the low halves
+            // of the 16 bit values.
+            __m128i highNibbles = _mm_and_si128(nibbles, _mm_set1_epi16(0x00ff));
+            __m128i lowNibbles = _mm_srli_epi16(nibbles, 8);
+            __m128i values = _mm_or_si128(_mm_slli_epi16(highNibbles, 4), lowNibbles);
+
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(outBytes), _mm_packus_epi16(values, values));
+
+            text += 16;
+            outBytes += 8;
+        }
+#endif
+
+        return hexDecode<char>(text, textLength, outBytes);
+    }
+
+    bool hexDecode(const String &s, std::vector<uint8_t> &result)
+    {
+        const std::string &text = s.asUtf8();
+
+        result.resize(text.length() / 2);
+        if (!hexDecode(text.c_str(), text.length(), result.data())) {
+            result.clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    String toHexString(const void *data, size_t bytes, bool upperCase)
+    {
+        P<NativeStringData> stringData = newObj<NativeStringData>();
+
+        NativeStringData::EncodedString &encoded = stringData->getEncodedString();
+        encoded.resize(bytes * 2);
+        if (bytes != 0)
+            hexEncode(data, bytes, &encoded[0], upperCase);
+
+        return String(stringData);
+    }
+}
@@ -18,6 +18,8 @@ namespace bdn
             */
         class MockButtonCore : public MockViewCore, BDN_IMPLEMENTS IButtonCore
         {
+            BDN_INTERFACE_TABLE(IButtonCore, IViewCore, LayoutCoordinator::IViewCoreExtension);
+
           public:
             MockButtonCore(Button *button) : MockViewCore(button) { _label = button->label(); }
 
@@ -18,6 +18,8 @@ namespace bdn
             */
         class MockCheckboxCore : public MockViewCore, BDN_IMPLEMENTS ICheckboxCore
         {
+            BDN_INTERFACE_TABLE(ICheckboxCore, IToggleCoreBase, IViewCore, LayoutCoordinator::IViewCoreExtension);
+
           public:
             MockCheckboxCore(Checkbox *checkbox) : MockViewCore(checkbox)
             {
@@ -20,6 +20,8 @@ namespace bdn
             */
         class MockScrollViewCore : public MockViewCore, BDN_IMPLEMENTS IScrollViewCore
         {
+            BDN_INTERFACE_TABLE(IScrollViewCore, IViewCore, LayoutCoordinator::IViewCoreExtension);
+
           public:
             MockScrollViewCore(ScrollView *view) : MockViewCore(view)
             {
@@ -18,6 +18,8 @@ namespace bdn
             */
         class MockSwitchCore : public MockViewCore, BDN_IMPLEMENTS ISwitchCore
         {
+            BDN_INTERFACE_TABLE(ISwitchCore, IToggleCoreBase, IViewCore, LayoutCoordinator::IViewCoreExtension);
+
           public:
             MockSwitchCore(Switch *outerSwitch) : MockViewCore(outerSwitch)
             {
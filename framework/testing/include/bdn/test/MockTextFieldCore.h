@@ -19,6 +19,8 @@ namespace bdn
             */
         class MockTextFieldCore : public MockViewCore, BDN_IMPLEMENTS ITextFieldCore
         {
+            BDN_INTERFACE_TABLE(ITextFieldCore, IViewCore, LayoutCoordinator::IViewCoreExtension);
+
           public:
             MockTextFieldCore(TextField *textField) : MockViewCore(textField) { _text = textField->text(); }
 
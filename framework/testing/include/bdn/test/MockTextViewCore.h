@@ -19,6 +19,8 @@ namespace bdn
             */
         class MockTextViewCore : public MockViewCore, BDN_IMPLEMENTS ITextViewCore
         {
+            BDN_INTERFACE_TABLE(ITextViewCore, IViewCore, LayoutCoordinator::IViewCoreExtension);
+
           public:
             MockTextViewCore(TextView *view) : MockViewCore(view) { _text = view->text(); }
 
@@ -19,6 +19,8 @@ namespace bdn
             */
         class MockToggleCore : public MockViewCore, BDN_IMPLEMENTS ISwitchCore
         {
+            BDN_INTERFACE_TABLE(ISwitchCore, IToggleCoreBase, IViewCore, LayoutCoordinator::IViewCoreExtension);
+
           public:
             MockToggleCore(Toggle *toggle) : MockViewCore(toggle)
             {
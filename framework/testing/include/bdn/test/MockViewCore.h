@@ -20,6 +20,8 @@ namespace bdn
             */
         class MockViewCore : public Base, BDN_IMPLEMENTS IViewCore, BDN_IMPLEMENTS LayoutCoordinator::IViewCoreExtension
         {
+            BDN_INTERFACE_TABLE(IViewCore, LayoutCoordinator::IViewCoreExtension);
+
           public:
             explicit MockViewCore(View *view)
             {
@@ -21,6 +21,9 @@ namespace bdn
                                BDN_IMPLEMENTS IWindowCore,
                                BDN_IMPLEMENTS LayoutCoordinator::IWindowCoreExtension
         {
+            BDN_INTERFACE_TABLE(IWindowCore, LayoutCoordinator::IWindowCoreExtension, IViewCore,
+                                LayoutCoordinator::IViewCoreExtension);
+
           public:
             MockWindowCore(Window *window) : MockViewCore(window)
             {
@@ -8,6 +8,8 @@ namespace bdn
 
     class IButtonCore : BDN_IMPLEMENTS IViewCore
     {
+        BDN_INTERFACE_ID(bdn::IButtonCore);
+
       public:
         /** Changes the button's label text.*/
         virtual void setLabel(const String &label) = 0;
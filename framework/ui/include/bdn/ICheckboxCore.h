@@ -10,6 +10,8 @@ namespace bdn
     /** Generic interface for toggle-like control cores */
     class ICheckboxCore : BDN_IMPLEMENTS IToggleCoreBase
     {
+        BDN_INTERFACE_ID(bdn::ICheckboxCore);
+
       public:
         /** Changes the controls's state. */
         virtual void setState(const TriState &state) = 0;
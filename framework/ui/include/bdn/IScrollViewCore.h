@@ -9,6 +9,8 @@ namespace bdn
     /** The core for scroll views.*/
     class IScrollViewCore : BDN_IMPLEMENTS IViewCore
     {
+        BDN_INTERFACE_ID(bdn::IScrollViewCore);
+
       public:
         /** Controls wether or not the view scrolls horizontally.*/
         virtual void setHorizontalScrollingEnabled(const bool &enabled) = 0;
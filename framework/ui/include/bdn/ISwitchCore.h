@@ -9,6 +9,8 @@ namespace bdn
     /** Generic interface for toggle-like control cores */
     class ISwitchCore : BDN_IMPLEMENTS IToggleCoreBase
     {
+        BDN_INTERFACE_ID(bdn::ISwitchCore);
+
       public:
         /** Changes the control's on/off state */
         virtual void setOn(const bool &on) = 0;
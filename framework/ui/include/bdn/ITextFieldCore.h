@@ -8,6 +8,8 @@ namespace bdn
 
     class ITextFieldCore : BDN_IMPLEMENTS IViewCore
     {
+        BDN_INTERFACE_ID(bdn::ITextFieldCore);
+
       public:
         // Implement setter functions for property observers here
         virtual void setText(const String &text) = 0;
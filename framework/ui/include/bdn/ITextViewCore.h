@@ -8,6 +8,8 @@ namespace bdn
 
     class ITextViewCore : BDN_IMPLEMENTS IViewCore
     {
+        BDN_INTERFACE_ID(bdn::ITextViewCore);
+
       public:
         /** Changes the text view's content text.*/
         virtual void setText(const String &text) = 0;
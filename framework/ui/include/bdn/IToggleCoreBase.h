@@ -8,6 +8,8 @@ namespace bdn
 
     class IToggleCoreBase : BDN_IMPLEMENTS IViewCore
     {
+        BDN_INTERFACE_ID(bdn::IToggleCoreBase);
+
       public:
         /** Changes the control's label text.*/
         virtual void setLabel(const String &label) = 0;
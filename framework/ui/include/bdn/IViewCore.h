@@ -17,6 +17,8 @@ namespace bdn
 
     class IViewCore : BDN_IMPLEMENTS IBase
     {
+        BDN_INTERFACE_ID(bdn::IViewCore);
+
       public:
         enum class InvalidateReason
         {
@@ -9,6 +9,8 @@ namespace bdn
     /** The core for a top level window.*/
     class IWindowCore : BDN_IMPLEMENTS IViewCore
     {
+        BDN_INTERFACE_ID(bdn::IWindowCore);
+
       public:
         /** Tells the window to auto-size itself. The window size will be
            adapted according to the preferred size of the content view. The
@@ -53,6 +53,8 @@ namespace bdn
          * should implement.*/
         class IViewCoreExtension : BDN_IMPLEMENTS IBase
         {
+            BDN_INTERFACE_ID(bdn::LayoutCoordinator::IViewCoreExtension);
+
           public:
             /** Updates the layout of the view's contents (see
              * View::needLayout()).*/
@@ -63,6 +65,8 @@ namespace bdn
          * should implement.*/
         class IWindowCoreExtension : BDN_IMPLEMENTS IViewCoreExtension
         {
+            BDN_INTERFACE_ID(bdn::LayoutCoordinator::IWindowCoreExtension);
+
           public:
             /** Autosizes the window. See Window::requestAutoSize().*/
             virtual void autoSize() = 0;
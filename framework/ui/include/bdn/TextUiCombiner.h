@@ -98,6 +98,8 @@ namespace bdn
                     throw UnfinishedError("Dummy read operation will never finish.");
             }
 
+            String takeResult() { return getResult(); }
+
             void signalStop()
             {
                 _aborted = true;
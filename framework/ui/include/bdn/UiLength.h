@@ -1,6 +1,8 @@
 #ifndef BDN_UiLength_H_
 #define BDN_UiLength_H_
 
+#include <type_traits>
+
 namespace bdn
 {
 
@@ -11,11 +13,9 @@ namespace bdn
        non-existent value (similar to the standard nullptr value).
        Default-constructed UiLength objects are none.
 
-
-
-
+        UiLength is a plain, trivially copyable value type.
         */
-    struct UiLength : public Base
+    struct UiLength
     {
       public:
         enum class Unit
@@ -58,41 +58,36 @@ namespace bdn
 
         /** Default constructor - sets the unit to #UiLength::Unit::none and
          * value to 0.*/
-        UiLength()
-        {
-            unit = UiLength::Unit::none;
-            value = 0;
-        };
+        constexpr UiLength() : unit(UiLength::Unit::none), value(0) {}
 
-        UiLength(double value, Unit unit = UiLength::Unit::dip)
-        {
-            this->value = value;
-            this->unit = unit;
-        }
+        constexpr UiLength(double value, Unit unit = UiLength::Unit::dip) : unit(unit), value(value) {}
 
         /** Creates a UiLength object with the specified value and the
          * UiLength::Unit::sem unit.*/
-        static UiLength sem(double value) { return UiLength(value, UiLength::Unit::sem); }
+        static constexpr UiLength sem(double value) { return UiLength(value, UiLength::Unit::sem); }
 
         /** Creates a UiLength object with the specified value and the
          * UiLength::Unit::em unit.*/
-        static UiLength em(double value) { return UiLength(value, UiLength::Unit::em); }
+        static constexpr UiLength em(double value) { return UiLength(value, UiLength::Unit::em); }
 
         /** Creates a UiLength object with the specified value and the
          * UiLength::Unit::dip unit.*/
-        static UiLength dip(double value) { return UiLength(value, UiLength::Unit::dip); }
+        static constexpr UiLength dip(double value) { return UiLength(value, UiLength::Unit::dip); }
 
         /** Creates a UiLength object with the UiLength::Unit::none unit (same
          * as default-constructed UiLength).*/
-        static UiLength none() { return UiLength(); }
+        static constexpr UiLength none() { return UiLength(); }
 
         /** Returns true if this UiLength object has the special "none" value.*/
-        bool isNone() const { return (unit == UiLength::Unit::none); }
+        constexpr bool isNone() const { return (unit == UiLength::Unit::none); }
 
         Unit unit;
         double value;
     };
 
+    static_assert(sizeof(UiLength) <= 2 * sizeof(double), "UiLength must not be bigger than two doubles");
+    static_assert(std::is_trivially_copyable<UiLength>::value, "UiLength must be trivially copyable");
+
     template <typename CHAR_TYPE, class CHAR_TRAITS>
     std::basic_ostream<CHAR_TYPE, CHAR_TRAITS> &operator<<(std::basic_ostream<CHAR_TYPE, CHAR_TRAITS> &stream,
                                                            const UiLength &l)
@@ -3,6 +3,8 @@
 
 #include <bdn/UiLength.h>
 
+#include <type_traits>
+
 namespace bdn
 {
 
@@ -16,15 +18,15 @@ namespace bdn
     struct UiMargin
     {
       public:
-        UiMargin() {}
+        constexpr UiMargin() {}
 
-        UiMargin(const UiLength &all) : top(all), right(all), bottom(all), left(all) {}
+        constexpr UiMargin(const UiLength &all) : top(all), right(all), bottom(all), left(all) {}
 
-        UiMargin(const UiLength &topBottom, const UiLength &leftRight)
+        constexpr UiMargin(const UiLength &topBottom, const UiLength &leftRight)
             : top(topBottom), right(leftRight), bottom(topBottom), left(leftRight)
         {}
 
-        UiMargin(const UiLength &top, const UiLength &right, const UiLength &bottom, const UiLength &left)
+        constexpr UiMargin(const UiLength &top, const UiLength &right, const UiLength &bottom, const UiLength &left)
             : top(top), right(right), bottom(bottom), left(left)
         {}
 
@@ -34,6 +36,8 @@ namespace bdn
         UiLength left;
     };
 
+    static_assert(std::is_trivially_copyable<UiMargin>::value, "UiMargin must be trivially copyable");
+
     template <typename CHAR_TYPE, class CHAR_TRAITS>
     std::basic_ostream<CHAR_TYPE, CHAR_TRAITS> &operator<<(std::basic_ostream<CHAR_TYPE, CHAR_TRAITS> &stream,
                                                            const UiMargin &m)
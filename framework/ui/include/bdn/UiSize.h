@@ -17,16 +17,18 @@ namespace bdn
     struct UiSize
     {
       public:
-        UiSize() {}
+        constexpr UiSize() {}
 
-        UiSize(const Size &size) : width(size.width), height(size.height) {}
+        constexpr UiSize(const Size &size) : width(size.width), height(size.height) {}
 
-        UiSize(const UiLength &width, const UiLength &height) : width(width), height(height) {}
+        constexpr UiSize(const UiLength &width, const UiLength &height) : width(width), height(height) {}
 
         UiLength width;
         UiLength height;
     };
 
+    static_assert(std::is_trivially_copyable<UiSize>::value, "UiSize must be trivially copyable");
+
     template <typename CHAR_TYPE, class CHAR_TRAITS>
     std::basic_ostream<CHAR_TYPE, CHAR_TRAITS> &operator<<(std::basic_ostream<CHAR_TYPE, CHAR_TRAITS> &stream,
                                                            const UiSize &s)
@@ -13,6 +13,8 @@ namespace bdn
 
         class ButtonCore : public ViewCore, BDN_IMPLEMENTS IButtonCore
         {
+            BDN_INTERFACE_TABLE(IButtonCore, IViewCore, LayoutCoordinator::IViewCoreExtension);
+
           private:
             static P<JButton> _createJButton(Button *outer)
             {
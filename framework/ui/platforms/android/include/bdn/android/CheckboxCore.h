@@ -14,6 +14,8 @@ namespace bdn
 
         template <class T> class CheckboxCore : public ViewCore, BDN_IMPLEMENTS ICheckboxCore
         {
+            BDN_INTERFACE_TABLE(ICheckboxCore, IToggleCoreBase, IViewCore, LayoutCoordinator::IViewCoreExtension);
+
           private:
             static P<JCheckBox> _createJCheckBox(T *outer)
             {
@@ -13,6 +13,8 @@ namespace bdn
 
         class ContainerViewCore : public ViewCore, BDN_IMPLEMENTS IParentViewCore
         {
+            BDN_INTERFACE_TABLE(IParentViewCore, IViewCore, LayoutCoordinator::IViewCoreExtension);
+
           private:
             static P<JNativeViewGroup> _createJNativeViewGroup(ContainerView *outer)
             {
@@ -10,6 +10,8 @@ namespace bdn
          * cores.*/
         class IParentViewCore : BDN_IMPLEMENTS IBase
         {
+            BDN_INTERFACE_ID(bdn::android::IParentViewCore);
+
           public:
             /** Adds a child Ui element to the parent.*/
             virtual void addChildJView(JView view) = 0;
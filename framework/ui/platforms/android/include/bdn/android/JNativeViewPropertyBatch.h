@@ -0,0 +1,59 @@
+#ifndef BDN_ANDROID_JNativeViewPropertyBatch_H_
+#define BDN_ANDROID_JNativeViewPropertyBatch_H_
+
+#include <bdn/java/JObject.h>
+#include <bdn/java/ArrayOfObjects.h>
+#include <bdn/java/ArrayOfPrimitives.h>
+#include <bdn/android/JView.h>
+
+namespace bdn
+{
+    namespace android
+    {
+
+        /** Accessor for Java-side io.boden.android.NativeViewPropertyBatch
+         * objects.
+         *
+         *  Usually you should use ViewPropertyBatch instead of calling this
+         * directly.*/
+        class JNativeViewPropertyBatch : public bdn::java::JObject
+        {
+          public:
+            /** @param javaRef the reference to the Java object.
+             *      The JObject instance will copy this reference and keep its
+             * type. So if you want the JObject instance to hold a strong
+             * reference then you need to call toStrong() on the reference first
+             * and pass the result.
+             *      */
+            explicit JNativeViewPropertyBatch(const bdn::java::Reference &javaRef) : JObject(javaRef) {}
+
+            /** Returns the JClass object for this class.
+             *
+             *  Note that the returned class object is not necessarily unique
+             * for the whole process. You might get different objects if this
+             * function is called from different shared libraries.
+             *
+             *  If you want to check for type equality then you should compare
+             * the type name (see getTypeName() )
+             *  */
+            static bdn::java::JClass &getStaticClass_()
+            {
+                static bdn::java::JClass cls("io/boden/android/NativeViewPropertyBatch");
+
+                return cls;
+            }
+
+            bdn::java::JClass &getClass_() override { return getStaticClass_(); }
+
+            /** Applies the encoded operations to the specified views.*/
+            static void apply(bdn::java::ArrayOfObjects<JView> views, bdn::java::ArrayOfInts ops, int opsLength)
+            {
+                static bdn::java::MethodId methodId;
+
+                invokeStatic_<void>(getStaticClass_(), methodId, "apply", views, ops, opsLength);
+            }
+        };
+    }
+}
+
+#endif
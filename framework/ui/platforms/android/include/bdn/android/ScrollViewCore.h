@@ -18,6 +18,8 @@ namespace bdn
 
         class ScrollViewCore : public ViewCore, BDN_IMPLEMENTS IScrollViewCore, BDN_IMPLEMENTS IParentViewCore
         {
+            BDN_INTERFACE_TABLE(IScrollViewCore, IParentViewCore, IViewCore, LayoutCoordinator::IViewCoreExtension);
+
           private:
             static P<JNativeScrollView> _createNativeScrollView(ScrollView *outer)
             {
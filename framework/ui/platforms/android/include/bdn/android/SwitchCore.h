@@ -14,6 +14,8 @@ namespace bdn
 
         template <class T> class SwitchCore : public ViewCore, BDN_IMPLEMENTS ISwitchCore
         {
+            BDN_INTERFACE_TABLE(ISwitchCore, IToggleCoreBase, IViewCore, LayoutCoordinator::IViewCoreExtension);
+
           private:
             static P<JSwitch> _createJSwitch(T *outer)
             {
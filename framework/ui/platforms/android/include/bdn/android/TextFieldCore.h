@@ -19,6 +19,8 @@ namespace bdn
 
         class TextFieldCore : public ViewCore, BDN_IMPLEMENTS ITextFieldCore
         {
+            BDN_INTERFACE_TABLE(ITextFieldCore, IViewCore, LayoutCoordinator::IViewCoreExtension);
+
           private:
             static P<JEditText> _createJEditText(TextField *outer)
             {
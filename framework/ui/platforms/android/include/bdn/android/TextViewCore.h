@@ -14,6 +14,8 @@ namespace bdn
 
         class TextViewCore : public ViewCore, BDN_IMPLEMENTS ITextViewCore
         {
+            BDN_INTERFACE_TABLE(ITextViewCore, IViewCore, LayoutCoordinator::IViewCoreExtension);
+
           private:
             static P<JTextView> _createJTextView(TextView *outer)
             {
@@ -19,6 +19,7 @@ namespace bdn
 #include <bdn/android/JNativeViewCoreClickListener.h>
 #include <bdn/android/JView.h>
 #include <bdn/android/JNativeViewGroup.h>
+#include <bdn/android/ViewPropertyBatch.h>
 #include <bdn/android/UiProvider.h>
 #include <bdn/android/IParentViewCore.h>
 
@@ -31,6 +32,8 @@ namespace bdn
 
         class ViewCore : public Base, BDN_IMPLEMENTS IViewCore, BDN_IMPLEMENTS LayoutCoordinator::IViewCoreExtension
         {
+            BDN_INTERFACE_TABLE(IViewCore, LayoutCoordinator::IViewCoreExtension);
+
           public:
             ViewCore(View *outerView, JView *jView)
             {
@@ -43,14 +46,20 @@ namespace bdn
                 // view
                 _jView->setTag(bdn::java::NativeWeakPointer(this));
 
-                setVisible(outerView->visible());
-
                 _addToParent(outerView->getParentView());
 
                 _defaultPixelPadding = Margin(_jView->getPaddingTop(), _jView->getPaddingRight(),
                                               _jView->getPaddingBottom(), _jView->getPaddingLeft());
 
-                setPadding(outerView->padding());
+                // push the initial visibility and padding to the java side
+                // with a single call.
+                Margin pixelPadding = getPixelPadding_(outerView->padding());
+
+                ViewPropertyBatch batch;
+                batch.setVisibility(*_jView, getJavaVisibility_(outerView->visible()));
+                batch.setPadding(*_jView, pixelPadding.left, pixelPadding.top, pixelPadding.right,
+                                 pixelPadding.bottom);
+                batch.flush();
 
                 // initialize the onClick listener. It will call the view core's
                 // virtual clicked() method.
@@ -92,22 +101,11 @@ namespace bdn
              */
             JView &getJView() { return *_jView; }
 
-            void setVisible(const bool &visible) override
-            {
-                _jView->setVisibility(visible ? JView::Visibility::visible : JView::Visibility::invisible);
-            }
+            void setVisible(const bool &visible) override { _jView->setVisibility(getJavaVisibility_(visible)); }
 
             void setPadding(const Nullable<UiMargin> &padding) override
             {
-                Margin pixelPadding;
-                if (padding.isNull())
-                    pixelPadding = _defaultPixelPadding;
-                else {
-                    Margin dipPadding = uiMarginToDipMargin(padding);
-
-                    pixelPadding = Margin(dipPadding.top * _uiScaleFactor, dipPadding.right * _uiScaleFactor,
-                                          dipPadding.bottom * _uiScaleFactor, dipPadding.left * _uiScaleFactor);
-                }
+                Margin pixelPadding = getPixelPadding_(padding);
 
                 _jView->setPadding(pixelPadding.left, pixelPadding.top, pixelPadding.right, pixelPadding.bottom);
             }
@@ -350,6 +348,23 @@ namespace bdn
             double getSemSizeDips() const;
 
           private:
+            static JView::Visibility getJavaVisibility_(bool visible)
+            {
+                return visible ? JView::Visibility::visible : JView::Visibility::invisible;
+            }
+
+            Margin getPixelPadding_(const Nullable<UiMargin> &padding) const
+            {
+                if (padding.isNull())
+                    return _defaultPixelPadding;
+                else {
+                    Margin dipPadding = uiMarginToDipMargin(padding);
+
+                    return Margin(dipPadding.top * _uiScaleFactor, dipPadding.right * _uiScaleFactor,
+                                  dipPadding.bottom * _uiScaleFactor, dipPadding.left * _uiScaleFactor);
+                }
+            }
+
             void _addToParent(View *parent)
             {
                 if (parent != nullptr) {
@@ -0,0 +1,102 @@
+#ifndef BDN_ANDROID_ViewPropertyBatch_H_
+#define BDN_ANDROID_ViewPropertyBatch_H_
+
+#include <bdn/android/JNativeViewPropertyBatch.h>
+
+#include <bdn/Array.h>
+
+namespace bdn
+{
+    namespace android
+    {
+
+        /** Collects many small view property updates on the native side and
+         * sends them to the Java side with a single JNI call.
+         *
+         *  Each individual JView method call (setVisibility, setPadding,
+         * etc.) is a separate native->Java transition. When many properties
+         * are updated at once (for example when ViewCore pushes the initial
+         * state of a new view) these transitions add up. ViewPropertyBatch
+         * instead encodes the updates into a primitive int array and applies
+         * them all in one call (see NativeViewPropertyBatch.java).
+         *
+         *  \code
+         *
+         *  ViewPropertyBatch batch;
+         *
+         *  batch.setVisibility(view1, JView::Visibility::gone);
+         *  batch.setPadding(view2, 10, 10, 10, 10);
+         *
+         *  batch.flush();
+         *
+         *  \endcode
+         *
+         *  The updates are applied in the order in which they were added.
+         * Nothing is applied until flush() is called. The destructor does NOT
+         * flush automatically, since flushing can throw exceptions.
+         *
+         *  ViewPropertyBatch objects must only be used from the main thread.
+         * */
+        class ViewPropertyBatch
+        {
+          public:
+            /** Operation codes. These must match the values in
+             * NativeViewPropertyBatch.java*/
+            enum class Op
+            {
+                setVisibility = 0,
+                setPadding = 1
+            };
+
+            void setVisibility(JView view, JView::Visibility visibility)
+            {
+                addOp(Op::setVisibility, view);
+                _ops.add((jint)visibility);
+            }
+
+            void setPadding(JView view, int left, int top, int right, int bottom)
+            {
+                addOp(Op::setPadding, view);
+                _ops.addSequence({left, top, right, bottom});
+            }
+
+            /** Returns true if no updates are pending.*/
+            bool isEmpty() const { return _ops.isEmpty(); }
+
+            /** Applies all pending updates with a single call to the Java side
+             * and clears the batch.*/
+            void flush()
+            {
+                if (_ops.isEmpty())
+                    return;
+
+                {
+                    // the Java arrays only need to exist for the duration of
+                    // the call.
+                    bdn::java::ArrayOfObjects<JView> javaViews(_views.size());
+                    javaViews.setElements_(0, _views);
+
+                    bdn::java::ArrayOfInts javaOps(_ops.data(), _ops.size());
+
+                    JNativeViewPropertyBatch::apply(javaViews, javaOps, (int)_ops.size());
+                }
+
+                _views.clear();
+                _ops.clear();
+            }
+
+          private:
+            void addOp(Op op, const JView &view)
+            {
+                _views.add(view);
+
+                _ops.addSequence({(jint)op, (jint)(_views.size() - 1)});
+            }
+
+            Array<JView> _views;
+            Array<jint> _ops;
+        };
+    }
+}
+
+#endif
@@ -24,6 +24,9 @@ namespace bdn
                            BDN_IMPLEMENTS LayoutCoordinator::IWindowCoreExtension,
                            BDN_IMPLEMENTS IParentViewCore
         {
+            BDN_INTERFACE_TABLE(IWindowCore, LayoutCoordinator::IWindowCoreExtension, IParentViewCore, IViewCore,
+                                LayoutCoordinator::IViewCoreExtension);
+
           private:
             P<JNativeViewGroup> createJNativeViewGroup(Window *outerWindow)
             {
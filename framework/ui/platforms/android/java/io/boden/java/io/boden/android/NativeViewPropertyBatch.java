@@ -0,0 +1,46 @@
+package io.boden.android;
+
+import android.view.View;
+
+
+/** Applies a batch of view property updates that were collected on the native side
+ *  (see bdn::android::ViewPropertyBatch).
+ *
+ *  The updates are encoded in a flat int array, so that the whole batch can be
+ *  passed to Java with a single JNI call. Each entry starts with an opcode, followed
+ *  by the index of the target view in the views array and the opcode specific arguments.
+ *
+ *  The opcode values must match the ones in ViewPropertyBatch.h.
+ *  */
+public class NativeViewPropertyBatch extends Object
+{
+    public static final int OP_SET_VISIBILITY = 0;
+    public static final int OP_SET_PADDING = 1;
+
+    public static void apply(View[] views, int[] ops, int opsLength)
+    {
+        int pos = 0;
+
+        while(pos < opsLength)
+        {
+            final int op = ops[pos++];
+            final View view = views[ ops[pos++] ];
+
+            switch(op)
+            {
+            case OP_SET_VISIBILITY:
+                view.setVisibility( ops[pos] );
+                pos += 1;
+                break;
+
+            case OP_SET_PADDING:
+                view.setPadding( ops[pos], ops[pos+1], ops[pos+2], ops[pos+3] );
+                pos += 4;
+                break;
+
+            default:
+                throw new IllegalArgumentException("Invalid view property batch opcode: "+Integer.toString(op));
+            }
+        }
+    }
+}
@@ -287,8 +287,9 @@ namespace bdn
         // log and ignore
         if (exceptionIfAvailable != nullptr)
             logError(*exceptionIfAvailable,
-                     "Exception in " + functionName + " during LayoutCoordinator updating. Ignording.");
+                     concat("Exception in ", functionName, " during LayoutCoordinator updating. Ignording."));
         else
-            logError("Exception pf unknown type in " + functionName + " during LayoutCoordinator updating. Ignording.");
+            logError(concat("Exception pf unknown type in ", functionName,
+                            " during LayoutCoordinator updating. Ignording."));
     }
 }
@@ -98,9 +98,10 @@ namespace bdn
                 !std::isfinite(adjustedBounds.x) || !std::isfinite(adjustedBounds.y)) {
                 // the preferred size MUST be finite.
                 IViewCore *corePtr = core;
-                programmingError(String(typeid(*corePtr).name()) + ".adjustAndSetBounds returned a non-finite value: " +
-                                 std::to_string(adjustedBounds.x) + " , " + std::to_string(adjustedBounds.y) + " " +
-                                 std::to_string(adjustedBounds.width) + " x " + std::to_string(adjustedBounds.height));
+                programmingError(concat(typeid(*corePtr).name(), ".adjustAndSetBounds returned a non-finite value: ",
+                                        std::to_string(adjustedBounds.x), " , ", std::to_string(adjustedBounds.y), " ",
+                                        std::to_string(adjustedBounds.width), " x ",
+                                        std::to_string(adjustedBounds.height)));
             }
         } else
             adjustedBounds = requestedBounds;
@@ -127,9 +128,10 @@ namespace bdn
                 !std::isfinite(adjustedBounds.x) || !std::isfinite(adjustedBounds.y)) {
                 // the adjusted bounds MUST be finite.
                 const IViewCore *corePtr = core;
-                programmingError(String(typeid(*corePtr).name()) + ".adjustBounds returned a non-finite value: " +
-                                 std::to_string(adjustedBounds.x) + " , " + std::to_string(adjustedBounds.y) + " " +
-                                 std::to_string(adjustedBounds.width) + " x " + std::to_string(adjustedBounds.height));
+                programmingError(concat(typeid(*corePtr).name(), ".adjustBounds returned a non-finite value: ",
+                                        std::to_string(adjustedBounds.x), " , ", std::to_string(adjustedBounds.y), " ",
+                                        std::to_string(adjustedBounds.width), " x ",
+                                        std::to_string(adjustedBounds.height)));
             }
 
             return adjustedBounds;
@@ -347,9 +349,9 @@ namespace bdn
                 if (!std::isfinite(preferredSize.width) || !std::isfinite(preferredSize.height)) {
                     // the preferred size MUST be finite.
                     IViewCore *corePtr = core;
-                    programmingError(
-                        String(typeid(*corePtr).name()) + ".calcPreferredSize returned a non-finite value: " +
-                        std::to_string(preferredSize.width) + " x " + std::to_string(preferredSize.height));
+                    programmingError(concat(typeid(*corePtr).name(), ".calcPreferredSize returned a non-finite value: ",
+                                            std::to_string(preferredSize.width), " x ",
+                                            std::to_string(preferredSize.height)));
                 }
 
                 _preferredSizeManager.set(availableSpace, preferredSize);
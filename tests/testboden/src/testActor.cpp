@@ -0,0 +1,215 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/Actor.h>
+#include <bdn/GenericDispatcher.h>
+#include <bdn/Signal.h>
+
+#if BDN_HAVE_THREADS
+
+#include <atomic>
+
+using namespace bdn;
+
+struct ActorTestState
+{
+    ActorTestState(int initialValue = 0) : value(initialValue) {}
+
+    int value;
+    std::vector<std::vector<int>> received{4};
+
+    std::atomic<int> active{0};
+    int overlapCount = 0;
+};
+
+template <class ResultType> static bool waitForOp(IAsyncOp<ResultType> *op)
+{
+    for (int i = 0; i < 500 && !op->isDone(); i++)
+        Thread::sleepMillis(10);
+
+    return op->isDone();
+}
+
+template <class ActorType> static void verifyActor(P<ActorType> actor)
+{
+    SECTION("order and no overlap")
+    {
+        const int senderCount = 4;
+        const int messageCount = 1000;
+
+        std::vector<std::future<void>> senders;
+        for (int sender = 0; sender < senderCount; sender++) {
+            senders.push_back(Thread::exec([actor, sender, messageCount]() {
+                for (int i = 0; i < messageCount; i++) {
+                    actor->tell([sender, i](ActorTestState &state) {
+                        if (++state.active != 1)
+                            state.overlapCount++;
+
+                        state.received[sender].push_back(i);
+
+                        state.active--;
+                    });
+                }
+            }));
+        }
+
+        for (auto &sender : senders)
+            sender.get();
+
+        P<IAsyncOp<bool>> op = actor->ask([senderCount, messageCount](ActorTestState &state) {
+            if (state.overlapCount != 0)
+                return false;
+
+            for (int sender = 0; sender < senderCount; sender++) {
+                if (state.received[sender].size() != (size_t)messageCount)
+                    return false;
+
+                for (int i = 0; i < messageCount; i++) {
+                    if (state.received[sender][i] != i)
+                        return false;
+                }
+            }
+
+            return true;
+        });
+
+        REQUIRE(waitForOp(op.getPtr()));
+        REQUIRE(op->getResult());
+    }
+
+    SECTION("ask")
+    {
+        actor->tell([](ActorTestState &state) { state.value += 10; });
+
+        P<IAsyncOp<int>> op = actor->ask([](ActorTestState &state) { return state.value; });
+
+        REQUIRE(waitForOp(op.getPtr()));
+        REQUIRE(op->getResult() == 52);
+    }
+
+    SECTION("ask exception")
+    {
+        P<IAsyncOp<int>> op =
+            actor->ask([](ActorTestState &state) -> int { throw InvalidArgumentError("hello"); });
+
+        REQUIRE(waitForOp(op.getPtr()));
+        REQUIRE_THROWS_AS(op->getResult(), InvalidArgumentError);
+    }
+
+    SECTION("tell from message")
+    {
+        P<Actor<ActorTestState>> actorP = actor;
+
+        // the message sends another message to the actor itself. That one is
+        // executed later, so it sees the value that the first message set.
+        actor->tell([actorP](ActorTestState &state) {
+            state.value = 1;
+            actorP->tell([](ActorTestState &state) { state.value += 10; });
+        });
+
+        actor->tell([](ActorTestState &state) { state.value += 100; });
+
+        P<IAsyncOp<int>> op;
+        for (int i = 0; i < 100; i++) {
+            op = actor->ask([](ActorTestState &state) { return state.value; });
+            REQUIRE(waitForOp(op.getPtr()));
+
+            if (op->getResult() == 111)
+                break;
+        }
+
+        REQUIRE(op->getResult() == 111);
+    }
+}
+
+TEST_CASE("Actor")
+{
+    SECTION("thread pool")
+    {
+        P<ThreadPool> pool = newObj<ThreadPool>(1, 4);
+
+        verifyActor(newObj<Actor<ActorTestState>>(pool, 42));
+    }
+
+    SECTION("serial executor")
+    {
+        P<SerialExecutor> executor = newObj<SerialExecutor>();
+
+        verifyActor(newObj<Actor<ActorTestState>>(executor, 42));
+    }
+
+    SECTION("dispatcher")
+    {
+        P<GenericDispatcher> dispatcher = newObj<GenericDispatcher>();
+        P<Thread> thread = newObj<Thread>(newObj<GenericDispatcher::ThreadRunnable>(dispatcher));
+
+        verifyActor(newObj<Actor<ActorTestState>>(dispatcher, 42));
+
+        thread->stop(Thread::ExceptionIgnore);
+        dispatcher->dispose();
+    }
+
+    SECTION("no thread while inactive")
+    {
+        P<ThreadPool> pool = newObj<ThreadPool>(0, 2);
+
+        std::vector<P<Actor<ActorTestState>>> actors;
+        for (int i = 0; i < 1000; i++)
+            actors.push_back(newObj<Actor<ActorTestState>>(pool));
+
+        REQUIRE(pool->getBusyThreadCount() == 0);
+        REQUIRE(pool->getQueuedJobCount() == 0);
+    }
+
+    SECTION("rejecting pool")
+    {
+        P<ThreadPool> pool = newObj<ThreadPool>(1, 1);
+        pool->setQueueLimit(0, ThreadPool::OverflowPolicy::reject);
+
+        // occupy the only thread of the pool
+        P<Signal> startedSignal = newObj<Signal>();
+        P<Signal> proceedSignal = newObj<Signal>();
+
+        P<Actor<ActorTestState>> blocker = newObj<Actor<ActorTestState>>(pool);
+        blocker->tell([startedSignal, proceedSignal](ActorTestState &) {
+            startedSignal->set();
+            proceedSignal->wait(5000);
+        });
+        REQUIRE(startedSignal->wait(5000));
+
+        P<Actor<ActorTestState>> actor = newObj<Actor<ActorTestState>>(pool, 1);
+        REQUIRE_THROWS_AS(actor->tell([](ActorTestState &state) { state.value++; }), QueueFullError);
+
+        proceedSignal->set();
+        for (int i = 0; i < 500 && pool->getBusyThreadCount() > 0; i++)
+            Thread::sleepMillis(10);
+
+        // the rejected drain must not prevent new drains. The message of the
+        // failed tell() is still executed.
+        P<IAsyncOp<int>> op = actor->ask([](ActorTestState &state) { return state.value; });
+        REQUIRE(waitForOp(op.getPtr()));
+        REQUIRE(op->getResult() == 2);
+    }
+
+    SECTION("delete aborts pending ask")
+    {
+        P<GenericDispatcher> dispatcher = newObj<GenericDispatcher>();
+        P<Actor<ActorTestState>> actor = newObj<Actor<ActorTestState>>(dispatcher);
+
+        // the dispatcher is not running, so the messages stay pending
+        P<IAsyncOp<int>> op = actor->ask([](ActorTestState &state) { return state.value; });
+        REQUIRE(actor->getPendingMessageCount() == 1);
+        REQUIRE(!op->isDone());
+
+        actor = nullptr;
+
+        REQUIRE(op->isDone());
+        REQUIRE_THROWS_AS(op->getResult(), AbortedError);
+
+        // the scheduled drain does nothing since the actor is gone
+        while (dispatcher->executeNext()) {
+        }
+    }
+}
+
+#endif
@@ -260,6 +260,54 @@ void verifyAsyncOpRunnable(bool withDoneListeners)
     }
 }
 
+class TestImmediateAsyncOp : public AsyncOpRunnable<String>
+{
+  protected:
+    String doOp() override { return "hello"; }
+};
+
+TEST_CASE("AsyncOpRunnable-takeResult")
+{
+    P<TestImmediateAsyncOp> op = newObj<TestImmediateAsyncOp>();
+
+    REQUIRE_THROWS_AS(op->takeResult(), UnfinishedError);
+
+    op->run();
+    REQUIRE(op->isDone());
+
+    SECTION("take")
+    {
+        REQUIRE(op->takeResult() == "hello");
+
+        REQUIRE_THROWS_PROGRAMMING_ERROR(op->takeResult());
+        REQUIRE_THROWS_PROGRAMMING_ERROR(op->getResult());
+    }
+
+    SECTION("get, then take")
+    {
+        REQUIRE(op->getResult() == "hello");
+        REQUIRE(op->takeResult() == "hello");
+    }
+
+    SECTION("first done listener added after finish")
+    {
+        // the notifier is only created now. The notification must still be
+        // delivered.
+        P<TestAsyncOpData> testData = newObj<TestAsyncOpData>();
+
+        op->onDone() += [testData](IAsyncOp<String> *op) { testData->done1CallCount++; };
+        op->onDone() += [testData](IAsyncOp<String> *op) { testData->done2CallCount++; };
+
+        REQUIRE(testData->done1CallCount == 0);
+
+        CONTINUE_SECTION_WHEN_IDLE(testData)
+        {
+            REQUIRE(testData->done1CallCount == 1);
+            REQUIRE(testData->done2CallCount == 1);
+        };
+    }
+}
+
 TEST_CASE("AsyncOpRunnable")
 {
     SECTION("without done listener")
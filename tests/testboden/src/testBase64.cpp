@@ -0,0 +1,94 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/base64.h>
+
+using namespace bdn;
+
+static void verifyBase64(const std::string &data, const String &expectedEncoded)
+{
+    REQUIRE(getBase64EncodedLength(data.length()) == expectedEncoded.getLength());
+
+    String encoded = toBase64String(data.c_str(), data.length());
+    REQUIRE(encoded == expectedEncoded);
+
+    std::vector<uint8_t> decoded;
+    REQUIRE(base64Decode(encoded, decoded));
+    REQUIRE(std::string(decoded.begin(), decoded.end()) == data);
+}
+
+static void verifyBase64DecodeFails(const String &text)
+{
+    std::vector<uint8_t> decoded(3);
+    REQUIRE(!base64Decode(text, decoded));
+    REQUIRE(decoded.empty());
+}
+
+TEST_CASE("base64")
+{
+    SECTION("rfc4648")
+    {
+        verifyBase64("", "");
+        verifyBase64("f", "Zg==");
+        verifyBase64("fo", "Zm8=");
+        verifyBase64("foo", "Zm9v");
+        verifyBase64("foob", "Zm9vYg==");
+        verifyBase64("fooba", "Zm9vYmE=");
+        verifyBase64("foobar", "Zm9vYmFy");
+    }
+
+    SECTION("allByteValues")
+    {
+        std::string data;
+        for (int i = 0; i < 256; i++)
+            data += char(i);
+
+        verifyBase64(data.substr(0, 6), "AAECAwQF");
+        verifyBase64(std::string("\xfb\xff\xbf", 3), "+/+/");
+
+        for (size_t length = 0; length <= data.length(); length++) {
+            std::string part = data.substr(data.length() - length);
+
+            String encoded = toBase64String(part.c_str(), part.length());
+            REQUIRE(encoded.getLength() == getBase64EncodedLength(length));
+
+            std::vector<uint8_t> decoded;
+            REQUIRE(base64Decode(encoded, decoded));
+            REQUIRE(std::string(decoded.begin(), decoded.end()) == part);
+        }
+    }
+
+    SECTION("rawBuffers")
+    {
+        const char data[] = "hello world";
+        char encoded[16];
+        base64Encode(data, 11, encoded);
+        REQUIRE(std::string(encoded, 16) == "aGVsbG8gd29ybGQ=");
+
+        uint8_t decoded[12];
+        size_t decodedBytes = 0;
+        REQUIRE(base64Decode(encoded, 16, decoded, decodedBytes));
+        REQUIRE(decodedBytes == 11);
+        REQUIRE(std::string(reinterpret_cast<char *>(decoded), decodedBytes) == data);
+    }
+
+    SECTION("invalid")
+    {
+        // missing padding
+        verifyBase64DecodeFails("Zg");
+        verifyBase64DecodeFails("Zm9vYg");
+
+        // misplaced padding
+        verifyBase64DecodeFails("Z===");
+        verifyBase64DecodeFails("====");
+        verifyBase64DecodeFails("Zg==Zm8=");
+        verifyBase64DecodeFails("Zm=v");
+
+        // characters that are not in the alphabet
+        verifyBase64DecodeFails("Zm9v YmFy");
+        verifyBase64DecodeFails("Zm9v\nYmFy");
+        verifyBase64DecodeFails("Zm9-");
+        verifyBase64DecodeFails("Zm9_");
+        verifyBase64DecodeFails(U"Zm9ä");
+    }
+}
@@ -0,0 +1,368 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/CancellationSource.h>
+#include <bdn/GenericDispatcher.h>
+#include <bdn/AsyncOpRunnable.h>
+
+#if BDN_HAVE_THREADS
+#include <bdn/ThreadPool.h>
+#endif
+
+#include <atomic>
+
+using namespace bdn;
+
+class CancellationTestOp : public AsyncOpRunnable<int>
+{
+  public:
+    CancellationTestOp(const CancellationToken &token) : AsyncOpRunnable<int>(token) {}
+
+    std::atomic<bool> doOpCalled{false};
+    std::atomic<bool> sawStopSignal{false};
+    Signal startedSignal;
+
+  protected:
+    int doOp() override
+    {
+        doOpCalled = true;
+        startedSignal.set();
+
+        for (int i = 0; i < 500; i++) {
+            if (isStopSignalled()) {
+                sawStopSignal = true;
+                getCancellationToken().throwIfCancelled();
+            }
+
+            Thread::sleepMillis(10);
+        }
+
+        return 42;
+    }
+};
+
+#if BDN_HAVE_THREADS
+
+class CancellationTestJob : public Base, BDN_IMPLEMENTS IThreadRunnable
+{
+  public:
+    CancellationTestJob(const CancellationToken &token = CancellationToken()) : _token(token) {}
+
+    void run() override
+    {
+        runCalled = true;
+        startedSignal.set();
+
+        if (blockUntilCancelled) {
+            for (int i = 0; i < 500 && !_token.isCancelled(); i++)
+                Thread::sleepMillis(10);
+
+            sawCancel = _token.isCancelled();
+        } else
+            releaseSignal.wait(5000);
+    }
+
+    void signalStop() override { signalStopCalled = true; }
+
+    bool blockUntilCancelled = false;
+
+    std::atomic<bool> runCalled{false};
+    std::atomic<bool> signalStopCalled{false};
+    std::atomic<bool> sawCancel{false};
+
+    Signal startedSignal;
+    Signal releaseSignal;
+
+  private:
+    CancellationToken _token;
+};
+
+#endif
+
+TEST_CASE("CancellationToken")
+{
+    SECTION("default token")
+    {
+        CancellationToken token;
+
+        REQUIRE(!token.canBeCancelled());
+        REQUIRE(!token.isCancelled());
+        REQUIRE_NOTHROW(token.throwIfCancelled());
+
+        REQUIRE(token.onCancel([]() {}) == nullptr);
+    }
+
+    SECTION("cancel")
+    {
+        P<CancellationSource> source = newObj<CancellationSource>();
+        CancellationToken token = source->getToken();
+        CancellationToken tokenCopy = token;
+
+        REQUIRE(token.canBeCancelled());
+        REQUIRE(!token.isCancelled());
+        REQUIRE(!source->isCancelled());
+
+        int callCount = 0;
+        P<INotifierSubscription> sub = token.onCancel([&callCount]() { callCount++; });
+        REQUIRE(sub != nullptr);
+
+        int removedCallCount = 0;
+        P<INotifierSubscription> removedSub = token.onCancel([&removedCallCount]() { removedCallCount++; });
+        token.removeOnCancel(removedSub);
+
+        source->cancel();
+
+        REQUIRE(source->isCancelled());
+        REQUIRE(token.isCancelled());
+        REQUIRE(tokenCopy.isCancelled());
+        REQUIRE_THROWS_AS(token.throwIfCancelled(), CancelledError);
+        REQUIRE_THROWS_AS(token.throwIfCancelled(), AbortedError);
+
+        REQUIRE(callCount == 1);
+        REQUIRE(removedCallCount == 0);
+
+        // only the first cancel has an effect
+        source->cancel();
+        REQUIRE(callCount == 1);
+
+        SECTION("onCancel after cancel")
+        {
+            int lateCallCount = 0;
+            REQUIRE(token.onCancel([&lateCallCount]() { lateCallCount++; }) == nullptr);
+            REQUIRE(lateCallCount == 1);
+        }
+    }
+
+    SECTION("dispatcher")
+    {
+        P<GenericDispatcher> dispatcher = newObj<GenericDispatcher>();
+        P<CancellationSource> source = newObj<CancellationSource>();
+
+        int callCount = 0;
+        dispatcher->enqueueCancellable(source->getToken(), [&callCount]() { callCount++; });
+        dispatcher->enqueueInSecondsCancellable(source->getToken(), 0.01, [&callCount]() { callCount++; });
+        dispatcher->enqueue([&callCount]() { callCount += 10; });
+
+        source->cancel();
+
+        // cancelled before enqueueing => not added at all
+        dispatcher->enqueueCancellable(source->getToken(), [&callCount]() { callCount++; });
+
+        Thread::sleepMillis(50);
+        while (dispatcher->executeNext()) {
+        }
+
+        REQUIRE(callCount == 10);
+
+        SECTION("cancel releases the function")
+        {
+            P<CancellationSource> otherSource = newObj<CancellationSource>();
+
+            P<Base> captured = newObj<Base>();
+            WeakP<Base> capturedWeak(captured);
+
+            dispatcher->enqueueCancellable(otherSource->getToken(), [captured, &callCount]() { callCount++; });
+            dispatcher->enqueueInSecondsCancellable(otherSource->getToken(), 100, [captured]() {});
+            captured = nullptr;
+
+            REQUIRE(capturedWeak.toStrong() != nullptr);
+
+            // the items are still queued, but the captures are released
+            otherSource->cancel();
+            REQUIRE(capturedWeak.toStrong() == nullptr);
+
+            while (dispatcher->executeNext()) {
+            }
+
+            REQUIRE(callCount == 10);
+        }
+
+        SECTION("not cancelled")
+        {
+            P<CancellationSource> otherSource = newObj<CancellationSource>();
+            dispatcher->enqueueCancellable(otherSource->getToken(), [&callCount]() { callCount++; });
+
+            while (dispatcher->executeNext()) {
+            }
+
+            REQUIRE(callCount == 11);
+        }
+
+        dispatcher->dispose();
+    }
+
+    SECTION("AsyncOpRunnable")
+    {
+        P<CancellationSource> source = newObj<CancellationSource>();
+
+        SECTION("cancelled before start")
+        {
+            P<CancellationTestOp> op = newObj<CancellationTestOp>(source->getToken());
+
+            source->cancel();
+            op->run();
+
+            REQUIRE(op->isDone());
+            REQUIRE(!op->doOpCalled);
+            REQUIRE_THROWS_AS(op->getResult(), CancelledError);
+        }
+
+        SECTION("cancel is reported before run")
+        {
+            P<CancellationTestOp> op = newObj<CancellationTestOp>(source->getToken());
+
+            // the operation has not been picked up by anyone yet. It must
+            // still report the cancellation right away.
+            source->cancel();
+
+            REQUIRE(op->isDone());
+            REQUIRE_THROWS_AS(op->getResult(), CancelledError);
+
+            op->run();
+            REQUIRE(!op->doOpCalled);
+        }
+
+        SECTION("destroyed before cancel")
+        {
+            P<CancellationTestOp> op = newObj<CancellationTestOp>(source->getToken());
+            op = nullptr;
+
+            source->cancel();
+        }
+
+        SECTION("not cancelled")
+        {
+            P<CancellationTestOp> op = newObj<CancellationTestOp>(CancellationToken());
+
+            source->cancel();
+            op->signalStop();
+            op->run();
+
+            // a plain stop is still reported as an AbortedError
+            REQUIRE(op->isDone());
+            REQUIRE_THROWS_AS(op->getResult(), AbortedError);
+
+            bool isCancelledError = false;
+            try {
+                op->getResult();
+            }
+            catch (CancelledError &) {
+                isCancelledError = true;
+            }
+            catch (AbortedError &) {
+            }
+            REQUIRE(!isCancelledError);
+        }
+
+#if BDN_HAVE_THREADS
+        SECTION("cancelled while running")
+        {
+            P<CancellationTestOp> op = newObj<CancellationTestOp>(source->getToken());
+
+            P<Thread> thread = newObj<Thread>(op);
+
+            REQUIRE(op->startedSignal.wait(5000));
+            source->cancel();
+
+            thread->join(Thread::ExceptionThrow);
+
+            REQUIRE(op->sawStopSignal);
+            REQUIRE_THROWS_AS(op->getResult(), CancelledError);
+        }
+#endif
+    }
+
+#if BDN_HAVE_THREADS
+    SECTION("ThreadPool")
+    {
+        P<ThreadPool> pool = newObj<ThreadPool>(1, 1);
+        P<CancellationSource> source = newObj<CancellationSource>();
+
+        // occupies the only thread of the pool
+        P<CancellationTestJob> blocker = newObj<CancellationTestJob>();
+        pool->addJob(blocker);
+        REQUIRE(blocker->startedSignal.wait(5000));
+
+        SECTION("queued job is dropped")
+        {
+            P<CancellationTestJob> job = newObj<CancellationTestJob>();
+            pool->addJob(job, source->getToken());
+
+            REQUIRE(pool->getQueuedJobCount() == 1);
+
+            source->cancel();
+            REQUIRE(job->signalStopCalled);
+
+            P<CancellationTestJob> afterJob = newObj<CancellationTestJob>();
+            afterJob->releaseSignal.set();
+            pool->addJob(afterJob);
+
+            blocker->releaseSignal.set();
+
+            REQUIRE(afterJob->startedSignal.wait(5000));
+            REQUIRE(!job->runCalled);
+        }
+
+        SECTION("already cancelled")
+        {
+            source->cancel();
+
+            P<CancellationTestJob> job = newObj<CancellationTestJob>();
+            pool->addJob(job, source->getToken());
+
+            REQUIRE(pool->getQueuedJobCount() == 0);
+            REQUIRE(job->signalStopCalled);
+            REQUIRE(!job->runCalled);
+
+            blocker->releaseSignal.set();
+        }
+
+        SECTION("running job sees cancel")
+        {
+            blocker->releaseSignal.set();
+
+            P<CancellationTestJob> job = newObj<CancellationTestJob>(source->getToken());
+            job->blockUntilCancelled = true;
+            pool->addJob(job, source->getToken());
+
+            REQUIRE(job->startedSignal.wait(5000));
+            source->cancel();
+
+            for (int i = 0; i < 500 && !job->sawCancel; i++)
+                Thread::sleepMillis(10);
+
+            REQUIRE(job->sawCancel);
+            REQUIRE(job->signalStopCalled);
+        }
+
+        SECTION("AsyncOpRunnable queued")
+        {
+            P<CancellationTestOp> op = newObj<CancellationTestOp>(source->getToken());
+            pool->addJob(op, source->getToken());
+
+            source->cancel();
+
+            // signalStop aborts the operation right away, without waiting for
+            // the queue.
+            REQUIRE(op->isDone());
+            REQUIRE_THROWS_AS(op->getResult(), CancelledError);
+
+            blocker->releaseSignal.set();
+        }
+
+        SECTION("AsyncOpRunnable queued without pool token")
+        {
+            P<CancellationTestOp> op = newObj<CancellationTestOp>(source->getToken());
+            pool->addJob(op);
+
+            source->cancel();
+
+            // the operation's own token aborts it while it is still queued.
+            REQUIRE(op->isDone());
+            REQUIRE_THROWS_AS(op->getResult(), CancelledError);
+
+            blocker->releaseSignal.set();
+        }
+    }
+#endif
+}
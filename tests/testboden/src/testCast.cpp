@@ -123,3 +123,177 @@ TEST_CASE("cast")
         }
     }
 }
+
+class ICastTestFirst : BDN_IMPLEMENTS IBase
+{
+    BDN_INTERFACE_ID(::ICastTestFirst);
+};
+
+class ICastTestSecond : BDN_IMPLEMENTS IBase
+{
+    BDN_INTERFACE_ID(::ICastTestSecond);
+};
+
+class ICastTestDerived : BDN_IMPLEMENTS ICastTestFirst
+{
+    // no own ID. Casts to this interface always use dynamic_cast.
+};
+
+class ICastTestUnlisted : BDN_IMPLEMENTS IBase
+{
+    BDN_INTERFACE_ID(::ICastTestUnlisted);
+};
+
+// declares the ID of ICastTestFirst under a different name, like an
+// interface whose name hash collides with that of ICastTestFirst.
+class ICastTestColliding : BDN_IMPLEMENTS IBase
+{
+  public:
+    using InterfaceIdOwner_ = ICastTestColliding;
+    static constexpr const char *getInterfaceName_() { return "::ICastTestColliding"; }
+    static constexpr InterfaceId getInterfaceId_() { return ICastTestFirst::getInterfaceId_(); }
+};
+
+namespace bdn
+{
+    namespace castTestA
+    {
+        class ICastTestSameName : BDN_IMPLEMENTS IBase
+        {
+            BDN_INTERFACE_ID(bdn::castTestA::ICastTestSameName);
+        };
+    }
+
+    namespace castTestB
+    {
+        class ICastTestSameName : BDN_IMPLEMENTS IBase
+        {
+            BDN_INTERFACE_ID(bdn::castTestB::ICastTestSameName);
+        };
+    }
+}
+
+class CastTestImpl : public Base,
+                     BDN_IMPLEMENTS ICastTestDerived,
+                     BDN_IMPLEMENTS ICastTestSecond,
+                     BDN_IMPLEMENTS ICastTestUnlisted
+{
+    BDN_INTERFACE_TABLE(ICastTestFirst, ICastTestSecond);
+};
+
+class CastTestSubImpl : public CastTestImpl
+{
+};
+
+class CastTestNoTable : public Base, BDN_IMPLEMENTS ICastTestFirst
+{
+};
+
+class CastTestCollidingImpl : public Base, BDN_IMPLEMENTS ICastTestFirst, BDN_IMPLEMENTS ICastTestColliding
+{
+    BDN_INTERFACE_TABLE(ICastTestFirst);
+};
+
+TEST_CASE("tryCast-interfaceTable")
+{
+    SECTION("interface ids")
+    {
+        REQUIRE(ICastTestFirst::getInterfaceId_() != ICastTestSecond::getInterfaceId_());
+        REQUIRE(ICastTestFirst::getInterfaceId_() == makeInterfaceId_("::ICastTestFirst"));
+        REQUIRE(String(ICastTestFirst::getInterfaceName_()) == "::ICastTestFirst");
+
+        // same unqualified name in different namespaces
+        REQUIRE(castTestA::ICastTestSameName::getInterfaceId_() != castTestB::ICastTestSameName::getInterfaceId_());
+
+        REQUIRE(isQualifiedInterfaceName_("bdn::IViewCore"));
+        REQUIRE(isQualifiedInterfaceName_("::IViewCore"));
+        REQUIRE(!isQualifiedInterfaceName_("IViewCore"));
+
+        REQUIRE(HasOwnInterfaceId_<ICastTestFirst>::value);
+        REQUIRE(HasOwnInterfaceId_<const ICastTestFirst>::value);
+        REQUIRE(!HasOwnInterfaceId_<ICastTestDerived>::value);
+        REQUIRE(!HasOwnInterfaceId_<CastTestImpl>::value);
+    }
+
+    SECTION("queryInterface")
+    {
+        P<CastTestImpl> obj = newObj<CastTestImpl>();
+
+        REQUIRE(obj->queryInterface(ICastTestFirst::getInterfaceId_(), ICastTestFirst::getInterfaceName_()) ==
+                static_cast<void *>(static_cast<ICastTestFirst *>(obj.getPtr())));
+        REQUIRE(obj->queryInterface(ICastTestSecond::getInterfaceId_(), ICastTestSecond::getInterfaceName_()) ==
+                static_cast<void *>(static_cast<ICastTestSecond *>(obj.getPtr())));
+
+        // not listed in the table
+        REQUIRE(obj->queryInterface(ICastTestUnlisted::getInterfaceId_(), ICastTestUnlisted::getInterfaceName_()) ==
+                nullptr);
+
+        // matching ID, but a different name
+        REQUIRE(obj->queryInterface(ICastTestFirst::getInterfaceId_(), "::ICastTestColliding") == nullptr);
+
+        P<CastTestNoTable> noTable = newObj<CastTestNoTable>();
+        REQUIRE(noTable->queryInterface(ICastTestFirst::getInterfaceId_(), ICastTestFirst::getInterfaceName_()) ==
+                nullptr);
+    }
+
+    SECTION("tryCast")
+    {
+        SECTION("class with table")
+        {
+            P<CastTestImpl> obj = newObj<CastTestImpl>();
+            IBase *base = static_cast<ICastTestSecond *>(obj.getPtr());
+            const IBase *constBase = base;
+
+            REQUIRE(tryCast<ICastTestFirst>(base) == static_cast<ICastTestFirst *>(obj.getPtr()));
+            REQUIRE(tryCast<ICastTestSecond>(base) == static_cast<ICastTestSecond *>(obj.getPtr()));
+            REQUIRE(tryCast<ICastTestFirst>(constBase) == static_cast<ICastTestFirst *>(obj.getPtr()));
+
+            // fallback to dynamic_cast
+            REQUIRE(tryCast<ICastTestDerived>(base) == static_cast<ICastTestDerived *>(obj.getPtr()));
+            REQUIRE(tryCast<ICastTestUnlisted>(base) == static_cast<ICastTestUnlisted *>(obj.getPtr()));
+            REQUIRE(tryCast<CastTestImpl>(base) == obj.getPtr());
+            REQUIRE(tryCast<CastTestSubImpl>(base) == nullptr);
+
+            REQUIRE(cast<ICastTestSecond>(base) == static_cast<ICastTestSecond *>(obj.getPtr()));
+        }
+
+        SECTION("inherited table")
+        {
+            P<CastTestSubImpl> obj = newObj<CastTestSubImpl>();
+            IBase *base = static_cast<ICastTestFirst *>(obj.getPtr());
+
+            REQUIRE(tryCast<ICastTestSecond>(base) == static_cast<ICastTestSecond *>(obj.getPtr()));
+            REQUIRE(tryCast<CastTestSubImpl>(base) == obj.getPtr());
+        }
+
+        SECTION("class without table")
+        {
+            P<CastTestNoTable> obj = newObj<CastTestNoTable>();
+            IBase *base = obj.getPtr();
+
+            REQUIRE(tryCast<ICastTestFirst>(base) == static_cast<ICastTestFirst *>(obj.getPtr()));
+            REQUIRE(tryCast<ICastTestSecond>(base) == nullptr);
+            REQUIRE_THROWS_AS(cast<ICastTestSecond>(base), CastError);
+        }
+
+        SECTION("colliding id")
+        {
+            P<CastTestCollidingImpl> obj = newObj<CastTestCollidingImpl>();
+            IBase *base = static_cast<ICastTestFirst *>(obj.getPtr());
+
+            // the ID matches ICastTestFirst in the table, but the name does
+            // not. So the cast falls back to dynamic_cast.
+            REQUIRE(tryCast<ICastTestColliding>(base) == static_cast<ICastTestColliding *>(obj.getPtr()));
+            REQUIRE(tryCast<ICastTestFirst>(base) == static_cast<ICastTestFirst *>(obj.getPtr()));
+
+            P<CastTestImpl> other = newObj<CastTestImpl>();
+            REQUIRE(tryCast<ICastTestColliding>(static_cast<ICastTestSecond *>(other.getPtr())) == nullptr);
+        }
+
+        SECTION("null")
+        {
+            IBase *base = nullptr;
+            REQUIRE(tryCast<ICastTestFirst>(base) == nullptr);
+        }
+    }
+}
@@ -0,0 +1,298 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/ComputedProperty.h>
+#include <bdn/property.h>
+#include <bdn/GenericDispatcher.h>
+#include <bdn/Array.h>
+
+using namespace bdn;
+
+class ComputedPropertyTestOwner : public Base
+{
+  public:
+    BDN_PROPERTY(int, a, setA);
+    BDN_PROPERTY(int, b, setB);
+    BDN_PROPERTY(bool, useB, setUseB);
+};
+
+static void flushDispatcher(GenericDispatcher *dispatcher)
+{
+    while (dispatcher->executeNext()) {
+    }
+}
+
+TEST_CASE("ComputedProperty")
+{
+    P<ComputedPropertyTestOwner> owner = newObj<ComputedPropertyTestOwner>();
+    owner->setA(1);
+    owner->setB(10);
+
+    int computeCount = 0;
+
+    ComputedProperty<int>::ComputeFunc sumFunc = [owner,
+                                                  &computeCount](ComputedProperty<int>::DependencyTracker &tracker) {
+        computeCount++;
+        return BDN_TRACK_PROPERTY(tracker, *owner, a) + BDN_TRACK_PROPERTY(tracker, *owner, b);
+    };
+
+    SECTION("lazy")
+    {
+        P<ComputedProperty<int>> sum = newObj<ComputedProperty<int>>(sumFunc);
+
+        // nothing is computed until the value is needed
+        REQUIRE(computeCount == 0);
+        REQUIRE(sum->isDirty());
+
+        REQUIRE(sum->get() == 11);
+        REQUIRE(computeCount == 1);
+
+        // reading again does not recompute
+        REQUIRE(sum->get() == 11);
+        REQUIRE(computeCount == 1);
+
+        owner->setA(2);
+        owner->setB(20);
+
+        // only marked dirty, no recomputation yet
+        REQUIRE(sum->isDirty());
+        REQUIRE(computeCount == 1);
+
+        REQUIRE(sum->get() == 22);
+        REQUIRE(computeCount == 2);
+    }
+
+    SECTION("immediate notification")
+    {
+        P<ComputedProperty<int>> sum = newObj<ComputedProperty<int>>(sumFunc);
+
+        Array<int> notified;
+        sum->changed() += [&notified](const int &value) { notified.add(value); };
+
+        // accessing the notifier establishes the dependencies
+        REQUIRE(computeCount == 1);
+
+        owner->setA(5);
+        REQUIRE(computeCount == 2);
+        REQUIRE(notified == Array<int>{15});
+
+        owner->setB(20);
+        REQUIRE(computeCount == 3);
+        REQUIRE(notified == (Array<int>{15, 25}));
+    }
+
+    SECTION("no notification if value unchanged")
+    {
+        P<ComputedProperty<bool>> positive =
+            newObj<ComputedProperty<bool>>([owner, &computeCount](ComputedProperty<bool>::DependencyTracker &tracker) {
+                computeCount++;
+                return BDN_TRACK_PROPERTY(tracker, *owner, a) > 0;
+            });
+
+        Array<String> notified;
+        positive->changed() += [&notified](const bool &value) { notified.add(value ? "true" : "false"); };
+
+        owner->setA(2);
+        owner->setA(3);
+
+        // recomputed, but the value stayed the same
+        REQUIRE(computeCount == 3);
+        REQUIRE(notified.size() == 0);
+
+        owner->setA(-1);
+        REQUIRE(notified == Array<String>{"false"});
+    }
+
+    SECTION("deferred notification")
+    {
+        P<GenericDispatcher> dispatcher = newObj<GenericDispatcher>();
+
+        P<ComputedProperty<int>> sum = newObj<ComputedProperty<int>>(sumFunc, dispatcher);
+
+        Array<int> notified;
+        sum->changed() += [&notified](const int &value) { notified.add(value); };
+        REQUIRE(computeCount == 1);
+
+        SECTION("coalesced")
+        {
+            owner->setA(2);
+            owner->setB(20);
+            owner->setA(3);
+
+            REQUIRE(computeCount == 1);
+            REQUIRE(notified.size() == 0);
+
+            flushDispatcher(dispatcher);
+
+            // only one recomputation for the whole turn
+            REQUIRE(computeCount == 2);
+            REQUIRE(notified == Array<int>{23});
+        }
+
+        SECTION("changes cancel out")
+        {
+            owner->setA(2);
+            owner->setA(1);
+
+            flushDispatcher(dispatcher);
+
+            REQUIRE(computeCount == 2);
+            REQUIRE(notified.size() == 0);
+        }
+
+        SECTION("read before dispatcher turn")
+        {
+            owner->setA(2);
+
+            REQUIRE(sum->get() == 12);
+            REQUIRE(computeCount == 2);
+            REQUIRE(notified.size() == 0);
+
+            flushDispatcher(dispatcher);
+
+            // the change is still reported, without recomputing again
+            REQUIRE(computeCount == 2);
+            REQUIRE(notified == Array<int>{12});
+        }
+
+        dispatcher->dispose();
+    }
+
+    SECTION("conditional dependencies")
+    {
+        owner->setUseB(false);
+
+        P<ComputedProperty<int>> value =
+            newObj<ComputedProperty<int>>([owner, &computeCount](ComputedProperty<int>::DependencyTracker &tracker) {
+                computeCount++;
+                if (BDN_TRACK_PROPERTY(tracker, *owner, useB))
+                    return BDN_TRACK_PROPERTY(tracker, *owner, b);
+                else
+                    return BDN_TRACK_PROPERTY(tracker, *owner, a);
+            });
+
+        Array<int> notified;
+        value->changed() += [&notified](const int &newValue) { notified.add(newValue); };
+        REQUIRE(computeCount == 1);
+
+        // b was not read, so it is not a dependency
+        owner->setB(20);
+        REQUIRE(computeCount == 1);
+
+        owner->setUseB(true);
+        REQUIRE(computeCount == 2);
+        REQUIRE(notified == Array<int>{20});
+
+        // now a is not a dependency anymore
+        owner->setA(7);
+        REQUIRE(computeCount == 2);
+
+        owner->setB(30);
+        REQUIRE(computeCount == 3);
+        REQUIRE(notified == (Array<int>{20, 30}));
+    }
+
+    SECTION("chained")
+    {
+        P<ComputedProperty<int>> sum = newObj<ComputedProperty<int>>(sumFunc);
+
+        P<ComputedProperty<int>> doubled =
+            newObj<ComputedProperty<int>>([sum](ComputedProperty<int>::DependencyTracker &tracker) {
+                return tracker.get(*sum) * 2;
+            });
+
+        Array<int> notified;
+        doubled->changed() += [&notified](const int &value) { notified.add(value); };
+
+        REQUIRE(doubled->get() == 22);
+
+        owner->setB(20);
+        REQUIRE(notified == Array<int>{42});
+        REQUIRE(doubled->get() == 42);
+    }
+
+    SECTION("diamond")
+    {
+        // b and c both depend on a, d depends on b and c
+        P<ComputedProperty<int>> b =
+            newObj<ComputedProperty<int>>([owner](ComputedProperty<int>::DependencyTracker &tracker) {
+                return BDN_TRACK_PROPERTY(tracker, *owner, a);
+            });
+        P<ComputedProperty<int>> c =
+            newObj<ComputedProperty<int>>([owner](ComputedProperty<int>::DependencyTracker &tracker) {
+                return BDN_TRACK_PROPERTY(tracker, *owner, a) * 10;
+            });
+
+        P<ComputedProperty<int>> d =
+            newObj<ComputedProperty<int>>([b, c](ComputedProperty<int>::DependencyTracker &tracker) {
+                return tracker.get(*b) + tracker.get(*c);
+            });
+
+        Array<int> notified;
+        d->changed() += [&notified](const int &value) { notified.add(value); };
+
+        REQUIRE(d->get() == 11);
+
+        owner->setA(2);
+
+        // d must never see the new value of b together with the old value
+        // of c
+        REQUIRE(notified == Array<int>{22});
+        REQUIRE(d->get() == 22);
+
+        owner->setA(3);
+        REQUIRE(notified == (Array<int>{22, 33}));
+    }
+
+    SECTION("uneven diamond")
+    {
+        // d depends on a directly and through a chain of three computed
+        // properties. The direct path is shorter, so d is reached first.
+        P<ComputedProperty<int>> c1 =
+            newObj<ComputedProperty<int>>([owner](ComputedProperty<int>::DependencyTracker &tracker) {
+                return BDN_TRACK_PROPERTY(tracker, *owner, a);
+            });
+        P<ComputedProperty<int>> c2 = newObj<ComputedProperty<int>>(
+            [c1](ComputedProperty<int>::DependencyTracker &tracker) { return tracker.get(*c1) + 1; });
+        P<ComputedProperty<int>> c3 = newObj<ComputedProperty<int>>(
+            [c2](ComputedProperty<int>::DependencyTracker &tracker) { return tracker.get(*c2) + 1; });
+
+        P<ComputedProperty<int>> d =
+            newObj<ComputedProperty<int>>([owner, c3](ComputedProperty<int>::DependencyTracker &tracker) {
+                return BDN_TRACK_PROPERTY(tracker, *owner, a) * 100 + tracker.get(*c3);
+            });
+
+        Array<int> notified;
+        d->changed() += [&notified](const int &value) { notified.add(value); };
+
+        REQUIRE(d->get() == 103);
+
+        owner->setA(2);
+
+        REQUIRE(notified == Array<int>{204});
+    }
+
+    SECTION("circular dependency")
+    {
+        P<ComputedProperty<int>> self;
+        self = newObj<ComputedProperty<int>>(
+            [&self](ComputedProperty<int>::DependencyTracker &tracker) { return tracker.get(*self) + 1; });
+
+        REQUIRE_THROWS_AS(self->get(), ProgrammingError);
+
+        self = nullptr;
+    }
+
+    SECTION("destroyed computed property")
+    {
+        P<ComputedProperty<int>> sum = newObj<ComputedProperty<int>>(sumFunc);
+        sum->changed();
+        REQUIRE(computeCount == 1);
+
+        sum = nullptr;
+
+        // must not crash and must not recompute
+        owner->setA(3);
+        REQUIRE(computeCount == 1);
+    }
+}
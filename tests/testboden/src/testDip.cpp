@@ -146,6 +146,13 @@ TEST_CASE("Dip")
             Dip d(s);
             REQUIRE(d.getValue() == 17.45);
         }
+
+        SECTION("constexpr")
+        {
+            constexpr Dip d(17.45);
+            static_assert(d.getValue() == 17.45, "Dip must be usable in constant expressions");
+            REQUIRE(static_cast<double>(d) == 17.45);
+        }
     }
 
     SECTION("implicit conversion")
@@ -614,6 +614,92 @@ TEST_CASE("weakMethod")
 
         REQUIRE_THROWS_AS(m(), DanglingFunctionError);
     }
+
+    SECTION("objectDestroyed in DanglingCallScope_")
+    {
+        std::function<int()> m;
+        std::function<int()> otherM;
+
+        {
+            P<MethodPTestHelper> helper = newObj<MethodPTestHelper>();
+
+            m = weakMethod(helper, &MethodPTestHelper::i);
+            otherM = weakMethod(helper, &MethodPTestHelper::i);
+
+            DanglingCallScope_ scope(m);
+
+            REQUIRE(m() == 42);
+            REQUIRE(!scope.wasDangling());
+        }
+
+        SECTION("scope target")
+        {
+            DanglingCallScope_ scope(m);
+
+            // no exception. We get a default-constructed value instead.
+            REQUIRE(m() == 0);
+            REQUIRE(scope.wasDangling());
+        }
+
+        SECTION("other function")
+        {
+            DanglingCallScope_ scope(m);
+
+            // otherM is not the function that the scope was created for. So it
+            // must throw.
+            REQUIRE_THROWS_AS(otherM(), DanglingFunctionError);
+            REQUIRE(!scope.wasDangling());
+        }
+
+        SECTION("nested scope")
+        {
+            DanglingCallScope_ outerScope(m);
+
+            {
+                DanglingCallScope_ innerScope(otherM);
+
+                REQUIRE(otherM() == 0);
+                REQUIRE(innerScope.wasDangling());
+            }
+
+            REQUIRE(!outerScope.wasDangling());
+
+            REQUIRE(m() == 0);
+            REQUIRE(outerScope.wasDangling());
+        }
+
+        SECTION("no scope")
+        {
+            REQUIRE_THROWS_AS(m(), DanglingFunctionError);
+        }
+    }
+
+    SECTION("tryCall")
+    {
+        WeakMethod_<MethodPTestHelper, int(MethodPTestHelper::*)()> m;
+
+        {
+            P<MethodPTestHelper> helper = newObj<MethodPTestHelper>();
+
+            m = WeakMethod_<MethodPTestHelper, int(MethodPTestHelper::*)()>(helper, &MethodPTestHelper::i);
+
+            REQUIRE(!m.isDangling());
+            REQUIRE(m.tryCall());
+            REQUIRE(helper->_lastCalled == "int()");
+        }
+
+        REQUIRE(m.isDangling());
+        REQUIRE(!m.tryCall());
+    }
+
+    SECTION("IsWeakCallable_")
+    {
+        typedef int (MethodPTestHelper::*MethodType)();
+
+        REQUIRE((IsWeakCallable_<WeakMethod_<MethodPTestHelper, MethodType>>::value));
+        REQUIRE(!(IsWeakCallable_<StrongMethod_<MethodPTestHelper, MethodType>>::value));
+        REQUIRE(!IsWeakCallable_<std::function<int()>>::value);
+    }
 }
 
 class PlainMethodTestHelperNonBase
@@ -3,6 +3,8 @@
 
 #include <bdn/hex.h>
 
+#include <cctype>
+
 using namespace bdn;
 
 TEST_CASE("isHexDigit")
@@ -64,3 +66,124 @@ TEST_CASE("encodeHexDigit")
     REQUIRE(encodeHexDigit(16) == 0);
     REQUIRE(encodeHexDigit(100) == 0);
 }
+
+TEST_CASE("hexEncode")
+{
+    // lengths around the block size of the SIMD implementation, so that both
+    // the vectorized part and the tail are tested
+    for (size_t bytes = 0; bytes <= 40; bytes++) {
+        SECTION(std::to_string(bytes))
+        {
+            std::vector<uint8_t> data(bytes);
+            std::string expectedLower;
+            std::string expectedUpper;
+            for (size_t i = 0; i < bytes; i++) {
+                data[i] = uint8_t(i * 37 + 0x5a);
+
+                expectedLower += char(encodeHexDigit(data[i] >> 4));
+                expectedLower += char(encodeHexDigit(data[i] & 0xf));
+            }
+            for (char chr : expectedLower)
+                expectedUpper += char(std::toupper(chr));
+
+            std::string lower(bytes * 2, 'x');
+            hexEncode(data.data(), bytes, &lower[0]);
+            REQUIRE(lower == expectedLower);
+
+            std::string upper(bytes * 2, 'x');
+            hexEncode(data.data(), bytes, &upper[0], true);
+            REQUIRE(upper == expectedUpper);
+
+            std::u32string wide(bytes * 2, U'x');
+            hexEncode(data.data(), bytes, &wide[0]);
+            REQUIRE(String(wide) == String(expectedLower));
+
+            REQUIRE(toHexString(data.data(), bytes) == expectedLower);
+            REQUIRE(toHexString(data.data(), bytes, true) == expectedUpper);
+        }
+    }
+
+    SECTION("allByteValues")
+    {
+        uint8_t data[256];
+        for (int i = 0; i < 256; i++)
+            data[i] = uint8_t(i);
+
+        String hex = toHexString(data, sizeof(data));
+        REQUIRE(hex.getLength() == 512);
+        for (int i = 0; i < 256; i++)
+            REQUIRE(hex.subString(i * 2, 2) == String(std::string{char(encodeHexDigit(i >> 4)),
+                                                                   char(encodeHexDigit(i & 0xf))}));
+    }
+}
+
+TEST_CASE("hexDecode")
+{
+    SECTION("roundTrip")
+    {
+        for (size_t bytes = 0; bytes <= 40; bytes++) {
+            std::vector<uint8_t> data(bytes);
+            for (size_t i = 0; i < bytes; i++)
+                data[i] = uint8_t(i * 91 + 3);
+
+            for (int upperCase = 0; upperCase < 2; upperCase++) {
+                std::vector<uint8_t> decoded;
+                REQUIRE(hexDecode(toHexString(data.data(), bytes, upperCase != 0), decoded));
+                REQUIRE(decoded == data);
+            }
+        }
+    }
+
+    SECTION("mixedCase")
+    {
+        std::vector<uint8_t> decoded;
+        REQUIRE(hexDecode("00aAbBcCdDeEfF0123456789abcdef", decoded));
+        REQUIRE(decoded == std::vector<uint8_t>({0x00, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff, 0x01, 0x23, 0x45, 0x67,
+                                                 0x89, 0xab, 0xcd, 0xef}));
+
+        std::u32string text = U"aBcD";
+        uint8_t bytes[2];
+        REQUIRE(hexDecode(text.c_str(), text.length(), bytes));
+        REQUIRE(bytes[0] == 0xab);
+        REQUIRE(bytes[1] == 0xcd);
+    }
+
+    SECTION("oddLength")
+    {
+        std::vector<uint8_t> decoded;
+        REQUIRE(!hexDecode("abc", decoded));
+        REQUIRE(decoded.empty());
+
+        REQUIRE(!hexDecode("0123456789abcdef0", decoded));
+    }
+
+    SECTION("invalidChars")
+    {
+        // each position, both in the vectorized part and in the tail
+        std::string valid = "0123456789abcdef0123456789ABCDEF012345";
+        for (size_t pos = 0; pos < valid.length(); pos++) {
+            for (char invalidChr : {'g', 'G', '/', ':', '@', '`', ' ', '\0', char(0x80), char(0xff)}) {
+                std::string text = valid;
+                text[pos] = invalidChr;
+
+                std::vector<uint8_t> decoded(text.length() / 2);
+                REQUIRE(!hexDecode(text.c_str(), text.length(), decoded.data()));
+            }
+        }
+
+        std::vector<uint8_t> decoded;
+        REQUIRE(!hexDecode(U"12ä34", decoded));
+    }
+}
+
+TEST_CASE("toHexString(integer)")
+{
+    REQUIRE(toHexString(uint8_t(0)) == "00");
+    REQUIRE(toHexString(uint8_t(0xab), true) == "AB");
+    REQUIRE(toHexString(uint16_t(0x1f)) == "001f");
+    REQUIRE(toHexString(uint32_t(0x12345678)) == "12345678");
+    REQUIRE(toHexString(uint64_t(0x0123456789abcdefull)) == "0123456789abcdef");
+    REQUIRE(toHexString(uint64_t(0x0123456789abcdefull), true) == "0123456789ABCDEF");
+    REQUIRE(toHexString(int32_t(-1)) == "ffffffff");
+    REQUIRE(toHexString(int16_t(-2)) == "fffe");
+}
@@ -0,0 +1,113 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/NativeBuffer.h>
+
+#include <cstring>
+#include <vector>
+
+#if BDN_PLATFORM_FAMILY_POSIX
+#include <cstdlib>
+#include <unistd.h>
+#endif
+
+using namespace bdn;
+
+#if BDN_PLATFORM_FAMILY_POSIX
+/** Creates a temporary file with the specified contents and returns its path.*/
+static String writeTempFileForNativeBufferTest(const std::vector<uint8_t> &contents)
+{
+    const char *tempDir = std::getenv("TMPDIR");
+    std::string pathTemplate = std::string((tempDir != nullptr && tempDir[0] != 0) ? tempDir : "/tmp") +
+                               "/bdnNativeBufferTest-XXXXXX";
+
+    std::vector<char> path(pathTemplate.begin(), pathTemplate.end());
+    path.push_back(0);
+
+    int fd = ::mkstemp(path.data());
+    REQUIRE(fd != -1);
+
+    size_t written = 0;
+    while (written < contents.size()) {
+        ssize_t result = ::write(fd, contents.data() + written, contents.size() - written);
+        REQUIRE(result > 0);
+        written += (size_t)result;
+    }
+
+    REQUIRE(::close(fd) == 0);
+
+    return String(path.data());
+}
+
+static void testMapFile(size_t size)
+{
+    std::vector<uint8_t> contents(size);
+    for (size_t i = 0; i < size; i++)
+        contents[i] = (uint8_t)(i * 7 + i / 251);
+
+    String path = writeTempFileForNativeBufferTest(contents);
+
+    P<NativeBuffer> buffer;
+    try {
+        buffer = NativeBuffer::mapFile(path);
+    }
+    catch (...) {
+        ::unlink(path.asUtf8Ptr());
+        throw;
+    }
+
+    // the mapping must stay valid after the file is deleted
+    REQUIRE(::unlink(path.asUtf8Ptr()) == 0);
+
+    REQUIRE(buffer->getSize() == size);
+    REQUIRE(!buffer->isWritable());
+
+    if (size > 0) {
+        REQUIRE(buffer->getData() != nullptr);
+        REQUIRE(std::memcmp(buffer->getData(), contents.data(), size) == 0);
+    }
+}
+#endif
+
+TEST_CASE("NativeBuffer")
+{
+    SECTION("allocate")
+    {
+        P<NativeBuffer> buffer = NativeBuffer::allocate(1000);
+
+        REQUIRE(buffer->getSize() == 1000);
+        REQUIRE(buffer->getData() != nullptr);
+        REQUIRE(buffer->isWritable());
+
+        // the memory must be fully usable
+        std::memset(buffer->getData(), 0x17, 1000);
+        REQUIRE(buffer->getData()[0] == 0x17);
+        REQUIRE(buffer->getData()[999] == 0x17);
+    }
+
+    SECTION("allocate empty")
+    {
+        P<NativeBuffer> buffer = NativeBuffer::allocate(0);
+
+        REQUIRE(buffer->getSize() == 0);
+    }
+
+#if BDN_PLATFORM_FAMILY_POSIX
+    SECTION("mapFile nonexistent")
+    {
+        REQUIRE_THROWS_AS(NativeBuffer::mapFile("/this/file/does/not/exist"), SystemError);
+    }
+
+    SECTION("mapFile")
+    {
+        SECTION("small")
+        testMapFile(100);
+
+        SECTION("multiple pages")
+        testMapFile(3 * 4096 + 123);
+
+        SECTION("empty")
+        testMapFile(0);
+    }
+#endif
+}
@@ -3,6 +3,7 @@
 
 #include <bdn/Number.h>
 
+#include <cstring>
 #include <type_traits>
 
 using namespace bdn;
@@ -302,6 +303,74 @@ template <class ObjectType, typename ValueType> static void _verifyIntNumberAndU
 
             REQUIRE(result == expectedResult);
         }
+
+        SECTION("rotateBits by 0")
+        {
+            REQUIRE(rotateBitsLeft(value, 0) == value);
+            REQUIRE(rotateBitsRight(value, 0) == value);
+        }
+
+        SECTION("swapByteOrder")
+        {
+            ValueType swapped = value;
+            swapByteOrder(swapped);
+            REQUIRE(swapped == invertByteOrder(value));
+        }
+
+        SECTION("bit counts")
+        {
+            typedef typename std::make_unsigned<ValueType>::type UnsignedType;
+            const int bitCount = sizeof(ValueType) * 8;
+
+            UnsignedType bits = static_cast<UnsignedType>(value);
+
+            int expectedPopCount = 0;
+            int expectedLeadingZeros = -1;
+            int expectedTrailingZeros = -1;
+            for (int i = 0; i < bitCount; i++) {
+                if ((bits >> i) & 1) {
+                    expectedPopCount++;
+                    if (expectedTrailingZeros < 0)
+                        expectedTrailingZeros = i;
+                    expectedLeadingZeros = bitCount - 1 - i;
+                }
+            }
+
+            REQUIRE(popCount(value) == expectedPopCount);
+            REQUIRE(countLeadingZeros(value) == expectedLeadingZeros);
+            REQUIRE(countTrailingZeros(value) == expectedTrailingZeros);
+
+            REQUIRE(popCount(ValueType(0)) == 0);
+            REQUIRE(countLeadingZeros(ValueType(0)) == bitCount);
+            REQUIRE(countTrailingZeros(ValueType(0)) == bitCount);
+
+            REQUIRE(popCount(ValueType(~ValueType(0))) == bitCount);
+            REQUIRE(countLeadingZeros(ValueType(~ValueType(0))) == 0);
+            REQUIRE(countTrailingZeros(ValueType(~ValueType(0))) == 0);
+        }
+
+        SECTION("load and store")
+        {
+            typedef typename std::make_unsigned<ValueType>::type UnsignedType;
+
+            uint8_t littleEndian[sizeof(ValueType) + 1];
+            uint8_t bigEndian[sizeof(ValueType) + 1];
+            for (size_t i = 0; i < sizeof(ValueType); i++) {
+                littleEndian[i + 1] = uint8_t(static_cast<UnsignedType>(value) >> (i * 8));
+                bigEndian[sizeof(ValueType) - i] = littleEndian[i + 1];
+            }
+
+            // unaligned
+            REQUIRE(loadLittleEndian<ValueType>(littleEndian + 1) == value);
+            REQUIRE(loadBigEndian<ValueType>(bigEndian + 1) == value);
+
+            uint8_t stored[sizeof(ValueType) + 1] = {};
+            storeLittleEndian(stored + 1, value);
+            REQUIRE(std::memcmp(stored + 1, littleEndian + 1, sizeof(ValueType)) == 0);
+
+            storeBigEndian(stored + 1, value);
+            REQUIRE(std::memcmp(stored + 1, bigEndian + 1, sizeof(ValueType)) == 0);
+        }
     }
 }
 
@@ -811,4 +880,114 @@ TEST_CASE("Number")
             _testGlobalFloatFunctionsWithIntegers<int8_t>();
         }
     }
+
+    SECTION("value type")
+    {
+        static_assert(sizeof(Int64) == sizeof(int64_t), "Number must have the same size as its simple type");
+        static_assert(std::is_trivially_copyable<Float>::value, "Number must be trivially copyable");
+
+        constexpr Int a(42);
+        static_assert(a.getValue() == 42, "Number must be usable in constant expressions");
+
+        Int b = a;
+        REQUIRE(b == 42);
+    }
+}
+
+TEST_CASE("bitUtil")
+{
+    SECTION("constexpr")
+    {
+#if !defined(_MSC_VER) || defined(__clang__)
+        static_assert(invertByteOrder(uint32_t(0x12345678)) == 0x78563412, "");
+        static_assert(rotateBitsLeft(uint64_t(0x8000000000000001), 1) == 3, "");
+        static_assert(rotateBitsRight(uint16_t(1), 1) == 0x8000, "");
+#endif
+        static_assert(popCount(uint64_t(0xf0f0)) == 8, "");
+        static_assert(countLeadingZeros(uint32_t(1)) == 31, "");
+        static_assert(countTrailingZeros(uint16_t(0x100)) == 8, "");
+        static_assert(nextPowerOfTwo(uint32_t(1000)) == 1024, "");
+    }
+
+    SECTION("popCount and signed values")
+    {
+        REQUIRE(popCount(int8_t(-1)) == 8);
+        REQUIRE(popCount(int64_t(-1)) == 64);
+        REQUIRE(countLeadingZeros(int32_t(-1)) == 0);
+        REQUIRE(countTrailingZeros(int32_t(-8)) == 3);
+    }
+
+    SECTION("nextPowerOfTwo")
+    {
+        REQUIRE(nextPowerOfTwo(0u) == 1u);
+        REQUIRE(nextPowerOfTwo(1u) == 1u);
+        REQUIRE(nextPowerOfTwo(2u) == 2u);
+        REQUIRE(nextPowerOfTwo(3u) == 4u);
+        REQUIRE(nextPowerOfTwo(5u) == 8u);
+        REQUIRE(nextPowerOfTwo(1024u) == 1024u);
+        REQUIRE(nextPowerOfTwo(1025u) == 2048u);
+
+        REQUIRE(nextPowerOfTwo(uint8_t(128)) == 128);
+        REQUIRE(nextPowerOfTwo(uint8_t(129)) == 0);
+        REQUIRE(nextPowerOfTwo(uint16_t(0x7fff)) == 0x8000);
+
+        REQUIRE(nextPowerOfTwo(uint64_t(0x8000000000000000)) == uint64_t(0x8000000000000000));
+        REQUIRE(nextPowerOfTwo(uint64_t(0x8000000000000001)) == 0);
+        REQUIRE(nextPowerOfTwo(uint64_t(0x100000001)) == uint64_t(0x200000000));
+
+        for (int i = 2; i < 64; i++) {
+            uint64_t power = uint64_t(1) << i;
+            REQUIRE(nextPowerOfTwo(power - 1) == power);
+            REQUIRE(nextPowerOfTwo(power) == power);
+        }
+    }
+
+    SECTION("portable bit counts")
+    {
+        // the fallback for compilers without builtins
+        for (int i = 0; i < 64; i++) {
+            uint64_t bit = uint64_t(1) << i;
+
+            REQUIRE(_PortableBitCountImpl::_popCount64(bit) == 1);
+            REQUIRE(_PortableBitCountImpl::_popCount64(bit - 1) == i);
+            REQUIRE(_PortableBitCountImpl::_countLeadingZeros64(bit) == 63 - i);
+            REQUIRE(_PortableBitCountImpl::_countLeadingZeros64(bit | 1) == 63 - i);
+            REQUIRE(_PortableBitCountImpl::_countTrailingZeros64(bit) == i);
+            REQUIRE(_PortableBitCountImpl::_countTrailingZeros64(bit | (bit << 1)) == i);
+        }
+
+        REQUIRE(_PortableBitCountImpl::_popCount32(0) == 0);
+        REQUIRE(_PortableBitCountImpl::_popCount32(0xffffffff) == 32);
+        REQUIRE(_PortableBitCountImpl::_countLeadingZeros32(0) == 32);
+        REQUIRE(_PortableBitCountImpl::_countTrailingZeros32(0) == 32);
+        REQUIRE(_PortableBitCountImpl::_countLeadingZeros64(0) == 64);
+        REQUIRE(_PortableBitCountImpl::_countTrailingZeros64(0) == 64);
+    }
+
+    SECTION("bulk load and store")
+    {
+        uint8_t bytes[33];
+        for (int i = 0; i < 33; i++)
+            bytes[i] = uint8_t(i * 17 + 1);
+
+        uint32_t values[8];
+
+        loadLittleEndian(bytes + 1, values, 8);
+        for (int i = 0; i < 8; i++)
+            REQUIRE(values[i] == loadLittleEndian<uint32_t>(bytes + 1 + i * 4));
+
+        uint8_t stored[33] = {};
+        storeLittleEndian(stored + 1, values, 8);
+        REQUIRE(std::memcmp(stored + 1, bytes + 1, 32) == 0);
+
+        loadBigEndian(bytes + 1, values, 8);
+        for (int i = 0; i < 8; i++) {
+            REQUIRE(values[i] == loadBigEndian<uint32_t>(bytes + 1 + i * 4));
+            REQUIRE(values[i] == invertByteOrder(loadLittleEndian<uint32_t>(bytes + 1 + i * 4)));
+        }
+
+        std::memset(stored, 0, sizeof(stored));
+        storeBigEndian(stored + 1, values, 8);
+        REQUIRE(std::memcmp(stored + 1, bytes + 1, 32) == 0);
+    }
 }
@@ -0,0 +1,255 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/parseNumber.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+using namespace bdn;
+
+template <class MainDataType, typename T> static void verifyParseInt(const StringImpl<MainDataType> &s, T expected)
+{
+    Nullable<T> result = parseInt<T>(s);
+    REQUIRE(!result.isNull());
+    REQUIRE(result.get() == expected);
+
+    REQUIRE(parseInt<T>(StringViewImpl<MainDataType>(s)) == expected);
+}
+
+template <class MainDataType, typename T> static void verifyParseIntFails(const StringImpl<MainDataType> &s)
+{
+    REQUIRE(parseInt<T>(s).isNull());
+}
+
+template <class MainDataType> static void verifyParseDouble(const StringImpl<MainDataType> &s, double expected)
+{
+    Nullable<double> result = parseDouble(s);
+    REQUIRE(!result.isNull());
+
+    // compare the bits, so that the sign of zero and the exact rounding are
+    // also checked
+    double value = result.get();
+    REQUIRE(std::memcmp(&value, &expected, sizeof(double)) == 0);
+}
+
+/** Parses randomly generated numbers and compares the results with strtod.
+   The generator has a fixed seed, so that failures are reproducible.*/
+template <class MainDataType> static void verifyParseDoubleMatchesStrtod()
+{
+    std::mt19937_64 random(4711);
+
+    char text[128];
+
+    for (int i = 0; i < 2000; i++) {
+        int kind = i % 3;
+
+        if (kind == 0) {
+            // the shortest round trip representation of a random double
+            uint64_t bits = random();
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            if (!std::isfinite(value))
+                continue;
+
+            std::snprintf(text, sizeof(text), "%.17g", value);
+        } else {
+            // many significant digits (these need the slow path more often),
+            // or only a few.
+            int digitCount = (kind == 1) ? 20 + int(random() % 40) : 1 + int(random() % 19);
+            int exponent = int(random() % 700) - 350;
+
+            char *p = text;
+            if (random() % 2 == 0)
+                *p++ = '-';
+
+            for (int d = 0; d < digitCount; d++) {
+                if (d == 1)
+                    *p++ = '.';
+                *p++ = char('0' + random() % 10);
+            }
+
+            std::snprintf(p, sizeof(text) - (p - text), "e%d", exponent);
+        }
+
+        verifyParseDouble<MainDataType>(text, std::strtod(text, nullptr));
+    }
+}
+
+template <class MainDataType> static void verifyParseNumber()
+{
+    typedef StringImpl<MainDataType> StringType;
+
+    SECTION("parseInt")
+    {
+        SECTION("valid")
+        {
+            verifyParseInt<MainDataType, int>("0", 0);
+            verifyParseInt<MainDataType, int>("42", 42);
+            verifyParseInt<MainDataType, int>("+42", 42);
+            verifyParseInt<MainDataType, int>("-42", -42);
+            verifyParseInt<MainDataType, int>("000123", 123);
+            verifyParseInt<MainDataType, int64_t>("1234567890123456", 1234567890123456);
+            verifyParseInt<MainDataType, int64_t>("-00000000000000000000001234567890123456789",
+                                                  -1234567890123456789);
+            verifyParseInt<MainDataType, unsigned>("-0", 0);
+        }
+
+        SECTION("limits")
+        {
+            verifyParseInt<MainDataType, int8_t>("127", 127);
+            verifyParseInt<MainDataType, int8_t>("-128", -128);
+            verifyParseIntFails<MainDataType, int8_t>("128");
+            verifyParseIntFails<MainDataType, int8_t>("-129");
+
+            verifyParseInt<MainDataType, uint16_t>("65535", 65535);
+            verifyParseIntFails<MainDataType, uint16_t>("65536");
+            verifyParseIntFails<MainDataType, uint16_t>("-1");
+
+            verifyParseInt<MainDataType, int64_t>("9223372036854775807", std::numeric_limits<int64_t>::max());
+            verifyParseInt<MainDataType, int64_t>("-9223372036854775808", std::numeric_limits<int64_t>::min());
+            verifyParseIntFails<MainDataType, int64_t>("9223372036854775808");
+            verifyParseIntFails<MainDataType, int64_t>("-9223372036854775809");
+
+            verifyParseInt<MainDataType, uint64_t>("18446744073709551615", std::numeric_limits<uint64_t>::max());
+            verifyParseIntFails<MainDataType, uint64_t>("18446744073709551616");
+            verifyParseIntFails<MainDataType, uint64_t>("100000000000000000000");
+        }
+
+        SECTION("invalid")
+        {
+            verifyParseIntFails<MainDataType, int>("");
+            verifyParseIntFails<MainDataType, int>(StringType());
+            REQUIRE(parseInt<int>(StringViewImpl<MainDataType>()).isNull());
+            verifyParseIntFails<MainDataType, int>("-");
+            verifyParseIntFails<MainDataType, int>("+");
+            verifyParseIntFails<MainDataType, int>(" 1");
+            verifyParseIntFails<MainDataType, int>("1 ");
+            verifyParseIntFails<MainDataType, int>("12a");
+            verifyParseIntFails<MainDataType, int>("1.0");
+            verifyParseIntFails<MainDataType, int>("0x10");
+            verifyParseIntFails<MainDataType, int>("--1");
+            verifyParseIntFails<MainDataType, int>(U"1١");
+            verifyParseIntFails<MainDataType, int64_t>("1234567890123456a");
+        }
+    }
+
+    SECTION("parseDouble")
+    {
+        SECTION("simple")
+        {
+            verifyParseDouble<MainDataType>("0", 0.0);
+            verifyParseDouble<MainDataType>("-0", -0.0);
+            verifyParseDouble<MainDataType>("1", 1.0);
+            verifyParseDouble<MainDataType>("+1.5", 1.5);
+            verifyParseDouble<MainDataType>("-1.5", -1.5);
+            verifyParseDouble<MainDataType>(".5", 0.5);
+            verifyParseDouble<MainDataType>("5.", 5.0);
+            verifyParseDouble<MainDataType>("0.1", 0.1);
+            verifyParseDouble<MainDataType>("3.14159", 3.14159);
+            verifyParseDouble<MainDataType>("1e10", 1e10);
+            verifyParseDouble<MainDataType>("1E-10", 1e-10);
+            verifyParseDouble<MainDataType>("2.5e+3", 2500.0);
+            verifyParseDouble<MainDataType>("123456789012", 123456789012.0);
+        }
+
+        SECTION("rounding")
+        {
+            verifyParseDouble<MainDataType>("9007199254740993", 9007199254740992.0);
+            verifyParseDouble<MainDataType>("9007199254740995", 9007199254740996.0);
+            verifyParseDouble<MainDataType>("1.7976931348623157e308", 1.7976931348623157e308);
+            verifyParseDouble<MainDataType>("2.2250738585072014e-308", 2.2250738585072014e-308);
+            verifyParseDouble<MainDataType>("2.2250738585072011e-308", 2.2250738585072011e-308);
+            verifyParseDouble<MainDataType>("4.9e-324", 4.9e-324);
+            verifyParseDouble<MainDataType>("7.3177701707893310e+15", 7.3177701707893310e+15);
+
+            // more than 19 significant digits
+            verifyParseDouble<MainDataType>("123456789012345678901234567890", 1.2345678901234568e29);
+            verifyParseDouble<MainDataType>("0.000000000000000000000000000001234567890123456789012",
+                                            1.234567890123456789012e-30);
+
+            // exactly between 1 and the next double, and slightly below and
+            // above that
+            verifyParseDouble<MainDataType>("1.00000000000000011102230246251565404236316680908203125", 1.0);
+            verifyParseDouble<MainDataType>("1.00000000000000011102230246251565404236316680908203124", 1.0);
+            verifyParseDouble<MainDataType>("1.00000000000000011102230246251565404236316680908203126",
+                                            1.0000000000000002);
+        }
+
+        SECTION("out of range")
+        {
+            verifyParseDouble<MainDataType>("1e309", std::numeric_limits<double>::infinity());
+            verifyParseDouble<MainDataType>("-1e400", -std::numeric_limits<double>::infinity());
+            verifyParseDouble<MainDataType>("1e-400", 0.0);
+            verifyParseDouble<MainDataType>("2e-324", 0.0);
+
+            // slightly below and above the value exactly between the largest
+            // double and 2^1024. With more than 19 significant digits these
+            // need the slow path.
+            verifyParseDouble<MainDataType>("1.7976931348623158079372897140530341507993e308",
+                                            std::numeric_limits<double>::max());
+            verifyParseDouble<MainDataType>("1.7976931348623158079372897140530341507994e308",
+                                            std::numeric_limits<double>::infinity());
+            verifyParseDouble<MainDataType>("-1.7976931348623158079372897140530341507994e308",
+                                            -std::numeric_limits<double>::infinity());
+        }
+
+        SECTION("special values")
+        {
+            verifyParseDouble<MainDataType>("inf", std::numeric_limits<double>::infinity());
+            verifyParseDouble<MainDataType>("-Infinity", -std::numeric_limits<double>::infinity());
+            REQUIRE(std::isnan(parseDouble(StringType("NaN")).get()));
+        }
+
+        SECTION("invalid")
+        {
+            REQUIRE(parseDouble(StringType("")).isNull());
+            REQUIRE(parseDouble(StringType()).isNull());
+            REQUIRE(parseDouble(StringViewImpl<MainDataType>()).isNull());
+            REQUIRE(parseDouble(StringType(".")).isNull());
+            REQUIRE(parseDouble(StringType("-")).isNull());
+            REQUIRE(parseDouble(StringType("e5")).isNull());
+            REQUIRE(parseDouble(StringType("1e")).isNull());
+            REQUIRE(parseDouble(StringType("1e+")).isNull());
+            REQUIRE(parseDouble(StringType("1,5")).isNull());
+            REQUIRE(parseDouble(StringType(" 1")).isNull());
+            REQUIRE(parseDouble(StringType("1 ")).isNull());
+            REQUIRE(parseDouble(StringType("1.2.3")).isNull());
+            REQUIRE(parseDouble(StringType("infx")).isNull());
+            REQUIRE(parseDouble(StringType(U"1·5")).isNull());
+        }
+
+        SECTION("random")
+        verifyParseDoubleMatchesStrtod<MainDataType>();
+
+        SECTION("view")
+        {
+            StringType s = "x=2.5;y=-3";
+            auto splitter = s.split("=;");
+            auto it = splitter.begin();
+            ++it;
+            REQUIRE(parseDouble(*it) == 2.5);
+            ++it;
+            ++it;
+            REQUIRE(parseInt<int>(*it) == -3);
+        }
+    }
+}
+
+TEST_CASE("parseNumber")
+{
+    SECTION("native")
+    verifyParseNumber<NativeStringData>();
+
+    SECTION("utf8")
+    verifyParseNumber<Utf8StringData>();
+
+    SECTION("utf16")
+    verifyParseNumber<Utf16StringData>();
+
+    SECTION("utf32")
+    verifyParseNumber<Utf32StringData>();
+}
@@ -4,6 +4,7 @@
 #include <bdn/property.h>
 #include <bdn/Array.h>
 #include <bdn/View.h>
+#include <bdn/GenericDispatcher.h>
 
 using namespace bdn;
 
@@ -1047,3 +1048,51 @@ TEST_CASE("properties")
         testViewProperty<String>("", "hello");
     }
 }
+
+class TestPropertyPolicyOwner : public Base, BDN_IMPLEMENTS IPropertyNotificationPolicyProvider
+{
+  public:
+    TestPropertyPolicyOwner(const NotificationPolicy &policy) : _policy(policy) {}
+
+    NotificationPolicy getPropertyNotificationPolicy() const override { return _policy; }
+
+    BDN_PROPERTY(int, progress, setProgress);
+    BDN_PROPERTY(String, status, setStatus);
+
+  private:
+    NotificationPolicy _policy;
+};
+
+TEST_CASE("properties-ownerNotificationPolicy")
+{
+    P<GenericDispatcher> dispatcher = newObj<GenericDispatcher>();
+    P<TestPropertyPolicyOwner> owner = newObj<TestPropertyPolicyOwner>(NotificationPolicy::coalesced(dispatcher));
+
+    REQUIRE(owner->progressChanged().getNotificationPolicy() == NotificationPolicy::coalesced(dispatcher));
+    REQUIRE(owner->statusChanged().getNotificationPolicy() == NotificationPolicy::coalesced(dispatcher));
+
+    Array<int> gotProgress;
+    owner->progressChanged() += [&gotProgress](int value) { gotProgress.add(value); };
+
+    for (int i = 1; i <= 1000; i++)
+        owner->setProgress(i);
+
+    REQUIRE(gotProgress.size() == 0);
+
+    while (dispatcher->executeNext()) {
+    }
+
+    REQUIRE(gotProgress == Array<int>{1000});
+
+    SECTION("individual property can be changed")
+    {
+        owner->progressChanged().setNotificationPolicy(NotificationPolicy::immediate());
+
+        owner->setProgress(1);
+        owner->setProgress(2);
+
+        REQUIRE((gotProgress == Array<int>{1000, 1, 2}));
+    }
+
+    dispatcher->dispose();
+}
@@ -3,6 +3,7 @@
 
 #include <bdn/PropertyNotifier.h>
 #include <bdn/Array.h>
+#include <bdn/GenericDispatcher.h>
 
 using namespace bdn;
 
@@ -452,3 +453,88 @@ TEST_CASE("PropertyNotifier")
         }
     }
 }
+
+TEST_CASE("PropertyNotifier-notificationPolicy")
+{
+    P<PropertyNotifier<String>> notifier = newObj<PropertyNotifier<String>>();
+    P<GenericDispatcher> dispatcher = newObj<GenericDispatcher>();
+
+    Array<String> gotParam;
+    notifier->subscribe([&gotParam](String param) { gotParam.add(param); });
+
+    SECTION("immediate is default")
+    {
+        REQUIRE(notifier->getNotificationPolicy() == NotificationPolicy::immediate());
+
+        notifier->notify(PropertyNotifierTestAccessor<String>(*notifier, "hello"));
+        REQUIRE(gotParam == Array<String>{"hello"});
+    }
+
+    SECTION("coalesced")
+    {
+        notifier->setNotificationPolicy(NotificationPolicy::coalesced(dispatcher));
+        REQUIRE(notifier->getNotificationPolicy() == NotificationPolicy::coalesced(dispatcher));
+
+        for (int i = 0; i < 1000; i++)
+            notifier->notify(PropertyNotifierTestAccessor<String>(*notifier, std::to_string(i)));
+
+        // nothing delivered yet
+        REQUIRE(gotParam.size() == 0);
+
+        while (dispatcher->executeNext()) {
+        }
+
+        // only the latest value is delivered
+        REQUIRE(gotParam == Array<String>{"999"});
+
+        // the next notification schedules a new delivery
+        notifier->notify(PropertyNotifierTestAccessor<String>(*notifier, "hello"));
+        while (dispatcher->executeNext()) {
+        }
+
+        REQUIRE((gotParam == Array<String>{"999", "hello"}));
+    }
+
+    SECTION("throttled")
+    {
+        notifier->setNotificationPolicy(NotificationPolicy::throttled(10, dispatcher));
+
+        notifier->notify(PropertyNotifierTestAccessor<String>(*notifier, "a"));
+
+        // the first one is delivered on the next dispatcher turn
+        while (dispatcher->executeNext()) {
+        }
+        REQUIRE(gotParam == Array<String>{"a"});
+
+        auto startTime = std::chrono::steady_clock::now();
+
+        notifier->notify(PropertyNotifierTestAccessor<String>(*notifier, "b"));
+        notifier->notify(PropertyNotifierTestAccessor<String>(*notifier, "c"));
+
+        // the next delivery has to wait until the interval has passed
+        REQUIRE(!dispatcher->executeNext());
+        REQUIRE(gotParam == Array<String>{"a"});
+
+        REQUIRE(dispatcher->waitForNext(5));
+        REQUIRE(dispatcher->executeNext());
+
+        auto elapsedMillis =
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+
+        REQUIRE(elapsedMillis >= 90);
+        REQUIRE((gotParam == Array<String>{"a", "c"}));
+    }
+
+    SECTION("invalid throttle rate") { REQUIRE_THROWS_AS(NotificationPolicy::throttled(0), InvalidArgumentError); }
+
+    SECTION("back to immediate")
+    {
+        notifier->setNotificationPolicy(NotificationPolicy::coalesced(dispatcher));
+        notifier->setNotificationPolicy(NotificationPolicy::immediate());
+
+        notifier->notify(PropertyNotifierTestAccessor<String>(*notifier, "hello"));
+        REQUIRE(gotParam == Array<String>{"hello"});
+    }
+
+    dispatcher->dispose();
+}
@@ -0,0 +1,216 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/SerialExecutor.h>
+
+#if BDN_HAVE_THREADS
+
+#include <atomic>
+
+using namespace bdn;
+
+class SerialExecutorTestState : public Base
+{
+  public:
+    Mutex mutex;
+    std::vector<std::vector<int>> executed;
+    std::atomic<int> activeJobs[8];
+    std::atomic<int> overlapCount{0};
+    std::atomic<int> remainingJobs{0};
+    Signal allDoneSignal;
+
+    SerialExecutorTestState(int executorCount) : executed(executorCount)
+    {
+        for (auto &count : activeJobs)
+            count = 0;
+    }
+};
+
+class SerialExecutorTestJob : public Base, BDN_IMPLEMENTS IThreadRunnable
+{
+  public:
+    SerialExecutorTestJob(SerialExecutorTestState *state, int executorIndex, int jobIndex)
+        : _state(state), _executorIndex(executorIndex), _jobIndex(jobIndex)
+    {}
+
+    void run() override
+    {
+        if (++_state->activeJobs[_executorIndex] != 1)
+            _state->overlapCount++;
+
+        {
+            Mutex::Lock lock(_state->mutex);
+            _state->executed[_executorIndex].push_back(_jobIndex);
+        }
+
+        _state->activeJobs[_executorIndex]--;
+
+        if (--_state->remainingJobs == 0)
+            _state->allDoneSignal.set();
+    }
+
+    void signalStop() override {}
+
+  private:
+    P<SerialExecutorTestState> _state;
+    int _executorIndex;
+    int _jobIndex;
+};
+
+class SerialExecutorBlockingJob : public Base, BDN_IMPLEMENTS IThreadRunnable
+{
+  public:
+    Signal startedSignal;
+    Signal proceedSignal;
+    std::atomic<bool> stopSignalled{false};
+    std::atomic<bool> ran{false};
+
+    void run() override
+    {
+        ran = true;
+        startedSignal.set();
+        proceedSignal.wait(5000);
+    }
+
+    void signalStop() override
+    {
+        stopSignalled = true;
+        proceedSignal.set();
+    }
+};
+
+TEST_CASE("SerialExecutor")
+{
+    SECTION("default pool")
+    {
+        P<SerialExecutor> executor = newObj<SerialExecutor>();
+
+        REQUIRE(executor->getThreadPool() == getSharedThreadPool());
+    }
+
+    SECTION("order and no overlap")
+    {
+        const int executorCount = 8;
+        const int jobCount = 200;
+
+        P<ThreadPool> pool = newObj<ThreadPool>(4, 4);
+        P<SerialExecutorTestState> state = newObj<SerialExecutorTestState>(executorCount);
+        state->remainingJobs = executorCount * jobCount;
+
+        std::vector<P<SerialExecutor>> executors;
+        for (int i = 0; i < executorCount; i++)
+            executors.push_back(newObj<SerialExecutor>(pool));
+
+        for (int jobIndex = 0; jobIndex < jobCount; jobIndex++) {
+            for (int i = 0; i < executorCount; i++)
+                executors[i]->addJob(newObj<SerialExecutorTestJob>(state, i, jobIndex));
+        }
+
+        REQUIRE(state->allDoneSignal.wait(10000));
+
+        REQUIRE(state->overlapCount == 0);
+
+        for (int i = 0; i < executorCount; i++) {
+            std::vector<int> &executed = state->executed[i];
+
+            REQUIRE(executed.size() == (size_t)jobCount);
+            for (int jobIndex = 0; jobIndex < jobCount; jobIndex++)
+                REQUIRE(executed[jobIndex] == jobIndex);
+        }
+    }
+
+    SECTION("no dedicated threads")
+    {
+        P<ThreadPool> pool = newObj<ThreadPool>(1, 2);
+
+        std::vector<P<SerialExecutor>> executors;
+        std::vector<P<SerialExecutorBlockingJob>> jobs;
+
+        for (int i = 0; i < 100; i++) {
+            executors.push_back(newObj<SerialExecutor>(pool));
+            jobs.push_back(newObj<SerialExecutorBlockingJob>());
+            executors.back()->addJob(jobs.back());
+        }
+
+        // all executors share the two threads of the pool
+        REQUIRE(pool->getBusyThreadCount() <= 2);
+
+        for (auto &job : jobs)
+            job->proceedSignal.set();
+    }
+
+    SECTION("pending job count")
+    {
+        P<SerialExecutor> executor = newObj<SerialExecutor>(newObj<ThreadPool>(1, 1));
+
+        P<SerialExecutorBlockingJob> a = newObj<SerialExecutorBlockingJob>();
+        P<SerialExecutorBlockingJob> b = newObj<SerialExecutorBlockingJob>();
+
+        executor->addJob(a);
+        executor->addJob(b);
+
+        REQUIRE(a->startedSignal.wait(5000));
+        REQUIRE(executor->getPendingJobCount() == 2);
+
+        a->proceedSignal.set();
+        REQUIRE(b->startedSignal.wait(5000));
+
+        b->proceedSignal.set();
+
+        CONTINUE_SECTION_AFTER_RUN_SECONDS(0.5, executor) { REQUIRE(executor->getPendingJobCount() == 0); };
+    }
+
+    SECTION("pool queue full")
+    {
+        // the pool has a single thread and no queue space. When the drainer's
+        // turn is over it cannot go back into the queue, so it must continue
+        // in its thread instead of waiting for itself.
+        const int jobCount = 40;
+
+        P<ThreadPool> pool = newObj<ThreadPool>(1, 1);
+        pool->setQueueLimit(0, ThreadPool::OverflowPolicy::block);
+
+        P<SerialExecutor> executor = newObj<SerialExecutor>(pool);
+        P<SerialExecutorTestState> state = newObj<SerialExecutorTestState>(1);
+        state->remainingJobs = jobCount;
+
+        P<SerialExecutorBlockingJob> first = newObj<SerialExecutorBlockingJob>();
+        executor->addJob(first);
+        REQUIRE(first->startedSignal.wait(5000));
+
+        for (int jobIndex = 0; jobIndex < jobCount; jobIndex++)
+            executor->addJob(newObj<SerialExecutorTestJob>(state, 0, jobIndex));
+
+        first->proceedSignal.set();
+
+        REQUIRE(state->allDoneSignal.wait(10000));
+        REQUIRE(state->executed[0].size() == (size_t)jobCount);
+    }
+
+    SECTION("delete executor stops jobs")
+    {
+        P<ThreadPool> pool = newObj<ThreadPool>(1, 1);
+        P<SerialExecutor> executor = newObj<SerialExecutor>(pool);
+
+        P<SerialExecutorBlockingJob> active = newObj<SerialExecutorBlockingJob>();
+        P<SerialExecutorBlockingJob> queued = newObj<SerialExecutorBlockingJob>();
+
+        executor->addJob(active);
+        executor->addJob(queued);
+
+        REQUIRE(active->startedSignal.wait(5000));
+
+        // the active job keeps the executor alive while it runs. The executor
+        // is deleted when it finishes.
+        executor = nullptr;
+        active->proceedSignal.set();
+
+        CONTINUE_SECTION_AFTER_RUN_SECONDS(0.5, queued)
+        {
+            REQUIRE(queued->stopSignalled);
+            REQUIRE(!queued->ran);
+        };
+    }
+}
+
+#endif
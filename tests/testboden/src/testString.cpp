@@ -115,6 +115,196 @@ inline void testGlobalConcatenation()
     verifyGlobalConcatenation<const char32_t *, String>();
 }
 
+inline void testChainedConcatenation()
+{
+    String hello("hello");
+    String world("world");
+
+    SECTION("mixed types")
+    {
+        String result = hello + " " + std::string("big") + L" " + u"wide" + std::u16string(u" ") + U"\U00013333" +
+                        std::u32string(U" ") + world;
+
+        verifyContents(result, U"hello big wide \U00013333 world");
+    }
+
+    SECTION("literal first")
+    {
+        String result = "<" + hello + ">";
+
+        verifyContents(result, U"<hello>");
+    }
+
+    SECTION("two expressions")
+    {
+        String result = (hello + "-") + ("-" + world);
+
+        verifyContents(result, U"hello--world");
+    }
+
+    SECTION("assign")
+    {
+        String result("x");
+        result = hello + "." + world;
+
+        verifyContents(result, U"hello.world");
+    }
+
+    SECTION("append")
+    {
+        String result("x");
+        result += hello + "." + world;
+
+        verifyContents(result, U"xhello.world");
+    }
+
+    SECTION("self in expression")
+    {
+        hello = hello + hello;
+
+        verifyContents(hello, U"hellohello");
+    }
+
+    SECTION("comparison")
+    {
+        REQUIRE(hello + world == "helloworld");
+        REQUIRE("helloworld" == hello + world);
+        REQUIRE(hello + world == String("helloworld"));
+        REQUIRE(hello + world != world + hello);
+        REQUIRE(hello + world < world);
+        REQUIRE(world > hello + world);
+    }
+
+    SECTION("std::string")
+    {
+        std::string result = hello + " " + world;
+
+        REQUIRE(result == "hello world");
+    }
+
+    SECTION("stream")
+    {
+        std::ostringstream stream;
+        stream << hello + " " + world;
+
+        REQUIRE(stream.str() == "hello world");
+    }
+
+    SECTION("does not modify operands")
+    {
+        String result = hello + world;
+
+        verifyContents(hello, U"hello");
+        verifyContents(world, U"world");
+    }
+
+    SECTION("auto")
+    {
+        auto result = hello + " " + world;
+
+        hello = "changed";
+        world = "changed";
+
+        verifyContents(result, U"hello world");
+    }
+
+    SECTION("auto with temporaries")
+    {
+        auto result = String("hello") + std::string(" ") + std::u32string(U"world");
+
+        verifyContents(result, U"hello world");
+    }
+
+    SECTION("returned from lambda")
+    {
+        auto makeGreeting = [](String name) {
+            String local("hello ");
+            return local + name + "!";
+        };
+
+        String result = makeGreeting("world");
+
+        verifyContents(result, U"hello world!");
+    }
+
+    SECTION("in pair")
+    {
+        std::pair<String, int> result;
+        {
+            String local("hel");
+            result = std::make_pair(local + "lo", 17);
+        }
+
+        verifyContents(result.first, U"hello");
+        REQUIRE(result.second == 17);
+    }
+
+    SECTION("member call")
+    {
+        REQUIRE((hello + world).length() == 10);
+        REQUIRE((hello + " " + world).asUtf8() == "hello world");
+    }
+
+    SECTION("conditional")
+    {
+        bool useWorld = true;
+        String result = useWorld ? hello + world : hello;
+
+        verifyContents(result, U"helloworld");
+    }
+}
+
+inline void testConcat()
+{
+    String hello("hello");
+    String world("world");
+
+    SECTION("no arguments")
+    {
+        String result = concat();
+
+        verifyContents(result, U"");
+    }
+
+    SECTION("single argument")
+    {
+        String result = concat(hello);
+
+        verifyContents(result, U"hello");
+    }
+
+    SECTION("mixed types")
+    {
+        String result = concat(hello, " ", std::string("big"), L" ", std::u16string(u"wide"), U" ", world, "!");
+
+        verifyContents(result, U"hello big wide world!");
+    }
+
+    SECTION("non-ascii")
+    {
+        String result = concat(u8"\u00e4", hello, U"\U00010437", L"\u00f6");
+
+        verifyContents(result, U"\u00e4hello\U00010437\u00f6");
+    }
+
+    SECTION("does not modify arguments")
+    {
+        String result = concat(hello, world, hello);
+
+        verifyContents(result, U"helloworldhello");
+        verifyContents(hello, U"hello");
+        verifyContents(world, U"world");
+    }
+
+    SECTION("argument used multiple times")
+    {
+        String result = concat(hello, hello);
+        hello = result;
+
+        verifyContents(hello, U"hellohello");
+    }
+}
+
 template <class LeftType, class RightType> inline void verifyGlobalComparison()
 {
     String hello("hello");
@@ -386,6 +576,12 @@ TEST_CASE("String", "[String]")
     SECTION("globalConcatenation")
     testGlobalConcatenation();
 
+    SECTION("chainedConcatenation")
+    testChainedConcatenation();
+
+    SECTION("concat")
+    testConcat();
+
     SECTION("globalComparison")
     testGlobalComparison();
 
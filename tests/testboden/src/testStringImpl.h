@@ -8,6 +8,7 @@
 #include <bdn/Utf32StringData.h>
 
 #include <bdn/XxHash32.h>
+#include <bdn/HashMap.h>
 
 #include <cstring>
 
@@ -1393,6 +1394,59 @@ template <class DATATYPE> inline void testComparison()
 
     SECTION("longer")
     testComparisonWith<DATATYPE>(s, "HeLLox", -1);
+
+    // characters outside of the basic multilingual plane are bigger than all
+    // others, even though their UTF-16 encoding is not.
+    SECTION("nonBmpVsHighBmp")
+    testComparisonWith<DATATYPE>(U"x\U00010000y", U"x\uff5ey", 1);
+
+    SECTION("highBmpVsNonBmp")
+    testComparisonWith<DATATYPE>(U"x\uff5ey", U"x\U00010000y", -1);
+
+    SECTION("nonBmpVsNonBmp")
+    testComparisonWith<DATATYPE>(U"x\U00010001", U"x\U00013333", -1);
+
+    SECTION("longWithLateDifference")
+    {
+        std::u32string prefix(100, U'\u00e4');
+
+        testComparisonWith<DATATYPE>(prefix + U"b" + prefix, prefix + U"a" + prefix, 1);
+    }
+
+    SECTION("equality")
+    {
+        StringImpl<DATATYPE> a(U"hello w\u00f6rld");
+        StringImpl<DATATYPE> b = a;
+
+        REQUIRE(a == b);
+        REQUIRE(!(a != b));
+
+        REQUIRE(a.subString(0, 5) == a.subString(0, 5));
+        REQUIRE(a.subString(0, 5) != a.subString(6, 5));
+        REQUIRE(a.subString(6, 5) == StringImpl<DATATYPE>(U"w\u00f6rld"));
+        REQUIRE(a.subString(0, 5) == StringImpl<DATATYPE>("hello"));
+        REQUIRE(a.subString(0, 5) != StringImpl<DATATYPE>("hell"));
+        REQUIRE(a.subString(0, 5) != StringImpl<DATATYPE>("hello "));
+    }
+
+    SECTION("emptyVsEmpty")
+    testComparisonWith<DATATYPE>(StringImpl<DATATYPE>(), StringImpl<DATATYPE>(), 0);
+
+    SECTION("emptyVsNonEmpty")
+    testComparisonWith<DATATYPE>(StringImpl<DATATYPE>(), s, -1);
+
+    SECTION("emptySliceAtEnd")
+    {
+        // the begin iterator of this slice is the end of the encoded data
+        StringImpl<DATATYPE> atEnd = s.subString(s.getLength(), 0);
+
+        REQUIRE(atEnd == StringImpl<DATATYPE>());
+        REQUIRE(atEnd.compare(StringImpl<DATATYPE>()) == 0);
+        REQUIRE(atEnd.compare(s) < 0);
+        REQUIRE(s.compare(atEnd) > 0);
+        REQUIRE(atEnd == "");
+        REQUIRE(atEnd != "x");
+    }
 }
 
 template <class DATATYPE> inline void verifyCharAccess(const StringImpl<DATATYPE> &s)
@@ -9179,6 +9233,234 @@ template <class DATATYPE> inline void testHash()
     }
 }
 
+template <class DATATYPE>
+inline void verifyCaseMapping(const std::u32string &input, const std::u32string &expectedLower,
+                              const std::u32string &expectedUpper, const std::u32string &expectedFolded)
+{
+    StringImpl<DATATYPE> s(input);
+
+    REQUIRE(s.toLower() == expectedLower);
+    REQUIRE(s.toUpper() == expectedUpper);
+    REQUIRE(s.toCaseFolded() == expectedFolded);
+
+    // the original must not be modified
+    REQUIRE(s == input);
+}
+
+template <class DATATYPE> inline void testCaseMapping()
+{
+    SECTION("empty")
+    verifyCaseMapping<DATATYPE>(U"", U"", U"", U"");
+
+    SECTION("ascii")
+    verifyCaseMapping<DATATYPE>(U"Hello World! [@`{] 0123 AZaz", U"hello world! [@`{] 0123 azaz",
+                                U"HELLO WORLD! [@`{] 0123 AZAZ", U"hello world! [@`{] 0123 azaz");
+
+    SECTION("longAscii")
+    {
+        // long enough for block-wise processing, with the changes in
+        // different positions of the blocks
+        std::u32string input;
+        std::u32string lower;
+        std::u32string upper;
+        for (int i = 0; i < 100; i++) {
+            char32_t chr = U'a' + (i % 26);
+            input += (i % 3 == 0) ? (chr - 0x20) : chr;
+            lower += chr;
+            upper += chr - 0x20;
+        }
+
+        verifyCaseMapping<DATATYPE>(input, lower, upper, lower);
+    }
+
+    SECTION("nonAscii")
+    verifyCaseMapping<DATATYPE>(U"Ärger über Öl ΣΑΣ \U00010400\U00010428 Kelvin:\u212a",
+                                U"ärger über öl σασ \U00010428\U00010428 kelvin:k",
+                                U"ÄRGER ÜBER ÖL ΣΑΣ \U00010400\U00010400 KELVIN:\u212a",
+                                U"ärger über öl σασ \U00010428\U00010428 kelvin:k");
+
+    SECTION("lengthChanges")
+    verifyCaseMapping<DATATYPE>(U"Straße \ufb03 \u0130", U"straße \ufb03 i\u0307", U"STRASSE FFI \u0130",
+                                U"strasse ffi i\u0307");
+
+    SECTION("mixedBlocks")
+    verifyCaseMapping<DATATYPE>(U"abcdefgÄhijklmnopQRSTUVWXYZäöüÄÖÜabcdefghIJKLMNOP",
+                                U"abcdefgähijklmnopqrstuvwxyzäöüäöüabcdefghijklmnop",
+                                U"ABCDEFGÄHIJKLMNOPQRSTUVWXYZÄÖÜÄÖÜABCDEFGHIJKLMNOP",
+                                U"abcdefgähijklmnopqrstuvwxyzäöüäöüabcdefghijklmnop");
+
+    SECTION("unchangedSharesData")
+    {
+        StringImpl<DATATYPE> s(U"already lower case ä");
+        StringImpl<DATATYPE> lower = s.toLower();
+
+        REQUIRE(lower == s);
+        REQUIRE(lower.begin().getInner() == s.begin().getInner());
+    }
+
+    SECTION("slice")
+    {
+        StringImpl<DATATYPE> s(U"ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+
+        REQUIRE(s.subString(3, 17).toLower() == U"defghijklmnopqrst");
+    }
+
+    SECTION("defaultConstructedAndEmptySlice")
+    {
+        StringImpl<DATATYPE> s(U"ABC");
+
+        for (const StringImpl<DATATYPE> &empty : {StringImpl<DATATYPE>(), s.subString(3, 0)}) {
+            REQUIRE(empty.toLower().isEmpty());
+            REQUIRE(empty.toUpper().isEmpty());
+            REQUIRE(empty.toCaseFolded().isEmpty());
+            REQUIRE(empty.compareIgnoringCase(StringImpl<DATATYPE>()) == 0);
+            REQUIRE(empty.compareIgnoringCase(s) < 0);
+            REQUIRE(s.compareIgnoringCase(empty) > 0);
+            REQUIRE(empty.calcCaseInsensitiveHash() == StringImpl<DATATYPE>().calcHash());
+        }
+    }
+}
+
+template <class DATATYPE> inline void verifyCompareIgnoringCase(const char32_t *a, const char32_t *b, int expected)
+{
+    StringImpl<DATATYPE> stringA(a);
+    StringImpl<DATATYPE> stringB(b);
+
+    REQUIRE(stringA.compareIgnoringCase(stringB) == expected);
+    REQUIRE(stringB.compareIgnoringCase(stringA) == -expected);
+
+    REQUIRE(stringA.equalsIgnoringCase(stringB) == (expected == 0));
+
+    if (expected == 0) {
+        REQUIRE(stringA.calcCaseInsensitiveHash() == stringB.calcCaseInsensitiveHash());
+        REQUIRE(CaseInsensitiveStringHash()(stringA) == CaseInsensitiveStringHash()(stringB));
+        REQUIRE(CaseInsensitiveStringEqual()(stringA, stringB));
+    } else
+        REQUIRE(!CaseInsensitiveStringEqual()(stringA, stringB));
+}
+
+template <class DATATYPE> inline void testCompareIgnoringCase()
+{
+    SECTION("empty")
+    verifyCompareIgnoringCase<DATATYPE>(U"", U"", 0);
+
+    SECTION("emptyAndNonEmpty")
+    verifyCompareIgnoringCase<DATATYPE>(U"", U"a", -1);
+
+    SECTION("sameCase")
+    verifyCompareIgnoringCase<DATATYPE>(U"hello", U"hello", 0);
+
+    SECTION("differentCase")
+    verifyCompareIgnoringCase<DATATYPE>(U"Hello World", U"hELLO wORLD", 0);
+
+    SECTION("longDifferentCase")
+    verifyCompareIgnoringCase<DATATYPE>(U"The Quick Brown Fox Jumps Over The Lazy Dog",
+                                        U"THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG", 0);
+
+    SECTION("longWithLateDifference")
+    verifyCompareIgnoringCase<DATATYPE>(U"The Quick Brown Fox Jumps Over The Lazy Dog",
+                                        U"THE QUICK BROWN FOX JUMPS OVER THE LAZY DOH", -1);
+
+    SECTION("prefix")
+    verifyCompareIgnoringCase<DATATYPE>(U"ABCDEFGHIJKL", U"abcdefghijklm", -1);
+
+    SECTION("nonAscii")
+    verifyCompareIgnoringCase<DATATYPE>(U"Ärger \U00010400 über", U"äRGER \U00010428 ÜBER", 0);
+
+    SECTION("lengthChanges")
+    verifyCompareIgnoringCase<DATATYPE>(U"STRASSE", U"straße", 0);
+
+    SECTION("asciiVsNonAscii")
+    verifyCompareIgnoringCase<DATATYPE>(U"abcdefghZ", U"ABCDEFGHä", -1);
+
+    SECTION("hashEqualsHashOfCaseFolded")
+    {
+        // long enough to need several chunks of folded data, with all tail
+        // sizes of the hash function
+        std::u32string text;
+        for (int i = 0; i < 700; i++) {
+            text += U"aB\u00c4\u00df\U00010400 \u0130xY"[i % 9];
+
+            StringImpl<DATATYPE> s(text);
+            REQUIRE(s.calcCaseInsensitiveHash() == s.toCaseFolded().calcHash());
+        }
+
+        StringImpl<DATATYPE> s(text);
+        StringImpl<DATATYPE> slice = s.subString(5, 300);
+        REQUIRE(slice.calcCaseInsensitiveHash() == slice.toCaseFolded().calcHash());
+    }
+
+    SECTION("hashMap")
+    {
+        HashMap<StringImpl<DATATYPE>, int, CaseInsensitiveStringHash, CaseInsensitiveStringEqual> map;
+
+        map[U"Straße"] = 1;
+        map[U"Hello"] = 2;
+
+        REQUIRE(map.size() == 2);
+        REQUIRE(map[U"STRASSE"] == 1);
+        REQUIRE(map[U"hELLO"] == 2);
+        REQUIRE(map.size() == 2);
+    }
+}
+
+template <class DATATYPE>
+inline void verifyTrim(const char32_t *input, const char32_t *expectedTrimmed, const char32_t *expectedTrimmedStart,
+                       const char32_t *expectedTrimmedEnd)
+{
+    StringImpl<DATATYPE> s(input);
+    StringImpl<DATATYPE> copy = s;
+
+    REQUIRE(&s.trim() == &s);
+    REQUIRE(s == expectedTrimmed);
+    REQUIRE(s.getLength() == std::char_traits<char32_t>::length(expectedTrimmed));
+
+    // the copy must not be affected
+    REQUIRE(copy == input);
+
+    s = input;
+    s.trimStart();
+    REQUIRE(s == expectedTrimmedStart);
+    REQUIRE(s.getLength() == std::char_traits<char32_t>::length(expectedTrimmedStart));
+
+    s = input;
+    s.trimEnd();
+    REQUIRE(s == expectedTrimmedEnd);
+    REQUIRE(s.getLength() == std::char_traits<char32_t>::length(expectedTrimmedEnd));
+}
+
+template <class DATATYPE> inline void testTrim()
+{
+    SECTION("empty")
+    verifyTrim<DATATYPE>(U"", U"", U"", U"");
+
+    SECTION("onlyWhitespace")
+    verifyTrim<DATATYPE>(U" \t\r\n\u3000", U"", U"", U"");
+
+    SECTION("noWhitespace")
+    verifyTrim<DATATYPE>(U"hello", U"hello", U"hello", U"hello");
+
+    SECTION("inner")
+    verifyTrim<DATATYPE>(U"hel lo", U"hel lo", U"hel lo", U"hel lo");
+
+    SECTION("ascii")
+    verifyTrim<DATATYPE>(U" \t\vhel lo\f\r\n", U"hel lo", U"hel lo\f\r\n", U" \t\vhel lo");
+
+    SECTION("unicode")
+    verifyTrim<DATATYPE>(U"\u00a0\u2001hällo\u2028\u0085", U"hällo", U"hällo\u2028\u0085", U"\u00a0\u2001hällo");
+
+    SECTION("allWhitespaceChars")
+    {
+        for (char32_t chr : StringImpl<DATATYPE>::getWhitespaceChars())
+            REQUIRE(isWhitespaceChar(chr));
+
+        for (char32_t chr = 0; chr < 0x3100; chr++) {
+            if (isWhitespaceChar(chr))
+                REQUIRE(StringImpl<DATATYPE>::getWhitespaceChars().contains(chr));
+        }
+    }
+}
+
 template <class DATATYPE> inline void testStringImpl()
 {
     SECTION("types")
@@ -9348,6 +9630,15 @@ template <class DATATYPE> inline void testStringImpl()
 
     SECTION("endsWith")
     testEndsWith<DATATYPE>();
+
+    SECTION("caseMapping")
+    testCaseMapping<DATATYPE>();
+
+    SECTION("compareIgnoringCase")
+    testCompareIgnoringCase<DATATYPE>();
+
+    SECTION("trim")
+    testTrim<DATATYPE>();
 }
 
 #endif
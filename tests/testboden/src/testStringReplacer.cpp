@@ -0,0 +1,135 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/StringReplacer.h>
+
+using namespace bdn;
+
+template <class MainDataType> static void verifyStringReplacer()
+{
+    typedef StringImpl<MainDataType> StringType;
+    typedef StringReplacerImpl<MainDataType> Replacer;
+
+    SECTION("single characters")
+    {
+        Replacer replacer{{"&", "&amp;"}, {"<", "&lt;"}, {">", "&gt;"}};
+
+        StringType s = "a < b & c > d";
+        REQUIRE(replacer.findAndReplace(s) == 3);
+        REQUIRE(s == "a &lt; b &amp; c &gt; d");
+    }
+
+    SECTION("replaced parts are not searched again")
+    {
+        Replacer replacer{{"%", "%25"}, {"]]", "%5d%5d"}, {":", "%3a"}};
+
+        StringType s = "a:%]]b]";
+        REQUIRE(replacer.findAndReplace(s) == 3);
+        REQUIRE(s == "a%3a%25%5d%5db]");
+    }
+
+    SECTION("leftmost match wins")
+    {
+        Replacer replacer{{"bcd", "1"}, {"abc", "2"}};
+
+        StringType s = "xabcdx";
+        REQUIRE(replacer.findAndReplace(s) == 1);
+        REQUIRE(s == "x2dx");
+    }
+
+    SECTION("longest match wins")
+    {
+        Replacer replacer{{"ab", "1"}, {"abcd", "2"}, {"abc", "3"}};
+
+        StringType s = "abcdeabcab";
+        REQUIRE(replacer.findAndReplace(s) == 3);
+        REQUIRE(s == "2e31");
+    }
+
+    SECTION("pattern is suffix of another")
+    {
+        Replacer replacer{{"abcx", "1"}, {"bc", "2"}};
+
+        StringType s = "abcabcx";
+        REQUIRE(replacer.findAndReplace(s) == 2);
+        REQUIRE(s == "a21");
+    }
+
+    SECTION("non-ASCII")
+    {
+        Replacer replacer{{U"ä", U"ae"}, {U"\U00013333", U"<ö>"}, {U"ää", U"AE"}};
+
+        StringType s = U"äx\U00013333äää";
+        REQUIRE(replacer.findAndReplace(s) == 4);
+        REQUIRE(s == U"aex<ö>AEae");
+    }
+
+    SECTION("no match")
+    {
+        Replacer replacer{{"x", "y"}, {"long", "short"}};
+
+        StringType s = "hello world";
+        StringType copy = s;
+
+        REQUIRE(replacer.findAndReplace(s) == 0);
+        REQUIRE(s == "hello world");
+        // the data was not copied
+        REQUIRE(s.begin().getInner() == copy.begin().getInner());
+    }
+
+    SECTION("empty")
+    {
+        Replacer replacer{{"", "x"}, {"a", ""}};
+
+        StringType s;
+        REQUIRE(replacer.findAndReplace(s) == 0);
+        REQUIRE(s.isEmpty());
+
+        s = "banana";
+        REQUIRE(replacer.findAndReplace(s) == 3);
+        REQUIRE(s == "bnn");
+    }
+
+    SECTION("slice")
+    {
+        Replacer replacer{{"a", "A"}};
+
+        StringType s = "abcabca";
+        StringType slice = s.subString(1, 5);
+
+        REQUIRE(replacer.findAndReplace(slice) == 1);
+        REQUIRE(slice == "bcAbc");
+        REQUIRE(s == "abcabca");
+    }
+
+    SECTION("getReplaced")
+    {
+        Replacer replacer{{"a", "b"}, {"b", "a"}};
+
+        StringType s = "abba";
+        REQUIRE(replacer.getReplaced(s) == "baab");
+        REQUIRE(s == "abba");
+    }
+
+    SECTION("findAndReplace member")
+    {
+        StringType s = "a:b\"c%";
+        REQUIRE(s.findAndReplace({{"%", "%25"}, {"\"", "%22"}, {":", "%3a"}}) == 3);
+        REQUIRE(s == "a%3ab%22c%25");
+    }
+}
+
+TEST_CASE("StringReplacer")
+{
+    SECTION("native")
+    verifyStringReplacer<NativeStringData>();
+
+    SECTION("utf8")
+    verifyStringReplacer<Utf8StringData>();
+
+    SECTION("utf16")
+    verifyStringReplacer<Utf16StringData>();
+
+    SECTION("utf32")
+    verifyStringReplacer<Utf32StringData>();
+}
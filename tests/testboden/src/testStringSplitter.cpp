@@ -0,0 +1,223 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/StringSplitter.h>
+
+using namespace bdn;
+
+template <class MainDataType>
+static void verifyFields(const StringSplitterImpl<MainDataType> &splitter,
+                         const std::vector<StringImpl<MainDataType>> &expectedFields)
+{
+    typedef StringImpl<MainDataType> StringType;
+
+    std::vector<StringType> fields;
+    for (const StringViewImpl<MainDataType> &field : splitter) {
+        StringType fieldString = field.toString();
+        REQUIRE(field.getLength() == fieldString.getLength());
+
+        fields.push_back(fieldString);
+    }
+
+    REQUIRE(fields == expectedFields);
+    REQUIRE(splitter.getFieldCount() == expectedFields.size());
+
+    Array<StringType> fieldArray = splitter.toArray();
+    REQUIRE(fieldArray.getSize() == expectedFields.size());
+    for (size_t i = 0; i < fieldArray.getSize(); i++) {
+        REQUIRE(fieldArray[i] == fields[i]);
+        REQUIRE(fieldArray[i].getLength() == fields[i].getLength());
+    }
+}
+
+template <class MainDataType> static void verifyStringSplitter()
+{
+    typedef StringImpl<MainDataType> StringType;
+    typedef StringViewImpl<MainDataType> ViewType;
+
+    SECTION("single delimiter")
+    {
+        StringType s = "a,bc,def";
+        verifyFields(s.split(","), {"a", "bc", "def"});
+    }
+
+    SECTION("multiple delimiters")
+    {
+        StringType s = "a,b;c d";
+        verifyFields(s.split(",; "), {"a", "b", "c", "d"});
+    }
+
+    SECTION("empty fields")
+    {
+        StringType s = ",a,,b,";
+        verifyFields(s.split(","), {"", "a", "", "b", ""});
+    }
+
+    SECTION("empty string")
+    {
+        StringType s;
+        verifyFields(s.split(","), {""});
+    }
+
+    SECTION("empty slice at the end of the data")
+    {
+        StringType s = "ab";
+        verifyFields(s.subString(2, 0).split(","), {""});
+        verifyFields(s.subString(2, 0).tokenize(), {});
+    }
+
+    SECTION("empty delimiters")
+    {
+        StringType s = "a,b c";
+        verifyFields(s.split(""), {"a,b c"});
+        verifyFields(s.split(StringType()), {"a,b c"});
+        verifyFields(s.tokenize(""), {"a,b c"});
+
+        verifyFields(StringType().split(""), {""});
+        verifyFields(StringType().tokenize(""), {});
+    }
+
+    SECTION("no delimiter")
+    {
+        StringType s = "hello";
+        verifyFields(s.split(","), {"hello"});
+    }
+
+    SECTION("skipEmptyFields")
+    {
+        StringSplitOptions options;
+        options.skipEmptyFields = true;
+
+        StringType s = ",,a,,b,";
+        verifyFields(s.split(",", options), {"a", "b"});
+
+        s = ",,,";
+        verifyFields(s.split(",", options), {});
+    }
+
+    SECTION("maxFieldCount")
+    {
+        StringSplitOptions options;
+        options.maxFieldCount = 2;
+
+        StringType s = "a,b,c,d";
+        verifyFields(s.split(",", options), {"a", "b,c,d"});
+
+        s = "a";
+        verifyFields(s.split(",", options), {"a"});
+
+        options.skipEmptyFields = true;
+        s = ",,a,,b,c,";
+        verifyFields(s.split(",", options), {"a", "b,c,"});
+    }
+
+    SECTION("quoted fields")
+    {
+        StringSplitOptions options;
+        options.quoteChar = '"';
+
+        StringType s = "name,\"Doe, John\",42,\"\",\"a\"\"b\",x\"y,z\"";
+        verifyFields(s.split(",", options), {"name", "Doe, John", "42", "", "a\"\"b", "x\"y,z\""});
+
+        s = "\"";
+        verifyFields(s.split(",", options), {"\""});
+
+        s = "\"a,b";
+        verifyFields(s.split(",", options), {"\"a,b"});
+    }
+
+    SECTION("non-ASCII")
+    {
+        StringType s = U"\U00013333ä\U00013333xyäzö\U00013333";
+        verifyFields(s.split(U"ä\U00013333"), {"", "", "", "xy", U"zö", ""});
+
+        StringSplitOptions options;
+        options.quoteChar = U'ö';
+        options.skipEmptyFields = true;
+
+        s = U"öa,bö,c,ö\U00013333ö";
+        verifyFields(s.split(",", options), {"a,b", "c", U"\U00013333"});
+    }
+
+    SECTION("tokenize")
+    {
+        StringType s = U" \t a bc\u3000d\r\n";
+        verifyFields(s.tokenize(), {"a", "bc", "d"});
+
+        s = "  ";
+        verifyFields(s.tokenize(), {});
+
+        s = "a;;b;";
+        verifyFields(s.tokenize(";"), {"a", "b"});
+    }
+
+    SECTION("views refer to the original data")
+    {
+        StringType s = "ab,cd";
+
+        auto splitter = s.split(",");
+        auto it = splitter.begin();
+        REQUIRE(it->getEncodedBegin() == &*s.begin().getInner());
+        REQUIRE(*it == "ab");
+        ++it;
+        REQUIRE(*it == "cd");
+        REQUIRE(*it != "ab");
+        ++it;
+        REQUIRE(it == splitter.end());
+
+        // the splitter keeps the data alive
+        s = "other";
+        REQUIRE(splitter.begin()->toString() == "ab");
+    }
+
+    SECTION("toArray shares the data")
+    {
+        StringType s = "ab,cd";
+
+        Array<StringType> fields = s.split(",").toArray();
+        REQUIRE(fields.getSize() == 2);
+        REQUIRE(&*fields[1].begin().getInner() == &*s.begin().getInner() + 3);
+    }
+
+    SECTION("view")
+    {
+        ViewType empty;
+        REQUIRE(empty.isEmpty());
+        REQUIRE(empty.getLength() == 0);
+        REQUIRE(empty.toString() == "");
+
+        StringType s = U"aä\U00013333";
+        ViewType view(s);
+        REQUIRE(!view.isEmpty());
+        REQUIRE(view.getLength() == 3);
+        REQUIRE(view == s);
+        REQUIRE(view == ViewType(StringType(U"aä\U00013333")));
+        REQUIRE(view != ViewType(StringType("a")));
+        REQUIRE(StringType(view.begin(), view.end()) == s);
+
+        ViewType emptyStringView{StringType()};
+        REQUIRE(emptyStringView.isEmpty());
+        REQUIRE(emptyStringView.getLength() == 0);
+        REQUIRE(emptyStringView == StringType());
+
+        ViewType emptySliceView(s.subString(3, 0));
+        REQUIRE(emptySliceView.isEmpty());
+        REQUIRE(emptySliceView.begin() == emptySliceView.end());
+        REQUIRE(emptySliceView.toString() == "");
+    }
+}
+
+TEST_CASE("StringSplitter")
+{
+    SECTION("native")
+    verifyStringSplitter<NativeStringData>();
+
+    SECTION("utf8")
+    verifyStringSplitter<Utf8StringData>();
+
+    SECTION("utf16")
+    verifyStringSplitter<Utf16StringData>();
+
+    SECTION("utf32")
+    verifyStringSplitter<Utf32StringData>();
+}
@@ -0,0 +1,213 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/TextRope.h>
+
+#include <random>
+
+using namespace bdn;
+
+static void verifyTextRope(const TextRope &rope, const String &expected)
+{
+    REQUIRE(rope.getLength() == expected.getLength());
+    REQUIRE(rope.toString() == expected);
+}
+
+static String createTextRopeTestText(std::mt19937 &random, size_t charCount)
+{
+    const char32_t chars[] = {U'a', U'b', U' ', U'\n', U'ä', U'€', U'\U00012345'};
+
+    std::uniform_int_distribution<size_t> charDist(0, sizeof(chars) / sizeof(chars[0]) - 1);
+
+    std::u32string text;
+    for (size_t i = 0; i < charCount; i++)
+        text += chars[charDist(random)];
+
+    return String(text);
+}
+
+TEST_CASE("TextRope")
+{
+    SECTION("empty")
+    {
+        TextRope rope;
+
+        verifyTextRope(rope, "");
+        REQUIRE(rope.isEmpty());
+        REQUIRE(rope.getLineCount() == 1);
+        REQUIRE(rope.getLineStartIndex(0) == 0);
+        REQUIRE(rope.getLineIndex(0) == 0);
+        REQUIRE(rope.getLine(0) == "");
+
+        REQUIRE_THROWS_AS(rope[0], OutOfRangeError);
+        REQUIRE_THROWS_AS(rope.insert(1, "x"), OutOfRangeError);
+        REQUIRE_THROWS_AS(rope.getLineStartIndex(1), OutOfRangeError);
+
+        verifyTextRope(TextRope(""), "");
+    }
+
+    SECTION("fromString")
+    {
+        String text = U"hällo\nw\U00012345rld";
+        TextRope rope(text);
+
+        verifyTextRope(rope, text);
+        REQUIRE(!rope.isEmpty());
+
+        for (size_t i = 0; i < text.getLength(); i++)
+            REQUIRE(rope[i] == text[i]);
+        REQUIRE_THROWS_AS(rope[text.getLength()], OutOfRangeError);
+    }
+
+    SECTION("edits")
+    {
+        TextRope rope("hello world");
+
+        rope.insert(5, U",ä");
+        verifyTextRope(rope, U"hello,ä world");
+
+        rope.insert(0, ">");
+        rope.append("<");
+        verifyTextRope(rope, U">hello,ä world<");
+
+        rope.erase(6, 2);
+        verifyTextRope(rope, ">hello world<");
+
+        rope.replace(7, 5, U"\U00012345");
+        verifyTextRope(rope, U">hello \U00012345<");
+
+        rope.erase(7);
+        verifyTextRope(rope, ">hello ");
+
+        rope.erase(0, 100);
+        verifyTextRope(rope, "");
+
+        REQUIRE_THROWS_AS(rope.erase(1, 0), OutOfRangeError);
+    }
+
+    SECTION("subString")
+    {
+        TextRope rope(U"aäb\U00012345c");
+
+        REQUIRE(rope.subString(0) == U"aäb\U00012345c");
+        REQUIRE(rope.subString(1, 3) == U"äb\U00012345");
+        REQUIRE(rope.subString(3, 100) == U"\U00012345c");
+        REQUIRE(rope.subString(5) == "");
+        REQUIRE_THROWS_AS(rope.subString(6), OutOfRangeError);
+    }
+
+    SECTION("lines")
+    {
+        TextRope rope("first\nsecond\n\nlast");
+
+        REQUIRE(rope.getLineCount() == 4);
+
+        REQUIRE(rope.getLineStartIndex(0) == 0);
+        REQUIRE(rope.getLineStartIndex(1) == 6);
+        REQUIRE(rope.getLineStartIndex(2) == 13);
+        REQUIRE(rope.getLineStartIndex(3) == 14);
+        REQUIRE_THROWS_AS(rope.getLineStartIndex(4), OutOfRangeError);
+
+        REQUIRE(rope.getLineIndex(0) == 0);
+        REQUIRE(rope.getLineIndex(5) == 0);
+        REQUIRE(rope.getLineIndex(6) == 1);
+        REQUIRE(rope.getLineIndex(13) == 2);
+        REQUIRE(rope.getLineIndex(18) == 3);
+        REQUIRE_THROWS_AS(rope.getLineIndex(19), OutOfRangeError);
+
+        REQUIRE(rope.getLine(0) == "first");
+        REQUIRE(rope.getLine(1) == "second");
+        REQUIRE(rope.getLine(2) == "");
+        REQUIRE(rope.getLine(3) == "last");
+
+        rope.append("\n");
+        REQUIRE(rope.getLineCount() == 5);
+        REQUIRE(rope.getLine(3) == "last");
+        REQUIRE(rope.getLine(4) == "");
+    }
+
+    SECTION("snapshots")
+    {
+        TextRope rope(String(std::string(10000, 'a')));
+        TextRope snapshot = rope;
+
+        rope.insert(5000, "b");
+        rope.erase(0, 10);
+
+        REQUIRE(rope.getLength() == 9991);
+        REQUIRE(rope[4990] == 'b');
+
+        verifyTextRope(snapshot, String(std::string(10000, 'a')));
+    }
+
+    SECTION("insertRope")
+    {
+        TextRope rope("abcd");
+        TextRope other(String(std::string(5000, 'x')));
+
+        rope.insert(2, other);
+        verifyTextRope(rope, "ab" + std::string(5000, 'x') + "cd");
+
+        rope.append(rope);
+        REQUIRE(rope.getLength() == 10008);
+        verifyTextRope(other, String(std::string(5000, 'x')));
+    }
+
+    SECTION("randomEdits")
+    {
+        // compare a long series of edits with the same edits on a String
+        std::mt19937 random(4711);
+
+        String text = createTextRopeTestText(random, 20000);
+        TextRope rope(text);
+
+        for (int i = 0; i < 2000; i++) {
+            size_t length = text.getLength();
+            size_t index = std::uniform_int_distribution<size_t>(0, length)(random);
+            size_t count = std::uniform_int_distribution<size_t>(0, (i % 10 == 0) ? 3000 : 10)(random);
+
+            switch (i % 3) {
+            case 0: {
+                String insertText = createTextRopeTestText(random, count);
+                rope.insert(index, insertText);
+                text.insert(index, insertText);
+                break;
+            }
+
+            case 1:
+                rope.erase(index, count);
+                text.erase(index, count);
+                break;
+
+            default: {
+                String replaceWith = createTextRopeTestText(random, count / 2);
+                rope.replace(index, count, replaceWith);
+                text.replace(index, count, replaceWith);
+                break;
+            }
+            }
+
+            REQUIRE(rope.getLength() == text.getLength());
+
+            if (i % 200 == 0) {
+                REQUIRE(rope.toString() == text);
+
+                size_t charIndex = 0;
+                size_t lineCount = 1;
+                for (char32_t chr : text) {
+                    REQUIRE(rope[charIndex] == chr);
+                    REQUIRE(rope.getLineIndex(charIndex) == lineCount - 1);
+
+                    if (chr == '\n') {
+                        REQUIRE(rope.getLineStartIndex(lineCount) == charIndex + 1);
+                        lineCount++;
+                    }
+                    charIndex++;
+                }
+                REQUIRE(rope.getLineCount() == lineCount);
+            }
+        }
+
+        verifyTextRope(rope, text);
+    }
+}
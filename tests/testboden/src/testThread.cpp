@@ -2,8 +2,14 @@
 #include <bdn/test.h>
 
 #include <bdn/Thread.h>
+#include <bdn/ThreadPool.h>
 #include <bdn/StopWatch.h>
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 using namespace bdn;
 
 class TestStopRunnable : public ThreadRunnableBase
@@ -931,3 +937,115 @@ TEST_CASE("ThreadLocalStorage")
         p70().dummy();
     }
 }
+
+#if BDN_HAVE_THREADS
+
+class ThreadOptionsTestRunnable : public ThreadRunnableBase
+{
+  public:
+    Thread::Id threadId;
+    std::string name;
+    size_t stackSize = 0;
+    int cpuCount = 0;
+    Signal doneSignal;
+
+    void run() override
+    {
+        threadId = Thread::getCurrentId();
+
+#if defined(__linux__)
+        char nameBuffer[32] = {0};
+        pthread_getname_np(pthread_self(), nameBuffer, sizeof(nameBuffer));
+        name = nameBuffer;
+
+        pthread_attr_t attr;
+        if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+            pthread_attr_getstacksize(&attr, &stackSize);
+            pthread_attr_destroy(&attr);
+        }
+
+        cpu_set_t cpuSet;
+        if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0)
+            cpuCount = CPU_COUNT(&cpuSet);
+#endif
+
+        doneSignal.set();
+    }
+};
+
+TEST_CASE("Thread-Options")
+{
+    Thread::Options options;
+    options.name = "bdn test thread with a long name";
+    options.affinityMask = 1;
+    options.stackSize = 512 * 1024;
+
+    P<ThreadOptionsTestRunnable> runnable = newObj<ThreadOptionsTestRunnable>();
+
+    SECTION("join")
+    {
+        Thread thread(runnable, options);
+        thread.join(Thread::ExceptionThrow);
+
+        REQUIRE(runnable->threadId == thread.getId());
+    }
+
+    SECTION("detach")
+    {
+        {
+            Thread thread(runnable, options);
+            thread.detach();
+        }
+
+        REQUIRE(runnable->doneSignal.wait(5000));
+    }
+
+    SECTION("thread pool")
+    {
+        P<ThreadPool> pool = newObj<ThreadPool>(1, 1, options);
+        REQUIRE(pool->getThreadOptions().name == options.name);
+
+        pool->addJob(runnable);
+
+        REQUIRE(runnable->doneSignal.wait(5000));
+    }
+
+#if defined(__linux__)
+    REQUIRE(runnable->doneSignal.wait(5000));
+
+    // the name is truncated to 15 bytes
+    REQUIRE(runnable->name == "bdn test thread");
+    REQUIRE(runnable->stackSize >= options.stackSize);
+    REQUIRE(runnable->cpuCount == 1);
+#endif
+}
+
+TEST_CASE("Thread-ResourceUsage")
+{
+    Thread::ResourceUsage before = Thread::getCurrentResourceUsage();
+
+    // burn some CPU time
+    volatile double value = 0;
+    auto startTime = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - startTime < std::chrono::milliseconds(100))
+        value = value + 1;
+
+    // and give up the CPU a few times
+    for (int i = 0; i < 5; i++)
+        Thread::sleepMillis(2);
+
+    Thread::ResourceUsage after = Thread::getCurrentResourceUsage();
+
+#if BDN_PLATFORM_FAMILY_POSIX
+    // we may have been preempted while we were spinning, so we leave some room
+    REQUIRE(after.cpuTimeSeconds - before.cpuTimeSeconds >= 0.02);
+#endif
+
+#if defined(__linux__)
+    REQUIRE(after.voluntaryContextSwitches - before.voluntaryContextSwitches >= 5);
+#endif
+
+    REQUIRE(after.involuntaryContextSwitches >= before.involuntaryContextSwitches);
+}
+
+#endif
@@ -0,0 +1,266 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/ThreadPerCoreRuntime.h>
+
+#if BDN_HAVE_THREADS
+
+#include <bdn/InvalidArgumentError.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+using namespace bdn;
+
+class ThreadPerCoreRuntimeTestState : public Base
+{
+  public:
+    Mutex mutex;
+    std::vector<int> loopIndices;
+    std::vector<std::vector<int>> received;
+    std::atomic<int> remaining{0};
+    std::atomic<int> wrongLoopCount{0};
+    Signal doneSignal;
+
+    ThreadPerCoreRuntimeTestState(int loopCount = 0) : received(loopCount) {}
+
+    void done()
+    {
+        if (--remaining == 0)
+            doneSignal.set();
+    }
+};
+
+TEST_CASE("SpscChannel")
+{
+    SECTION("capacity")
+    {
+        SpscChannel<int> channel(5);
+        REQUIRE(channel.getCapacity() == 8);
+
+        for (int i = 0; i < 8; i++)
+            REQUIRE(channel.tryPush(i));
+        REQUIRE(!channel.tryPush(8));
+
+        int item = -1;
+        REQUIRE(channel.tryPop(item));
+        REQUIRE(item == 0);
+        REQUIRE(channel.tryPush(8));
+
+        for (int i = 1; i <= 8; i++) {
+            REQUIRE(channel.tryPop(item));
+            REQUIRE(item == i);
+        }
+
+        REQUIRE(channel.isEmpty());
+        REQUIRE(!channel.tryPop(item));
+    }
+
+    SECTION("threads")
+    {
+        const int itemCount = 100000;
+        SpscChannel<int> channel(64);
+
+        std::future<void> producer = Thread::exec([&channel]() {
+            for (int i = 0; i < itemCount; i++) {
+                while (!channel.tryPush(i))
+                    std::this_thread::yield();
+            }
+        });
+
+        int expected = 0;
+        int item;
+        while (expected < itemCount) {
+            if (channel.tryPop(item)) {
+                REQUIRE(item == expected);
+                expected++;
+            } else
+                std::this_thread::yield();
+        }
+
+        producer.get();
+    }
+}
+
+TEST_CASE("LoopAllocator")
+{
+    LoopAllocator allocator;
+
+    void *a = allocator.allocate(10);
+    void *b = allocator.allocate(10);
+    REQUIRE(a != b);
+
+    // released blocks are reused
+    allocator.deallocate(a, 10);
+    REQUIRE(allocator.allocate(16) == a);
+
+    // big blocks are passed through
+    void *big = allocator.allocate(LoopAllocator::maxPooledSize + 1);
+    REQUIRE(big != nullptr);
+    allocator.deallocate(big, LoopAllocator::maxPooledSize + 1);
+
+    String *str = allocator.create<String>("hello");
+    REQUIRE(*str == "hello");
+    allocator.destroy(str);
+
+    allocator.deallocate(b, 10);
+}
+
+TEST_CASE("ThreadPerCoreRuntime")
+{
+    const int loopCount = 4;
+
+    P<ThreadPerCoreRuntime> runtimeObj = newObj<ThreadPerCoreRuntime>(loopCount, true, 8);
+
+    // the tasks must not hold references to the runtime. Otherwise it could
+    // end up being deleted from one of its own loops.
+    ThreadPerCoreRuntime *runtime = runtimeObj;
+
+    REQUIRE(runtime->getLoopCount() == loopCount);
+    REQUIRE(runtime->getCurrentLoopIndex() == -1);
+
+    SECTION("default loop count")
+    {
+        P<ThreadPerCoreRuntime> defaultRuntime = newObj<ThreadPerCoreRuntime>();
+
+        REQUIRE(defaultRuntime->getLoopCount() == std::max(1, (int)std::thread::hardware_concurrency()));
+    }
+
+    SECTION("submitTo runs on target loop")
+    {
+        P<ThreadPerCoreRuntimeTestState> state = newObj<ThreadPerCoreRuntimeTestState>();
+        state->remaining = loopCount;
+
+        for (int i = 0; i < loopCount; i++) {
+            runtime->submitTo(i, [runtime, state]() {
+                {
+                    Mutex::Lock lock(state->mutex);
+                    state->loopIndices.push_back(runtime->getCurrentLoopIndex());
+                }
+                state->done();
+            });
+        }
+
+        REQUIRE(state->doneSignal.wait(5000));
+
+        std::sort(state->loopIndices.begin(), state->loopIndices.end());
+        for (int i = 0; i < loopCount; i++)
+            REQUIRE(state->loopIndices[i] == i);
+    }
+
+    SECTION("broadcast")
+    {
+        P<ThreadPerCoreRuntimeTestState> state = newObj<ThreadPerCoreRuntimeTestState>(loopCount);
+        state->remaining = loopCount;
+
+        runtime->broadcast([runtime, state]() {
+            int index = runtime->getCurrentLoopIndex();
+            {
+                Mutex::Lock lock(state->mutex);
+                state->received[index].push_back(1);
+            }
+            state->done();
+        });
+
+        REQUIRE(state->doneSignal.wait(5000));
+
+        for (auto &received : state->received)
+            REQUIRE(received.size() == 1);
+    }
+
+    SECTION("cross-loop order")
+    {
+        // each loop sends many more tasks to every other loop than the
+        // channels can hold, so the overflow handling is exercised as well.
+        const int messageCount = 1000;
+
+        P<ThreadPerCoreRuntimeTestState> state = newObj<ThreadPerCoreRuntimeTestState>(loopCount * loopCount);
+        state->remaining = loopCount * loopCount * messageCount;
+
+        runtime->broadcast([runtime, state, messageCount]() {
+            int source = runtime->getCurrentLoopIndex();
+
+            for (int message = 0; message < messageCount; message++) {
+                for (int target = 0; target < loopCount; target++) {
+                    runtime->submitTo(target, [runtime, state, source, target, message]() {
+                        if (runtime->getCurrentLoopIndex() != target)
+                            state->wrongLoopCount++;
+
+                        // only the target loop accesses this entry, so no
+                        // lock is needed
+                        state->received[source * loopCount + target].push_back(message);
+                        state->done();
+                    });
+                }
+            }
+        });
+
+        REQUIRE(state->doneSignal.wait(10000));
+        REQUIRE(state->wrongLoopCount == 0);
+
+        for (auto &received : state->received) {
+            REQUIRE(received.size() == (size_t)messageCount);
+            for (int message = 0; message < messageCount; message++)
+                REQUIRE(received[message] == message);
+        }
+    }
+
+    SECTION("dispatcher")
+    {
+        P<ThreadPerCoreRuntimeTestState> state = newObj<ThreadPerCoreRuntimeTestState>();
+        state->remaining = 1;
+
+        P<IDispatcher> dispatcher = runtime->getDispatcher(2);
+        dispatcher->enqueueInSeconds(0.1, [runtime, state]() {
+            {
+                Mutex::Lock lock(state->mutex);
+                state->loopIndices.push_back(runtime->getCurrentLoopIndex());
+            }
+            state->done();
+        });
+
+        REQUIRE(state->doneSignal.wait(5000));
+        REQUIRE(state->loopIndices.size() == 1);
+        REQUIRE(state->loopIndices[0] == 2);
+    }
+
+    SECTION("loop allocator")
+    {
+        REQUIRE_THROWS_PROGRAMMING_ERROR(runtime->getCurrentLoopAllocator());
+
+        P<ThreadPerCoreRuntimeTestState> state = newObj<ThreadPerCoreRuntimeTestState>();
+        state->remaining = loopCount;
+
+        runtime->broadcast([runtime, state]() {
+            LoopAllocator &allocator = runtime->getCurrentLoopAllocator();
+
+            int *value = allocator.create<int>(runtime->getCurrentLoopIndex());
+            {
+                Mutex::Lock lock(state->mutex);
+                state->loopIndices.push_back(*value);
+            }
+            allocator.destroy(value);
+
+            state->done();
+        });
+
+        REQUIRE(state->doneSignal.wait(5000));
+        REQUIRE(state->loopIndices.size() == (size_t)loopCount);
+    }
+
+    SECTION("invalid loop index")
+    {
+        REQUIRE_THROWS_AS(runtime->submitTo(loopCount, []() {}), InvalidArgumentError);
+        REQUIRE_THROWS_AS(runtime->getDispatcher(-1), InvalidArgumentError);
+    }
+
+    SECTION("stop")
+    {
+        runtime->stop();
+        // calling it again is ok
+        runtime->stop();
+    }
+}
+
+#endif
@@ -26,6 +26,31 @@ class ThreadPoolTestRunnable : public Base, BDN_IMPLEMENTS IThreadRunnable
     }
 };
 
+class ThreadPoolOrderTestState : public Base
+{
+  public:
+    Mutex mutex;
+    String order;
+};
+
+class ThreadPoolOrderTestRunnable : public Base, BDN_IMPLEMENTS IThreadRunnable
+{
+  public:
+    ThreadPoolOrderTestRunnable(ThreadPoolOrderTestState *state, const String &name) : _state(state), _name(name) {}
+
+    void signalStop() override {}
+
+    void run() override
+    {
+        Mutex::Lock lock(_state->mutex);
+        _state->order += _name + " ";
+    }
+
+  private:
+    P<ThreadPoolOrderTestState> _state;
+    String _name;
+};
+
 TEST_CASE("ThreadPool")
 {
     SECTION("construct")
@@ -255,6 +280,153 @@ TEST_CASE("ThreadPool")
         }
     }
 
+    SECTION("queue order")
+    {
+        P<ThreadPool> pool = newObj<ThreadPool>(1, 1);
+
+        P<ThreadPoolTestRunnable> blocker = newObj<ThreadPoolTestRunnable>();
+        pool->addJob(blocker);
+        REQUIRE(blocker->startedSignal.wait(5000));
+
+        P<ThreadPoolOrderTestState> state = newObj<ThreadPoolOrderTestState>();
+
+        auto addJob = [&](const String &name, ThreadPool::Priority priority) {
+            pool->addJob(newObj<ThreadPoolOrderTestRunnable>(state, name), priority);
+        };
+
+        SECTION("priorities")
+        {
+            addJob("low", ThreadPool::Priority::low);
+            addJob("normal1", ThreadPool::Priority::normal);
+            addJob("high", ThreadPool::Priority::high);
+            addJob("normal2", ThreadPool::Priority::normal);
+
+            REQUIRE(pool->getQueuedJobCount() == 4);
+        }
+
+        SECTION("aging")
+        {
+            pool->setAgingIntervalSeconds(0.05);
+            REQUIRE(pool->getAgingIntervalSeconds() == 0.05);
+
+            addJob("low", ThreadPool::Priority::low);
+
+            // after 4 aging intervals the low job has a higher effective
+            // priority than a new high priority job.
+            Thread::sleepSeconds(0.2);
+
+            addJob("high", ThreadPool::Priority::high);
+            addJob("normal1", ThreadPool::Priority::normal);
+            addJob("normal2", ThreadPool::Priority::normal);
+        }
+
+        SECTION("deadline")
+        {
+            addJob("normal1", ThreadPool::Priority::normal);
+            pool->addJobWithDeadline(newObj<ThreadPoolOrderTestRunnable>(state, "normal2"), 1000);
+            pool->addJobWithDeadline(newObj<ThreadPoolOrderTestRunnable>(state, "high"), 500,
+                                     ThreadPool::Priority::high);
+
+            // a passed deadline beats all priorities
+            pool->addJobWithDeadline(newObj<ThreadPoolOrderTestRunnable>(state, "low"), 0,
+                                     ThreadPool::Priority::low);
+        }
+
+        blocker->proceedSignal.set();
+        blocker->stopSignal.set();
+
+        CONTINUE_SECTION_AFTER_RUN_SECONDS(0.5, pool, state)
+        {
+            Mutex::Lock lock(state->mutex);
+
+            // with aging and with a passed deadline the low priority job goes
+            // first.
+            REQUIRE((state->order == "high normal1 normal2 low " || state->order == "low high normal1 normal2 "));
+        };
+    }
+
+    SECTION("queue limit")
+    {
+        P<ThreadPool> pool = newObj<ThreadPool>(1, 1);
+
+        REQUIRE(pool->getMaxQueuedJobs() < 0);
+
+        P<ThreadPoolTestRunnable> a = newObj<ThreadPoolTestRunnable>();
+        P<ThreadPoolTestRunnable> b = newObj<ThreadPoolTestRunnable>();
+        P<ThreadPoolTestRunnable> c = newObj<ThreadPoolTestRunnable>();
+
+        pool->addJob(a);
+        REQUIRE(a->startedSignal.wait(5000));
+
+        SECTION("reject")
+        {
+            pool->setQueueLimit(1, ThreadPool::OverflowPolicy::reject);
+            REQUIRE(pool->getOverflowPolicy() == ThreadPool::OverflowPolicy::reject);
+
+            pool->addJob(b);
+            REQUIRE_THROWS_AS(pool->addJob(c), QueueFullError);
+
+            ThreadPool::Metrics metrics = pool->getMetrics();
+            REQUIRE(metrics.queuedJobCount == 1);
+            REQUIRE(metrics.peakQueuedJobCount == 1);
+            REQUIRE(metrics.rejectedJobCount == 1);
+        }
+
+        SECTION("callerRuns")
+        {
+            pool->setQueueLimit(0, ThreadPool::OverflowPolicy::callerRuns);
+
+            // c is run synchronously in our thread
+            c->proceedSignal.set();
+            c->stopSignal.set();
+            pool->addJob(c);
+            REQUIRE(c->startedSignal.isSet());
+
+            ThreadPool::Metrics metrics = pool->getMetrics();
+            REQUIRE(metrics.queuedJobCount == 0);
+            REQUIRE(metrics.callerRunJobCount == 1);
+        }
+
+        SECTION("block")
+        {
+            pool->setQueueLimit(1, ThreadPool::OverflowPolicy::block);
+
+            pool->addJob(b);
+
+            std::future<void> result = Thread::exec([pool, c]() { pool->addJob(c); });
+
+            // the producer must wait until there is space in the queue
+            REQUIRE(result.wait_for(std::chrono::milliseconds(500)) == std::future_status::timeout);
+
+            // let a finish. Then b is started and c can be queued.
+            a->proceedSignal.set();
+            a->stopSignal.set();
+
+            REQUIRE(result.wait_for(std::chrono::milliseconds(5000)) == std::future_status::ready);
+            REQUIRE(b->startedSignal.wait(5000));
+            REQUIRE(pool->getQueuedJobCount() == 1);
+
+            ThreadPool::Metrics metrics = pool->getMetrics();
+            REQUIRE(metrics.blockedAddCount == 1);
+            REQUIRE(metrics.startedJobCount == 2);
+            REQUIRE(metrics.maxWaitSeconds >= 0.4);
+        }
+
+        a->proceedSignal.set();
+        a->stopSignal.set();
+        b->proceedSignal.set();
+        b->stopSignal.set();
+        c->proceedSignal.set();
+        c->stopSignal.set();
+    }
+
+    SECTION("invalid aging interval")
+    {
+        P<ThreadPool> pool = newObj<ThreadPool>(1, 1);
+
+        REQUIRE_THROWS_AS(pool->setAgingIntervalSeconds(0), InvalidArgumentError);
+    }
+
     SECTION("pool destroyed")
     {
         P<ThreadPool> pool = newObj<ThreadPool>(1, 1);
@@ -3,6 +3,10 @@
 
 #include <bdn/ThreadSafeNotifier.h>
 #include <bdn/DanglingFunctionError.h>
+#include <bdn/GenericDispatcher.h>
+#include <bdn/Array.h>
+
+#include <thread>
 
 using namespace bdn;
 
@@ -646,3 +650,43 @@ TEST_CASE("ThreadSafeNotifier")
         }
     }
 }
+
+TEST_CASE("ThreadSafeNotifier-notificationPolicy")
+{
+    P<ThreadSafeNotifier<int, String>> notifier = newObj<ThreadSafeNotifier<int, String>>();
+    P<GenericDispatcher> dispatcher = newObj<GenericDispatcher>();
+
+    Array<String> got;
+    notifier->subscribe([&got](int num, String text) { got.add(std::to_string(num) + text); });
+
+    SECTION("coalesced")
+    {
+        notifier->setNotificationPolicy(NotificationPolicy::coalesced(dispatcher));
+
+        // post from another thread, like a model that is updated by a worker
+        std::thread thread([notifier]() {
+            for (int i = 0; i < 1000; i++)
+                notifier->postNotification(i, "x");
+        });
+        thread.join();
+
+        REQUIRE(got.size() == 0);
+
+        while (dispatcher->executeNext()) {
+        }
+
+        REQUIRE(got == Array<String>{"999x"});
+    }
+
+    SECTION("notify is not affected")
+    {
+        notifier->setNotificationPolicy(NotificationPolicy::coalesced(dispatcher));
+
+        notifier->notify(1, "a");
+        notifier->notify(2, "b");
+
+        REQUIRE((got == Array<String>{"1a", "2b"}));
+    }
+
+    dispatcher->dispose();
+}
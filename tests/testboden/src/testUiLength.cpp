@@ -55,6 +55,16 @@ TEST_CASE("UiLength")
         REQUIRE(a.isNone());
     }
 
+    SECTION("constexpr")
+    {
+        constexpr UiLength a = UiLength::sem(2.5);
+        static_assert(a.unit == UiLength::Unit::sem && a.value == 2.5,
+                      "UiLength must be usable in constant expressions");
+        static_assert(UiLength::none().isNone(), "UiLength must be usable in constant expressions");
+
+        REQUIRE(a == UiLength(2.5, UiLength::Unit::sem));
+    }
+
     SECTION("construct(double)")
     {
         UiLength a(12.3456);
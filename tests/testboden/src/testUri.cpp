@@ -69,8 +69,32 @@ void testUnescape()
     SECTION("unfinishedUtf8AtEnd") { REQUIRE(Uri::unescape("hell%e1") == U"hell\ufffd"); }
 }
 
+void testEscape()
+{
+    SECTION("empty")
+    REQUIRE(Uri::escape("") == "");
+
+    SECTION("unreserved")
+    REQUIRE(Uri::escape("azAZ09-._~") == "azAZ09-._~");
+
+    SECTION("reserved")
+    REQUIRE(Uri::escape("a b/c?d=e&f%g+h") == "a%20b%2Fc%3Fd%3De%26f%25g%2Bh");
+
+    SECTION("nonAscii")
+    REQUIRE(Uri::escape(U"hä𒍅o") == "h%C3%A4%F0%92%8D%85o");
+
+    SECTION("roundTrip")
+    {
+        String s = U"he\U00012345llo w%orld/\u00e4?x=1&y=\u20ac";
+        REQUIRE(Uri::unescape(Uri::escape(s)) == s);
+    }
+}
+
 TEST_CASE("Uri")
 {
     SECTION("unescape")
     testUnescape();
+
+    SECTION("escape")
+    testEscape();
 }
@@ -33,4 +33,97 @@ TEST_CASE("GenericDispatcher")
     }
 }
 
+TEST_CASE("GenericDispatcher-priorities")
+{
+    P<GenericDispatcher> dispatcher = newObj<GenericDispatcher>();
+    std::vector<int> executed;
+
+    auto add = [dispatcher, &executed](int id, IDispatcher::Priority priority) {
+        dispatcher->enqueue([&executed, id]() { executed.push_back(id); }, priority);
+    };
+
+    auto executeAll = [dispatcher]() {
+        while (dispatcher->executeNext()) {
+        }
+    };
+
+    SECTION("levels")
+    {
+        add(1, IDispatcher::Priority::idle);
+        add(2, IDispatcher::Priority::low);
+        add(3, IDispatcher::Priority::normal);
+        add(4, IDispatcher::Priority::high);
+        add(5, IDispatcher::Priority::urgent);
+        add(6, IDispatcher::Priority::normal);
+        add(7, IDispatcher::Priority::urgent);
+
+        executeAll();
+
+        REQUIRE(executed == std::vector<int>({5, 7, 4, 3, 6, 2, 1}));
+    }
+
+    SECTION("aging")
+    {
+        REQUIRE(dispatcher->getAgingIntervalSeconds() == 0);
+
+        dispatcher->setAgingIntervalSeconds(0.05);
+        REQUIRE(dispatcher->getAgingIntervalSeconds() == Approx(0.05));
+
+        add(1, IDispatcher::Priority::idle);
+
+        // after more than four intervals the idle item has overtaken even new
+        // urgent items.
+        Thread::sleepSeconds(0.3);
+
+        add(2, IDispatcher::Priority::urgent);
+        add(3, IDispatcher::Priority::normal);
+
+        executeAll();
+
+        REQUIRE(executed == std::vector<int>({1, 2, 3}));
+
+        dispatcher->setAgingIntervalSeconds(0);
+        REQUIRE(dispatcher->getAgingIntervalSeconds() == 0);
+    }
+
+    SECTION("no aging")
+    {
+        add(1, IDispatcher::Priority::idle);
+
+        Thread::sleepSeconds(0.1);
+
+        add(2, IDispatcher::Priority::low);
+
+        executeAll();
+
+        REQUIRE(executed == std::vector<int>({2, 1}));
+    }
+
+    SECTION("deadline")
+    {
+        dispatcher->enqueueWithDeadline(10, [&executed]() { executed.push_back(1); });
+        dispatcher->enqueueWithDeadline(5, [&executed]() { executed.push_back(2); });
+        dispatcher->enqueueWithDeadline(0.05, [&executed]() { executed.push_back(3); }, IDispatcher::Priority::idle);
+        add(4, IDispatcher::Priority::high);
+
+        // the idle item's deadline passes, so it comes first.
+        Thread::sleepSeconds(0.1);
+
+        executeAll();
+
+        REQUIRE(executed == std::vector<int>({3, 4, 2, 1}));
+    }
+
+    SECTION("dispose")
+    {
+        add(1, IDispatcher::Priority::urgent);
+        dispatcher->enqueueWithDeadline(1, [&executed]() { executed.push_back(2); }, IDispatcher::Priority::low);
+
+        dispatcher->dispose();
+
+        REQUIRE(!dispatcher->executeNext());
+        REQUIRE(executed.empty());
+    }
+}
+
 #endif
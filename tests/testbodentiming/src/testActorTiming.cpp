@@ -0,0 +1,109 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/Actor.h>
+#include <bdn/StopWatch.h>
+#include <bdn/log.h>
+
+#if BDN_HAVE_THREADS
+
+using namespace bdn;
+
+struct PingPongState
+{
+    P<Actor<PingPongState>> partner;
+    int remainingRoundTrips = 0;
+    Signal *doneSignal = nullptr;
+};
+
+static void pingPong(PingPongState &state);
+
+static void sendPing(Actor<PingPongState> *target)
+{
+    // the message captures nothing, so no allocation is necessary.
+    target->tell([](PingPongState &state) { pingPong(state); });
+}
+
+static void pingPong(PingPongState &state)
+{
+    if (state.doneSignal != nullptr) {
+        // this is the initiating side
+        if (--state.remainingRoundTrips <= 0) {
+            state.doneSignal->set();
+            return;
+        }
+    }
+
+    sendPing(state.partner);
+}
+
+struct CounterState
+{
+    int64_t count = 0;
+};
+
+TEST_CASE("actor-timing")
+{
+    P<ThreadPool> pool = newObj<ThreadPool>(2, 2);
+
+    SECTION("ping-pong latency")
+    {
+        const int roundTrips = 100000;
+
+        P<Actor<PingPongState>> a = newObj<Actor<PingPongState>>(pool);
+        P<Actor<PingPongState>> b = newObj<Actor<PingPongState>>(pool);
+
+        Signal doneSignal;
+
+        Actor<PingPongState> *aPtr = a;
+        Actor<PingPongState> *bPtr = b;
+
+        a->tell([bPtr, &doneSignal](PingPongState &state) {
+            state.partner = bPtr;
+            state.remainingRoundTrips = roundTrips;
+            state.doneSignal = &doneSignal;
+        });
+        b->tell([aPtr](PingPongState &state) { state.partner = aPtr; });
+
+        StopWatch watch;
+
+        sendPing(a);
+
+        REQUIRE(doneSignal.wait(120000));
+
+        int64_t millis = watch.getMillis();
+
+        logInfo("Actor ping-pong: " + std::to_string(roundTrips) + " round trips in " + std::to_string(millis) +
+                " ms (" + std::to_string(millis * 1000.0 / roundTrips) + " us per round trip)");
+
+        // break the reference cycle
+        a->tell([](PingPongState &state) { state.partner = nullptr; });
+        b->tell([](PingPongState &state) { state.partner = nullptr; });
+    }
+
+    SECTION("throughput")
+    {
+        const int messageCount = 1000000;
+
+        P<Actor<CounterState>> counter = newObj<Actor<CounterState>>(pool);
+
+        StopWatch watch;
+
+        for (int i = 0; i < messageCount; i++)
+            counter->tell([](CounterState &state) { state.count++; });
+
+        P<IAsyncOp<int64_t>> op = counter->ask([](CounterState &state) { return state.count; });
+
+        while (!op->isDone())
+            Thread::sleepMillis(1);
+
+        int64_t millis = watch.getMillis();
+
+        REQUIRE(op->getResult() == messageCount);
+
+        logInfo("Actor throughput: " + std::to_string(messageCount) + " messages in " + std::to_string(millis) +
+                " ms (" + std::to_string(messageCount / std::max<int64_t>(millis, 1) * 1000) + " messages/s)");
+    }
+}
+
+#endif
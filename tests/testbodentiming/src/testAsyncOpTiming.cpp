@@ -0,0 +1,78 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/AsyncOpRunnable.h>
+#include <bdn/StopWatch.h>
+#include <bdn/log.h>
+
+using namespace bdn;
+
+class IntTimingOp : public AsyncOpRunnable<int>
+{
+  public:
+    IntTimingOp(int value) : _value(value) {}
+
+  protected:
+    int doOp() override { return _value; }
+
+  private:
+    int _value;
+};
+
+class StringTimingOp : public AsyncOpRunnable<String>
+{
+  public:
+    StringTimingOp(const String &value) : _value(value) {}
+
+  protected:
+    String doOp() override { return _value; }
+
+  private:
+    String _value;
+};
+
+TEST_CASE("asyncOp-timing")
+{
+    const int opCount = 1000000;
+
+    SECTION("int")
+    {
+        int64_t sum = 0;
+
+        StopWatch watch;
+
+        for (int i = 0; i < opCount; i++) {
+            P<IntTimingOp> op = newObj<IntTimingOp>(i);
+            op->run();
+            sum += op->getResult();
+        }
+
+        int64_t millis = watch.getMillis();
+
+        REQUIRE(sum == (int64_t)opCount * (opCount - 1) / 2);
+
+        logInfo("AsyncOpRunnable<int>: created and completed " + std::to_string(opCount) + " ops in " +
+                std::to_string(millis) + " ms");
+    }
+
+    SECTION("String")
+    {
+        String value = "a line of text that was read from stdin";
+        size_t totalLength = 0;
+
+        StopWatch watch;
+
+        for (int i = 0; i < opCount; i++) {
+            P<StringTimingOp> op = newObj<StringTimingOp>(value);
+            op->run();
+            totalLength += op->takeResult().getLength();
+        }
+
+        int64_t millis = watch.getMillis();
+
+        REQUIRE(totalLength == value.getLength() * opCount);
+
+        logInfo("AsyncOpRunnable<String>: created and completed " + std::to_string(opCount) + " ops in " +
+                std::to_string(millis) + " ms");
+    }
+}
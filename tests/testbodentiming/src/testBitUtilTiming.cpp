@@ -0,0 +1,101 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/Number.h>
+#include <bdn/XxHash32.h>
+#include <bdn/XxHash64.h>
+#include <bdn/StopWatch.h>
+#include <bdn/log.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace bdn;
+
+static std::string getMegabytesPerSecond(size_t bytes, int64_t millis)
+{
+    if (millis <= 0)
+        millis = 1;
+
+    return std::to_string(int64_t(bytes / (1024.0 * 1024.0) / (millis / 1000.0))) + " MB/s";
+}
+
+TEST_CASE("bitUtil-timing")
+{
+    const size_t dataSize = 64 * 1024 * 1024;
+
+    std::mt19937 random(1234);
+    std::vector<uint8_t> data(dataSize);
+    for (uint8_t &byte : data)
+        byte = uint8_t(random());
+
+    SECTION("xxHash")
+    {
+        StopWatch watch32;
+        uint32_t hash32 = XxHash32::calcHash(data.data(), dataSize);
+        int64_t millis32 = watch32.getMillis();
+
+        StopWatch watch64;
+        uint64_t hash64 = XxHash64::calcHash(data.data(), dataSize);
+        int64_t millis64 = watch64.getMillis();
+
+        // use the results, so that the calls cannot be optimized away
+        REQUIRE((hash32 != 0 || hash64 != 0));
+
+        logInfo("Hashing 64 MB: XxHash32 " + getMegabytesPerSecond(dataSize, millis32) + ", XxHash64 " +
+                getMegabytesPerSecond(dataSize, millis64));
+    }
+
+    SECTION("byte order")
+    {
+        const size_t valueCount = dataSize / 8;
+
+        // big endian loads, as used in network protocols and file formats
+        StopWatch loadWatch;
+        uint64_t loadSum = 0;
+        for (size_t i = 0; i < valueCount; i++)
+            loadSum += loadBigEndian<uint64_t>(&data[i * 8]);
+        int64_t loadMillis = loadWatch.getMillis();
+
+        // assembling the value byte by byte
+        StopWatch byteWatch;
+        uint64_t byteSum = 0;
+        for (size_t i = 0; i < valueCount; i++) {
+            uint64_t value = 0;
+            for (size_t b = 0; b < 8; b++)
+                value = (value << 8) | data[i * 8 + b];
+            byteSum += value;
+        }
+        int64_t byteMillis = byteWatch.getMillis();
+
+        REQUIRE(loadSum == byteSum);
+
+        logInfo("Big endian loads, 64 MB: loadBigEndian " + getMegabytesPerSecond(dataSize, loadMillis) +
+                ", byte by byte " + getMegabytesPerSecond(dataSize, byteMillis));
+    }
+
+    SECTION("bit counts")
+    {
+        const size_t valueCount = dataSize / 8;
+
+        StopWatch popCountWatch;
+        int64_t popCountSum = 0;
+        for (size_t i = 0; i < valueCount; i++)
+            popCountSum += popCount(loadLittleEndian<uint64_t>(&data[i * 8]));
+        int64_t popCountMillis = popCountWatch.getMillis();
+
+        StopWatch loopWatch;
+        int64_t loopSum = 0;
+        for (size_t i = 0; i < valueCount; i++) {
+            for (uint64_t value = loadLittleEndian<uint64_t>(&data[i * 8]); value != 0; value >>= 1)
+                loopSum += int64_t(value & 1);
+        }
+        int64_t loopMillis = loopWatch.getMillis();
+
+        REQUIRE(popCountSum == loopSum);
+
+        logInfo("Counting bits, 64 MB: popCount " + getMegabytesPerSecond(dataSize, popCountMillis) +
+                ", bit by bit " + getMegabytesPerSecond(dataSize, loopMillis));
+    }
+}
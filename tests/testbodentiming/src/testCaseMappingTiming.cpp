@@ -0,0 +1,132 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/StopWatch.h>
+#include <bdn/log.h>
+
+#include <vector>
+
+using namespace bdn;
+
+static String createCaseMappingTimingInput(size_t length)
+{
+    // mostly ASCII text with some non-ASCII characters
+    std::string line = "The Quick Brown Fox Jumps Over The Lazy Dog. \xc3\x84rger \xc3\xbc"
+                       "ber \xc3\x96l.\n";
+
+    std::string data;
+    data.reserve(length + line.length());
+    while (data.length() < length)
+        data += line;
+
+    return String(data);
+}
+
+TEST_CASE("caseMapping-timing")
+{
+    const size_t inputLength = 1024 * 1024;
+
+    String input = createCaseMappingTimingInput(inputLength);
+
+    SECTION("toLower")
+    {
+        StopWatch mapWatch;
+        String lower = input.toLower();
+        int64_t mapMillis = mapWatch.getMillis();
+
+        // decoding, converting and appending each character separately
+        StopWatch charWatch;
+        String charByChar;
+        for (char32_t chr : input) {
+            char32_t mapped[maxCharCaseMappingLength];
+            int mappedLength = mapCharCase(chr, CaseMapping::toLower, mapped);
+            charByChar.append(mapped, mappedLength);
+        }
+        int64_t charMillis = charWatch.getMillis();
+
+        REQUIRE(lower == charByChar);
+
+        logInfo("toLower on " + std::to_string(inputLength / 1024) + " KB: " + std::to_string(mapMillis) +
+                " ms, character by character " + std::to_string(charMillis) + " ms");
+    }
+
+    SECTION("compareIgnoringCase")
+    {
+        String other = input.toUpper();
+        const int iterationCount = 10;
+
+        StopWatch compareWatch;
+        int compareResult = 0;
+        for (int i = 0; i < iterationCount; i++)
+            compareResult += input.compareIgnoringCase(other);
+        int64_t compareMillis = compareWatch.getMillis();
+
+        StopWatch convertWatch;
+        int convertResult = 0;
+        for (int i = 0; i < iterationCount; i++)
+            convertResult += input.toLower().compare(other.toLower());
+        int64_t convertMillis = convertWatch.getMillis();
+
+        REQUIRE(compareResult == 0);
+        REQUIRE(convertResult == 0);
+
+        logInfo("compareIgnoringCase on " + std::to_string(inputLength / 1024) + " KB (" +
+                std::to_string(iterationCount) + " times): " + std::to_string(compareMillis) +
+                " ms, comparing lower case copies " + std::to_string(convertMillis) + " ms");
+    }
+
+    SECTION("trim")
+    {
+        const int iterationCount = 200000;
+        String padded = " \t  some text with spaces   \r\n";
+
+        StopWatch trimWatch;
+        size_t trimLength = 0;
+        for (int i = 0; i < iterationCount; i++) {
+            String s = padded;
+            trimLength += s.trim().getLength();
+        }
+        int64_t trimMillis = trimWatch.getMillis();
+
+        // the previous way: searching the list of whitespace characters
+        StopWatch findWatch;
+        size_t findLength = 0;
+        for (int i = 0; i < iterationCount; i++) {
+            size_t beginIndex = padded.findNotOneOf(String::getWhitespaceChars());
+            size_t lastIndex = padded.reverseFindNotOneOf(String::getWhitespaceChars());
+            findLength += padded.subString(beginIndex, lastIndex + 1 - beginIndex).getLength();
+        }
+        int64_t findMillis = findWatch.getMillis();
+
+        REQUIRE(trimLength == findLength);
+
+        logInfo("trim " + std::to_string(iterationCount) + " times: " + std::to_string(trimMillis) +
+                " ms, findNotOneOf with getWhitespaceChars() " + std::to_string(findMillis) + " ms");
+    }
+
+    SECTION("calcCaseInsensitiveHash")
+    {
+        // short keys, as they are used in case-insensitive hash maps
+        std::vector<String> keys;
+        for (int i = 0; i < 200000; i++)
+            keys.push_back("Some-Key_" + std::to_string(i) + ((i % 3 != 0) ? "\xc3\x84" "BC" : "abc"));
+
+        StopWatch hashWatch;
+        size_t hashSum = 0;
+        for (const String &key : keys)
+            hashSum += key.calcCaseInsensitiveHash();
+        int64_t hashMillis = hashWatch.getMillis();
+
+        // the previous way: hashing a case folded copy
+        StopWatch copyWatch;
+        size_t copySum = 0;
+        for (const String &key : keys)
+            copySum += key.toCaseFolded().calcHash();
+        int64_t copyMillis = copyWatch.getMillis();
+
+        REQUIRE(hashSum == copySum);
+
+        logInfo("calcCaseInsensitiveHash for " + std::to_string(keys.size()) + " keys: " + std::to_string(hashMillis) +
+                " ms, hashing case folded copies " + std::to_string(copyMillis) + " ms");
+    }
+}
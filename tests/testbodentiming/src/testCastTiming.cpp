@@ -0,0 +1,104 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/StopWatch.h>
+#include <bdn/log.h>
+
+using namespace bdn;
+
+// a hierarchy that resembles the view core interfaces
+
+class ICastTimingView : BDN_IMPLEMENTS IBase
+{
+    BDN_INTERFACE_ID(::ICastTimingView);
+
+  public:
+    virtual int viewValue() = 0;
+};
+
+class ICastTimingExtension : BDN_IMPLEMENTS IBase
+{
+    BDN_INTERFACE_ID(::ICastTimingExtension);
+
+  public:
+    virtual int extensionValue() = 0;
+};
+
+class ICastTimingToggle : BDN_IMPLEMENTS ICastTimingView
+{
+    BDN_INTERFACE_ID(::ICastTimingToggle);
+};
+
+class ICastTimingCheckbox : BDN_IMPLEMENTS ICastTimingToggle
+{
+    BDN_INTERFACE_ID(::ICastTimingCheckbox);
+};
+
+class CastTimingViewCore : public Base, BDN_IMPLEMENTS ICastTimingView, BDN_IMPLEMENTS ICastTimingExtension
+{
+  public:
+    int viewValue() override { return 1; }
+    int extensionValue() override { return 2; }
+};
+
+class CastTimingCheckboxCore : public CastTimingViewCore, BDN_IMPLEMENTS ICastTimingCheckbox
+{
+};
+
+class CastTimingCheckboxCoreWithTable : public CastTimingViewCore, BDN_IMPLEMENTS ICastTimingCheckbox
+{
+    BDN_INTERFACE_TABLE(ICastTimingCheckbox, ICastTimingToggle, ICastTimingView, ICastTimingExtension);
+};
+
+template <class DestType> static int64_t measureDynamicCast(IBase *object, int iterations, uintptr_t &sink)
+{
+    StopWatch watch;
+
+    for (int i = 0; i < iterations; i++)
+        sink += reinterpret_cast<uintptr_t>(dynamic_cast<DestType *>(object));
+
+    return watch.getMillis();
+}
+
+template <class DestType> static int64_t measureTryCast(IBase *object, int iterations, uintptr_t &sink)
+{
+    StopWatch watch;
+
+    for (int i = 0; i < iterations; i++)
+        sink += reinterpret_cast<uintptr_t>(tryCast<DestType>(object));
+
+    return watch.getMillis();
+}
+
+template <class DestType> static void compareCasts(const String &name, IBase *withoutTable, IBase *withTable)
+{
+    const int iterations = 5000000;
+
+    uintptr_t sink = 0;
+
+    int64_t dynamicMillis = measureDynamicCast<DestType>(withoutTable, iterations, sink);
+    int64_t tableMillis = measureTryCast<DestType>(withTable, iterations, sink);
+
+    REQUIRE(sink != 0);
+
+    logInfo(name + ": dynamic_cast " + std::to_string(dynamicMillis) + " ms, interface table " +
+            std::to_string(tableMillis) + " ms (" + std::to_string(iterations) + " casts)");
+}
+
+TEST_CASE("tryCast-timing")
+{
+    P<CastTimingCheckboxCore> withoutTable = newObj<CastTimingCheckboxCore>();
+    P<CastTimingCheckboxCoreWithTable> withTable = newObj<CastTimingCheckboxCoreWithTable>();
+
+    // the casts start from the view interface, like
+    // cast<ICheckboxCore>(getViewCore()) does.
+    IBase *withoutTableBase = static_cast<ICastTimingView *>(withoutTable.getPtr());
+    IBase *withTableBase = static_cast<ICastTimingView *>(withTable.getPtr());
+
+    REQUIRE(tryCast<ICastTimingCheckbox>(withTableBase) == dynamic_cast<ICastTimingCheckbox *>(withTableBase));
+    REQUIRE(tryCast<ICastTimingExtension>(withTableBase) == dynamic_cast<ICastTimingExtension *>(withTableBase));
+
+    compareCasts<ICastTimingCheckbox>("cast to most derived interface", withoutTableBase, withTableBase);
+    compareCasts<ICastTimingView>("cast to base interface", withoutTableBase, withTableBase);
+    compareCasts<ICastTimingExtension>("cross cast to sibling interface", withoutTableBase, withTableBase);
+}
@@ -0,0 +1,90 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/GenericDispatcher.h>
+#include <bdn/Thread.h>
+#include <bdn/log.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+using namespace bdn;
+
+#if BDN_HAVE_THREADS
+
+// Measures how long a latency-critical item (e.g. input handling) waits when
+// the dispatcher is flooded with background work.
+
+typedef std::chrono::steady_clock LatencyClock;
+
+static void busyWaitMicros(int micros)
+{
+    auto endTime = LatencyClock::now() + std::chrono::microseconds(micros);
+    while (LatencyClock::now() < endTime) {
+    }
+}
+
+static void measureProbeLatency(IDispatcher::Priority probePriority, double &averageMillis, double &maxMillis)
+{
+    const int backgroundItemCount = 20000;
+    const int backgroundItemMicros = 20;
+    const int probeCount = 50;
+
+    P<GenericDispatcher> dispatcher = newObj<GenericDispatcher>();
+    P<Thread> thread = newObj<Thread>(newObj<GenericDispatcher::ThreadRunnable>(dispatcher));
+
+    for (int i = 0; i < backgroundItemCount; i++)
+        dispatcher->enqueue([]() { busyWaitMicros(backgroundItemMicros); });
+
+    std::atomic<int64_t> totalLatencyMicros{0};
+    std::atomic<int64_t> maxLatencyMicros{0};
+    Signal probeDoneSignal;
+
+    for (int probe = 0; probe < probeCount; probe++) {
+        LatencyClock::time_point enqueueTime = LatencyClock::now();
+
+        probeDoneSignal.clear();
+
+        dispatcher->enqueue(
+            [enqueueTime, &totalLatencyMicros, &maxLatencyMicros, &probeDoneSignal]() {
+                int64_t latency =
+                    std::chrono::duration_cast<std::chrono::microseconds>(LatencyClock::now() - enqueueTime).count();
+
+                totalLatencyMicros += latency;
+                if (latency > maxLatencyMicros)
+                    maxLatencyMicros = latency;
+
+                probeDoneSignal.set();
+            },
+            probePriority);
+
+        REQUIRE(probeDoneSignal.wait(60000));
+
+        Thread::sleepMillis(1);
+    }
+
+    thread->stop(Thread::ExceptionIgnore);
+    dispatcher->dispose();
+
+    averageMillis = totalLatencyMicros / (double)probeCount / 1000.0;
+    maxMillis = maxLatencyMicros / 1000.0;
+}
+
+TEST_CASE("dispatcherLatency-timing")
+{
+    double normalAverage, normalMax;
+    measureProbeLatency(IDispatcher::Priority::normal, normalAverage, normalMax);
+
+    double urgentAverage, urgentMax;
+    measureProbeLatency(IDispatcher::Priority::urgent, urgentAverage, urgentMax);
+
+    logInfo("Dispatcher probe latency under load (normal priority): average " + std::to_string(normalAverage) +
+            " ms, max " + std::to_string(normalMax) + " ms");
+    logInfo("Dispatcher probe latency under load (urgent priority): average " + std::to_string(urgentAverage) +
+            " ms, max " + std::to_string(urgentMax) + " ms");
+
+    REQUIRE(urgentAverage < normalAverage);
+}
+
+#endif
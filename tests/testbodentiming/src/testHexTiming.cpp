@@ -0,0 +1,96 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/hex.h>
+#include <bdn/base64.h>
+#include <bdn/StopWatch.h>
+#include <bdn/log.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace bdn;
+
+static std::string getMegabytesPerSecond(size_t bytes, int64_t millis)
+{
+    if (millis <= 0)
+        millis = 1;
+
+    return std::to_string(int64_t(bytes / (1024.0 * 1024.0) / (millis / 1000.0))) + " MB/s";
+}
+
+TEST_CASE("hex-timing")
+{
+    const size_t dataSize = 16 * 1024 * 1024;
+
+    std::mt19937 random(1234);
+    std::vector<uint8_t> data(dataSize);
+    for (uint8_t &byte : data)
+        byte = uint8_t(random());
+
+    SECTION("hex")
+    {
+        std::string encoded(dataSize * 2, ' ');
+
+        StopWatch encodeWatch;
+        hexEncode(data.data(), dataSize, &encoded[0]);
+        int64_t encodeMillis = encodeWatch.getMillis();
+
+        // the previous way: one digit at a time with encodeHexDigit
+        std::string perDigitEncoded(dataSize * 2, ' ');
+        StopWatch perDigitEncodeWatch;
+        for (size_t i = 0; i < dataSize; i++) {
+            perDigitEncoded[i * 2] = char(encodeHexDigit(data[i] >> 4));
+            perDigitEncoded[i * 2 + 1] = char(encodeHexDigit(data[i] & 0xf));
+        }
+        int64_t perDigitEncodeMillis = perDigitEncodeWatch.getMillis();
+
+        REQUIRE(encoded == perDigitEncoded);
+
+        std::vector<uint8_t> decoded(dataSize);
+        StopWatch decodeWatch;
+        REQUIRE(hexDecode(encoded.c_str(), encoded.length(), decoded.data()));
+        int64_t decodeMillis = decodeWatch.getMillis();
+
+        std::vector<uint8_t> perDigitDecoded(dataSize);
+        StopWatch perDigitDecodeWatch;
+        for (size_t i = 0; i < dataSize; i++) {
+            int high = decodeHexDigit(encoded[i * 2]);
+            int low = decodeHexDigit(encoded[i * 2 + 1]);
+            if (high < 0 || low < 0)
+                break;
+            perDigitDecoded[i] = uint8_t((high << 4) | low);
+        }
+        int64_t perDigitDecodeMillis = perDigitDecodeWatch.getMillis();
+
+        REQUIRE(decoded == data);
+        REQUIRE(perDigitDecoded == data);
+
+        logInfo("Hex encoding 16 MB: hexEncode " + getMegabytesPerSecond(dataSize, encodeMillis) +
+                ", per digit " + getMegabytesPerSecond(dataSize, perDigitEncodeMillis));
+        logInfo("Hex decoding 16 MB: hexDecode " + getMegabytesPerSecond(dataSize, decodeMillis) +
+                ", per digit " + getMegabytesPerSecond(dataSize, perDigitDecodeMillis));
+    }
+
+    SECTION("base64")
+    {
+        std::string encoded(getBase64EncodedLength(dataSize), ' ');
+
+        StopWatch encodeWatch;
+        base64Encode(data.data(), dataSize, &encoded[0]);
+        int64_t encodeMillis = encodeWatch.getMillis();
+
+        std::vector<uint8_t> decoded(encoded.length() / 4 * 3);
+        size_t decodedBytes = 0;
+        StopWatch decodeWatch;
+        REQUIRE(base64Decode(encoded.c_str(), encoded.length(), decoded.data(), decodedBytes));
+        int64_t decodeMillis = decodeWatch.getMillis();
+
+        decoded.resize(decodedBytes);
+        REQUIRE(decoded == data);
+
+        logInfo("Base64 16 MB: encode " + getMegabytesPerSecond(dataSize, encodeMillis) + ", decode " +
+                getMegabytesPerSecond(dataSize, decodeMillis));
+    }
+}
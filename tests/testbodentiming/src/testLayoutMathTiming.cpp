@@ -0,0 +1,85 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/StopWatch.h>
+#include <bdn/log.h>
+#include <bdn/Dip.h>
+#include <bdn/Rect.h>
+#include <bdn/UiMargin.h>
+
+#include <vector>
+
+using namespace bdn;
+
+// Simulates the kind of value shuffling that a layout pass does: lengths and
+// margins are copied out of views, converted and combined with rects.
+
+template <class ValueType> static int64_t measureCopy(const std::vector<ValueType> &source, int rounds, double &sink)
+{
+    StopWatch watch;
+
+    for (int round = 0; round < rounds; round++) {
+        std::vector<ValueType> copy(source);
+        sink += static_cast<double>(copy[round % copy.size()].getValue());
+    }
+
+    return watch.getMillis();
+}
+
+static int64_t measureLayoutMath(const std::vector<UiMargin> &margins, const std::vector<Rect> &rects, int rounds,
+                                 double &sink)
+{
+    StopWatch watch;
+
+    std::vector<Rect> result(rects.size());
+
+    for (int round = 0; round < rounds; round++) {
+        for (size_t i = 0; i < rects.size(); i++) {
+            UiMargin uiMargin = margins[i];
+
+            Margin margin(uiMargin.top.value, uiMargin.right.value, uiMargin.bottom.value, uiMargin.left.value);
+
+            Rect contentRect = rects[i] - margin;
+            Size size = contentRect.getSize() + margin;
+
+            Dip width = size.width;
+            Dip height = size.height;
+            if (width == contentRect.width)
+                height = height + 1;
+
+            result[i] = Rect(contentRect.getPosition(), Size(width, height));
+        }
+
+        sink += result[round % result.size()].width;
+    }
+
+    return watch.getMillis();
+}
+
+TEST_CASE("layoutMath-timing")
+{
+    const size_t count = 100000;
+    const int rounds = 200;
+
+    std::vector<Dip> dips;
+    std::vector<UiMargin> margins;
+    std::vector<Rect> rects;
+
+    for (size_t i = 0; i < count; i++) {
+        dips.push_back(Dip(i * 0.5));
+        margins.push_back(UiMargin(UiLength::dip(i % 7), UiLength::dip(i % 3)));
+        rects.push_back(Rect(i % 100, i % 50, 100 + i % 200, 20 + i % 30));
+    }
+
+    double sink = 0;
+
+    int64_t dipCopyMillis = measureCopy(dips, rounds, sink);
+    int64_t layoutMillis = measureLayoutMath(margins, rects, rounds, sink);
+
+    REQUIRE(sink != 0);
+
+    logInfo("Copying " + std::to_string(count) + " Dip values " + std::to_string(rounds) + " times: " +
+            std::to_string(dipCopyMillis) + " ms");
+    logInfo("Layout math on " + std::to_string(count) + " rects " + std::to_string(rounds) +
+            " times: " + std::to_string(layoutMillis) + " ms");
+}
@@ -0,0 +1,71 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/parseNumber.h>
+#include <bdn/StopWatch.h>
+#include <bdn/log.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace bdn;
+
+TEST_CASE("parseNumber-timing")
+{
+    const int valueCount = 200000;
+
+    std::mt19937 random(1234);
+
+    std::vector<String> doubleTexts;
+    std::vector<String> intTexts;
+    for (int i = 0; i < valueCount; i++) {
+        double value = std::uniform_real_distribution<double>(-1e6, 1e6)(random);
+        doubleTexts.push_back(std::to_string(value));
+
+        int64_t intValue = std::uniform_int_distribution<int64_t>(-1000000000000, 1000000000000)(random);
+        intTexts.push_back(std::to_string(intValue));
+    }
+
+    SECTION("double")
+    {
+        StopWatch parseWatch;
+        double parseSum = 0;
+        for (const String &text : doubleTexts)
+            parseSum += parseDouble(text).get();
+        int64_t parseMillis = parseWatch.getMillis();
+
+        // the previous way: converting to the locale encoding and calling
+        // std::stod
+        StopWatch stodWatch;
+        double stodSum = 0;
+        for (const String &text : doubleTexts)
+            stodSum += std::stod(text.toLocaleEncoding());
+        int64_t stodMillis = stodWatch.getMillis();
+
+        REQUIRE(parseSum == stodSum);
+
+        logInfo("Parsing " + std::to_string(valueCount) + " doubles: parseDouble " + std::to_string(parseMillis) +
+                " ms, std::stod " + std::to_string(stodMillis) + " ms");
+    }
+
+    SECTION("int")
+    {
+        StopWatch parseWatch;
+        int64_t parseSum = 0;
+        for (const String &text : intTexts)
+            parseSum += parseInt<int64_t>(text).get();
+        int64_t parseMillis = parseWatch.getMillis();
+
+        StopWatch stollWatch;
+        int64_t stollSum = 0;
+        for (const String &text : intTexts)
+            stollSum += std::stoll(text.toLocaleEncoding());
+        int64_t stollMillis = stollWatch.getMillis();
+
+        REQUIRE(parseSum == stollSum);
+
+        logInfo("Parsing " + std::to_string(valueCount) + " integers: parseInt " + std::to_string(parseMillis) +
+                " ms, std::stoll " + std::to_string(stollMillis) + " ms");
+    }
+}
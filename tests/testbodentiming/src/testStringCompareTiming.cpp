@@ -0,0 +1,85 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/StopWatch.h>
+#include <bdn/log.h>
+
+#include <vector>
+
+using namespace bdn;
+
+template <class StringType> static std::vector<StringType> createCompareTimingStrings(int count)
+{
+    // long common prefixes (like file paths) with the differences at the end
+    std::vector<StringType> result;
+
+    for (int i = 0; i < count; i++)
+        result.push_back(StringType(U"/home/user/Dokumente/Projekte/Überblick/source/module_" +
+                                    std::u32string(1, U'a' + (i * 7) % 26) + U"/file_" +
+                                    std::u32string(1, U'a' + (i * 13) % 26) + U".cpp"));
+
+    return result;
+}
+
+template <class MainDataType> static void testCompareTiming(const String &encodingName)
+{
+    typedef StringImpl<MainDataType> StringType;
+
+    const int stringCount = 500;
+
+    std::vector<StringType> strings = createCompareTimingStrings<StringType>(stringCount);
+
+    int64_t encodedSum = 0;
+    StopWatch encodedWatch;
+
+    for (const StringType &a : strings) {
+        for (const StringType &b : strings)
+            encodedSum += a.compare(b);
+    }
+
+    int64_t encodedMillis = encodedWatch.getMillis();
+
+    int64_t decodedSum = 0;
+    StopWatch decodedWatch;
+
+    // this is what compare used to do: decode both strings and compare the
+    // characters one by one.
+    for (const StringType &a : strings) {
+        for (const StringType &b : strings)
+            decodedSum += a.compare(b.begin(), b.end());
+    }
+
+    int64_t decodedMillis = decodedWatch.getMillis();
+
+    REQUIRE(encodedSum == decodedSum);
+
+    int equalCount = 0;
+    StopWatch equalsWatch;
+
+    for (const StringType &a : strings) {
+        for (const StringType &b : strings) {
+            if (a == b)
+                equalCount++;
+        }
+    }
+
+    int64_t equalsMillis = equalsWatch.getMillis();
+
+    REQUIRE(equalCount >= stringCount);
+
+    logInfo("Comparing " + std::to_string(stringCount * stringCount) + " " + encodingName +
+            " string pairs: encoded data " + std::to_string(encodedMillis) + " ms, decoded characters " +
+            std::to_string(decodedMillis) + " ms, equality " + std::to_string(equalsMillis) + " ms");
+}
+
+TEST_CASE("stringCompare-timing")
+{
+    SECTION("utf8")
+    testCompareTiming<Utf8StringData>("UTF-8");
+
+    SECTION("utf16")
+    testCompareTiming<Utf16StringData>("UTF-16");
+
+    SECTION("utf32")
+    testCompareTiming<Utf32StringData>("UTF-32");
+}
@@ -0,0 +1,130 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/StopWatch.h>
+#include <bdn/log.h>
+
+using namespace bdn;
+
+TEST_CASE("stringConcat-timing")
+{
+    const int iterationCount = 200000;
+
+    String functionName = "LayoutCoordinator::updateLayout";
+    String message = "the view was deleted while a layout update was pending";
+    std::string details = "pending views: 17";
+
+    SECTION("two operands")
+    {
+        size_t expectedLength = functionName.length() + 2;
+
+        SECTION("operator+")
+        {
+            size_t totalLength = 0;
+
+            StopWatch watch;
+
+            for (int i = 0; i < iterationCount; i++) {
+                String result = functionName + ": ";
+                totalLength += result.length();
+            }
+
+            int64_t millis = watch.getMillis();
+
+            REQUIRE(totalLength == expectedLength * iterationCount);
+
+            logInfo("String concatenation with 2 operands (operator+): " + std::to_string(iterationCount) +
+                    " iterations in " + std::to_string(millis) + " ms");
+        }
+
+        SECTION("copy and append")
+        {
+            // this is what operator+ used to do: copy the left operand, then
+            // append the right one (which re-allocates the shared copy).
+            size_t totalLength = 0;
+
+            StopWatch watch;
+
+            for (int i = 0; i < iterationCount; i++) {
+                String result(functionName);
+                result += ": ";
+                totalLength += result.length();
+            }
+
+            int64_t millis = watch.getMillis();
+
+            REQUIRE(totalLength == expectedLength * iterationCount);
+
+            logInfo("String concatenation with 2 operands (copy and append): " + std::to_string(iterationCount) +
+                    " iterations in " + std::to_string(millis) + " ms");
+        }
+    }
+
+    SECTION("six operands")
+    {
+        size_t expectedLength = ("Exception in " + functionName + ": " + message + " (" + details + ")").length();
+
+        SECTION("operator+")
+        {
+            size_t totalLength = 0;
+
+            StopWatch watch;
+
+            for (int i = 0; i < iterationCount; i++) {
+                String result = "Exception in " + functionName + ": " + message + " (" + details + ")";
+                totalLength += result.length();
+            }
+
+            int64_t millis = watch.getMillis();
+
+            REQUIRE(totalLength == expectedLength * iterationCount);
+
+            logInfo("String concatenation with 6 operands (operator+): " + std::to_string(iterationCount) +
+                    " iterations in " + std::to_string(millis) + " ms");
+        }
+
+        SECTION("concat")
+        {
+            size_t totalLength = 0;
+
+            StopWatch watch;
+
+            for (int i = 0; i < iterationCount; i++) {
+                String result = concat("Exception in ", functionName, ": ", message, " (", details, ")");
+                totalLength += result.length();
+            }
+
+            int64_t millis = watch.getMillis();
+
+            REQUIRE(totalLength == expectedLength * iterationCount);
+
+            logInfo("String concatenation with 6 operands (concat): " + std::to_string(iterationCount) +
+                    " iterations in " + std::to_string(millis) + " ms");
+        }
+
+        SECTION("step by step")
+        {
+            size_t totalLength = 0;
+
+            StopWatch watch;
+
+            for (int i = 0; i < iterationCount; i++) {
+                String result("Exception in ");
+                result += functionName;
+                result += ": ";
+                result += message;
+                result += " (";
+                result += details;
+                result += ")";
+                totalLength += result.length();
+            }
+
+            int64_t millis = watch.getMillis();
+
+            REQUIRE(totalLength == expectedLength * iterationCount);
+
+            logInfo("String concatenation with 6 operands (step by step): " + std::to_string(iterationCount) +
+                    " iterations in " + std::to_string(millis) + " ms");
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/StringReplacer.h>
+#include <bdn/StopWatch.h>
+#include <bdn/log.h>
+
+using namespace bdn;
+
+static String createReplacerTimingInput(size_t length)
+{
+    // mostly text without matches, with some characters that need escaping
+    const char *words[] = {"lorem ", "ipsum ", "dolor: ", "sit ", "amet, ", "<consectetur> ", "adipiscing ",
+                           "elit & ", "sed ", "do \"eiusmod\" ", "tempor ", "100% ", "[[incididunt]] "};
+
+    std::string data;
+    data.reserve(length + 32);
+
+    for (int i = 0; data.length() < length; i++)
+        data += words[(i * 7) % (sizeof(words) / sizeof(words[0]))];
+
+    return String(data);
+}
+
+static StringReplacer::Replacements createTimingReplacements(int count)
+{
+    StringReplacer::Replacements replacements = {{"%", "%25"},   {"]]", "%5d%5d"}, {":", "%3a"},   {"\"", "%22"},
+                                                 {"&", "&amp;"}, {"<", "&lt;"},    {">", "&gt;"}, {"tempor", "TEMPOR"}};
+
+    // the remaining patterns do not occur in the input, so they only make the
+    // search harder.
+    for (int i = (int)replacements.size(); i < count; i++)
+        replacements.emplace_back("pattern" + std::to_string(i), "x");
+
+    replacements.resize(count);
+
+    return replacements;
+}
+
+TEST_CASE("stringReplacer-timing")
+{
+    const size_t inputLength = 1024 * 1024;
+
+    String input = createReplacerTimingInput(inputLength);
+
+    for (int patternCount : {1, 3, 8, 20, 50}) {
+        StringReplacer::Replacements replacements = createTimingReplacements(patternCount);
+
+        StopWatch replacerWatch;
+
+        StringReplacer replacer(replacements);
+        String replacerResult = input;
+        replacer.findAndReplace(replacerResult);
+
+        int64_t replacerMillis = replacerWatch.getMillis();
+
+        StopWatch sequentialWatch;
+
+        String sequentialResult = input;
+        for (auto &replacement : replacements)
+            sequentialResult.findAndReplace(replacement.first, replacement.second);
+
+        int64_t sequentialMillis = sequentialWatch.getMillis();
+
+        // none of the replacements contain other patterns, so the result is
+        // the same.
+        REQUIRE(replacerResult == sequentialResult);
+
+        logInfo("Replacing " + std::to_string(patternCount) + " patterns in " +
+                std::to_string(inputLength / (1024 * 1024)) + " MB: StringReplacer " + std::to_string(replacerMillis) +
+                " ms, one findAndReplace per pattern " + std::to_string(sequentialMillis) + " ms");
+    }
+}
@@ -0,0 +1,70 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/StringSplitter.h>
+#include <bdn/StopWatch.h>
+#include <bdn/log.h>
+
+using namespace bdn;
+
+static String createSplitTimingInput(size_t length)
+{
+    // lines of a log file with comma separated fields
+    std::string line = "2018-04-12 10:31:07,INFO,worker-3,request \xc3\xbc"
+                       "ber proxy,200,17 ms\n";
+
+    std::string data;
+    data.reserve(length + line.length());
+    while (data.length() < length)
+        data += line;
+
+    return String(data);
+}
+
+TEST_CASE("stringSplit-timing")
+{
+    const size_t inputLength = 16 * 1024 * 1024;
+
+    String input = createSplitTimingInput(inputLength);
+
+    StopWatch splitWatch;
+    size_t splitFieldCount = 0;
+    size_t splitCharCount = 0;
+    for (const StringView &field : input.split(",\n")) {
+        splitFieldCount++;
+        splitCharCount += field.getLength();
+    }
+    int64_t splitMillis = splitWatch.getMillis();
+
+    StopWatch arrayWatch;
+    Array<String> fieldArray = input.split(",\n").toArray();
+    int64_t arrayMillis = arrayWatch.getMillis();
+
+    // the previous way: find and subString for each field
+    StopWatch findWatch;
+    size_t findFieldCount = 0;
+    size_t findCharCount = 0;
+    const String delimiters = ",\n";
+    String::Iterator fieldBeginIt = input.begin();
+    while (true) {
+        String::Iterator fieldEndIt = input.findOneOf(delimiters.begin(), delimiters.end(), fieldBeginIt);
+        String field = input.subString(fieldBeginIt, fieldEndIt);
+
+        findFieldCount++;
+        findCharCount += field.getLength();
+
+        if (fieldEndIt == input.end())
+            break;
+        fieldBeginIt = fieldEndIt;
+        ++fieldBeginIt;
+    }
+    int64_t findMillis = findWatch.getMillis();
+
+    REQUIRE(splitFieldCount == findFieldCount);
+    REQUIRE(splitCharCount == findCharCount);
+    REQUIRE(fieldArray.getSize() == splitFieldCount);
+
+    logInfo("Splitting " + std::to_string(inputLength / (1024 * 1024)) + " MB into " +
+            std::to_string(splitFieldCount) + " fields: split " + std::to_string(splitMillis) + " ms, toArray " +
+            std::to_string(arrayMillis) + " ms, findOneOf and subString " + std::to_string(findMillis) + " ms");
+}
@@ -0,0 +1,99 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/TextRope.h>
+#include <bdn/StopWatch.h>
+#include <bdn/log.h>
+
+#include <random>
+#include <vector>
+
+using namespace bdn;
+
+namespace
+{
+    struct TextEdit
+    {
+        size_t index;
+        size_t eraseCount;
+        String insertText;
+    };
+}
+
+static std::vector<TextEdit> createTextEdits(size_t textLength, int editCount)
+{
+    // typing, deleting and pasting at random positions of the document
+    std::mt19937 random(1234);
+    std::vector<TextEdit> edits;
+
+    size_t length = textLength;
+    for (int i = 0; i < editCount; i++) {
+        TextEdit edit;
+        edit.index = std::uniform_int_distribution<size_t>(0, length)(random);
+
+        switch (i % 4) {
+        case 0:
+        case 1:
+            edit.eraseCount = 0;
+            edit.insertText = (i % 8 == 0) ? U"ä" : U"x";
+            break;
+
+        case 2:
+            edit.eraseCount = 1;
+            break;
+
+        default:
+            edit.eraseCount = 5;
+            edit.insertText = "pasted text\n";
+            break;
+        }
+
+        edit.eraseCount = std::min(edit.eraseCount, length - edit.index);
+        length = length - edit.eraseCount + edit.insertText.getLength();
+
+        edits.push_back(edit);
+    }
+
+    return edits;
+}
+
+TEST_CASE("textRope-timing")
+{
+    const int editCount = 500;
+
+    std::string line = "The quick brown fox jumps over the lazy dog. \xc3\xa4\xc3\xb6\xc3\xbc\n";
+    std::string utf8;
+    while (utf8.length() < 1024 * 1024)
+        utf8 += line;
+
+    String document(utf8);
+    std::vector<TextEdit> edits = createTextEdits(document.getLength(), editCount);
+
+    StopWatch ropeWatch;
+
+    TextRope rope(document);
+    for (const TextEdit &edit : edits)
+        rope.replace(edit.index, edit.eraseCount, edit.insertText);
+
+    size_t lineCount = rope.getLineCount();
+    size_t lineStartIndex = rope.getLineStartIndex(lineCount / 2);
+
+    String ropeResult = rope.toString();
+
+    int64_t ropeMillis = ropeWatch.getMillis();
+
+    StopWatch stringWatch;
+
+    String stringResult = document;
+    for (const TextEdit &edit : edits)
+        stringResult.replace(edit.index, edit.eraseCount, edit.insertText);
+
+    int64_t stringMillis = stringWatch.getMillis();
+
+    REQUIRE(ropeResult == stringResult);
+    REQUIRE(lineStartIndex > 0);
+
+    logInfo("Applying " + std::to_string(editCount) + " edits to a " + std::to_string(utf8.length() / 1024) +
+            " KB text: TextRope " + std::to_string(ropeMillis) +
+            " ms (including the conversion from and to String), String " + std::to_string(stringMillis) + " ms");
+}
@@ -0,0 +1,76 @@
+#include <bdn/init.h>
+#include <bdn/test.h>
+
+#include <bdn/SimpleNotifier.h>
+#include <bdn/StopWatch.h>
+#include <bdn/log.h>
+
+#include <vector>
+
+using namespace bdn;
+
+class WeakSubscriberTimingHelper : public Base
+{
+  public:
+    void onNotify(int value) { sum += value; }
+
+    int sum = 0;
+};
+
+/** Subscribes subscriberCount weak methods, destroys every second object and
+   measures the notify call that finds and removes the dead subscribers.
+
+    If wrapInLambda is true then each weak method is wrapped in a lambda. The
+   weak method is then not the direct target of the subscribed function, so
+   dead subscribers are only detected by catching the DanglingFunctionError
+   (which is what the notifier did for all subscribers before
+   DanglingCallScope_ existed).*/
+static void measureNotifyWithDeadSubscribers(const String &name, bool wrapInLambda)
+{
+    const int subscriberCount = 100000;
+
+    P<SimpleNotifier<int>> notifier = newObj<SimpleNotifier<int>>();
+    std::vector<P<WeakSubscriberTimingHelper>> helpers;
+
+    for (int i = 0; i < subscriberCount; i++) {
+        P<WeakSubscriberTimingHelper> helper = newObj<WeakSubscriberTimingHelper>();
+
+        std::function<void(int)> func = weakMethod(helper, &WeakSubscriberTimingHelper::onNotify);
+        if (wrapInLambda)
+            notifier->subscribe([func](int value) { func(value); });
+        else
+            notifier->subscribe(func);
+
+        if (i % 2 == 0)
+            helpers.push_back(helper);
+    }
+
+    StopWatch watch;
+
+    notifier->notify(1);
+
+    int64_t millis = watch.getMillis();
+
+    for (auto &helper : helpers)
+        REQUIRE(helper->sum == 1);
+
+    // the dead subscribers have been removed, so the second notification
+    // only reaches the live ones.
+    notifier->notify(1);
+
+    for (auto &helper : helpers)
+        REQUIRE(helper->sum == 2);
+
+    logInfo(name + ": " + std::to_string(subscriberCount) + " weak subscribers (50% dead) notified in " +
+            std::to_string(millis) + " ms (" + std::to_string(millis * 1000.0 / subscriberCount) +
+            " us per subscriber)");
+}
+
+TEST_CASE("weakSubscriber-timing")
+{
+    SECTION("DanglingCallScope_")
+    measureNotifyWithDeadSubscribers("DanglingCallScope_", false);
+
+    SECTION("DanglingFunctionError")
+    measureNotifyWithDeadSubscribers("DanglingFunctionError", true);
+}